@@ -0,0 +1,371 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2015-2016 Mario Luzeiro <mrluzeiro@ua.pt>
+ * Copyright (C) 1992-2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file  cbvh4_traversal.cpp
+ * @brief This file implements the 4-wide BVH built from the PBRT binary BVH
+ * and the single ray traversal over it.
+ *
+ * "Shallow Bounding Volume Hierarchies for Fast SIMD Ray Tracing of
+ * Incoherent Rays", H. Dammertz, J. Hanika and A. Keller
+ */
+
+#include "cbvh_pbrt.h"
+#include <string.h>
+#include <wx/debug.h>
+
+#ifdef BVH4_USE_SSE
+#include <emmintrin.h>
+#endif
+
+
+// Each interior node pushes at most 3 more nodes than it pops
+#define MAX_TODOS4 256
+
+
+struct StackNode4
+{
+    int   node;     ///< same encoding as LinearBVH4Node::child
+    float tNear;    ///< distance where the ray enters the node bounds
+};
+
+
+/**
+ * Ray data laid out for the slab test of the 4-wide nodes
+ */
+struct BVH4_RAY
+{
+    BVH4_RAY( const RAY &aRay )
+    {
+        for( unsigned int a = 0; a < 3; ++a )
+        {
+            m_Origin[a] = aRay.m_Origin[a];
+            m_InvDir[a] = aRay.m_InvDir[a];
+
+            // Use the sign of the inverse so a +0.0 direction gets the min plane
+            // as the near one, the same as a +inf inverse implies
+            m_nearIsMax[a] = (aRay.m_InvDir[a] < 0.0f) ? 1 : 0;
+        }
+    }
+
+    float        m_Origin[3];
+    float        m_InvDir[3];
+    unsigned int m_nearIsMax[3];
+};
+
+
+/**
+ * Function intersectChildren
+ * tests a ray against the bounds of all children of a node.
+ * The min / max operands are ordered so a NaN (ray parallel to and laying on
+ * a slab plane) takes the second operand, that is, the axis is ignored.
+ * @param aTNear - returns the distance where the ray enters each child
+ * @return the bit mask of the children hit before aTMax
+ */
+static inline unsigned int intersectChildren( const LinearBVH4Node &aNode,
+                                              const BVH4_RAY &aRay,
+                                              float aTMax,
+                                              float aTNear[4] )
+{
+#ifdef BVH4_USE_SSE
+    __m128 tNear = _mm_setzero_ps();
+    __m128 tFar  = _mm_set1_ps( aTMax );
+
+    for( unsigned int a = 0; a < 3; ++a )
+    {
+        const __m128 org    = _mm_set1_ps( aRay.m_Origin[a] );
+        const __m128 invDir = _mm_set1_ps( aRay.m_InvDir[a] );
+
+        const unsigned int nearIdx = aRay.m_nearIsMax[a];
+
+        const __m128 t0 = _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( aNode.bounds[nearIdx][a] ),
+                                                  org ),
+                                      invDir );
+
+        const __m128 t1 = _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( aNode.bounds[1 - nearIdx][a] ),
+                                                  org ),
+                                      invDir );
+
+        tNear = _mm_max_ps( t0, tNear );
+        tFar  = _mm_min_ps( t1, tFar );
+    }
+
+    _mm_storeu_ps( aTNear, tNear );
+
+    const unsigned int mask = _mm_movemask_ps( _mm_cmple_ps( tNear, tFar ) );
+#else
+    unsigned int mask = 0;
+
+    for( int c = 0; c < aNode.nChildren; ++c )
+    {
+        float tNear = 0.0f;
+        float tFar  = aTMax;
+
+        for( unsigned int a = 0; a < 3; ++a )
+        {
+            const unsigned int nearIdx = aRay.m_nearIsMax[a];
+
+            const float t0 = (aNode.bounds[nearIdx][a][c] - aRay.m_Origin[a]) *
+                             aRay.m_InvDir[a];
+
+            const float t1 = (aNode.bounds[1 - nearIdx][a][c] - aRay.m_Origin[a]) *
+                             aRay.m_InvDir[a];
+
+            // Same operand order as _mm_max_ps / _mm_min_ps
+            tNear = (t0 > tNear) ? t0 : tNear;
+            tFar  = (t1 < tFar)  ? t1 : tFar;
+        }
+
+        aTNear[c] = tNear;
+
+        if( tNear <= tFar )
+            mask |= 1 << c;
+    }
+#endif
+
+    return mask & ( (1 << aNode.nChildren) - 1 );
+}
+
+
+/**
+ * Function pushHitChildren
+ * puts the hit children on the _todo_ stack, the nearest one on top
+ */
+static inline void pushHitChildren( const LinearBVH4Node &aNode,
+                                    unsigned int aMask,
+                                    const float aTNear[4],
+                                    StackNode4 *aTodo,
+                                    int &aTodoOffset )
+{
+    StackNode4 hits[4];
+    int nHits = 0;
+
+    for( int c = 0; c < aNode.nChildren; ++c )
+    {
+        if( !(aMask & (1 << c)) )
+            continue;
+
+        // Insertion sort, far to near
+        int i = nHits++;
+
+        for( ; (i > 0) && (hits[i - 1].tNear < aTNear[c]); --i )
+            hits[i] = hits[i - 1];
+
+        hits[i].node  = aNode.child[c];
+        hits[i].tNear = aTNear[c];
+    }
+
+    wxASSERT( (aTodoOffset + nHits) <= MAX_TODOS4 );
+
+    for( int i = 0; i < nHits; ++i )
+        aTodo[aTodoOffset++] = hits[i];
+}
+
+
+int CBVH_PBRT::collapseBVHTree( int aNodeNum )
+{
+    const int myOffset = m_nodes4.size();
+
+    m_nodes4.push_back( LinearBVH4Node() );
+
+    int children[4];
+    int nChildren = 0;
+
+    if( m_nodes[aNodeNum].nPrimitives > 0 )
+    {
+        // Only happens when the whole tree is a single leaf
+        children[nChildren++] = aNodeNum;
+    }
+    else
+    {
+        children[nChildren++] = aNodeNum + 1;
+        children[nChildren++] = m_nodes[aNodeNum].secondChildOffset;
+
+        // Open the interior child with the largest surface area until the
+        // node is full
+        while( nChildren < 4 )
+        {
+            int   bestChild = -1;
+            float bestArea  = -1.0f;
+
+            for( int c = 0; c < nChildren; ++c )
+            {
+                const LinearBVHNode &node = m_nodes[children[c]];
+
+                if( node.nPrimitives > 0 )
+                    continue;
+
+                const float area = node.bounds.SurfaceArea();
+
+                if( area > bestArea )
+                {
+                    bestArea  = area;
+                    bestChild = c;
+                }
+            }
+
+            if( bestChild < 0 )
+                break;
+
+            const int nodeNum = children[bestChild];
+
+            children[bestChild]   = nodeNum + 1;
+            children[nChildren++]  = m_nodes[nodeNum].secondChildOffset;
+        }
+    }
+
+    // m_nodes4 may be reallocated by the recursion, so fill a local copy
+    LinearBVH4Node node4;
+
+    memset( &node4, 0, sizeof( node4 ) );
+
+    node4.nChildren = nChildren;
+
+    for( int c = 0; c < nChildren; ++c )
+    {
+        const LinearBVHNode &node = m_nodes[children[c]];
+
+        for( unsigned int a = 0; a < 3; ++a )
+        {
+            node4.bounds[0][a][c] = node.bounds.Min()[a];
+            node4.bounds[1][a][c] = node.bounds.Max()[a];
+        }
+
+        if( node.nPrimitives > 0 )
+            node4.child[c] = ~children[c];
+        else
+            node4.child[c] = collapseBVHTree( children[c] );
+    }
+
+    m_nodes4[myOffset] = node4;
+
+    return myOffset;
+}
+
+
+bool CBVH_PBRT::Intersect( const RAY &aRay, HITINFO &aHitInfo ) const
+{
+    if( m_nodes4.empty() )
+        return false;
+
+    const BVH4_RAY ray( aRay );
+
+    bool hit = false;
+
+    // Follow ray through BVH nodes to find primitive intersections
+    StackNode4 todo[MAX_TODOS4];
+    int todoOffset = 0;
+
+    todo[todoOffset].node    = 0;
+    todo[todoOffset++].tNear = 0.0f;
+
+    while( todoOffset > 0 )
+    {
+        const StackNode4 item = todo[--todoOffset];
+
+        // A closer hit may have been found since the node was pushed
+        if( item.tNear > aHitInfo.m_tHit )
+            continue;
+
+        if( item.node < 0 )
+        {
+            const int nodeNum = ~item.node;
+            const LinearBVHNode &leaf = m_nodes[nodeNum];
+
+            // Intersect ray with primitives in leaf BVH node
+            for( int i = 0; i < leaf.nPrimitives; ++i )
+            {
+                if( m_primitives[leaf.primitivesOffset + i]->Intersect( aRay, aHitInfo ) )
+                {
+                    // Report the binary node, it is the one used by
+                    // Intersect( aRay, aHitInfo, aAccNodeInfo )
+                    aHitInfo.m_acc_node_info = nodeNum;
+                    hit = true;
+                }
+            }
+
+            continue;
+        }
+
+        const LinearBVH4Node &node = m_nodes4[item.node];
+
+        float tNear[4];
+
+        const unsigned int mask = intersectChildren( node, ray, aHitInfo.m_tHit, tNear );
+
+        if( mask )
+            pushHitChildren( node, mask, tNear, todo, todoOffset );
+    }
+
+    return hit;
+}
+
+
+bool CBVH_PBRT::IntersectP( const RAY &aRay, float aMaxDistance ) const
+{
+    if( m_nodes4.empty() )
+        return false;
+
+    const BVH4_RAY ray( aRay );
+
+    // Follow ray through BVH nodes to find primitive intersections
+    StackNode4 todo[MAX_TODOS4];
+    int todoOffset = 0;
+
+    todo[todoOffset].node    = 0;
+    todo[todoOffset++].tNear = 0.0f;
+
+    while( todoOffset > 0 )
+    {
+        const StackNode4 item = todo[--todoOffset];
+
+        if( item.node < 0 )
+        {
+            const LinearBVHNode &leaf = m_nodes[~item.node];
+
+            // Intersect ray with primitives in leaf BVH node
+            for( int i = 0; i < leaf.nPrimitives; ++i )
+            {
+                const COBJECT *obj = m_primitives[leaf.primitivesOffset + i];
+
+                if( obj->GetMaterial()->GetCastShadows() )
+                    if( obj->IntersectP( aRay, aMaxDistance ) )
+                        return true;
+            }
+
+            continue;
+        }
+
+        const LinearBVH4Node &node = m_nodes4[item.node];
+
+        float tNear[4];
+
+        const unsigned int mask = intersectChildren( node, ray, aMaxDistance, tNear );
+
+        if( mask )
+            pushHitChildren( node, mask, tNear, todo, todoOffset );
+    }
+
+    return false;
+}
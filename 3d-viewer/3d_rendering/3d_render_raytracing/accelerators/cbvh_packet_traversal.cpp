@@ -2,7 +2,7 @@
  * This program source code file is part of KiCad, a free EDA CAD application.
  *
  * Copyright (C) 2015-2016 Mario Luzeiro <mrluzeiro@ua.pt>
- * Copyright (C) 1992-2016 KiCad Developers, see AUTHORS.txt for contributors.
+ * Copyright (C) 1992-2017 KiCad Developers, see AUTHORS.txt for contributors.
  *
  * This program is free software; you can redistribute it and/or
  * modify it under the terms of the GNU General Public License
@@ -30,6 +30,19 @@
 #include "cbvh_pbrt.h"
 #include <wx/debug.h>
 
+#ifdef BVH4_USE_SSE
+#include <emmintrin.h>
+#endif
+
+// AVX is not enabled by the compiler options: the AVX functions are compiled for it
+// with the target attribute, and only used if the CPU supports it.
+#if defined( BVH4_USE_SSE ) && defined( __GNUC__ ) && \
+    ( defined( __x86_64__ ) || defined( __i386__ ) ) && \
+    ( defined( __clang__ ) || __GNUC__ >= 5 )
+#define BVH_USE_AVX
+#include <immintrin.h>
+#endif
+
 
 #define BVH_RANGED_TRAVERSAL
 //#define BVH_PARTITION_TRAVERSAL
@@ -45,123 +58,495 @@ struct StackNode
 };
 
 
-static inline unsigned int getFirstHit( const RAYPACKET &aRayPacket,
-                                        const CBBOX &aBBox,
-                                        unsigned int ia,
-                                        HITINFO_PACKET *aHitInfoPacket )
+#ifdef BVH_RANGED_TRAVERSAL
+
+// The SIMD box tests work on groups of 4 or 8 rays
+static_assert( RAYPACKET_RAYS_PER_PACKET % 8 == 0,
+               "The packet size must be a multiple of the SIMD width" );
+
+// Each interior node pushes at most 3 more nodes than it pops
+#define MAX_TODOS4 256
+
+
+struct StackNode4
 {
-    float hitT;
+    int          node;      ///< same encoding as LinearBVH4Node::child
+    unsigned int ia;        ///< index to the first alive ray
+};
 
-    if( aBBox.Intersect( aRayPacket.m_ray[ia], &hitT ) )
-        if( hitT < aHitInfoPacket[ia].m_HitInfo.m_tHit )
-            return ia;
 
-    if( !aRayPacket.m_Frustum.Intersect( aBBox ) )
-        return RAYPACKET_RAYS_PER_PACKET;
+/**
+ * The rays of a packet, laid out as structure of arrays for the SIMD box tests
+ */
+struct PACKET_SOA
+{
+    float m_Origin[3][RAYPACKET_RAYS_PER_PACKET];
+    float m_InvDir[3][RAYPACKET_RAYS_PER_PACKET];
+    float m_tMax[RAYPACKET_RAYS_PER_PACKET];    ///< distance of the closest hit of each ray
+};
+
 
-    for( unsigned int i = ia + 1; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+/**
+ * Function rayHitsBox
+ * tests one ray of the packet against a box.
+ * The min / max operands are in the same order as in the SIMD versions, so a
+ * NaN (ray parallel to and laying on a slab plane) gives the same results.
+ * @param aTNear - if not NULL, returns the distance where the ray enters the box
+ * @return true if the ray enters the box before its closest hit
+ */
+static inline bool rayHitsBox( const PACKET_SOA &aSoa,
+                               const float aMin[3],
+                               const float aMax[3],
+                               unsigned int aRay,
+                               float *aTNear = NULL )
+{
+    float tNear = 0.0f;
+    float tFar  = aSoa.m_tMax[aRay];
+
+    for( unsigned int a = 0; a < 3; ++a )
     {
-        if( aBBox.Intersect( aRayPacket.m_ray[i], &hitT ) )
-            if( hitT < aHitInfoPacket[i].m_HitInfo.m_tHit )
-                return i;
+        const float t0 = (aMin[a] - aSoa.m_Origin[a][aRay]) * aSoa.m_InvDir[a][aRay];
+        const float t1 = (aMax[a] - aSoa.m_Origin[a][aRay]) * aSoa.m_InvDir[a][aRay];
+
+        const float tEnter = (t0 < t1) ? t0 : t1;
+        const float tExit  = (t0 > t1) ? t0 : t1;
+
+        tNear = (tEnter > tNear) ? tEnter : tNear;
+        tFar  = (tExit  < tFar)  ? tExit  : tFar;
     }
 
+    if( aTNear )
+        *aTNear = tNear;
+
+    return tNear <= tFar;
+}
+
+
+static inline unsigned int lowestBit( unsigned int aMask )
+{
+    unsigned int bit = 0;
+
+    while( !(aMask & (1 << bit)) )
+        ++bit;
+
+    return bit;
+}
+
+
+static inline unsigned int highestBit( unsigned int aMask )
+{
+    unsigned int bit = 0;
+
+    while( aMask >>= 1 )
+        ++bit;
+
+    return bit;
+}
+
+
+/**
+ * The box test kernels of the packet traversal.
+ * FIRST_HIT returns the index of the first ray, from aFirst, hitting the box,
+ * or RAYPACKET_RAYS_PER_PACKET if none.
+ * LAST_HIT returns the index after the last ray hitting the box,
+ * or aFirst + 1 if only aFirst (known to hit it) does.
+ */
+typedef unsigned int (*FIRST_HIT_FUNC)( const PACKET_SOA &aSoa,
+                                        const float aMin[3],
+                                        const float aMax[3],
+                                        unsigned int aFirst );
+
+typedef unsigned int (*LAST_HIT_FUNC)( const PACKET_SOA &aSoa,
+                                       const float aMin[3],
+                                       const float aMax[3],
+                                       unsigned int aFirst );
+
+struct PACKET_KERNELS
+{
+    FIRST_HIT_FUNC firstHit;
+    LAST_HIT_FUNC  lastHit;
+};
+
+
+#ifndef BVH4_USE_SSE
+
+static unsigned int firstHitScalar( const PACKET_SOA &aSoa,
+                                    const float aMin[3],
+                                    const float aMax[3],
+                                    unsigned int aFirst )
+{
+    for( unsigned int i = aFirst; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        if( rayHitsBox( aSoa, aMin, aMax, i ) )
+            return i;
+
     return RAYPACKET_RAYS_PER_PACKET;
 }
 
 
-#ifdef BVH_RANGED_TRAVERSAL
+static unsigned int lastHitScalar( const PACKET_SOA &aSoa,
+                                   const float aMin[3],
+                                   const float aMax[3],
+                                   unsigned int aFirst )
+{
+    for( unsigned int ie = (RAYPACKET_RAYS_PER_PACKET - 1); ie > aFirst; --ie )
+        if( rayHitsBox( aSoa, aMin, aMax, ie ) )
+            return ie + 1;
 
-static inline unsigned int getLastHit( const RAYPACKET &aRayPacket,
-                                       const CBBOX &aBBox,
-                                       unsigned int ia,
-                                       HITINFO_PACKET *aHitInfoPacket )
+    return aFirst + 1;
+}
+
+#else
+
+/**
+ * Function hitMask4
+ * tests the rays aBase to aBase + 3 against a box
+ * @return the bit mask of the rays hitting the box
+ */
+static inline unsigned int hitMask4( const PACKET_SOA &aSoa,
+                                     const __m128 aMin[3],
+                                     const __m128 aMax[3],
+                                     unsigned int aBase )
 {
-    for( unsigned int ie = (RAYPACKET_RAYS_PER_PACKET - 1); ie > ia; --ie )
+    __m128 tNear = _mm_setzero_ps();
+    __m128 tFar  = _mm_loadu_ps( &aSoa.m_tMax[aBase] );
+
+    for( unsigned int a = 0; a < 3; ++a )
     {
-        float hitT;
+        const __m128 org    = _mm_loadu_ps( &aSoa.m_Origin[a][aBase] );
+        const __m128 invDir = _mm_loadu_ps( &aSoa.m_InvDir[a][aBase] );
 
-        if( aBBox.Intersect( aRayPacket.m_ray[ie], &hitT ) )
-            if( hitT < aHitInfoPacket[ie].m_HitInfo.m_tHit )
-                return ie + 1;
+        const __m128 t0 = _mm_mul_ps( _mm_sub_ps( aMin[a], org ), invDir );
+        const __m128 t1 = _mm_mul_ps( _mm_sub_ps( aMax[a], org ), invDir );
+
+        tNear = _mm_max_ps( _mm_min_ps( t0, t1 ), tNear );
+        tFar  = _mm_min_ps( _mm_max_ps( t0, t1 ), tFar );
     }
 
-    return ia + 1;
+    return _mm_movemask_ps( _mm_cmple_ps( tNear, tFar ) );
+}
+
+
+static unsigned int firstHitSSE( const PACKET_SOA &aSoa,
+                                 const float aMin[3],
+                                 const float aMax[3],
+                                 unsigned int aFirst )
+{
+    const __m128 bMin[3] = { _mm_set1_ps( aMin[0] ), _mm_set1_ps( aMin[1] ),
+                             _mm_set1_ps( aMin[2] ) };
+    const __m128 bMax[3] = { _mm_set1_ps( aMax[0] ), _mm_set1_ps( aMax[1] ),
+                             _mm_set1_ps( aMax[2] ) };
+
+    unsigned int base  = aFirst & ~3u;
+    unsigned int alive = (0xF << (aFirst - base)) & 0xF;
+
+    for( ; base < RAYPACKET_RAYS_PER_PACKET; base += 4, alive = 0xF )
+    {
+        const unsigned int mask = hitMask4( aSoa, bMin, bMax, base ) & alive;
+
+        if( mask )
+            return base + lowestBit( mask );
+    }
+
+    return RAYPACKET_RAYS_PER_PACKET;
+}
+
+
+static unsigned int lastHitSSE( const PACKET_SOA &aSoa,
+                                const float aMin[3],
+                                const float aMax[3],
+                                unsigned int aFirst )
+{
+    const __m128 bMin[3] = { _mm_set1_ps( aMin[0] ), _mm_set1_ps( aMin[1] ),
+                             _mm_set1_ps( aMin[2] ) };
+    const __m128 bMax[3] = { _mm_set1_ps( aMax[0] ), _mm_set1_ps( aMax[1] ),
+                             _mm_set1_ps( aMax[2] ) };
+
+    const unsigned int firstBase = aFirst & ~3u;
+
+    for( unsigned int base = RAYPACKET_RAYS_PER_PACKET - 4; ; base -= 4 )
+    {
+        unsigned int mask = hitMask4( aSoa, bMin, bMax, base );
+
+        // Only the rays after aFirst are searched
+        if( base == firstBase )
+            mask &= ~( (2u << (aFirst - base)) - 1 );
+
+        if( mask )
+            return base + highestBit( mask ) + 1;
+
+        if( base == firstBase )
+            break;
+    }
+
+    return aFirst + 1;
+}
+
+#endif // BVH4_USE_SSE
+
+
+#ifdef BVH_USE_AVX
+
+__attribute__(( target( "avx" ) ))
+static inline unsigned int hitMask8( const PACKET_SOA &aSoa,
+                                     const __m256 aMin[3],
+                                     const __m256 aMax[3],
+                                     unsigned int aBase )
+{
+    __m256 tNear = _mm256_setzero_ps();
+    __m256 tFar  = _mm256_loadu_ps( &aSoa.m_tMax[aBase] );
+
+    for( unsigned int a = 0; a < 3; ++a )
+    {
+        const __m256 org    = _mm256_loadu_ps( &aSoa.m_Origin[a][aBase] );
+        const __m256 invDir = _mm256_loadu_ps( &aSoa.m_InvDir[a][aBase] );
+
+        const __m256 t0 = _mm256_mul_ps( _mm256_sub_ps( aMin[a], org ), invDir );
+        const __m256 t1 = _mm256_mul_ps( _mm256_sub_ps( aMax[a], org ), invDir );
+
+        tNear = _mm256_max_ps( _mm256_min_ps( t0, t1 ), tNear );
+        tFar  = _mm256_min_ps( _mm256_max_ps( t0, t1 ), tFar );
+    }
+
+    return _mm256_movemask_ps( _mm256_cmp_ps( tNear, tFar, _CMP_LE_OQ ) );
+}
+
+
+__attribute__(( target( "avx" ) ))
+static unsigned int firstHitAVX( const PACKET_SOA &aSoa,
+                                 const float aMin[3],
+                                 const float aMax[3],
+                                 unsigned int aFirst )
+{
+    const __m256 bMin[3] = { _mm256_set1_ps( aMin[0] ), _mm256_set1_ps( aMin[1] ),
+                             _mm256_set1_ps( aMin[2] ) };
+    const __m256 bMax[3] = { _mm256_set1_ps( aMax[0] ), _mm256_set1_ps( aMax[1] ),
+                             _mm256_set1_ps( aMax[2] ) };
+
+    unsigned int base  = aFirst & ~7u;
+    unsigned int alive = (0xFF << (aFirst - base)) & 0xFF;
+
+    for( ; base < RAYPACKET_RAYS_PER_PACKET; base += 8, alive = 0xFF )
+    {
+        const unsigned int mask = hitMask8( aSoa, bMin, bMax, base ) & alive;
+
+        if( mask )
+            return base + lowestBit( mask );
+    }
+
+    return RAYPACKET_RAYS_PER_PACKET;
+}
+
+
+__attribute__(( target( "avx" ) ))
+static unsigned int lastHitAVX( const PACKET_SOA &aSoa,
+                                const float aMin[3],
+                                const float aMax[3],
+                                unsigned int aFirst )
+{
+    const __m256 bMin[3] = { _mm256_set1_ps( aMin[0] ), _mm256_set1_ps( aMin[1] ),
+                             _mm256_set1_ps( aMin[2] ) };
+    const __m256 bMax[3] = { _mm256_set1_ps( aMax[0] ), _mm256_set1_ps( aMax[1] ),
+                             _mm256_set1_ps( aMax[2] ) };
+
+    const unsigned int firstBase = aFirst & ~7u;
+
+    for( unsigned int base = RAYPACKET_RAYS_PER_PACKET - 8; ; base -= 8 )
+    {
+        unsigned int mask = hitMask8( aSoa, bMin, bMax, base );
+
+        // Only the rays after aFirst are searched
+        if( base == firstBase )
+            mask &= ~( (2u << (aFirst - base)) - 1 );
+
+        if( mask )
+            return base + highestBit( mask ) + 1;
+
+        if( base == firstBase )
+            break;
+    }
+
+    return aFirst + 1;
+}
+
+#endif // BVH_USE_AVX
+
+
+/**
+ * Function getPacketKernels
+ * selects the box test kernels once, from the instruction sets of the CPU:
+ * AVX (8 rays), SSE2 (4 rays) or the scalar version.
+ */
+static const PACKET_KERNELS &getPacketKernels()
+{
+    static const PACKET_KERNELS kernels = []() -> PACKET_KERNELS
+    {
+#ifdef BVH_USE_AVX
+        __builtin_cpu_init();
+
+        if( __builtin_cpu_supports( "avx" ) )
+            return PACKET_KERNELS{ firstHitAVX, lastHitAVX };
+#endif
+
+#ifdef BVH4_USE_SSE
+        return PACKET_KERNELS{ firstHitSSE, lastHitSSE };
+#else
+        return PACKET_KERNELS{ firstHitScalar, lastHitScalar };
+#endif
+    }();
+
+    return kernels;
+}
+
+
+/**
+ * Function getFirstHit
+ * the first alive ray is tested alone, it is usually the one hitting the box.
+ * The frustum of the packet is tested before the other rays.
+ */
+static inline unsigned int getFirstHit( const PACKET_KERNELS &aKernels,
+                                        const RAYPACKET &aRayPacket,
+                                        const PACKET_SOA &aSoa,
+                                        const float aMin[3],
+                                        const float aMax[3],
+                                        unsigned int ia,
+                                        float *aTNear = NULL )
+{
+    if( rayHitsBox( aSoa, aMin, aMax, ia, aTNear ) )
+        return ia;
+
+    const CBBOX bbox( SFVEC3F( aMin[0], aMin[1], aMin[2] ),
+                      SFVEC3F( aMax[0], aMax[1], aMax[2] ) );
+
+    if( (ia + 1 >= RAYPACKET_RAYS_PER_PACKET) || !aRayPacket.m_Frustum.Intersect( bbox ) )
+        return RAYPACKET_RAYS_PER_PACKET;
+
+    ia = aKernels.firstHit( aSoa, aMin, aMax, ia + 1 );
+
+    if( aTNear && (ia < RAYPACKET_RAYS_PER_PACKET) )
+        rayHitsBox( aSoa, aMin, aMax, ia, aTNear );
+
+    return ia;
 }
 
 
 // "Large Ray Packets for Real-time Whitted Ray Tracing"
 // http://cseweb.ucsd.edu/~ravir/whitted.pdf
 
-// Ranged Traversal
+// Ranged Traversal, over the 4-wide nodes
 bool CBVH_PBRT::Intersect( const RAYPACKET &aRayPacket,
                            HITINFO_PACKET *aHitInfoPacket ) const
 {
-    if( m_nodes == NULL )
+    if( m_nodes4.empty() )
         return false;
 
-    if( (&m_nodes[0]) == NULL )
-        return false;
+    const PACKET_KERNELS &kernels = getPacketKernels();
+
+    PACKET_SOA soa;
+
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+    {
+        const RAY &ray = aRayPacket.m_ray[i];
+
+        for( unsigned int a = 0; a < 3; ++a )
+        {
+            soa.m_Origin[a][i] = ray.m_Origin[a];
+            soa.m_InvDir[a][i] = ray.m_InvDir[a];
+        }
+
+        soa.m_tMax[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
+    }
 
     bool anyHitted = false;
-    int todoOffset = 0, nodeNum = 0;
-    StackNode todo[MAX_TODOS];
+    int todoOffset = 0;
+    StackNode4 todo[MAX_TODOS4];
 
-    unsigned int ia = 0;
+    todo[todoOffset].node = 0;
+    todo[todoOffset++].ia = 0;
 
-    while( true )
+    while( todoOffset > 0 )
     {
-        const LinearBVHNode *curCell = &m_nodes[nodeNum];
-
-        ia = getFirstHit( aRayPacket, curCell->bounds, ia, aHitInfoPacket );
+        const StackNode4 item = todo[--todoOffset];
 
-        if( ia < RAYPACKET_RAYS_PER_PACKET )
+        if( item.node < 0 )
         {
-            if( curCell->nPrimitives == 0 )
-            {
-                StackNode &node = todo[todoOffset++];
-                node.cell = curCell->secondChildOffset;
-                node.ia = ia;
-                nodeNum = nodeNum + 1;
+            const int nodeNum = ~item.node;
+            const LinearBVHNode &leaf = m_nodes[nodeNum];
+
+            const float bMin[3] = { leaf.bounds.Min().x, leaf.bounds.Min().y,
+                                    leaf.bounds.Min().z };
+            const float bMax[3] = { leaf.bounds.Max().x, leaf.bounds.Max().y,
+                                    leaf.bounds.Max().z };
+
+            // Closer hits may have been found since the leaf was pushed
+            const unsigned int ia = getFirstHit( kernels, aRayPacket, soa, bMin, bMax,
+                                                 item.ia );
+
+            if( ia >= RAYPACKET_RAYS_PER_PACKET )
                 continue;
-            }
-            else
+
+            const unsigned int ie = kernels.lastHit( soa, bMin, bMax, ia );
+
+            for( int j = 0; j < leaf.nPrimitives; ++j )
             {
-                const unsigned int ie = getLastHit( aRayPacket,
-                                                    curCell->bounds,
-                                                    ia,
-                                                    aHitInfoPacket );
+                const COBJECT *obj = m_primitives[leaf.primitivesOffset + j];
 
-                for( int j = 0; j < curCell->nPrimitives; ++j )
-                {
-                    const COBJECT *obj = m_primitives[curCell->primitivesOffset + j];
+                if( !aRayPacket.m_Frustum.Intersect( obj->GetBBox() ) )
+                    continue;
 
-                    if( aRayPacket.m_Frustum.Intersect( obj->GetBBox() ) )
+                for( unsigned int i = ia; i < ie; ++i )
+                {
+                    if( obj->Intersect( aRayPacket.m_ray[i], aHitInfoPacket[i].m_HitInfo ) )
                     {
-                        for( unsigned int i = ia; i < ie; ++i )
-                        {
-                            const bool hitted = obj->Intersect( aRayPacket.m_ray[i],
-                                                                aHitInfoPacket[i].m_HitInfo );
-
-                            if( hitted )
-                            {
-                                anyHitted |= hitted;
-                                aHitInfoPacket[i].m_hitresult |= hitted;
-                                aHitInfoPacket[i].m_HitInfo.m_acc_node_info = nodeNum;
-                            }
-                        }
+                        anyHitted = true;
+                        aHitInfoPacket[i].m_hitresult = true;
+                        aHitInfoPacket[i].m_HitInfo.m_acc_node_info = nodeNum;
+                        soa.m_tMax[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
                     }
                 }
             }
+
+            continue;
         }
 
-        if( todoOffset == 0 )
-            break;
+        const LinearBVH4Node &node = m_nodes4[item.node];
 
-        const StackNode &node = todo[--todoOffset];
+        // The children hit by the packet, sorted far to near, using the
+        // distance of their first hitting ray
+        StackNode4 hits[4];
+        float      hitsTNear[4];
+        int        nHits = 0;
 
-        nodeNum = node.cell;
-        ia = node.ia;
+        for( int c = 0; c < node.nChildren; ++c )
+        {
+            const float bMin[3] = { node.bounds[0][0][c], node.bounds[0][1][c],
+                                    node.bounds[0][2][c] };
+            const float bMax[3] = { node.bounds[1][0][c], node.bounds[1][1][c],
+                                    node.bounds[1][2][c] };
+
+            float tNear;
+            const unsigned int ia = getFirstHit( kernels, aRayPacket, soa, bMin, bMax,
+                                                 item.ia, &tNear );
+
+            if( ia >= RAYPACKET_RAYS_PER_PACKET )
+                continue;
+
+            int i = nHits++;
+
+            for( ; (i > 0) && (hitsTNear[i - 1] < tNear); --i )
+            {
+                hits[i]      = hits[i - 1];
+                hitsTNear[i] = hitsTNear[i - 1];
+            }
+
+            hits[i].node = node.child[c];
+            hits[i].ia   = ia;
+            hitsTNear[i] = tNear;
+        }
+
+        wxASSERT( (todoOffset + nHits) <= MAX_TODOS4 );
+
+        for( int i = 0; i < nHits; ++i )
+            todo[todoOffset++] = hits[i];
     }
 
     return anyHitted;
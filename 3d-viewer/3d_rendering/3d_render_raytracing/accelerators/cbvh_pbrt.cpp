@@ -304,8 +304,15 @@ CBVH_PBRT::CBVH_PBRT( const CGENERICCONTAINER &aObjectContainer,
 
     wxASSERT( offset == (unsigned int)totalNodes );
 
+    // Collapse the binary tree into the 4-wide one used by the traversals
+    m_nodes4.clear();
+    m_nodes4.reserve( totalNodes / 2 + 1 );
+
+    collapseBVHTree( 0 );
+
 #ifdef PRINT_STATISTICS_3D_VIEWER
     uint32_t treeBytes = totalNodes * sizeof( LinearBVHNode ) + sizeof( *this ) +
+                         m_nodes4.size() * sizeof( LinearBVH4Node ) +
                          m_primitives.size() * sizeof( m_primitives[0] ) +
                          m_addresses_pointer_to_mm_free.size() * sizeof( void * );
 
@@ -320,8 +327,9 @@ CBVH_PBRT::CBVH_PBRT( const CGENERICCONTAINER &aObjectContainer,
     case SPLIT_HLBVH:       printf( "using SPLIT_HLBVH\n" ); break;
     }
 
-    printf( "  BVH created with %d nodes (%.2f MB)\n",
-            totalNodes, float(treeBytes) / (1024.f * 1024.f) );
+    printf( "  BVH created with %d nodes, %u 4-wide nodes (%.2f MB)\n",
+            totalNodes, (unsigned int)m_nodes4.size(),
+            float(treeBytes) / (1024.f * 1024.f) );
     printf( "////////////////////////////////////////////////////////////////////////////////\n\n" );
 #endif
 }
@@ -1126,70 +1134,6 @@ int CBVH_PBRT::flattenBVHTree( BVHBuildNode *node, uint32_t *offset )
 
 #define MAX_TODOS 64
 
-bool CBVH_PBRT::Intersect( const RAY &aRay, HITINFO &aHitInfo ) const
-{
-    if( !m_nodes )
-        return false;
-
-    bool hit = false;
-
-    // Follow ray through BVH nodes to find primitive intersections
-    int todoOffset = 0, nodeNum = 0;
-    int todo[MAX_TODOS];
-
-    while( true )
-    {
-        const LinearBVHNode *node = &m_nodes[nodeNum];
-
-        wxASSERT( todoOffset < MAX_TODOS );
-
-        // Check ray against BVH node
-        float hitBox = 0.0f;
-
-        const bool hitted = node->bounds.Intersect( aRay, &hitBox );
-
-        if( hitted && (hitBox < aHitInfo.m_tHit) )
-        {
-            if( node->nPrimitives > 0 )
-            {
-                // Intersect ray with primitives in leaf BVH node
-                for( int i = 0; i < node->nPrimitives; ++i )
-                {
-                    if( m_primitives[node->primitivesOffset + i]->Intersect( aRay,
-                                                                             aHitInfo ) )
-                    {
-                        aHitInfo.m_acc_node_info = nodeNum;
-                        hit = true;
-                    }
-                }
-            }
-            else
-            {
-                // Put far BVH node on _todo_ stack, advance to near node
-                if( aRay.m_dirIsNeg[node->axis] )
-                {
-                    todo[todoOffset++] = nodeNum + 1;
-                    nodeNum = node->secondChildOffset;
-                }
-                else
-                {
-                    todo[todoOffset++] = node->secondChildOffset;
-                    nodeNum = nodeNum + 1;
-                }
-
-                continue;
-            }
-        }
-
-        if( todoOffset == 0 )
-            break;
-
-        nodeNum = todo[--todoOffset];
-    }
-
-    return hit;
-}
-
 // !TODO: this may be optimized
 bool CBVH_PBRT::Intersect( const RAY &aRay,
                            HITINFO &aHitInfo,
@@ -1257,64 +1201,3 @@ bool CBVH_PBRT::Intersect( const RAY &aRay,
     return hit;
 }
 
-
-bool CBVH_PBRT::IntersectP( const RAY &aRay, float aMaxDistance ) const
-{
-    if( !m_nodes )
-        return false;
-
-    // Follow ray through BVH nodes to find primitive intersections
-    int todoOffset = 0, nodeNum = 0;
-    int todo[MAX_TODOS];
-
-    while( true )
-    {
-        const LinearBVHNode *node = &m_nodes[nodeNum];
-
-        wxASSERT( todoOffset < MAX_TODOS );
-
-        // Check ray against BVH node
-        float hitBox = 0.0f;
-
-        const bool hitted = node->bounds.Intersect( aRay, &hitBox );
-
-        if( hitted && (hitBox < aMaxDistance) )
-        {
-            if( node->nPrimitives > 0 )
-            {
-                // Intersect ray with primitives in leaf BVH node
-                for( int i = 0; i < node->nPrimitives; ++i )
-                {
-                    const COBJECT *obj = m_primitives[node->primitivesOffset + i];
-
-                    if( obj->GetMaterial()->GetCastShadows() )
-                        if( obj->IntersectP( aRay, aMaxDistance ) )
-                            return true;
-                }
-            }
-            else
-            {
-                // Put far BVH node on _todo_ stack, advance to near node
-                if( aRay.m_dirIsNeg[node->axis] )
-                {
-                    todo[todoOffset++] = nodeNum + 1;
-                    nodeNum = node->secondChildOffset;
-                }
-                else
-                {
-                    todo[todoOffset++] = node->secondChildOffset;
-                    nodeNum = nodeNum + 1;
-                }
-
-                continue;
-            }
-        }
-
-        if( todoOffset == 0 )
-            break;
-
-        nodeNum = todo[--todoOffset];
-    }
-
-    return false;
-}
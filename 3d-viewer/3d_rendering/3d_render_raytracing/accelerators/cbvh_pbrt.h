@@ -72,8 +72,15 @@
 
 #include "caccelerator.h"
 #include <list>
+#include <vector>
 #include <stdint.h>
 
+// SSE2 is always available on x86-64, and on x86 when enabled by the compiler options.
+// The packet traversal also selects an AVX version at run time, see cbvh_packet_traversal.cpp
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define BVH4_USE_SSE
+#endif
+
 // Forward Declarations
 struct BVHBuildNode;
 struct BVHPrimitiveInfo;
@@ -98,6 +105,25 @@ struct LinearBVHNode
 };
 
 
+/**
+ * 4-wide BVH node, created by collapsing the binary LinearBVHNode tree.
+ * The bounding boxes of the children are stored as structure of arrays,
+ * so a ray can be tested against the four of them at once.
+ */
+struct LinearBVH4Node
+{
+    // 96 bytes
+    float bounds[2][3][4];  ///< [min/max][axis x,y,z][child]
+
+    // 16 bytes
+    int   child[4];         ///< >= 0 -> interior LinearBVH4Node index
+                            ///< < 0  -> ~(index of the LinearBVHNode leaf)
+
+    // 4 bytes
+    int   nChildren;
+};
+
+
 enum SPLITMETHOD
 {
     SPLIT_MIDDLE,
@@ -153,12 +179,23 @@ private:
     int flattenBVHTree( BVHBuildNode *node,
                         uint32_t *offset );
 
+    /**
+     * Function collapseBVHTree
+     * creates the 4-wide nodes of the sub tree starting at the flattened
+     * node aNodeNum, up to 4 children are pulled from the binary levels below.
+     * @return the index of the created node in m_nodes4
+     */
+    int collapseBVHTree( int aNodeNum );
+
     // BVH Private Data
     const int           m_maxPrimsInNode;
     SPLITMETHOD         m_splitMethod;
     CONST_VECTOR_OBJECT m_primitives;
     LinearBVHNode       *m_nodes;
 
+    /// 4-wide version of m_nodes, used by the single ray and the packet traversals
+    std::vector<LinearBVH4Node> m_nodes4;
+
     std::list<void *> m_addresses_pointer_to_mm_free;
 
     // Partition traversal
@@ -1199,6 +1199,10 @@ void C3D_RENDER_RAYTRACING::add_3D_vias_and_pads_to_container()
 
 void C3D_RENDER_RAYTRACING::load_3D_models()
 {
+    // Headless renders may have no 3D cache, the board is rendered without models
+    if( !m_settings.Get3DCacheManager() )
+        return;
+
     // Go for all modules
     for( const MODULE* module = m_settings.GetBoard()->m_Modules;
          module;
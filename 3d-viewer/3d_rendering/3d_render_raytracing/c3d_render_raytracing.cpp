@@ -29,6 +29,7 @@
 
 #include <GL/glew.h>
 #include <climits>
+#include <algorithm>
 
 #include "c3d_render_raytracing.h"
 #include "mortoncodes.h"
@@ -165,6 +166,7 @@ bool C3D_RENDER_RAYTRACING::Redraw( bool aIsMoving, REPORTER *aStatusTextReporte
         // revert to preview mode the first time the Redraw is called
         m_oldWindowsSize = m_windowSize;
         initialize_block_positions();
+        opengl_init_pbo();
     }
 
 
@@ -190,6 +192,7 @@ bool C3D_RENDER_RAYTRACING::Redraw( bool aIsMoving, REPORTER *aStatusTextReporte
         requestRedraw = true;
 
         initialize_block_positions();
+        opengl_init_pbo();
     }
 
 
@@ -297,6 +300,78 @@ bool C3D_RENDER_RAYTRACING::Redraw( bool aIsMoving, REPORTER *aStatusTextReporte
 }
 
 
+void C3D_RENDER_RAYTRACING::RenderToImage( const wxSize &aSize,
+                                           wxImage &aOutImage,
+                                           REPORTER *aStatusTextReporter )
+{
+    m_windowSize = aSize;
+    m_oldWindowsSize = aSize;
+    m_settings.CameraGet().SetCurWindowSize( aSize );
+
+    initialize_block_positions();
+
+    if( m_reloadRequested )
+    {
+        if( aStatusTextReporter )
+            aStatusTextReporter->Report( _( "Loading..." ) );
+
+        reload( aStatusTextReporter );
+    }
+
+    // The camera may be changed by the caller after the reload
+    // (that sets the look at position), so consume the change flag here
+    m_settings.CameraGet().ParametersChanged();
+
+    // Plain memory replaces the PBO, in the same RGBA bottom-up layout
+    std::vector<GLubyte> buffer( m_realBufferSize.x * m_realBufferSize.y * 4, 0 );
+
+    m_rt_render_state = RT_RENDER_STATE_MAX;
+
+    do
+    {
+        render( &buffer[0], aStatusTextReporter );
+    } while( m_rt_render_state != RT_RENDER_STATE_FINISH );
+
+    // Copy the buffer to the image, centered as it is on the canvas, over the
+    // background gradient
+    aOutImage.Create( aSize.x, aSize.y, false );
+
+    unsigned char *rgb = aOutImage.GetData();
+
+    for( int y = 0; y < aSize.y; ++y )
+    {
+        const float posYfactor = (float)(aSize.y - 1 - y) / (float)aSize.y;
+        const SFVEC3F bgColor = (SFVEC3F)m_settings.m_BgColorTop * SFVEC3F(posYfactor) +
+                                (SFVEC3F)m_settings.m_BgColorBot *
+                                ( SFVEC3F(1.0f) - SFVEC3F(posYfactor) );
+
+        // wxImage is top-down, the render buffer is bottom-up
+        const int bufY = (aSize.y - 1 - y) - (int)m_yoffset;
+
+        for( int x = 0; x < aSize.x; ++x, rgb += 3 )
+        {
+            const int bufX = x - (int)m_xoffset;
+
+            if( (bufX >= 0) && (bufX < (int)m_realBufferSize.x) &&
+                (bufY >= 0) && (bufY < (int)m_realBufferSize.y) )
+            {
+                const GLubyte *p = &buffer[(bufX + bufY * m_realBufferSize.x) * 4];
+
+                rgb[0] = p[0];
+                rgb[1] = p[1];
+                rgb[2] = p[2];
+            }
+            else
+            {
+                rgb[0] = (unsigned char)glm::clamp( (int)(bgColor.r * 255.0f), 0, 255 );
+                rgb[1] = (unsigned char)glm::clamp( (int)(bgColor.g * 255.0f), 0, 255 );
+                rgb[2] = (unsigned char)glm::clamp( (int)(bgColor.b * 255.0f), 0, 255 );
+            }
+        }
+    }
+}
+
+
 void C3D_RENDER_RAYTRACING::render( GLubyte *ptrPBO , REPORTER *aStatusTextReporter )
 {
     if( (m_rt_render_state == RT_RENDER_STATE_FINISH) ||
@@ -359,6 +434,11 @@ void C3D_RENDER_RAYTRACING::render( GLubyte *ptrPBO , REPORTER *aStatusTextRepor
 }
 
 
+// Time (in microseconds) after which the tracing returns to display the
+// progress. This is also the max delay to restart the render after the
+// camera changes, as the events are only processed between slices.
+#define RT_RENDER_TIME_SLICE_US 50000
+
 void C3D_RENDER_RAYTRACING::rt_render_tracing( GLubyte *ptrPBO ,
                                                REPORTER *aStatusTextReporter )
 {
@@ -399,7 +479,7 @@ void C3D_RENDER_RAYTRACING::rt_render_tracing( GLubyte *ptrPBO ,
                 #ifdef _OPENMP
                 if( omp_get_thread_num() == 0 )
                 #endif
-                    if( (GetRunningMicroSecs() - startTime) > 150000 )
+                    if( (GetRunningMicroSecs() - startTime) > RT_RENDER_TIME_SLICE_US )
                     {
                         breakLoop = true;
                         #pragma omp flush(breakLoop)
@@ -657,6 +737,10 @@ void C3D_RENDER_RAYTRACING::rt_trace_AA_packet( const SFVEC3F *aBgColorY,
 
 #define DISP_FACTOR 0.075f
 
+// Max color difference (linear RGB) between the two first samples of every
+// pixel of a block to consider the block converged and skip the AA samples
+#define RT_AA_VARIANCE_THRESHOLD (1.0f / 512.0f)
+
 void C3D_RENDER_RAYTRACING::rt_render_trace_block( GLubyte *ptrPBO ,
                                                    signed int iBlock )
 {
@@ -790,63 +874,86 @@ void C3D_RENDER_RAYTRACING::rt_render_trace_block( GLubyte *ptrPBO ,
                               );
         }
 
-        SFVEC3F hitColor_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
-        SFVEC3F hitColor_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
-        SFVEC3F hitColor_AA_X0Y1_half[RAYPACKET_RAYS_PER_PACKET];
+        // Adaptive sampling: if both samples of every pixel already agree,
+        // there is no edge or noise in this block, so the three extra AA
+        // packets are not traced
+        // /////////////////////////////////////////////////////////////////////
+        float blockVariance = 0.0f;
 
         for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
         {
-            const SFVEC3F color_average = ( hitColor_X0Y0[i] +
-                                            hitColor_AA_X1Y1[i] ) * SFVEC3F(0.5f);
+            const SFVEC3F diff = glm::abs( hitColor_X0Y0[i] - hitColor_AA_X1Y1[i] );
 
-            hitColor_AA_X1Y0[i] = color_average;
-            hitColor_AA_X0Y1[i] = color_average;
-            hitColor_AA_X0Y1_half[i] = color_average;
+            blockVariance = glm::max( blockVariance,
+                                      glm::max( diff.r, glm::max( diff.g, diff.b ) ) );
         }
 
-        RAY blockRayPck_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
-        RAY blockRayPck_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
-        RAY blockRayPck_AA_X1Y1_half[RAYPACKET_RAYS_PER_PACKET];
-
-        RAYPACKET_InitRays_with2DDisplacement( m_settings.CameraGet(),
-                                               (SFVEC2F)blockPosI + SFVEC2F(0.5f - DISP_FACTOR, DISP_FACTOR),
-                                               SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
-                                               blockRayPck_AA_X1Y0 );
-
-        RAYPACKET_InitRays_with2DDisplacement( m_settings.CameraGet(),
-                                               (SFVEC2F)blockPosI + SFVEC2F(DISP_FACTOR, 0.5f - DISP_FACTOR),
-                                               SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
-                                               blockRayPck_AA_X0Y1 );
-
-        RAYPACKET_InitRays_with2DDisplacement( m_settings.CameraGet(),
-                                               (SFVEC2F)blockPosI + SFVEC2F(0.25f - DISP_FACTOR, 0.25f - DISP_FACTOR),
-                                               SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
-                                               blockRayPck_AA_X1Y1_half );
-
-        rt_trace_AA_packet( bgColor,
-                            hitPacket_X0Y0, hitPacket_AA_X1Y1,
-                            blockRayPck_AA_X1Y0,
-                            hitColor_AA_X1Y0 );
-
-        rt_trace_AA_packet( bgColor,
-                            hitPacket_X0Y0, hitPacket_AA_X1Y1,
-                            blockRayPck_AA_X0Y1,
-                            hitColor_AA_X0Y1 );
-
-        rt_trace_AA_packet( bgColor,
-                            hitPacket_X0Y0, hitPacket_AA_X1Y1,
-                            blockRayPck_AA_X1Y1_half,
-                            hitColor_AA_X0Y1_half );
-
-        // Average the result
-        for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        if( blockVariance < RT_AA_VARIANCE_THRESHOLD )
+        {
+            for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+                hitColor_X0Y0[i] = ( hitColor_X0Y0[i] +
+                                     hitColor_AA_X1Y1[i] ) * SFVEC3F(0.5f);
+        }
+        else
         {
-            hitColor_X0Y0[i] = ( hitColor_X0Y0[i] +
-                                 hitColor_AA_X1Y1[i] +
-                                 hitColor_AA_X1Y0[i] +
-                                 hitColor_AA_X0Y1[i] +
-                                 hitColor_AA_X0Y1_half[i]
-                                 ) * SFVEC3F(1.0f / 5.0f);
+            SFVEC3F hitColor_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
+            SFVEC3F hitColor_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
+            SFVEC3F hitColor_AA_X0Y1_half[RAYPACKET_RAYS_PER_PACKET];
+
+            for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+            {
+                const SFVEC3F color_average = ( hitColor_X0Y0[i] +
+                                                hitColor_AA_X1Y1[i] ) * SFVEC3F(0.5f);
+
+                hitColor_AA_X1Y0[i] = color_average;
+                hitColor_AA_X0Y1[i] = color_average;
+                hitColor_AA_X0Y1_half[i] = color_average;
+            }
+
+            RAY blockRayPck_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
+            RAY blockRayPck_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
+            RAY blockRayPck_AA_X1Y1_half[RAYPACKET_RAYS_PER_PACKET];
+
+            RAYPACKET_InitRays_with2DDisplacement( m_settings.CameraGet(),
+                                                   (SFVEC2F)blockPosI + SFVEC2F(0.5f - DISP_FACTOR, DISP_FACTOR),
+                                                   SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
+                                                   blockRayPck_AA_X1Y0 );
+
+            RAYPACKET_InitRays_with2DDisplacement( m_settings.CameraGet(),
+                                                   (SFVEC2F)blockPosI + SFVEC2F(DISP_FACTOR, 0.5f - DISP_FACTOR),
+                                                   SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
+                                                   blockRayPck_AA_X0Y1 );
+
+            RAYPACKET_InitRays_with2DDisplacement( m_settings.CameraGet(),
+                                                   (SFVEC2F)blockPosI + SFVEC2F(0.25f - DISP_FACTOR, 0.25f - DISP_FACTOR),
+                                                   SFVEC2F(DISP_FACTOR, DISP_FACTOR), // Displacement random factor
+                                                   blockRayPck_AA_X1Y1_half );
+
+            rt_trace_AA_packet( bgColor,
+                                hitPacket_X0Y0, hitPacket_AA_X1Y1,
+                                blockRayPck_AA_X1Y0,
+                                hitColor_AA_X1Y0 );
+
+            rt_trace_AA_packet( bgColor,
+                                hitPacket_X0Y0, hitPacket_AA_X1Y1,
+                                blockRayPck_AA_X0Y1,
+                                hitColor_AA_X0Y1 );
+
+            rt_trace_AA_packet( bgColor,
+                                hitPacket_X0Y0, hitPacket_AA_X1Y1,
+                                blockRayPck_AA_X1Y1_half,
+                                hitColor_AA_X0Y1_half );
+
+            // Average the result
+            for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+            {
+                hitColor_X0Y0[i] = ( hitColor_X0Y0[i] +
+                                     hitColor_AA_X1Y1[i] +
+                                     hitColor_AA_X1Y0[i] +
+                                     hitColor_AA_X0Y1[i] +
+                                     hitColor_AA_X0Y1_half[i]
+                                     ) * SFVEC3F(1.0f / 5.0f);
+            }
         }
     }
 
@@ -2063,6 +2170,33 @@ bool C3D_RENDER_RAYTRACING::initializeOpenGL()
 }
 
 
+/**
+ * Orders the blocks by their ring (chessboard distance in blocks) around a
+ * center position
+ */
+struct CompareBlockRing
+{
+    explicit CompareBlockRing( const SFVEC2UI &aCenter ) : m_center( aCenter ) {}
+
+    unsigned int ring( const SFVEC2UI &aBlockPos ) const
+    {
+        const unsigned int dx = ( aBlockPos.x > m_center.x ) ? aBlockPos.x - m_center.x :
+                                                               m_center.x - aBlockPos.x;
+        const unsigned int dy = ( aBlockPos.y > m_center.y ) ? aBlockPos.y - m_center.y :
+                                                               m_center.y - aBlockPos.y;
+
+        return std::max( dx, dy ) / RAYPACKET_DIM;
+    }
+
+    bool operator()( const SFVEC2UI &a, const SFVEC2UI &b ) const
+    {
+        return ring( a ) < ring( b );
+    }
+
+    SFVEC2UI m_center;
+};
+
+
 void C3D_RENDER_RAYTRACING::initialize_block_positions()
 {
 
@@ -2133,9 +2267,13 @@ void C3D_RENDER_RAYTRACING::initialize_block_positions()
             m_blockPositions.push_back( blockPos );
     }
 
+    // Render the blocks from the view center outward, so the area the user is
+    // looking at is available first. The Morton order is kept inside each ring.
+    std::stable_sort( m_blockPositions.begin(), m_blockPositions.end(),
+                      CompareBlockRing( SFVEC2UI( m_realBufferSize.x / 2,
+                                                  m_realBufferSize.y / 2 ) ) );
+
     // Create m_shader buffer
     delete[] m_shaderBuffer;
     m_shaderBuffer = new SFVEC3F[m_realBufferSize.x * m_realBufferSize.y];
-
-    opengl_init_pbo();
 }
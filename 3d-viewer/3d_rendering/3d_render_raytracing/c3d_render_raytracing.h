@@ -40,6 +40,7 @@
 #include <plugins/3dapi/c3dmodel.h>
 
 #include <map>
+#include <wx/image.h>
 
 /// Vector of materials
 typedef std::vector< CBLINN_PHONG_MATERIAL > MODEL_MATERIALS;
@@ -69,6 +70,17 @@ public:
 
     int GetWaitForEditingTimeOut() override;
 
+    /**
+     * @brief RenderToImage - render the full quality image on the CPU only,
+     * without an OpenGL context or a canvas. It is used by headless exports.
+     * @param aSize: the size of the image in pixels
+     * @param aOutImage: receives the rendered image
+     * @param aStatusTextReporter: a pointer to the status progress reporter
+     */
+    void RenderToImage( const wxSize &aSize,
+                        wxImage &aOutImage,
+                        REPORTER *aStatusTextReporter = NULL );
+
 private:
     bool initializeOpenGL();
     void initializeNewWindowSize();
@@ -43,6 +43,8 @@ BASE_SCREEN::BASE_SCREEN( KICAD_T aType ) :
     EDA_ITEM( aType )
 {
     m_UndoRedoCountMax = DEFAULT_MAX_UNDO_ITEMS;
+    m_UndoRedoMemoryMax = 0;
+    m_UndoRedoMemoryUsage = 0;
     m_FirstRedraw      = true;
     m_ScreenNumber     = 1;
     m_NumberOfScreens  = 1;      // Hierarchy: Root: ScreenNumber = 1
@@ -414,40 +416,145 @@ void BASE_SCREEN::ClearUndoRedoList()
 void BASE_SCREEN::PushCommandToUndoList( PICKED_ITEMS_LIST* aNewitem )
 {
     m_UndoList.PushCommand( aNewitem );
+    addCommandData( *aNewitem );
 
-    // Delete the extra items, if count max reached
-    if( m_UndoRedoCountMax > 0 )
-    {
-        int extraitems = GetUndoCommandCount() - m_UndoRedoCountMax;
-        if( extraitems > 0 )
-            ClearUndoORRedoList( m_UndoList, extraitems );
-    }
+    trimUndoORRedoList( m_UndoList );
 }
 
 
 void BASE_SCREEN::PushCommandToRedoList( PICKED_ITEMS_LIST* aNewitem )
 {
     m_RedoList.PushCommand( aNewitem );
+    addCommandData( *aNewitem );
+
+    trimUndoORRedoList( m_RedoList );
+}
+
+
+void BASE_SCREEN::trimUndoORRedoList( UNDO_REDO_CONTAINER& aList )
+{
+    int count = aList.m_CommandsList.size();
 
     // Delete the extra items, if count max reached
-    if( m_UndoRedoCountMax > 0 )
+    if( m_UndoRedoCountMax > 0 && count > m_UndoRedoCountMax )
+        ClearUndoORRedoList( aList, count - m_UndoRedoCountMax );
+
+    // Delete more old items while the memory budget is exceeded
+    if( m_UndoRedoMemoryMax > 0 )
+    {
+        refreshSharedData();
+
+        while( m_UndoRedoMemoryUsage > m_UndoRedoMemoryMax && aList.m_CommandsList.size() > 1 )
+        {
+            size_t oldCount = aList.m_CommandsList.size();
+
+            ClearUndoORRedoList( aList, 1 );
+
+            if( aList.m_CommandsList.size() == oldCount )
+                break;
+
+            // The data the deleted command shared with other commands can now be
+            // held by the lists only
+            refreshSharedData();
+        }
+    }
+}
+
+
+void BASE_SCREEN::addCommandData( PICKED_ITEMS_LIST& aCommand )
+{
+    aCommand.m_SharedData.clear();
+    aCommand.m_DataSize = GetCommandDataSize( aCommand, aCommand.m_SharedData );
+    m_UndoRedoMemoryUsage += aCommand.m_DataSize;
+
+    for( const UNDO_SHARED_DATA& data : aCommand.m_SharedData )
+    {
+        auto it = m_UndoRedoSharedData.find( data.m_Data );
+
+        if( it == m_UndoRedoSharedData.end() )
+        {
+            SHARED_DATA_USAGE usage = { data.m_Data, data.m_Size, 0, 0 };
+            it = m_UndoRedoSharedData.insert( std::make_pair( data.m_Data, usage ) ).first;
+        }
+
+        accountSharedData( it->second, 1 );
+    }
+}
+
+
+void BASE_SCREEN::ReleaseCommandData( PICKED_ITEMS_LIST& aCommand )
+{
+    m_UndoRedoMemoryUsage -= aCommand.m_DataSize;
+    aCommand.m_DataSize = 0;
+
+    for( const UNDO_SHARED_DATA& data : aCommand.m_SharedData )
     {
-        int extraitems = GetRedoCommandCount() - m_UndoRedoCountMax;
-        if( extraitems > 0 )
-            ClearUndoORRedoList( m_RedoList, extraitems );
+        auto it = m_UndoRedoSharedData.find( data.m_Data );
+
+        if( it == m_UndoRedoSharedData.end() )
+            continue;
+
+        accountSharedData( it->second, -1 );
+
+        if( it->second.m_Holders <= 0 )
+            m_UndoRedoSharedData.erase( it );
     }
+
+    aCommand.m_SharedData.clear();
+}
+
+
+void BASE_SCREEN::accountSharedData( SHARED_DATA_USAGE& aData, long aHoldersDelta )
+{
+    // The data is held by the lists only if the commands hold all its references
+    if( aData.m_Holders > 0 && aData.m_UseCount == aData.m_Holders )
+        m_UndoRedoMemoryUsage -= aData.m_Size;
+
+    aData.m_Holders += aHoldersDelta;
+    aData.m_UseCount = aData.m_Data.use_count();
+
+    if( aData.m_Holders > 0 && aData.m_UseCount == aData.m_Holders )
+        m_UndoRedoMemoryUsage += aData.m_Size;
+}
+
+
+void BASE_SCREEN::refreshSharedData()
+{
+    for( auto& data : m_UndoRedoSharedData )
+    {
+        if( data.second.m_Data.use_count() != data.second.m_UseCount )
+            accountSharedData( data.second, 0 );
+    }
+}
+
+
+size_t BASE_SCREEN::GetUndoRedoMemoryUsage()
+{
+    refreshSharedData();
+
+    return m_UndoRedoMemoryUsage;
 }
 
 
 PICKED_ITEMS_LIST* BASE_SCREEN::PopCommandFromUndoList( )
 {
-    return m_UndoList.PopCommand( );
+    PICKED_ITEMS_LIST* command = m_UndoList.PopCommand( );
+
+    if( command )
+        ReleaseCommandData( *command );
+
+    return command;
 }
 
 
 PICKED_ITEMS_LIST* BASE_SCREEN::PopCommandFromRedoList( )
 {
-    return m_RedoList.PopCommand( );
+    PICKED_ITEMS_LIST* command = m_RedoList.PopCommand( );
+
+    if( command )
+        ReleaseCommandData( *command );
+
+    return command;
 }
 
 
@@ -44,6 +44,8 @@ KIGFX::GAL_DISPLAY_OPTIONS basic_displayOptions;
 // the basic GAL doesn't get an external display option object
 BASIC_GAL basic_gal( basic_displayOptions );
 
+std::recursive_mutex basic_gal_mutex;
+
 const VECTOR2D BASIC_GAL::transform( const VECTOR2D& aPoint ) const
 {
     VECTOR2D point = aPoint + m_transform.m_moveOffset - m_transform.m_rotCenter;
@@ -97,7 +99,7 @@ void BASIC_GAL::DrawPolyline( const std::deque<VECTOR2D>& aPointList )
         for( unsigned ii = 1; ii < polyline_corners.size(); ii++ )
         {
             m_callback( polyline_corners[ii-1].x, polyline_corners[ii-1].y,
-                        polyline_corners[ii].x, polyline_corners[ii].y );
+                        polyline_corners[ii].x, polyline_corners[ii].y, m_callbackData );
         }
     }
 }
@@ -129,6 +131,6 @@ void BASIC_GAL::DrawLine( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint
     else if( m_callback )
     {
             m_callback( startVector.x, startVector.y,
-                        endVector.x, endVector.y );
+                        endVector.x, endVector.y, m_callbackData );
     }
 }
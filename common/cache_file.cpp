@@ -0,0 +1,158 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <fctsys.h>
+#include <common.h>
+#include <ki_exception.h>
+#include <utf8.h>
+#include <cache_file.h>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <algorithm>
+#include <cstring>
+
+
+wxUint64 HashBytes( const char* aData, size_t aSize, wxUint64 aHash )
+{
+    for( size_t ii = 0; ii < aSize; ++ii )
+    {
+        aHash ^= (unsigned char) aData[ii];
+        aHash *= 1099511628211ULL;
+    }
+
+    return aHash;
+}
+
+
+bool ReadCacheFile( const wxString& aFileName, std::string& aData )
+{
+    wxLogNull   doNotLog;       // A missing or unreadable cache file is not an error.
+    wxFFile     file;
+
+    aData.clear();
+
+    if( !wxFileExists( aFileName ) || !file.Open( aFileName, "rb" ) )
+        return false;
+
+    aData.resize( (size_t) file.Length() );
+
+    if( !aData.empty() && file.Read( &aData[0], aData.size() ) != aData.size() )
+    {
+        aData.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+bool WriteCacheFile( const wxString& aFileName, const std::string& aData )
+{
+    wxLogNull   doNotLog;       // The cache is optional, do not report write errors.
+    wxFileName  fn( aFileName );
+
+    if( !fn.DirExists() && !fn.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+        return false;
+
+    // The same file can be saved by several instances, and by several threads
+    // of an instance: the temporary file name is unique for both.
+    wxString tmpFileName = aFileName + wxString::Format( wxT( ".%lu-%p" ),
+                                                         wxGetProcessId(), &aData );
+    wxFFile  file( tmpFileName, "wb" );
+
+    if( !file.IsOpened() )
+        return false;
+
+    bool success = file.Write( aData.data(), aData.size() ) == aData.size();
+
+    success = file.Close() && success;
+
+    if( !success || !wxRenameFile( tmpFileName, aFileName, true ) )
+    {
+        wxRemoveFile( tmpFileName );
+        return false;
+    }
+
+    return true;
+}
+
+
+void CACHE_FILE_WRITER::WriteString( const wxString& aText )
+{
+    UTF8 utf8 = aText;
+
+    WriteInt( (int) utf8.size() );
+    write( utf8.c_str(), utf8.size() );
+}
+
+
+void CACHE_FILE_WRITER::WriteData( const std::string& aData )
+{
+    WriteInt( (int) aData.size() );
+    write( aData.data(), aData.size() );
+}
+
+
+CACHE_FILE_READER::CACHE_FILE_READER( const std::string& aData, size_t aOffset ) :
+    m_start( aData.data() ),
+    m_pos( aData.data() + std::min( aOffset, aData.size() ) ),
+    m_end( aData.data() + aData.size() )
+{
+}
+
+
+wxString CACHE_FILE_READER::ReadString()
+{
+    int size = ReadInt();
+
+    if( size < 0 || size > m_end - m_pos )
+        THROW_IO_ERROR( _( "cache file is corrupted" ) );
+
+    wxString text = wxString::FromUTF8( m_pos, size );
+    m_pos += size;
+    return text;
+}
+
+
+size_t CACHE_FILE_READER::SkipData()
+{
+    int size = ReadInt();
+
+    if( size < 0 || size > m_end - m_pos )
+        THROW_IO_ERROR( _( "cache file is corrupted" ) );
+
+    size_t offset = m_pos - m_start;
+    m_pos += size;
+    return offset;
+}
+
+
+void CACHE_FILE_READER::read( void* aData, size_t aSize )
+{
+    if( (size_t) ( m_end - m_pos ) < aSize )
+        THROW_IO_ERROR( _( "cache file is truncated" ) );
+
+    memcpy( aData, m_pos, aSize );
+    m_pos += aSize;
+}
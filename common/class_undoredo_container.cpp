@@ -43,6 +43,7 @@ ITEM_PICKER::ITEM_PICKER( EDA_ITEM* aItem, UNDO_REDO_T aUndoRedoStatus )
 PICKED_ITEMS_LIST::PICKED_ITEMS_LIST()
 {
     m_Status = UR_UNSPECIFIED;
+    m_DataSize = 0;
 }
 
 PICKED_ITEMS_LIST::~PICKED_ITEMS_LIST()
@@ -250,6 +250,51 @@ wxString GetKicadConfigPath()
 }
 
 
+wxString GetKicadCachePath()
+{
+    wxFileName cachepath;
+
+    // wxWidgets has no user cache directory, so use the same places as the 3D model cache:
+    //      Unix: ${XDG_CACHE_HOME}/kicad or ~/.cache/kicad
+    //      Windows: AppData\Local\kicad
+    //      Mac: ~/Library/Caches/kicad
+#if defined( __WINDOWS__ )
+    wxString envstr;
+
+    if( wxGetEnv( wxT( "LOCALAPPDATA" ), &envstr ) && !envstr.IsEmpty() )
+        cachepath.AssignDir( envstr );
+    else
+        cachepath.AssignDir( wxStandardPaths::Get().GetUserLocalDataDir() );
+#elif defined( __WXMAC__ )
+    cachepath.AssignDir( wxGetHomeDir() );
+    cachepath.AppendDir( wxT( "Library" ) );
+    cachepath.AppendDir( wxT( "Caches" ) );
+#else
+    wxString envstr;
+
+    if( !wxGetEnv( wxT( "XDG_CACHE_HOME" ), &envstr ) || envstr.IsEmpty() )
+    {
+        // XDG_CACHE_HOME is not set, so use the fallback
+        cachepath.AssignDir( wxGetHomeDir() );
+        cachepath.AppendDir( wxT( ".cache" ) );
+    }
+    else
+    {
+        cachepath.AssignDir( envstr );
+    }
+#endif
+
+    cachepath.AppendDir( wxT( "kicad" ) );
+
+    if( !cachepath.DirExists() )
+    {
+        cachepath.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL );
+    }
+
+    return cachepath.GetPath();
+}
+
+
 #include <ki_mutex.h>
 const wxString ExpandEnvVarSubstitutions( const wxString& aString )
 {
@@ -98,11 +98,107 @@ void GERBER_PLOTTER::SetGerberCoordinatesFormat( int aResolution, bool aUseInche
 }
 
 
+// Size of the stdio buffer of the work file. Zone fills are output vertex by vertex,
+// so large writes reduce the number of system calls
+#define GERBER_WORKFILE_BUFSIZE ( 256 * 1024 )
+
+
+/**
+ * Function formatInt
+ * writes the decimal ascii representation of aValue in aBuffer, without trailing nul.
+ * It is a lot faster than sprintf( "%d" ), and coordinates are the main part of a gerber file
+ * @param aMinDigits = the minimal count of digits, padded with leading zeros
+ * @return a pointer to the char after the last written char
+ */
+static inline char* formatInt( char* aBuffer, int aValue, int aMinDigits = 1 )
+{
+    char digits[16];
+    int  count = 0;
+
+    // Use an unsigned value, -INT_MIN does not fit in an int
+    unsigned int uvalue = aValue < 0 ? 0u - (unsigned int) aValue : (unsigned int) aValue;
+
+    do
+    {
+        digits[count++] = '0' + ( uvalue % 10 );
+        uvalue /= 10;
+    } while( uvalue );
+
+    while( count < aMinDigits )
+        digits[count++] = '0';
+
+    if( aValue < 0 )
+        *aBuffer++ = '-';
+
+    while( count )
+        *aBuffer++ = digits[--count];
+
+    return aBuffer;
+}
+
+
 void GERBER_PLOTTER::emitDcode( const DPOINT& pt, int dcode )
 {
+    // Same as fprintf( outputFile, "X%dY%dD%02d*\n", x, y, dcode )
+    char  buffer[64];
+    char* text = buffer;
+
+    *text++ = 'X';
+    text = formatInt( text, KiROUND( pt.x ) );
+    *text++ = 'Y';
+    text = formatInt( text, KiROUND( pt.y ) );
+    *text++ = 'D';
+    text = formatInt( text, dcode, 2 );
+    *text++ = '*';
+    *text++ = '\n';
+
+    fwrite( buffer, 1, text - buffer, outputFile );
+}
+
+
+void GERBER_PLOTTER::emitRegionContour( const std::vector<wxPoint>& aCornerList )
+{
+    // Build the contour in device coordinates, the ones written in the file
+    std::vector<wxPoint> contour;
+    contour.reserve( aCornerList.size() + 1 );
+
+    for( const wxPoint& corner : aCornerList )
+    {
+        DPOINT  pos_dev = userToDeviceCoordinates( corner );
+        wxPoint pt( KiROUND( pos_dev.x ), KiROUND( pos_dev.y ) );
+
+        if( !contour.empty() && contour.back() == pt )
+            continue;
+
+        // The last corner can be removed if it is between its previous corner and pt,
+        // on the same line. Backward moves (null width spikes) are kept as they are.
+        if( contour.size() >= 2 )
+        {
+            const wxPoint& prev = contour[contour.size() - 2];
+            wxPoint d1 = contour.back() - prev;
+            wxPoint d2 = pt - contour.back();
+
+            if( (int64_t) d1.x * d2.y == (int64_t) d1.y * d2.x
+                && (int64_t) d1.x * d2.x + (int64_t) d1.y * d2.y > 0 )
+            {
+                contour.back() = pt;
+                continue;
+            }
+        }
 
-    fprintf( outputFile, "X%dY%dD%02d*\n",
-	    KiROUND( pt.x ), KiROUND( pt.y ), dcode );
+        contour.push_back( pt );
+    }
+
+    // A region contour is always closed
+    if( contour.back() != contour.front() )
+        contour.push_back( contour.front() );
+
+    emitDcode( DPOINT( contour[0].x, contour[0].y ), 2 );
+
+    for( unsigned ii = 1; ii < contour.size(); ii++ )
+        emitDcode( DPOINT( contour[ii].x, contour[ii].y ), 1 );
+
+    penState = 'Z';
 }
 
 
@@ -172,6 +268,8 @@ bool GERBER_PLOTTER::StartPlot()
     if( outputFile == NULL )
         return false;
 
+    setvbuf( workFile, NULL, _IOFBF, GERBER_WORKFILE_BUFSIZE );
+
     for( unsigned ii = 0; ii < m_headerExtraLines.GetCount(); ii++ )
     {
         if( ! m_headerExtraLines[ii].IsEmpty() )
@@ -283,28 +381,20 @@ void GERBER_PLOTTER::SetCurrentLineWidth( int width, void* aData )
 std::vector<APERTURE>::iterator GERBER_PLOTTER::getAperture( const wxSize& aSize,
                         APERTURE::APERTURE_TYPE aType, int aApertureAttribute )
 {
-    int last_D_code = 9;
-
-    // Search an existing aperture
-    std::vector<APERTURE>::iterator tool = apertures.begin();
-
-    while( tool != apertures.end() )
-    {
-        last_D_code = tool->m_DCode;
-
-        if( (tool->m_Type == aType) && (tool->m_Size == aSize) && (tool->m_ApertureAttribute == aApertureAttribute) )
-            return tool;
-
-        ++tool;
-    }
-
-    // Allocate a new aperture
     APERTURE new_tool;
     new_tool.m_Size  = aSize;
     new_tool.m_Type  = aType;
-    new_tool.m_DCode = last_D_code + 1;
+    new_tool.m_DCode = apertures.empty() ? 10 : apertures.back().m_DCode + 1;
     new_tool.m_ApertureAttribute = aApertureAttribute;
 
+    // Search an existing aperture
+    auto found = m_apertureIndex.find( new_tool );
+
+    if( found != m_apertureIndex.end() )
+        return apertures.begin() + found->second;
+
+    // Allocate a new aperture
+    m_apertureIndex[new_tool] = apertures.size();
     apertures.push_back( new_tool );
 
     return apertures.end() - 1;
@@ -328,7 +418,16 @@ void GERBER_PLOTTER::selectAperture( const wxSize&           aSize,
     {
         // Pick an existing aperture or create a new one
         currentAperture = getAperture( aSize, aType, aApertureAttribute );
-        fprintf( outputFile, "D%d*\n", currentAperture->m_DCode );
+
+        char  buffer[32];
+        char* text = buffer;
+
+        *text++ = 'D';
+        text = formatInt( text, currentAperture->m_DCode );
+        *text++ = '*';
+        *text++ = '\n';
+
+        fwrite( buffer, 1, text - buffer, outputFile );
     }
 }
 
@@ -496,13 +595,7 @@ void GERBER_PLOTTER:: PlotPoly( const std::vector< wxPoint >& aCornerList,
     if( aFill )
     {
         fputs( "G36*\n", outputFile );
-
-        MoveTo( aCornerList[0] );
-
-        for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
-            LineTo( aCornerList[ii] );
-
-        FinishTo( aCornerList[0] );
+        emitRegionContour( aCornerList );
         fputs( "G37*\n", outputFile );
     }
 
@@ -93,6 +93,19 @@ static const wxString GalDisplayOptionsKeyword( wxT( "GalDisplayOptions" ) );
  */
 static const wxString MaxUndoItemsEntry(wxT( "DevelMaxUndoItems" ) );
 
+/**
+ * Integer to set the memory budget of the undo and redo lists, in megabytes.  When it
+ * is exceeded, the oldest undo commands are deleted.  If zero, the memory is unlimited.
+ *
+ * Present as:
+ *
+ * - PcbFrameDevelMaxUndoMemoryMB (file: pcbnew)
+ * - ModEditFrameDevelMaxUndoMemoryMB (file: pcbnew)
+ *
+ * \ingroup develconfig
+ */
+static const wxString MaxUndoMemoryEntry(wxT( "DevelMaxUndoMemoryMB" ) );
+
 BEGIN_EVENT_TABLE( EDA_DRAW_FRAME, KIWAY_PLAYER )
     EVT_MOUSEWHEEL( EDA_DRAW_FRAME::OnMouseEvent )
     EVT_MENU_OPEN( EDA_DRAW_FRAME::OnMenuOpen )
@@ -161,6 +174,8 @@ EDA_DRAW_FRAME::EDA_DRAW_FRAME( KIWAY* aKiway, wxWindow* aParent,
     m_MsgFrameHeight      = EDA_MSG_PANEL::GetRequiredHeight();
     m_movingCursorWithKeyboard = false;
     m_zoomLevelCoeff      = 1.0;
+    m_UndoRedoCountMax    = DEFAULT_MAX_UNDO_ITEMS;
+    m_UndoRedoMemoryMaxMB = DEFAULT_MAX_UNDO_MEMORY_MB;
 
     m_auimgr.SetFlags(wxAUI_MGR_DEFAULT|wxAUI_MGR_LIVE_RESIZE);
 
@@ -709,6 +724,9 @@ void EDA_DRAW_FRAME::LoadSettings( wxConfigBase* aCfg )
     m_UndoRedoCountMax = aCfg->Read( baseCfgName + MaxUndoItemsEntry,
             long( DEFAULT_MAX_UNDO_ITEMS ) );
 
+    m_UndoRedoMemoryMaxMB = aCfg->Read( baseCfgName + MaxUndoMemoryEntry,
+            long( DEFAULT_MAX_UNDO_MEMORY_MB ) );
+
     m_galDisplayOptions->ReadConfig( aCfg, baseCfgName + GalDisplayOptionsKeyword );
 }
 
@@ -725,7 +743,11 @@ void EDA_DRAW_FRAME::SaveSettings( wxConfigBase* aCfg )
     aCfg->Write( baseCfgName + LastGridSizeIdKeyword, ( long ) m_LastGridSizeId );
 
     if( GetScreen() )
+    {
         aCfg->Write( baseCfgName + MaxUndoItemsEntry, long( GetScreen()->GetMaxUndoItems() ) );
+        aCfg->Write( baseCfgName + MaxUndoMemoryEntry,
+                     long( GetScreen()->GetMaxUndoMemory() / ( 1024 * 1024 ) ) );
+    }
 
     m_galDisplayOptions->WriteConfig( aCfg, baseCfgName + GalDisplayOptionsKeyword );
 }
@@ -87,6 +87,8 @@ int Clamp_Text_PenSize( int aPenSize, wxSize aSize, bool aBold )
 
 int GraphicTextWidth( const wxString& aText, const wxSize& aSize, bool aItalic, bool aBold )
 {
+    std::lock_guard<std::recursive_mutex> lock( basic_gal_mutex );
+
     basic_gal.SetFontItalic( aItalic );
     basic_gal.SetFontBold( aBold );
     basic_gal.SetGlyphSize( VECTOR2D( aSize ) );
@@ -118,6 +120,7 @@ int GraphicTextWidth( const wxString& aText, const wxSize& aSize, bool aItalic,
  *                  used to draw 3D texts or for plotting, NULL for normal drawings
  *  @param aPlotter = a pointer to a PLOTTER instance, when this function is used to plot
  *                  the text. NULL to draw this text.
+ *  @param aCallbackData = the last parameter of aCallback()
  */
 void DrawGraphicText( EDA_RECT* aClipBox,
                       wxDC* aDC,
@@ -131,8 +134,9 @@ void DrawGraphicText( EDA_RECT* aClipBox,
                       int aWidth,
                       bool aItalic,
                       bool aBold,
-                      void (* aCallback)( int x0, int y0, int xf, int yf ),
-                      PLOTTER* aPlotter )
+                      void (* aCallback)( int x0, int y0, int xf, int yf, void* aData ),
+                      PLOTTER* aPlotter,
+                      void* aCallbackData )
 {
     bool    fill_mode = true;
 
@@ -145,6 +149,9 @@ void DrawGraphicText( EDA_RECT* aClipBox,
         fill_mode = false;
     }
 
+    // basic_gal is shared by all the threads plotting a board
+    std::lock_guard<std::recursive_mutex> lock( basic_gal_mutex );
+
     basic_gal.SetIsFill( fill_mode );
     basic_gal.SetLineWidth( aWidth );
 
@@ -164,7 +171,7 @@ void DrawGraphicText( EDA_RECT* aClipBox,
 
     basic_gal.SetTextAttributes( &dummy );
     basic_gal.SetPlotter( aPlotter );
-    basic_gal.SetCallback( aCallback );
+    basic_gal.SetCallback( aCallback, aCallbackData );
     basic_gal.m_DC = aDC;
     basic_gal.m_Color = aColor;
     basic_gal.SetClipBox( aClipBox );
@@ -184,8 +191,9 @@ void DrawGraphicHaloText( EDA_RECT* aClipBox, wxDC * aDC,
                           enum EDA_TEXT_HJUSTIFY_T aH_justify,
                           enum EDA_TEXT_VJUSTIFY_T aV_justify,
                           int aWidth, bool aItalic, bool aBold,
-                          void (*aCallback)( int x0, int y0, int xf, int yf ),
-                          PLOTTER * aPlotter )
+                          void (*aCallback)( int x0, int y0, int xf, int yf, void* aData ),
+                          PLOTTER * aPlotter,
+                          void* aCallbackData )
 {
     // Swap color if contrast would be better
     // TODO: Maybe calculate contrast some way other than brightness
@@ -199,12 +207,12 @@ void DrawGraphicHaloText( EDA_RECT* aClipBox, wxDC * aDC,
     // Draw the background
     DrawGraphicText( aClipBox, aDC, aPos, aColor1, aText, aOrient, aSize,
                      aH_justify, aV_justify, aWidth, aItalic, aBold,
-                     aCallback, aPlotter );
+                     aCallback, aPlotter, aCallbackData );
 
     // Draw the text
     DrawGraphicText( aClipBox, aDC, aPos, aColor2, aText, aOrient, aSize,
                      aH_justify, aV_justify, aWidth/4, aItalic, aBold,
-                     aCallback, aPlotter );
+                     aCallback, aPlotter, aCallbackData );
 }
 
 /**
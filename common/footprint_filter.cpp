@@ -19,7 +19,9 @@
  */
 
 #include <footprint_filter.h>
+#include <footprint_search_index.h>
 #include <make_unique.h>
+#include <algorithm>
 #include <stdexcept>
 
 using FOOTPRINT_FILTER_IT = FOOTPRINT_FILTER::ITERATOR;
@@ -37,70 +39,15 @@ FOOTPRINT_FILTER::ITERATOR::ITERATOR( FOOTPRINT_FILTER_IT const& aOther )
 
 
 FOOTPRINT_FILTER::ITERATOR::ITERATOR( FOOTPRINT_FILTER& aFilter )
-        : m_pos( (size_t) -1 ), m_filter( &aFilter )
+        : m_pos( 0 ), m_filter( &aFilter )
 {
-    increment();
 }
 
 
 void FOOTPRINT_FILTER_IT::increment()
 {
-    bool found = false;
-
-    if( !m_filter || !m_filter->m_list || m_filter->m_list->GetCount() == 0 )
-    {
-        m_pos = 0;
-        return;
-    }
-
-    auto  filter_type       = m_filter->m_filter_type;
-    auto  list              = m_filter->m_list;
-    auto& lib_name          = m_filter->m_lib_name;
-    auto& filter_pattern    = m_filter->m_filter_pattern;
-    auto& filter            = m_filter->m_filter;
-
-    for( ++m_pos; m_pos < list->GetCount() && !found; ++m_pos )
-    {
-        found = true;
-
-        if( ( filter_type & FOOTPRINT_FILTER::FILTERING_BY_LIBRARY ) && !lib_name.IsEmpty()
-                && !list->GetItem( m_pos ).InLibrary( lib_name ) )
-            found = false;
-
-        if( ( filter_type & FOOTPRINT_FILTER::FILTERING_BY_COMPONENT_KEYWORD )
-                && !FootprintFilterMatch( list->GetItem( m_pos ) ) )
-            found = false;
-
-        if( ( filter_type & FOOTPRINT_FILTER::FILTERING_BY_PIN_COUNT )
-                && !PinCountMatch( list->GetItem( m_pos ) ) )
-            found = false;
-
-        if( ( filter_type & FOOTPRINT_FILTER::FILTERING_BY_NAME ) && !filter_pattern.IsEmpty() )
-        {
-            wxString currname;
-
-            // If the search string contains a ':' character,
-            // include the library name in the search string
-            // e.g. LibName:FootprintName
-            if( filter_pattern.Contains( ":" ) )
-                currname = list->GetItem( m_pos ).GetNickname().Lower() + ":";
-
-            currname += list->GetItem( m_pos ).GetFootprintName().Lower();
-
-            if( filter.Find( currname ) == EDA_PATTERN_NOT_FOUND )
-                found = false;
-        }
-
-        if( filter_type == FOOTPRINT_FILTER::UNFILTERED_FP_LIST )
-        {
-            // override
-            found = true;
-        }
-    }
-
-    // for loop will stop one past the correct item
-    if( found )
-        --m_pos;
+    if( m_filter && m_pos < m_filter->m_matches.size() )
+        ++m_pos;
 }
 
 
@@ -113,24 +60,22 @@ bool FOOTPRINT_FILTER_IT::equal( FOOTPRINT_FILTER_IT const& aOther ) const
 
 FOOTPRINT_INFO& FOOTPRINT_FILTER_IT::dereference() const
 {
-    if( m_filter && m_filter->m_list && m_pos < m_filter->m_list->GetCount() )
-        return m_filter->m_list->GetItem( m_pos );
+    if( m_filter && m_filter->m_list && m_pos < m_filter->m_matches.size() )
+        return m_filter->m_list->GetItem( m_filter->m_matches[m_pos] );
     else
         throw std::out_of_range( "Attempt to dereference past FOOTPRINT_FILTER::end()" );
 }
 
 
-bool FOOTPRINT_FILTER_IT::FootprintFilterMatch( FOOTPRINT_INFO& aItem )
+bool FOOTPRINT_FILTER::footprintFilterMatch( FOOTPRINT_INFO& aItem ) const
 {
-    if( m_filter->m_footprint_filters.empty() )
+    if( m_footprint_filters.empty() )
         return true;
 
     // The matching is case insensitive
     wxString name;
 
-    EDA_PATTERN_MATCH_WILDCARD patternFilter;
-
-    for( auto const& each_filter : m_filter->m_footprint_filters )
+    for( auto const& each_filter : m_footprint_filters )
     {
         name.Empty();
 
@@ -152,9 +97,127 @@ bool FOOTPRINT_FILTER_IT::FootprintFilterMatch( FOOTPRINT_INFO& aItem )
 }
 
 
-bool FOOTPRINT_FILTER_IT::PinCountMatch( FOOTPRINT_INFO& aItem )
+bool FOOTPRINT_FILTER::itemMatches( FOOTPRINT_INFO& aItem ) const
+{
+    if( m_filter_type == UNFILTERED_FP_LIST )
+        return true;
+
+    if( ( m_filter_type & FILTERING_BY_LIBRARY ) && !m_lib_name.IsEmpty()
+            && !aItem.InLibrary( m_lib_name ) )
+        return false;
+
+    if( ( m_filter_type & FILTERING_BY_COMPONENT_KEYWORD ) && !footprintFilterMatch( aItem ) )
+        return false;
+
+    if( ( m_filter_type & FILTERING_BY_PIN_COUNT )
+            && (unsigned) m_pin_count != aItem.GetUniquePadCount() )
+        return false;
+
+    if( ( m_filter_type & FILTERING_BY_NAME ) && !m_filter_pattern.IsEmpty() )
+    {
+        wxString currname;
+
+        // If the search string contains a ':' character,
+        // include the library name in the search string
+        // e.g. LibName:FootprintName
+        if( m_filter_pattern.Contains( ":" ) )
+            currname = aItem.GetNickname().Lower() + ":";
+
+        currname += aItem.GetFootprintName().Lower();
+
+        if( m_filter.Find( currname ) == EDA_PATTERN_NOT_FOUND )
+            return false;
+    }
+
+    return true;
+}
+
+
+void FOOTPRINT_FILTER::updateMatches()
 {
-    return (unsigned) m_filter->m_pin_count == aItem.GetUniquePadCount();
+    m_matches.clear();
+    m_matches_valid = true;
+
+    if( !m_list )
+        return;
+
+    const FOOTPRINT_SEARCH_INDEX& index = m_list->GetSearchIndex();
+
+    std::vector<int> candidates;
+    std::vector<int> items;
+    bool             restricted = false;
+
+    // Only the items given by the index for each criterion can match all of them
+    auto restrictTo = [&]( const std::vector<int>& aItems )
+    {
+        if( restricted )
+        {
+            std::vector<int> intersection;
+
+            std::set_intersection( candidates.begin(), candidates.end(),
+                                   aItems.begin(), aItems.end(),
+                                   std::back_inserter( intersection ) );
+            candidates.swap( intersection );
+        }
+        else
+        {
+            candidates = aItems;
+            restricted = true;
+        }
+    };
+
+    if( m_filter_type != UNFILTERED_FP_LIST )
+    {
+        if( ( m_filter_type & FILTERING_BY_LIBRARY ) && !m_lib_name.IsEmpty() )
+            restrictTo( index.GetLibraryItems( m_lib_name ) );
+
+        if( m_filter_type & FILTERING_BY_PIN_COUNT )
+            restrictTo( index.GetPadCountItems( (unsigned) m_pin_count ) );
+
+        if( ( m_filter_type & FILTERING_BY_COMPONENT_KEYWORD ) && !m_footprint_filters.empty() )
+        {
+            std::vector<int> filterItems;
+            bool             hint = true;
+
+            items.clear();
+
+            // An item matching any of the filters is a candidate
+            for( auto const& each_filter : m_footprint_filters )
+            {
+                hint = index.FindPatternCandidates( each_filter->GetPattern(), filterItems );
+
+                if( !hint )
+                    break;
+
+                items.insert( items.end(), filterItems.begin(), filterItems.end() );
+            }
+
+            if( hint )
+            {
+                std::sort( items.begin(), items.end() );
+                items.erase( std::unique( items.begin(), items.end() ), items.end() );
+                restrictTo( items );
+            }
+        }
+
+        if( ( m_filter_type & FILTERING_BY_NAME ) && !m_filter_pattern.IsEmpty()
+                && index.FindPatternCandidates( m_filter.GetPattern(), items ) )
+            restrictTo( items );
+    }
+
+    if( !restricted )
+    {
+        candidates.resize( m_list->GetCount() );
+
+        for( size_t ii = 0; ii < candidates.size(); ++ii )
+            candidates[ii] = ii;
+    }
+
+    for( int ii : candidates )
+    {
+        if( itemMatches( m_list->GetItem( ii ) ) )
+            m_matches.push_back( ii );
+    }
 }
 
 
@@ -165,7 +228,8 @@ FOOTPRINT_FILTER::FOOTPRINT_FILTER( FOOTPRINT_LIST& aList ) : FOOTPRINT_FILTER()
 
 
 FOOTPRINT_FILTER::FOOTPRINT_FILTER()
-        : m_list( nullptr ), m_pin_count( -1 ), m_filter_type( UNFILTERED_FP_LIST )
+        : m_list( nullptr ), m_pin_count( -1 ), m_filter_type( UNFILTERED_FP_LIST ),
+          m_matches_valid( false )
 {
 }
 
@@ -173,12 +237,14 @@ FOOTPRINT_FILTER::FOOTPRINT_FILTER()
 void FOOTPRINT_FILTER::SetList( FOOTPRINT_LIST& aList )
 {
     m_list = &aList;
+    m_matches_valid = false;
 }
 
 
 void FOOTPRINT_FILTER::ClearFilters()
 {
     m_filter_type = UNFILTERED_FP_LIST;
+    m_matches_valid = false;
 }
 
 
@@ -186,6 +252,7 @@ void FOOTPRINT_FILTER::FilterByLibrary( wxString const& aLibName )
 {
     m_lib_name = aLibName;
     m_filter_type |= FILTERING_BY_LIBRARY;
+    m_matches_valid = false;
 }
 
 
@@ -193,6 +260,7 @@ void FOOTPRINT_FILTER::FilterByPinCount( int aPinCount )
 {
     m_pin_count = aPinCount;
     m_filter_type |= FILTERING_BY_PIN_COUNT;
+    m_matches_valid = false;
 }
 
 
@@ -207,6 +275,7 @@ void FOOTPRINT_FILTER::FilterByFootprintFilters( wxArrayString const& aFilters )
     }
 
     m_filter_type |= FILTERING_BY_COMPONENT_KEYWORD;
+    m_matches_valid = false;
 }
 
 
@@ -215,18 +284,25 @@ void FOOTPRINT_FILTER::FilterByPattern( wxString const& aPattern )
     m_filter_pattern = aPattern;
     m_filter.SetPattern( aPattern.Lower() );
     m_filter_type |= FILTERING_BY_NAME;
+    m_matches_valid = false;
 }
 
 
 FOOTPRINT_FILTER_IT FOOTPRINT_FILTER::begin()
 {
+    if( !m_matches_valid )
+        updateMatches();
+
     return FOOTPRINT_FILTER_IT( *this );
 }
 
 
 FOOTPRINT_FILTER_IT FOOTPRINT_FILTER::end()
 {
+    if( !m_matches_valid )
+        updateMatches();
+
     FOOTPRINT_FILTER_IT end_it( *this );
-    end_it.m_pos = m_list->GetCount();
+    end_it.m_pos = m_matches.size();
     return end_it;
 }
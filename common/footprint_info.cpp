@@ -80,6 +80,15 @@ bool FOOTPRINT_INFO::InLibrary( const wxString& aLibrary ) const
 }
 
 
+const FOOTPRINT_SEARCH_INDEX& FOOTPRINT_LIST::GetSearchIndex()
+{
+    if( !m_search_index.IsBuilt() )
+        m_search_index.Build( *this );
+
+    return m_search_index;
+}
+
+
 void FOOTPRINT_LIST::DisplayErrors( wxTopLevelWindow* aWindow )
 {
     // @todo: go to a more HTML !<table>! ? centric output, possibly with
@@ -0,0 +1,354 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <footprint_search_index.h>
+#include <footprint_info.h>
+#include <ki_exception.h>
+
+#include <wx/tokenzr.h>
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+
+
+// Shorter runs are contained in too many tokens to restrict the search
+static const size_t kMinRunLength = 2;
+
+// The longest n-grams indexed
+static const size_t kMaxNgramLength = 3;
+
+
+/**
+ * Pack the n-gram of \a aLength (2 or 3) characters of \a aText at \a aPos in 64 bits:
+ * 21 bits per character, enough for any code point, and a flag for the bigrams.
+ */
+static uint64_t ngramKey( const std::wstring& aText, size_t aPos, size_t aLength )
+{
+    uint64_t key = aLength == 2 ? ( uint64_t( 1 ) << 63 ) : 0;
+
+    for( size_t ii = 0; ii < aLength; ++ii )
+        key |= ( uint64_t( aText[aPos + ii] ) & 0x1FFFFF ) << ( 21 * ( aLength - 1 - ii ) );
+
+    return key;
+}
+
+
+static void intersect( std::vector<int>& aItems, const std::vector<int>& aOther )
+{
+    std::vector<int> intersection;
+
+    std::set_intersection( aItems.begin(), aItems.end(), aOther.begin(), aOther.end(),
+                           std::back_inserter( intersection ) );
+    aItems.swap( intersection );
+}
+
+
+FOOTPRINT_SEARCH_INDEX::FOOTPRINT_SEARCH_INDEX()
+    : m_list( nullptr )
+{
+}
+
+
+void FOOTPRINT_SEARCH_INDEX::Clear()
+{
+    m_list = nullptr;
+    m_tokens.clear();
+    m_tokenItems.clear();
+    m_ngramTokens.clear();
+    m_libraries.clear();
+    m_padCounts.clear();
+}
+
+
+void FOOTPRINT_SEARCH_INDEX::tokenize( const wxString& aText, std::vector<wxString>& aTokens )
+{
+    wxString token;
+
+    for( wxString::const_iterator it = aText.begin(); it != aText.end(); ++it )
+    {
+        if( wxIsalnum( *it ) )
+        {
+            token += *it;
+        }
+        else if( !token.IsEmpty() )
+        {
+            aTokens.push_back( token );
+            token.Empty();
+        }
+    }
+
+    if( !token.IsEmpty() )
+        aTokens.push_back( token );
+}
+
+
+void FOOTPRINT_SEARCH_INDEX::indexNgrams( const std::wstring& aToken, int aId )
+{
+    for( size_t length = kMinRunLength; length <= kMaxNgramLength; ++length )
+    {
+        for( size_t pos = 0; pos + length <= aToken.length(); ++pos )
+        {
+            // The tokens are indexed in increasing order, so the lists stay sorted
+            std::vector<int>& tokens = m_ngramTokens[ngramKey( aToken, pos, length )];
+
+            if( tokens.empty() || tokens.back() != aId )
+                tokens.push_back( aId );
+        }
+    }
+}
+
+
+void FOOTPRINT_SEARCH_INDEX::Build( FOOTPRINT_LIST& aList )
+{
+    Clear();
+
+    std::unordered_map<std::wstring, int> tokenIds;
+    std::vector<wxString> tokens;
+
+    for( unsigned ii = 0; ii < aList.GetCount(); ++ii )
+    {
+        FOOTPRINT_INFO& item = aList.GetItem( ii );
+
+        tokens.clear();
+        tokenize( item.GetNickname().Lower(), tokens );
+        tokenize( item.GetFootprintName().Lower(), tokens );
+
+        m_libraries[item.GetNickname()].push_back( ii );
+
+        try
+        {
+            tokenize( item.GetKeywords().Lower(), tokens );
+            tokenize( item.GetDoc().Lower(), tokens );
+
+            m_padCounts[item.GetUniquePadCount()].push_back( ii );
+        }
+        catch( const IO_ERROR& )
+        {
+            // The item is indexed by name only, as it cannot be matched by anything else
+        }
+
+        for( const wxString& token : tokens )
+        {
+            std::wstring text = token.ToStdWstring();
+            auto         found = tokenIds.find( text );
+            int          id;
+
+            if( found == tokenIds.end() )
+            {
+                id = (int) m_tokens.size();
+                tokenIds[text] = id;
+                m_tokens.push_back( token );
+                m_tokenItems.emplace_back();
+                indexNgrams( text, id );
+            }
+            else
+            {
+                id = found->second;
+            }
+
+            // The items are indexed in increasing order, so the lists stay sorted
+            std::vector<int>& items = m_tokenItems[id];
+
+            if( items.empty() || items.back() != (int) ii )
+                items.push_back( ii );
+        }
+    }
+
+    m_list = &aList;
+}
+
+
+const std::vector<int>& FOOTPRINT_SEARCH_INDEX::GetLibraryItems( const wxString& aNickname ) const
+{
+    static const std::vector<int> empty;
+
+    auto found = m_libraries.find( aNickname );
+
+    return found == m_libraries.end() ? empty : found->second;
+}
+
+
+const std::vector<int>& FOOTPRINT_SEARCH_INDEX::GetPadCountItems( unsigned aPadCount ) const
+{
+    static const std::vector<int> empty;
+
+    auto found = m_padCounts.find( aPadCount );
+
+    return found == m_padCounts.end() ? empty : found->second;
+}
+
+
+bool FOOTPRINT_SEARCH_INDEX::findRun( const wxString& aRun, std::vector<int>& aItems ) const
+{
+    aItems.clear();
+
+    if( aRun.length() < kMinRunLength )
+        return false;
+
+    // A token containing the run contains all its n-grams: intersect their lists of
+    // tokens, the shortest ones first
+    std::wstring run = aRun.ToStdWstring();
+    size_t       length = std::min( run.length(), kMaxNgramLength );
+
+    std::vector<const std::vector<int>*> ngramTokens;
+
+    for( size_t pos = 0; pos + length <= run.length(); ++pos )
+    {
+        auto found = m_ngramTokens.find( ngramKey( run, pos, length ) );
+
+        if( found == m_ngramTokens.end() )
+            return true;
+
+        ngramTokens.push_back( &found->second );
+    }
+
+    std::sort( ngramTokens.begin(), ngramTokens.end(),
+            []( const std::vector<int>* a, const std::vector<int>* b )
+            {
+                return a->size() < b->size();
+            } );
+
+    std::vector<int> tokens = *ngramTokens[0];
+
+    for( size_t ii = 1; ii < ngramTokens.size() && !tokens.empty(); ++ii )
+        intersect( tokens, *ngramTokens[ii] );
+
+    for( int id : tokens )
+    {
+        // A token can contain all the n-grams of a longer run, but not the run itself
+        if( run.length() > length && m_tokens[id].Find( aRun ) == wxNOT_FOUND )
+            continue;
+
+        aItems.insert( aItems.end(), m_tokenItems[id].begin(), m_tokenItems[id].end() );
+    }
+
+    std::sort( aItems.begin(), aItems.end() );
+    aItems.erase( std::unique( aItems.begin(), aItems.end() ), aItems.end() );
+
+    return true;
+}
+
+
+bool FOOTPRINT_SEARCH_INDEX::findRuns( const wxString& aText, std::vector<int>& aItems ) const
+{
+    std::vector<wxString> runs;
+    std::vector<int>      runItems;
+    bool                  restricted = false;
+
+    // A text containing a run of letters and digits contains a token containing this run
+    tokenize( aText, runs );
+
+    aItems.clear();
+
+    for( const wxString& run : runs )
+    {
+        if( !findRun( run, runItems ) )
+            continue;
+
+        if( restricted )
+        {
+            intersect( aItems, runItems );
+        }
+        else
+        {
+            aItems.swap( runItems );
+            restricted = true;
+        }
+
+        if( aItems.empty() )
+            break;
+    }
+
+    return restricted;
+}
+
+
+bool FOOTPRINT_SEARCH_INDEX::FindPatternCandidates( const wxString& aPattern,
+                                                    std::vector<int>& aCandidates ) const
+{
+    wxCHECK_MSG( IsBuilt(), false, "Search index not built" );
+
+    // The wildcards are not letters or digits, so they split the pattern in runs
+    // which must be found as is in the matching names
+    return findRuns( aPattern, aCandidates );
+}
+
+
+void FOOTPRINT_SEARCH_INDEX::Search( const wxString& aText, std::vector<int>& aItems ) const
+{
+    std::vector<wxString> terms;
+    wxStringTokenizer     tokenizer( aText.Lower() );
+
+    aItems.clear();
+
+    wxCHECK_RET( IsBuilt(), "Search index not built" );
+
+    while( tokenizer.HasMoreTokens() )
+        terms.push_back( tokenizer.GetNextToken() );
+
+    std::vector<int> candidates;
+    std::vector<int> termCandidates;
+    bool             restricted = false;
+
+    for( const wxString& term : terms )
+    {
+        if( !findRuns( term, termCandidates ) )
+            continue;
+
+        if( restricted )
+        {
+            intersect( candidates, termCandidates );
+        }
+        else
+        {
+            candidates.swap( termCandidates );
+            restricted = true;
+        }
+    }
+
+    if( !restricted )
+    {
+        candidates.resize( m_list->GetCount() );
+
+        for( size_t ii = 0; ii < candidates.size(); ++ii )
+            candidates[ii] = ii;
+    }
+
+    for( int ii : candidates )
+    {
+        FOOTPRINT_INFO& item = m_list->GetItem( ii );
+        wxString        text = item.GetNickname() + wxT( ":" ) + item.GetFootprintName();
+
+        try
+        {
+            text += wxT( "\n" ) + item.GetKeywords() + wxT( "\n" ) + item.GetDoc();
+        }
+        catch( const IO_ERROR& )
+        {
+        }
+
+        text.MakeLower();
+
+        bool found = std::all_of( terms.begin(), terms.end(),
+                [&text]( const wxString& term ) { return text.Find( term ) != wxNOT_FOUND; } );
+
+        if( found )
+            aItems.push_back( ii );
+    }
+}
@@ -22,6 +22,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
+
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_circle.h>
 
@@ -368,45 +370,85 @@ bool SHAPE_LINE_CHAIN::PointOnEdge( const VECTOR2I& aP ) const
 
 const optional<SHAPE_LINE_CHAIN::INTERSECTION> SHAPE_LINE_CHAIN::SelfIntersecting() const
 {
-    for( int s1 = 0; s1 < SegmentCount(); s1++ )
+    int segCount = SegmentCount();
+
+    // Only the segments whose bounding boxes overlap can touch each other: find these
+    // pairs by sweeping the boxes sorted by their left side.  The boxes are inflated by
+    // the tolerance of SEG::Contains().
+    std::vector<BOX2I> bboxes( segCount );
+    std::vector<int> order( segCount );
+
+    for( int s = 0; s < segCount; s++ )
+    {
+        const SEG seg = CSegment( s );
+
+        bboxes[s] = BOX2I( seg.A, seg.B - seg.A );
+        bboxes[s].Normalize();
+        bboxes[s].Inflate( 1 );
+        order[s] = s;
+    }
+
+    std::sort( order.begin(), order.end(), [&bboxes] ( int a, int b ) {
+        return bboxes[a].GetX() < bboxes[b].GetX();
+    } );
+
+    std::vector<std::pair<int, int> > candidates;
+
+    for( int i = 0; i < segCount; i++ )
     {
-        for( int s2 = s1 + 1; s2 < SegmentCount(); s2++ )
+        const BOX2I& bbox = bboxes[order[i]];
+
+        for( int j = i + 1; j < segCount && bboxes[order[j]].GetX() <= bbox.GetRight(); j++ )
         {
-            const VECTOR2I s2a = CSegment( s2 ).A, s2b = CSegment( s2 ).B;
+            const BOX2I& other = bboxes[order[j]];
 
-            if( s1 + 1 != s2 && CSegment( s1 ).Contains( s2a ) )
-            {
-                INTERSECTION is;
-                is.our = CSegment( s1 );
-                is.their = CSegment( s2 );
-                is.p = s2a;
-                return is;
-            }
-            else if( CSegment( s1 ).Contains( s2b ) &&
-                     // for closed polylines, the ending point of the
-                     // last segment == starting point of the first segment
-                     // this is a normal case, not self intersecting case
-                     !( IsClosed() && s1 == 0 && s2 == SegmentCount()-1 ) )
+            if( other.GetY() <= bbox.GetBottom() && bbox.GetY() <= other.GetBottom() )
+                candidates.push_back( std::make_pair( std::min( order[i], order[j] ),
+                                                      std::max( order[i], order[j] ) ) );
+        }
+    }
+
+    // Test the pairs in the order of the segments, so the first intersection is reported
+    std::sort( candidates.begin(), candidates.end() );
+
+    for( const std::pair<int, int>& candidate : candidates )
+    {
+        int s1 = candidate.first;
+        int s2 = candidate.second;
+        const VECTOR2I s2a = CSegment( s2 ).A, s2b = CSegment( s2 ).B;
+
+        if( s1 + 1 != s2 && CSegment( s1 ).Contains( s2a ) )
+        {
+            INTERSECTION is;
+            is.our = CSegment( s1 );
+            is.their = CSegment( s2 );
+            is.p = s2a;
+            return is;
+        }
+        else if( CSegment( s1 ).Contains( s2b ) &&
+                 // for closed polylines, the ending point of the
+                 // last segment == starting point of the first segment
+                 // this is a normal case, not self intersecting case
+                 !( IsClosed() && s1 == 0 && s2 == segCount - 1 ) )
+        {
+            INTERSECTION is;
+            is.our = CSegment( s1 );
+            is.their = CSegment( s2 );
+            is.p = s2b;
+            return is;
+        }
+        else
+        {
+            OPT_VECTOR2I p = CSegment( s1 ).Intersect( CSegment( s2 ), true );
+
+            if( p )
             {
                 INTERSECTION is;
                 is.our = CSegment( s1 );
                 is.their = CSegment( s2 );
-                is.p = s2b;
+                is.p = *p;
                 return is;
             }
-            else
-            {
-                OPT_VECTOR2I p = CSegment( s1 ).Intersect( CSegment( s2 ), true );
-
-                if( p )
-                {
-                    INTERSECTION is;
-                    is.our = CSegment( s1 );
-                    is.their = CSegment( s2 );
-                    is.p = *p;
-                    return is;
-                }
-            }
         }
     }
 
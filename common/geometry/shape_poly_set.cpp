@@ -31,16 +31,182 @@
 #include <cstdio>
 #include <set>
 #include <list>
+#include <map>
 #include <algorithm>
+#include <climits>
+#include <cmath>
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif /* USE_OPENMP */
 
 #include <common.h>
 
 #include <geometry/shape.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
+#include <geometry/rtree.h>
 
 using namespace ClipperLib;
 
+/**
+ * Class SHAPE_POLY_SET::EDGE_INDEX
+ *
+ * An R-tree of the bounding boxes of the edges of a polygon set.  The edges are stored by
+ * their polygon, contour and first vertex, not by their coordinates, so the index stays valid
+ * for the copies of the set, and for the translated set with an offset.  The contours are
+ * indexed as closed, like pointInPolygon() walks them.
+ */
+class SHAPE_POLY_SET::EDGE_INDEX
+{
+public:
+    struct EDGE
+    {
+        int m_polygon;
+        int m_contour;
+        int m_vertex;
+    };
+
+    EDGE_INDEX( const Polyset& aPolys )
+    {
+        for( int polygonIdx = 0; polygonIdx < (int) aPolys.size(); polygonIdx++ )
+        {
+            const POLYGON& polygon = aPolys[polygonIdx];
+
+            for( int contourIdx = 0; contourIdx < (int) polygon.size(); contourIdx++ )
+            {
+                const SHAPE_LINE_CHAIN& contour = polygon[contourIdx];
+
+                for( int vertexIdx = 0; vertexIdx < contour.PointCount(); vertexIdx++ )
+                    m_edges.push_back( { polygonIdx, contourIdx, vertexIdx } );
+            }
+        }
+
+        // The tree stores pointers to the edges: the vector is complete
+        for( const EDGE& edge : m_edges )
+        {
+            const SHAPE_LINE_CHAIN& contour = aPolys[edge.m_polygon][edge.m_contour];
+            const VECTOR2I& a = contour.CPoint( edge.m_vertex );
+            const VECTOR2I& b = contour.CPoint( nextVertex( contour, edge.m_vertex ) );
+
+            int min[2] = { std::min( a.x, b.x ), std::min( a.y, b.y ) };
+            int max[2] = { std::max( a.x, b.x ), std::max( a.y, b.y ) };
+
+            m_tree.Insert( min, max, &edge );
+
+            if( &edge == &m_edges.front() )
+                m_bbox = BOX2I( a, VECTOR2I( 0, 0 ) );
+
+            m_bbox.Merge( a );
+        }
+    }
+
+    static int nextVertex( const SHAPE_LINE_CHAIN& aContour, int aVertex )
+    {
+        return aVertex + 1 < aContour.PointCount() ? aVertex + 1 : 0;
+    }
+
+    ///> The bounding box of all the edges
+    const BOX2I& BBox() const
+    {
+        return m_bbox;
+    }
+
+    int EdgeCount() const
+    {
+        return m_edges.size();
+    }
+
+    /**
+     * Function Query
+     * calls aVisitor( const EDGE& ) for the edges whose bounding box overlaps the given box,
+     * in the coordinates of the polygons when the index was built.
+     */
+    template <class VISITOR>
+    void Query( int64_t aMinX, int64_t aMinY, int64_t aMaxX, int64_t aMaxY,
+                VISITOR& aVisitor ) const
+    {
+        int min[2] = { clamp( aMinX ), clamp( aMinY ) };
+        int max[2] = { clamp( aMaxX ), clamp( aMaxY ) };
+
+        auto visit = [&]( const EDGE* aEdge ) -> bool
+        {
+            aVisitor( *aEdge );
+            return true;
+        };
+
+        m_tree.Search( min, max, visit );
+    }
+
+private:
+    static int clamp( int64_t aValue )
+    {
+        return (int) std::max<int64_t>( INT_MIN, std::min<int64_t>( INT_MAX, aValue ) );
+    }
+
+    std::vector<EDGE> m_edges;
+    BOX2I m_bbox;
+
+    // Search() does not modify the tree, but is not const
+    mutable RTree<const EDGE*, int, 2, double> m_tree;
+};
+
+
+/**
+ * Function edgeCrossing
+ * is the test made by pointInPolygon() for the edge aPrev-aNext of a contour.
+ * @return -1 if aP lies on the edge or on aNext, 1 if the edge crosses the horizontal ray
+ *         starting from aP towards the positive x, 0 otherwise.
+ */
+static int edgeCrossing( const VECTOR2I& aP, const VECTOR2I& aPrev, const VECTOR2I& aNext )
+{
+    if( aNext.y == aP.y )
+    {
+        if( ( aNext.x == aP.x ) || ( aPrev.y == aP.y &&
+            ( ( aNext.x > aP.x ) == ( aPrev.x < aP.x ) ) ) )
+            return -1;
+    }
+
+    if( ( aPrev.y < aP.y ) != ( aNext.y < aP.y ) )
+    {
+        if( aPrev.x >= aP.x && aNext.x > aP.x )
+            return 1;
+
+        if( aPrev.x >= aP.x || aNext.x > aP.x )
+        {
+            int64_t d = (int64_t)( aPrev.x - aP.x ) * (int64_t)( aNext.y - aP.y ) -
+                        (int64_t)( aNext.x - aP.x ) * (int64_t)( aPrev.y - aP.y );
+
+            if( !d )
+                return -1;
+
+            if( ( d > 0 ) == ( aNext.y > aPrev.y ) )
+                return 1;
+        }
+    }
+
+    return 0;
+}
+
+
+/**
+ * Function edgeContains
+ * is the test made by SHAPE_LINE_CHAIN::PointOnEdge() for the aVertex-th edge of aContour.
+ */
+static bool edgeContains( const SHAPE_LINE_CHAIN& aContour, int aVertex, const VECTOR2I& aP )
+{
+    if( aContour.PointCount() == 1 )
+        return aContour.CPoint( 0 ) == aP;
+
+    // The closing edge is not a segment of an open line chain
+    if( aVertex >= aContour.SegmentCount() )
+        return false;
+
+    const SEG s = aContour.CSegment( aVertex );
+
+    return s.A == aP || s.B == aP || s.Distance( aP ) <= 1;
+}
+
 SHAPE_POLY_SET::SHAPE_POLY_SET() :
     SHAPE( SH_POLY_SET )
 {
@@ -48,7 +214,9 @@ SHAPE_POLY_SET::SHAPE_POLY_SET() :
 
 
 SHAPE_POLY_SET::SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther ) :
-    SHAPE( SH_POLY_SET ), m_polys( aOther.m_polys )
+    SHAPE( SH_POLY_SET ), m_polys( aOther.m_polys ),
+    m_edgeIndex( aOther.m_edgeIndex ),
+    m_edgeIndexOffset( aOther.m_edgeIndexOffset )
 {
 }
 
@@ -121,7 +289,7 @@ bool SHAPE_POLY_SET::GetGlobalIndex( SHAPE_POLY_SET::VERTEX_INDEX aRelativeIndic
 
         for( unsigned int polygonIdx = 0; polygonIdx < selectedPolygon; polygonIdx++ )
         {
-            currentPolygon = Polygon( polygonIdx );
+            currentPolygon = CPolygon( polygonIdx );
 
             for( unsigned int contourIdx = 0; contourIdx < currentPolygon.size(); contourIdx++ )
             {
@@ -129,7 +297,7 @@ bool SHAPE_POLY_SET::GetGlobalIndex( SHAPE_POLY_SET::VERTEX_INDEX aRelativeIndic
             }
         }
 
-        currentPolygon = Polygon( selectedPolygon );
+        currentPolygon = CPolygon( selectedPolygon );
 
         for( unsigned int contourIdx = 0; contourIdx < selectedContour; contourIdx ++ )
         {
@@ -149,6 +317,8 @@ bool SHAPE_POLY_SET::GetGlobalIndex( SHAPE_POLY_SET::VERTEX_INDEX aRelativeIndic
 
 int SHAPE_POLY_SET::NewOutline()
 {
+    invalidateIndex();
+
     SHAPE_LINE_CHAIN empty_path;
     POLYGON poly;
     empty_path.SetClosed( true );
@@ -160,6 +330,8 @@ int SHAPE_POLY_SET::NewOutline()
 
 int SHAPE_POLY_SET::NewHole( int aOutline )
 {
+    invalidateIndex();
+
     SHAPE_LINE_CHAIN empty_path;
     empty_path.SetClosed( true );
 
@@ -176,6 +348,8 @@ int SHAPE_POLY_SET::NewHole( int aOutline )
 
 int SHAPE_POLY_SET::Append( int x, int y, int aOutline, int aHole, bool aAllowDuplication )
 {
+    invalidateIndex();
+
     if( aOutline < 0 )
         aOutline += m_polys.size();
 
@@ -199,6 +373,8 @@ void SHAPE_POLY_SET::InsertVertex( int aGlobalIndex, VECTOR2I aNewVertex )
 {
     VERTEX_INDEX index;
 
+    invalidateIndex();
+
     if( aGlobalIndex < 0 )
         aGlobalIndex = 0;
 
@@ -245,7 +421,7 @@ SHAPE_POLY_SET SHAPE_POLY_SET::Subset( int aFirstPolygon, int aLastPolygon )
 
     for( int index = aFirstPolygon; index < aLastPolygon; index++ )
     {
-        newPolySet.m_polys.push_back( Polygon( index ) );
+        newPolySet.m_polys.push_back( CPolygon( index ) );
     }
 
     return newPolySet;
@@ -254,6 +430,8 @@ SHAPE_POLY_SET SHAPE_POLY_SET::Subset( int aFirstPolygon, int aLastPolygon )
 
 VECTOR2I& SHAPE_POLY_SET::Vertex( int aIndex, int aOutline, int aHole )
 {
+    invalidateIndex();
+
     if( aOutline < 0 )
         aOutline += m_polys.size();
 
@@ -294,6 +472,8 @@ VECTOR2I& SHAPE_POLY_SET::Vertex( int aGlobalIndex )
 {
     SHAPE_POLY_SET::VERTEX_INDEX index;
 
+    invalidateIndex();
+
     // Assure the passed index references a legal position; abort otherwise
     if( !GetRelativeIndices( aGlobalIndex, &index ) )
         throw( std::out_of_range( "aGlobalIndex-th vertex does not exist" ) );
@@ -418,6 +598,8 @@ int SHAPE_POLY_SET::AddOutline( const SHAPE_LINE_CHAIN& aOutline )
 {
     assert( aOutline.IsClosed() );
 
+    invalidateIndex();
+
     POLYGON poly;
 
     poly.push_back( aOutline );
@@ -432,6 +614,8 @@ int SHAPE_POLY_SET::AddHole( const SHAPE_LINE_CHAIN& aHole, int aOutline )
 {
     assert ( m_polys.size() );
 
+    invalidateIndex();
+
     if( aOutline < 0 )
         aOutline += m_polys.size();
 
@@ -478,28 +662,7 @@ const SHAPE_LINE_CHAIN SHAPE_POLY_SET::convertFromClipper( const Path& aPath )
 void SHAPE_POLY_SET::booleanOp( ClipType aType, const SHAPE_POLY_SET& aOtherShape,
                                 POLYGON_MODE aFastMode )
 {
-    Clipper c;
-
-    if( aFastMode == PM_STRICTLY_SIMPLE )
-        c.StrictlySimple( true );
-
-    for( const POLYGON& poly : m_polys )
-    {
-        for( unsigned int i = 0; i < poly.size(); i++ )
-            c.AddPath( convertToClipper( poly[i], i > 0 ? false : true ), ptSubject, true );
-    }
-
-    for( const POLYGON& poly : aOtherShape.m_polys )
-    {
-        for( unsigned int i = 0; i < poly.size(); i++ )
-            c.AddPath( convertToClipper( poly[i], i > 0 ? false : true ), ptClip, true );
-    }
-
-    PolyTree solution;
-
-    c.Execute( aType, solution, pftNonZero, pftNonZero );
-
-    importTree( &solution );
+    booleanOp( aType, *this, aOtherShape, aFastMode );
 }
 
 
@@ -508,6 +671,21 @@ void SHAPE_POLY_SET::booleanOp( ClipperLib::ClipType aType,
                                 const SHAPE_POLY_SET& aOtherShape,
                                 POLYGON_MODE aFastMode )
 {
+    TILE_OP op = [aType, aFastMode]( const Paths& aSubject, const Paths& aClip, Paths& aResult )
+    {
+        Clipper c;
+
+        if( aFastMode == PM_STRICTLY_SIMPLE )
+            c.StrictlySimple( true );
+
+        c.AddPaths( aSubject, ptSubject, true );
+        c.AddPaths( aClip, ptClip, true );
+        c.Execute( aType, aResult, pftNonZero, pftNonZero );
+    };
+
+    if( tiledOp( aShape, aOtherShape, 0, aFastMode, op ) )
+        return;
+
     Clipper c;
 
     if( aFastMode == PM_STRICTLY_SIMPLE )
@@ -577,16 +755,6 @@ void SHAPE_POLY_SET::Inflate( int aFactor, int aCircleSegmentsCount )
     #define SEG_CNT_MAX 64
     static double arc_tolerance_factor[SEG_CNT_MAX+1];
 
-    ClipperOffset c;
-
-    for( const POLYGON& poly : m_polys )
-    {
-        for( unsigned int i = 0; i < poly.size(); i++ )
-            c.AddPath( convertToClipper( poly[i], i > 0 ? false : true ), jtRound, etClosedPolygon );
-    }
-
-    PolyTree solution;
-
     // Calculate the arc tolerance (arc error) from the seg count by circle.
     // the seg count is nn = M_PI / acos(1.0 - c.ArcTolerance / abs(aFactor))
     // see:
@@ -607,7 +775,33 @@ void SHAPE_POLY_SET::Inflate( int aFactor, int aCircleSegmentsCount )
     else
         coeff = arc_tolerance_factor[aCircleSegmentsCount];
 
-    c.ArcTolerance = std::abs( aFactor ) * coeff;
+    double arcTolerance = std::abs( aFactor ) * coeff;
+
+    TILE_OP op = [aFactor, arcTolerance]( const Paths& aSubject, const Paths& aClip,
+                                          Paths& aResult )
+    {
+        ClipperOffset c;
+
+        c.ArcTolerance = arcTolerance;
+        c.AddPaths( aSubject, jtRound, etClosedPolygon );
+        c.Execute( aResult, aFactor );
+    };
+
+    // The arcs vertices are rounded to the nearest integer, keep a small margin
+    if( tiledOp( *this, SHAPE_POLY_SET(), std::abs( aFactor ) + 2, PM_FAST, op ) )
+        return;
+
+    ClipperOffset c;
+
+    for( const POLYGON& poly : m_polys )
+    {
+        for( unsigned int i = 0; i < poly.size(); i++ )
+            c.AddPath( convertToClipper( poly[i], i > 0 ? false : true ), jtRound, etClosedPolygon );
+    }
+
+    PolyTree solution;
+
+    c.ArcTolerance = arcTolerance;
 
     c.Execute( solution, aFactor );
 
@@ -615,8 +809,284 @@ void SHAPE_POLY_SET::Inflate( int aFactor, int aCircleSegmentsCount )
 }
 
 
+// Tiled operations are disabled by default, see SetTiledOperations()
+static bool s_tiledOperations = false;
+
+// The polygon sets having fewer vertices are not worth splitting in strips
+static const int TILED_OP_MIN_VERTICES = 16384;
+
+
+void SHAPE_POLY_SET::SetTiledOperations( bool aEnable )
+{
+    s_tiledOperations = aEnable;
+}
+
+
+/**
+ * Function touchesSeam
+ * @return true if a vertex of aContour lies on the vertical line x = aLeft or x = aRight.
+ */
+static bool touchesSeam( const SHAPE_LINE_CHAIN& aContour, int aLeft, int aRight )
+{
+    for( int i = 0; i < aContour.PointCount(); i++ )
+    {
+        int x = aContour.CPoint( i ).x;
+
+        if( x == aLeft || x == aRight )
+            return true;
+    }
+
+    return false;
+}
+
+
+bool SHAPE_POLY_SET::tiledOp( const SHAPE_POLY_SET& aShape, const SHAPE_POLY_SET& aOtherShape,
+                              int aMargin, POLYGON_MODE aFastMode, const TILE_OP& aOp )
+{
+#ifdef USE_OPENMP
+    // When called from a parallel region (e.g. the zones filled in parallel), the threads
+    // are already busy: a nested team would only add its overhead
+    int maxTiles = omp_in_parallel() ? 1 : omp_get_max_threads();
+#else
+    int maxTiles = 1;
+#endif
+
+    if( !s_tiledOperations || maxTiles < 2
+            || aShape.TotalVertices() + aOtherShape.TotalVertices() < TILED_OP_MIN_VERTICES )
+        return false;
+
+    // The contours of both sets, with their bounding box grown by the margin
+    struct CONTOUR
+    {
+        const SHAPE_LINE_CHAIN* m_chain;
+        bool  m_outline;
+        bool  m_subject;
+        BOX2I m_bbox;
+    };
+
+    std::vector<CONTOUR> contours;
+    std::vector<int> xs;
+    BOX2I bbox;
+
+    for( const SHAPE_POLY_SET* set : { &aShape, &aOtherShape } )
+    {
+        for( const POLYGON& poly : set->m_polys )
+        {
+            for( unsigned int i = 0; i < poly.size(); i++ )
+            {
+                if( poly[i].PointCount() == 0 )
+                    continue;
+
+                CONTOUR contour = { &poly[i], i == 0, set == &aShape, poly[i].BBox( aMargin ) };
+
+                if( contours.empty() )
+                    bbox = contour.m_bbox;
+                else
+                    bbox.Merge( contour.m_bbox );
+
+                contours.push_back( contour );
+
+                for( int v = 0; v < poly[i].PointCount(); v++ )
+                    xs.push_back( poly[i].CPoint( v ).x );
+            }
+        }
+    }
+
+    // Choose the seams between the strips to split the vertices in equal parts
+    std::vector<int> seams;
+    std::vector<int>::iterator first = xs.begin();
+
+    for( int i = 1; i < maxTiles; i++ )
+    {
+        std::vector<int>::iterator nth = xs.begin() + xs.size() * i / maxTiles;
+
+        std::nth_element( first, nth, xs.end() );
+        first = nth;
+
+        if( *nth > bbox.GetLeft() && *nth < bbox.GetRight()
+                && ( seams.empty() || *nth > seams.back() ) )
+            seams.push_back( *nth );
+    }
+
+    if( seams.empty() )
+        return false;
+
+    // The result in a strip: the pieces away from the seams are complete polygons, the
+    // others must be merged with the pieces of the neighbor strips.  The holes of these
+    // pieces which do not touch the seams are not merged, but put back in the merged
+    // polygons.
+    struct TILE
+    {
+        Polyset m_polys;
+        Paths   m_seamContours;
+        std::vector<SHAPE_LINE_CHAIN> m_holes;
+    };
+
+    int tileCount = seams.size() + 1;
+    std::vector<TILE> tiles( tileCount );
+
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for( int k = 0; k < tileCount; k++ )
+    {
+        int left = ( k == 0 ) ? bbox.GetLeft() - 1 : seams[k - 1];
+        int right = ( k == tileCount - 1 ) ? bbox.GetRight() + 1 : seams[k];
+
+        Paths subject, clip;
+
+        for( const CONTOUR& contour : contours )
+        {
+            if( contour.m_bbox.GetRight() < left || contour.m_bbox.GetLeft() > right )
+                continue;
+
+            Path path = convertToClipper( *contour.m_chain, contour.m_outline );
+
+            if( contour.m_subject )
+                subject.push_back( path );
+            else
+                clip.push_back( path );
+        }
+
+        Paths result;
+        aOp( subject, clip, result );
+
+        Path strip;
+        strip.push_back( IntPoint( left, bbox.GetTop() - 1 ) );
+        strip.push_back( IntPoint( right, bbox.GetTop() - 1 ) );
+        strip.push_back( IntPoint( right, bbox.GetBottom() + 1 ) );
+        strip.push_back( IntPoint( left, bbox.GetBottom() + 1 ) );
+
+        Clipper c;
+
+        if( aFastMode == PM_STRICTLY_SIMPLE )
+            c.StrictlySimple( true );
+
+        c.AddPaths( result, ptSubject, true );
+        c.AddPath( strip, ptClip, true );
+
+        PolyTree solution;
+
+        c.Execute( ctIntersection, solution, pftNonZero, pftNonZero );
+
+        TILE& tile = tiles[k];
+
+        for( PolyNode* n = solution.GetFirst(); n; n = n->GetNext() )
+        {
+            if( n->IsHole() )
+                continue;
+
+            POLYGON piece;
+            piece.reserve( n->Childs.size() + 1 );
+            piece.push_back( convertFromClipper( n->Contour ) );
+
+            if( !touchesSeam( piece[0], left, right ) )
+            {
+                for( unsigned int i = 0; i < n->Childs.size(); i++ )
+                    piece.push_back( convertFromClipper( n->Childs[i]->Contour ) );
+
+                tile.m_polys.push_back( piece );
+                continue;
+            }
+
+            tile.m_seamContours.push_back( n->Contour );
+
+            for( unsigned int i = 0; i < n->Childs.size(); i++ )
+            {
+                SHAPE_LINE_CHAIN hole = convertFromClipper( n->Childs[i]->Contour );
+
+                if( touchesSeam( hole, left, right ) )
+                    tile.m_seamContours.push_back( n->Childs[i]->Contour );
+                else
+                    tile.m_holes.push_back( hole );
+            }
+        }
+    }
+
+    Polyset polys;
+    Clipper c;
+
+    for( TILE& tile : tiles )
+    {
+        polys.insert( polys.end(), tile.m_polys.begin(), tile.m_polys.end() );
+        c.AddPaths( tile.m_seamContours, ptSubject, true );
+    }
+
+    PolyTree solution;
+    SHAPE_POLY_SET merged;
+
+    c.Execute( ctUnion, solution, pftNonZero, pftNonZero );
+
+    // Clipper is very slow to make strictly simple polygons from the pieces sharing the
+    // seam edges, but not from their union
+    if( aFastMode == PM_STRICTLY_SIMPLE )
+    {
+        Paths paths;
+        PolyTreeToPaths( solution, paths );
+
+        Clipper simplifier;
+        simplifier.StrictlySimple( true );
+        simplifier.AddPaths( paths, ptSubject, true );
+        simplifier.Execute( ctUnion, solution, pftNonZero, pftNonZero );
+    }
+
+    merged.importTree( &solution );
+    merged.BuildIndex();
+
+    std::vector<BOX2I> mergedBBoxes;
+
+    for( const POLYGON& poly : merged.m_polys )
+        mergedBBoxes.push_back( poly[0].BBox() );
+
+    // Put the holes back in the merged polygon containing them.  A vertex on the edges
+    // of the merged polygons, where holes touch outlines, does not tell which one.
+    std::vector<std::pair<int, const SHAPE_LINE_CHAIN*> > holes;
+
+    for( const TILE& tile : tiles )
+    {
+        for( const SHAPE_LINE_CHAIN& hole : tile.m_holes )
+        {
+            int target = -1;
+
+            for( int v = 0; v < hole.PointCount() && target < 0; v++ )
+            {
+                const VECTOR2I& p = hole.CPoint( v );
+
+                if( merged.PointOnEdge( p ) )
+                    continue;
+
+                for( unsigned int i = 0; i < merged.m_polys.size() && target < 0; i++ )
+                {
+                    if( mergedBBoxes[i].Contains( p ) && merged.containsSingle( p, i ) )
+                        target = i;
+                }
+
+                break;
+            }
+
+            // Not expected, but the operation can still be done without the strips
+            if( target < 0 )
+                return false;
+
+            holes.push_back( std::make_pair( target, &hole ) );
+        }
+    }
+
+    for( const std::pair<int, const SHAPE_LINE_CHAIN*>& hole : holes )
+        merged.m_polys[hole.first].push_back( *hole.second );
+
+    polys.insert( polys.end(), merged.m_polys.begin(), merged.m_polys.end() );
+
+    invalidateIndex();
+    m_polys.swap( polys );
+
+    return true;
+}
+
+
 void SHAPE_POLY_SET::importTree( PolyTree* tree )
 {
+    invalidateIndex();
     m_polys.clear();
 
     for( PolyNode* n = tree->GetFirst(); n; n = n->GetNext() )
@@ -641,7 +1111,8 @@ struct FractureEdge
 {
     FractureEdge( bool connected, SHAPE_LINE_CHAIN* owner, int index ) :
         m_connected( connected ),
-        m_next( NULL )
+        m_next( NULL ),
+        m_id( 0 )
     {
         m_p1 = owner->CPoint( index );
         m_p2 = owner->CPoint( index + 1 );
@@ -649,7 +1120,8 @@ struct FractureEdge
 
     FractureEdge( int y = 0 ) :
         m_connected( false ),
-        m_next( NULL )
+        m_next( NULL ),
+        m_id( 0 )
     {
         m_p1.x = m_p2.y = y;
     }
@@ -658,7 +1130,8 @@ struct FractureEdge
         m_connected( connected ),
         m_p1( p1 ),
         m_p2( p2 ),
-        m_next( NULL )
+        m_next( NULL ),
+        m_id( 0 )
     {
     }
 
@@ -673,13 +1146,35 @@ struct FractureEdge
     bool m_connected;
     VECTOR2I m_p1, m_p2;
     FractureEdge* m_next;
+
+    ///> Creation order of the edge, which breaks the ties between the nearest edges
+    int m_id;
 };
 
 
 typedef std::vector<FractureEdge*> FractureEdgeSet;
 
+///> The connected edges, by their bounding box
+typedef RTree<FractureEdge*, int, 2, double> FractureEdgeTree;
+
 
-static int processEdge( FractureEdgeSet& edges, FractureEdge* edge )
+static void addEdge( FractureEdgeSet& edges, FractureEdge* edge )
+{
+    edge->m_id = edges.size();
+    edges.push_back( edge );
+}
+
+
+static void indexEdge( FractureEdgeTree& tree, FractureEdge* edge )
+{
+    int min[2] = { std::min( edge->m_p1.x, edge->m_p2.x ), std::min( edge->m_p1.y, edge->m_p2.y ) };
+    int max[2] = { std::max( edge->m_p1.x, edge->m_p2.x ), std::max( edge->m_p1.y, edge->m_p2.y ) };
+
+    tree.Insert( min, max, edge );
+}
+
+
+static int processEdge( FractureEdgeSet& edges, FractureEdgeTree& tree, FractureEdge* edge )
 {
     int x = edge->m_p1.x;
     int y = edge->m_p1.y;
@@ -688,39 +1183,50 @@ static int processEdge( FractureEdgeSet& edges, FractureEdge* edge )
 
     FractureEdge* e_nearest = NULL;
 
-    for( FractureEdgeSet::iterator i = edges.begin(); i != edges.end(); ++i )
+    // Look for the nearest connected edge on the left of edge, among the edges crossing
+    // the horizontal line y.  The edges shortened when splitting them keep their initial
+    // bounding box in the tree, and are checked again here.
+    int min[2] = { std::numeric_limits<int>::min(), y };
+    int max[2] = { x, y };
+
+    auto visit = [&]( FractureEdge* aEdge ) -> bool
     {
-        if( !(*i)->matches( y ) )
-            continue;
+        if( !aEdge->matches( y ) )
+            return true;
 
         int x_intersect;
 
-        if( (*i)->m_p1.y == (*i)->m_p2.y ) // horizontal edge
-            x_intersect = std::max ( (*i)->m_p1.x, (*i)->m_p2.x );
+        if( aEdge->m_p1.y == aEdge->m_p2.y ) // horizontal edge
+            x_intersect = std::max ( aEdge->m_p1.x, aEdge->m_p2.x );
         else
-            x_intersect = (*i)->m_p1.x + rescale((*i)->m_p2.x - (*i)->m_p1.x,   y - (*i)->m_p1.y,   (*i)->m_p2.y - (*i)->m_p1.y );
+            x_intersect = aEdge->m_p1.x + rescale( aEdge->m_p2.x - aEdge->m_p1.x,   y - aEdge->m_p1.y,   aEdge->m_p2.y - aEdge->m_p1.y );
 
         int dist = ( x - x_intersect );
 
-        if( dist >= 0 && dist < min_dist && (*i)->m_connected )
+        if( dist >= 0 && ( dist < min_dist
+                           || ( e_nearest && dist == min_dist && aEdge->m_id < e_nearest->m_id ) ) )
         {
             min_dist = dist;
             x_nearest = x_intersect;
-            e_nearest = (*i);
+            e_nearest = aEdge;
         }
-    }
+
+        return true;
+    };
+
+    tree.Search( min, max, visit );
 
     if( e_nearest && e_nearest->m_connected )
     {
         int count = 0;
 
-		FractureEdge* lead1 = new FractureEdge( true, VECTOR2I( x_nearest, y ), VECTOR2I( x, y ) );
+        FractureEdge* lead1 = new FractureEdge( true, VECTOR2I( x_nearest, y ), VECTOR2I( x, y ) );
         FractureEdge* lead2 = new FractureEdge( true, VECTOR2I( x, y ), VECTOR2I( x_nearest, y ) );
         FractureEdge* split_2 = new FractureEdge( true, VECTOR2I( x_nearest, y ), e_nearest->m_p2 );
 
-        edges.push_back( split_2 );
-        edges.push_back( lead1 );
-        edges.push_back( lead2 );
+        addEdge( edges, split_2 );
+        addEdge( edges, lead1 );
+        addEdge( edges, lead2 );
 
         FractureEdge* link = e_nearest->m_next;
 
@@ -732,14 +1238,20 @@ static int processEdge( FractureEdgeSet& edges, FractureEdge* edge )
         for( last = edge; last->m_next != edge; last = last->m_next )
         {
             last->m_connected = true;
+            indexEdge( tree, last );
             count++;
         }
 
         last->m_connected = true;
+        indexEdge( tree, last );
         last->m_next = lead2;
         lead2->m_next = split_2;
         split_2->m_next = link;
 
+        indexEdge( tree, split_2 );
+        indexEdge( tree, lead1 );
+        indexEdge( tree, lead2 );
+
         return count + 1;
     }
 
@@ -751,6 +1263,7 @@ void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
 {
     FractureEdgeSet edges;
     FractureEdgeSet border_edges;
+    FractureEdgeTree tree;
     FractureEdge* root = NULL;
 
     bool first = true;
@@ -793,7 +1306,10 @@ void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
                 fe->m_next = first_edge;
 
             prev = fe;
-            edges.push_back( fe );
+            addEdge( edges, fe );
+
+            if( fe->m_connected )
+                indexEdge( tree, fe );
 
             if( !first )
             {
@@ -807,26 +1323,26 @@ void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
         first = false; // first path is always the outline
     }
 
+    // the holes are connected from left to right: sort their left-most edges once
+    std::stable_sort( border_edges.begin(), border_edges.end(),
+                      []( const FractureEdge* a, const FractureEdge* b )
+                      {
+                          return a->m_p1.x < b->m_p1.x;
+                      } );
+
+    FractureEdgeSet::iterator smallestX = border_edges.begin();
+
     // keep connecting holes to the main outline, until there's no holes left...
     while( num_unconnected > 0 )
     {
-        int x_min = std::numeric_limits<int>::max();
-
-        FractureEdge* smallestX = NULL;
-
         // find the left-most hole edge and merge with the outline
-        for( FractureEdgeSet::iterator i = border_edges.begin(); i != border_edges.end(); ++i )
-        {
-            int xt = (*i)->m_p1.x;
+        while( smallestX != border_edges.end() && (*smallestX)->m_connected )
+            ++smallestX;
 
-            if( ( xt < x_min ) && ! (*i)->m_connected )
-            {
-                x_min = xt;
-                smallestX = *i;
-            }
-        }
+        if( smallestX == border_edges.end() )
+            break;
 
-        num_unconnected -= processEdge( edges, smallestX );
+        num_unconnected -= processEdge( edges, tree, *smallestX++ );
     }
 
     paths.clear();
@@ -852,9 +1368,13 @@ void SHAPE_POLY_SET::Fracture( POLYGON_MODE aFastMode )
 {
     Simplify( aFastMode ); // remove overlapping holes/degeneracy
 
-    for( POLYGON& paths : m_polys )
+    // the polygons are fractured independently
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic) if( m_polys.size() > 1 )
+#endif
+    for( int i = 0; i < (int) m_polys.size(); i++ )
     {
-        fractureSingle( paths );
+        fractureSingle( m_polys[i] );
     }
 }
 
@@ -953,6 +1473,8 @@ bool SHAPE_POLY_SET::Parse( std::stringstream& aStream )
     if( n_polys < 0 )
         return false;
 
+    invalidateIndex();
+
     for( int i = 0; i < n_polys; i++ )
     {
         POLYGON paths;
@@ -1011,8 +1533,85 @@ const BOX2I SHAPE_POLY_SET::BBox( int aClearance ) const
 }
 
 
+void SHAPE_POLY_SET::BuildIndex()
+{
+    m_edgeIndex = std::make_shared<const EDGE_INDEX>( m_polys );
+    m_edgeIndexOffset = VECTOR2I( 0, 0 );
+}
+
+
+template <class DISTANCE>
+int SHAPE_POLY_SET::nearestEdgeDistance( const BOX2I& aBox, int aSubpolyIndex,
+                                         DISTANCE aDistance ) const
+{
+    const BOX2I& bounds = m_edgeIndex->BBox();
+    BOX2I box( aBox.GetOrigin() - m_edgeIndexOffset, aBox.GetSize() );
+    box.Normalize();
+
+    int minDistance = -1;
+
+    auto visitor = [&]( const EDGE_INDEX::EDGE& aEdge )
+    {
+        if( aSubpolyIndex >= 0 && aEdge.m_polygon != aSubpolyIndex )
+            return;
+
+        const SHAPE_LINE_CHAIN& contour = m_polys[aEdge.m_polygon][aEdge.m_contour];
+        SEG edge( contour.CPoint( aEdge.m_vertex ),
+                  contour.CPoint( EDGE_INDEX::nextVertex( contour, aEdge.m_vertex ) ) );
+
+        int distance = aDistance( edge );
+
+        if( minDistance < 0 || distance < minDistance )
+            minDistance = distance;
+    };
+
+    // Start with the mean edge length, and double the search radius until an edge is found
+    int64_t radius = (int64_t) std::max( 1.0, std::max( bounds.GetWidth(), bounds.GetHeight() )
+                                              / sqrt( (double) m_edgeIndex->EdgeCount() ) );
+
+    while( true )
+    {
+        int64_t minX = (int64_t) box.GetX() - radius - 1;
+        int64_t minY = (int64_t) box.GetY() - radius - 1;
+        int64_t maxX = (int64_t) box.GetRight() + radius + 1;
+        int64_t maxY = (int64_t) box.GetBottom() + radius + 1;
+
+        m_edgeIndex->Query( minX, minY, maxX, maxY, visitor );
+
+        // The edges closer than the search radius are all in the searched box
+        if( minDistance >= 0 && minDistance <= radius )
+            return minDistance;
+
+        // No edge out of the searched box
+        if( minX <= bounds.GetX() && minY <= bounds.GetY()
+                && maxX >= bounds.GetRight() && maxY >= bounds.GetBottom() )
+            return minDistance;
+
+        radius = minDistance >= 0 ? minDistance : radius * 2;
+    }
+}
+
+
 bool SHAPE_POLY_SET::PointOnEdge( const VECTOR2I& aP ) const
 {
+    if( m_edgeIndex )
+    {
+        bool onEdge = false;
+
+        auto visitor = [&]( const EDGE_INDEX::EDGE& aEdge )
+        {
+            if( !onEdge )
+                onEdge = edgeContains( m_polys[aEdge.m_polygon][aEdge.m_contour],
+                                       aEdge.m_vertex, aP );
+        };
+
+        VECTOR2I p = aP - m_edgeIndexOffset;
+        m_edgeIndex->Query( (int64_t) p.x - 1, (int64_t) p.y - 1,
+                            (int64_t) p.x + 1, (int64_t) p.y + 1, visitor );
+
+        return onEdge;
+    }
+
     // Iterate through all the polygons in the set
     for( const POLYGON& polygon : m_polys )
     {
@@ -1030,28 +1629,67 @@ bool SHAPE_POLY_SET::PointOnEdge( const VECTOR2I& aP ) const
 
 bool SHAPE_POLY_SET::Collide( const VECTOR2I& aP, int aClearance ) const
 {
-    SHAPE_POLY_SET polySet = SHAPE_POLY_SET( *this );
+    // There is a collision if the point is inside of the polygon, or closer to one of its
+    // edges than aClearance, which is what a test on the inflated polygon would find, without
+    // the approximation of its round corners
+    if( Contains( aP ) )
+        return true;
 
-    // Inflate the polygon if necessary.
-    if( aClearance > 0 )
+    if( aClearance <= 0 )
+        return false;
+
+    VECTOR2I::extended_type clearanceSq = (VECTOR2I::extended_type) aClearance * aClearance;
+
+    if( m_edgeIndex )
     {
-        // fixme: the number of arc segments should not be hardcoded
-        polySet.Inflate( aClearance, 8 );
+        bool collide = false;
+
+        auto visitor = [&]( const EDGE_INDEX::EDGE& aEdge )
+        {
+            const SHAPE_LINE_CHAIN& contour = m_polys[aEdge.m_polygon][aEdge.m_contour];
+            SEG edge( contour.CPoint( aEdge.m_vertex ),
+                      contour.CPoint( EDGE_INDEX::nextVertex( contour, aEdge.m_vertex ) ) );
+
+            if( !collide )
+                collide = edge.SquaredDistance( aP ) <= clearanceSq;
+        };
+
+        VECTOR2I p = aP - m_edgeIndexOffset;
+        m_edgeIndex->Query( (int64_t) p.x - aClearance, (int64_t) p.y - aClearance,
+                            (int64_t) p.x + aClearance, (int64_t) p.y + aClearance, visitor );
+
+        return collide;
+    }
+
+    for( const POLYGON& polygon : m_polys )
+    {
+        for( const SHAPE_LINE_CHAIN& contour : polygon )
+        {
+            for( int i = 0; i < contour.PointCount(); i++ )
+            {
+                SEG edge( contour.CPoint( i ), contour.CPoint( ( i + 1 ) % contour.PointCount() ) );
+
+                if( edge.SquaredDistance( aP ) <= clearanceSq )
+                    return true;
+            }
+        }
     }
 
-    // There is a collision if and only if the point is inside of the polygon.
-    return polySet.Contains( aP );
+    return false;
 }
 
 
 void SHAPE_POLY_SET::RemoveAllContours()
 {
+    invalidateIndex();
     m_polys.clear();
 }
 
 
 void SHAPE_POLY_SET::RemoveContour( int aContourIdx, int aPolygonIdx )
 {
+    invalidateIndex();
+
     // Default polygon is the last one
     if( aPolygonIdx < 0 )
         aPolygonIdx += m_polys.size();
@@ -1115,12 +1753,24 @@ int SHAPE_POLY_SET::RemoveNullSegments()
 
 void SHAPE_POLY_SET::DeletePolygon( int aIdx )
 {
+    invalidateIndex();
     m_polys.erase( m_polys.begin() + aIdx );
 }
 
 
 void SHAPE_POLY_SET::Append( const SHAPE_POLY_SET& aSet )
 {
+    // Appended to an empty set, the polygons keep their indices
+    if( m_polys.empty() )
+    {
+        m_edgeIndex = aSet.m_edgeIndex;
+        m_edgeIndexOffset = aSet.m_edgeIndexOffset;
+    }
+    else
+    {
+        invalidateIndex();
+    }
+
     m_polys.insert( m_polys.end(), aSet.m_polys.begin(), aSet.m_polys.end() );
 }
 
@@ -1144,7 +1794,7 @@ bool SHAPE_POLY_SET::CollideVertex( const VECTOR2I& aPoint,
     // Convert clearance to double for precission when comparing distances
     clearance = aClearance;
 
-    for( ITERATOR iterator = IterateWithHoles(); iterator; iterator++ )
+    for( CONST_ITERATOR iterator = CIterateWithHoles(); iterator; iterator++ )
     {
         // Get the difference vector between current vertex and aPoint
         delta = *iterator - aPoint;
@@ -1208,6 +1858,10 @@ bool SHAPE_POLY_SET::Contains( const VECTOR2I& aP, int aSubpolyIndex ) const
     if( aSubpolyIndex >= 0 )
         return containsSingle( aP, aSubpolyIndex );
 
+    // The index finds the polygons containing the point at once
+    if( m_edgeIndex )
+        return containsIndexed( aP, -1 );
+
     // In any other case, check it against all polygons in the set
     for( int polygonIdx = 0; polygonIdx < OutlineCount(); polygonIdx++ )
     {
@@ -1234,12 +1888,16 @@ void SHAPE_POLY_SET::RemoveVertex( int aGlobalIndex )
 
 void SHAPE_POLY_SET::RemoveVertex( VERTEX_INDEX aIndex )
 {
+    invalidateIndex();
     m_polys[aIndex.m_polygon][aIndex.m_contour].Remove( aIndex.m_vertex );
 }
 
 
 bool SHAPE_POLY_SET::containsSingle( const VECTOR2I& aP, int aSubpolyIndex ) const
 {
+    if( m_edgeIndex )
+        return containsIndexed( aP, aSubpolyIndex );
+
     // Check that the point is inside the outline
     if( pointInPolygon( aP, m_polys[aSubpolyIndex][0] ) )
     {
@@ -1277,56 +1935,92 @@ bool SHAPE_POLY_SET::pointInPolygon( const VECTOR2I& aP, const SHAPE_LINE_CHAIN&
     {
         VECTOR2I ipNext = ( i == cnt ? aPath.CPoint( 0 ) : aPath.CPoint( i ) );
 
-        if( ipNext.y == aP.y )
-        {
-            if( ( ipNext.x == aP.x ) || ( ip.y == aP.y &&
-                ( ( ipNext.x > aP.x ) == ( ip.x < aP.x ) ) ) )
-                return true;
-        }
+        int crossing = edgeCrossing( aP, ip, ipNext );
 
-        if( ( ip.y < aP.y ) != ( ipNext.y < aP.y ) )
-        {
-            if( ip.x >= aP.x )
-            {
-                if( ipNext.x > aP.x )
-                    result = 1 - result;
-                else
-                {
-                    int64_t d = (int64_t)( ip.x - aP.x ) * (int64_t)( ipNext.y - aP.y ) -
-                                (int64_t)( ipNext.x - aP.x ) * (int64_t)( ip.y - aP.y );
+        if( crossing < 0 )
+            return true;
 
-                    if( !d )
-                        return true;
+        if( crossing > 0 )
+            result = 1 - result;
 
-                    if( ( d > 0 ) == ( ipNext.y > ip.y ) )
-                        result = 1 - result;
-                }
-            }
-            else
-            {
-                if( ipNext.x > aP.x )
-                {
-                    int64_t d = (int64_t)( ip.x - aP.x ) * (int64_t)( ipNext.y - aP.y ) -
-                                (int64_t)( ipNext.x - aP.x ) * (int64_t)( ip.y - aP.y );
+        ip = ipNext;
+    }
 
-                if( !d )
-                    return true;
+    return result ? true : false;
+}
 
-                if( ( d > 0 ) == ( ipNext.y > ip.y ) )
-                    result = 1 - result;
-                }
-            }
+
+bool SHAPE_POLY_SET::containsIndexed( const VECTOR2I& aP, int aSubpolyIndex ) const
+{
+    // What pointInPolygon() and PointOnEdge() find for each contour, from its edges crossing
+    // the horizontal ray starting from aP, and its edges closer than 1 to aP
+    struct CONTOUR_STATE
+    {
+        bool m_inside = false;
+        bool m_onEdge = false;
+        bool m_nearEdge = false;
+    };
+
+    typedef std::pair<int, int> CONTOUR_ID;
+    std::map<CONTOUR_ID, CONTOUR_STATE> contours;
+
+    auto visitor = [&]( const EDGE_INDEX::EDGE& aEdge )
+    {
+        if( aSubpolyIndex >= 0 && aEdge.m_polygon != aSubpolyIndex )
+            return;
+
+        const SHAPE_LINE_CHAIN& contour = m_polys[aEdge.m_polygon][aEdge.m_contour];
+
+        if( contour.PointCount() < 3 )
+            return;
+
+        CONTOUR_STATE& state = contours[CONTOUR_ID( aEdge.m_polygon, aEdge.m_contour )];
+        int crossing = edgeCrossing( aP, contour.CPoint( aEdge.m_vertex ),
+                contour.CPoint( EDGE_INDEX::nextVertex( contour, aEdge.m_vertex ) ) );
+
+        if( crossing < 0 )
+            state.m_onEdge = true;
+        else if( crossing > 0 )
+            state.m_inside = !state.m_inside;
+
+        if( aEdge.m_contour > 0 && !state.m_nearEdge )
+            state.m_nearEdge = edgeContains( contour, aEdge.m_vertex, aP );
+    };
+
+    VECTOR2I p = aP - m_edgeIndexOffset;
+    int64_t rayEnd = std::max( p.x, m_edgeIndex->BBox().GetRight() );
+
+    m_edgeIndex->Query( (int64_t) p.x - 1, (int64_t) p.y - 1, rayEnd, (int64_t) p.y + 1, visitor );
+
+    // The contours are sorted by polygon, and the outline of each polygon comes first
+    for( auto outline = contours.begin(); outline != contours.end(); )
+    {
+        int polygon = outline->first.first;
+        bool inside = outline->first.second == 0
+                      && ( outline->second.m_inside || outline->second.m_onEdge );
+
+        for( ++outline; outline != contours.end() && outline->first.first == polygon; ++outline )
+        {
+            const CONTOUR_STATE& hole = outline->second;
+
+            // Inside a hole, and not on its edge
+            if( ( hole.m_inside || hole.m_onEdge ) && !hole.m_nearEdge )
+                inside = false;
         }
 
-        ip = ipNext;
+        if( inside )
+            return true;
     }
 
-    return result ? true : false;
+    return false;
 }
 
 
 void SHAPE_POLY_SET::Move( const VECTOR2I& aVector )
 {
+    // The edges keep their order, only the queries are translated
+    m_edgeIndexOffset += aVector;
+
     for( POLYGON &poly : m_polys )
     {
         for( SHAPE_LINE_CHAIN &path : poly )
@@ -1353,6 +2047,37 @@ int SHAPE_POLY_SET::TotalVertices() const
 }
 
 
+double SHAPE_POLY_SET::Area() const
+{
+    double area = 0.0;
+
+    for( const POLYGON& poly : m_polys )
+    {
+        for( unsigned int i = 0; i < poly.size(); i++ )
+        {
+            const SHAPE_LINE_CHAIN& contour = poly[i];
+            double contourArea = 0.0;
+
+            // Shoelace formula, the contours being closed
+            for( int v = 0; v < contour.PointCount(); v++ )
+            {
+                const VECTOR2I& a = contour.CPoint( v );
+                const VECTOR2I& b = contour.CPoint( ( v + 1 ) % contour.PointCount() );
+
+                contourArea += (double) a.x * b.y - (double) b.x * a.y;
+            }
+
+            contourArea = std::fabs( contourArea ) / 2.0;
+
+            // The first contour is the outline, the others are its holes
+            area += i == 0 ? contourArea : -contourArea;
+        }
+    }
+
+    return area;
+}
+
+
 SHAPE_POLY_SET::POLYGON SHAPE_POLY_SET::ChamferPolygon( unsigned int aDistance, int aIndex )
 {
     return chamferFilletPolygon( CORNER_MODE::CHAMFERED, aDistance, aIndex );
@@ -1376,6 +2101,15 @@ int SHAPE_POLY_SET::DistanceToPolygon( VECTOR2I aPoint, int aPolygonIndex )
     if( containsSingle( aPoint, aPolygonIndex ) )
         return 0;
 
+    if( m_edgeIndex )
+    {
+        int minDistance = nearestEdgeDistance( BOX2I( aPoint, VECTOR2I( 0, 0 ) ), aPolygonIndex,
+                [&]( const SEG& aEdge ) { return aEdge.Distance( aPoint ); } );
+
+        if( minDistance >= 0 )
+            return minDistance;
+    }
+
     SEGMENT_ITERATOR iterator = IterateSegmentsWithHoles( aPolygonIndex );
 
     SEG polygonEdge = *iterator;
@@ -1404,19 +2138,30 @@ int SHAPE_POLY_SET::DistanceToPolygon( SEG aSegment, int aPolygonIndex, int aSeg
     if( containsSingle( aSegment.A, aPolygonIndex ) )
         return 0;
 
-    SEGMENT_ITERATOR iterator = IterateSegmentsWithHoles( aPolygonIndex );
+    int minDistance = -1;
 
-    SEG polygonEdge = *iterator;
-    int minDistance = polygonEdge.Distance( aSegment );
+    if( m_edgeIndex )
+    {
+        minDistance = nearestEdgeDistance( BOX2I( aSegment.A, aSegment.B - aSegment.A ),
+                aPolygonIndex, [&]( const SEG& aEdge ) { return aEdge.Distance( aSegment ); } );
+    }
 
-    for( iterator++; iterator && minDistance > 0; iterator++ )
+    if( minDistance < 0 )
     {
-        polygonEdge = *iterator;
+        SEGMENT_ITERATOR iterator = IterateSegmentsWithHoles( aPolygonIndex );
 
-        int currentDistance = polygonEdge.Distance( aSegment );
+        SEG polygonEdge = *iterator;
+        minDistance = polygonEdge.Distance( aSegment );
 
-        if( currentDistance < minDistance )
-            minDistance = currentDistance;
+        for( iterator++; iterator && minDistance > 0; iterator++ )
+        {
+            polygonEdge = *iterator;
+
+            int currentDistance = polygonEdge.Distance( aSegment );
+
+            if( currentDistance < minDistance )
+                minDistance = currentDistance;
+        }
     }
 
     // Take into account the width of the segment
@@ -1507,7 +2252,7 @@ SHAPE_POLY_SET::POLYGON SHAPE_POLY_SET::chamferFilletPolygon( CORNER_MODE aMode,
     // Null segments create serious issues in calculations. Remove them:
     RemoveNullSegments();
 
-    SHAPE_POLY_SET::POLYGON currentPoly = Polygon( aIndex );
+    SHAPE_POLY_SET::POLYGON currentPoly = CPolygon( aIndex );
     SHAPE_POLY_SET::POLYGON newPoly;
 
     // If the chamfering distance is zero, then the polygon remain intact.
@@ -24,6 +24,8 @@
 
 #include <kicad_curl/kicad_curl_easy.h>
 
+#include <algorithm>
+#include <cctype>
 #include <cstddef>
 #include <exception>
 #include <stdarg.h>
@@ -43,6 +45,46 @@ static size_t write_callback( void* contents, size_t size, size_t nmemb, void* u
 }
 
 
+static std::string lowerCase( std::string aText )
+{
+    std::transform( aText.begin(), aText.end(), aText.begin(),
+                    []( unsigned char c ) { return (char) std::tolower( c ); } );
+    return aText;
+}
+
+
+static size_t header_callback( char* buffer, size_t size, size_t nitems, void* userp )
+{
+    size_t realsize = size * nitems;
+
+    std::map<std::string, std::string>* headers = (std::map<std::string, std::string>*) userp;
+    std::string line( buffer, realsize );
+
+    // Each response after a redirect starts with its own status line
+    if( line.compare( 0, 5, "HTTP/" ) == 0 )
+    {
+        headers->clear();
+        return realsize;
+    }
+
+    size_t colon = line.find( ':' );
+
+    if( colon == std::string::npos )
+        return realsize;
+
+    const char* blanks = " \t\r\n";
+    size_t      first  = line.find_first_not_of( blanks, colon + 1 );
+    size_t      last   = line.find_last_not_of( blanks );
+
+    if( first == std::string::npos || last < first )
+        (*headers)[ lowerCase( line.substr( 0, colon ) ) ] = std::string();
+    else
+        (*headers)[ lowerCase( line.substr( 0, colon ) ) ] = line.substr( first, last - first + 1 );
+
+    return realsize;
+}
+
+
 KICAD_CURL_EASY::KICAD_CURL_EASY() :
     m_headers( NULL )
 {
@@ -61,6 +103,8 @@ KICAD_CURL_EASY::KICAD_CURL_EASY() :
 
     curl_easy_setopt( m_CURL, CURLOPT_WRITEFUNCTION, write_callback );
     curl_easy_setopt( m_CURL, CURLOPT_WRITEDATA, (void*) &m_buffer );
+    curl_easy_setopt( m_CURL, CURLOPT_HEADERFUNCTION, header_callback );
+    curl_easy_setopt( m_CURL, CURLOPT_HEADERDATA, (void*) &m_response_headers );
 }
 
 
@@ -82,6 +126,7 @@ void KICAD_CURL_EASY::Perform()
 
     // bonus: retain worst case memory allocation, should re-use occur
     m_buffer.clear();
+    m_response_headers.clear();
 
     CURLcode res = curl_easy_perform( m_CURL );
 
@@ -92,3 +137,22 @@ void KICAD_CURL_EASY::Perform()
         THROW_IO_ERROR( msg );
     }
 }
+
+
+long KICAD_CURL_EASY::GetResponseCode()
+{
+    long code = 0;
+
+    if( curl_easy_getinfo( m_CURL, CURLINFO_RESPONSE_CODE, &code ) != CURLE_OK )
+        return 0;
+
+    return code;
+}
+
+
+const std::string KICAD_CURL_EASY::GetResponseHeader( const std::string& aName ) const
+{
+    auto it = m_response_headers.find( lowerCase( aName ) );
+
+    return it == m_response_headers.end() ? std::string() : it->second;
+}
@@ -34,6 +34,8 @@
 #include <id.h>
 #include <class_drawpanel.h>
 #include <view/view.h>
+#include <class_draw_panel_gal.h>
+#include <gal/graphics_abstraction_layer.h>
 #include <class_base_screen.h>
 #include <draw_frame.h>
 #include <kicad_device_context.h>
@@ -90,9 +92,23 @@ void EDA_DRAW_FRAME::Zoom_Automatique( bool aWarpPointer )
         SetCrossHairPosition( GetScrollCenterPosition() );
 
     if( !IsGalCanvasActive() )
+    {
         RedrawScreen( GetScrollCenterPosition(), aWarpPointer );
-    else
+    }
+    else if( m_toolManager )
+    {
         m_toolManager->RunAction( "common.Control.zoomFitScreen", true );
+    }
+    else
+    {
+        // Frames without tool framework (GerbView): apply the best zoom to the view
+        KIGFX::GAL* gal = GetGalCanvas()->GetGAL();
+        double zoomFactor = gal->GetWorldScale() / gal->GetZoomFactor();
+
+        GetGalCanvas()->GetView()->SetScale( 1.0 / ( zoomFactor * screen->GetZoom() ) );
+        GetGalCanvas()->GetView()->SetCenter( VECTOR2D( GetScrollCenterPosition() ) );
+        GetGalCanvas()->Refresh();
+    }
 }
 
 
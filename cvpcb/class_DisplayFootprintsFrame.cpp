@@ -420,6 +420,17 @@ void PCB_SCREEN::ClearUndoORRedoList( UNDO_REDO_CONTAINER&, int )
 }
 
 
+/**
+ * Virtual function needed by the PCB_SCREEN class, defined in pcbnew undo_redo.cpp
+ * Cvpcb has no undo list
+ */
+size_t PCB_SCREEN::GetCommandDataSize( const PICKED_ITEMS_LIST&,
+                                       std::vector<UNDO_SHARED_DATA>& ) const
+{
+    return 0;
+}
+
+
 bool DISPLAY_FOOTPRINTS_FRAME::IsGridVisible() const
 {
     return m_drawGrid;
@@ -1017,6 +1017,9 @@ void GOST_COMP_MANAGER::OnActivate( wxActivateEvent& event )
         //printf("focus lost\n");
         if( m_componentDB->WriteBackToKiCad() )
         {
+            // The fields were changed without undo command
+            SCH_SCREENS().InvalidateItemIndexes();
+
             // let eeschema know to save changes on closing it
             m_schEditFrame->GetScreen()->SetModify();
         }
@@ -1029,8 +1032,13 @@ void GOST_COMP_MANAGER::OnActivate( wxActivateEvent& event )
 void GOST_COMP_MANAGER::OnCloseWindow( wxCloseEvent& event )
 {
     if( m_componentDB->WriteBackToKiCad() )
+    {
+        // The fields were changed without undo command
+        SCH_SCREENS().InvalidateItemIndexes();
+
         // let eeschema know to save changes on closing it
         m_schEditFrame->GetScreen()->SetModify();
+    }
 
     Destroy();
 }
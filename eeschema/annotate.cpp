@@ -158,6 +158,9 @@ void SCH_EDIT_FRAME::AnnotateComponents( bool              aAnnotateSchematic,
     references.Annotate( useSheetNum, idStep, lockedComponents );
     references.UpdateAnnotation();
 
+    // The references were changed without undo command
+    screens.InvalidateItemIndexes();
+
     wxArrayString errors;
 
     // Final control (just in case ... ).
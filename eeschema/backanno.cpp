@@ -125,7 +125,13 @@ void SCH_EDIT_FRAME::backAnnotateFootprints( const std::string& aChangedSetOfRef
     }
 
     if( isChanged )
+    {
+        // The footprint fields were changed without undo command
+        SCH_SCREENS screens;
+        screens.InvalidateItemIndexes();
+
         OnModify();
+    }
 }
 
 
@@ -256,6 +262,10 @@ bool SCH_EDIT_FRAME::LoadCmpToFootprintLinkFile()
         return false;
     }
 
+    // The footprint fields were changed without undo command
+    SCH_SCREENS screens;
+    screens.InvalidateItemIndexes();
+
     OnModify();
     return true;
 }
@@ -259,6 +259,25 @@ LIB_PART::~LIB_PART()
 }
 
 
+void LIB_PART::loadBody()
+{
+    // Clear the loader first: it adds the items with AddDrawItem(), which calls LoadBody().
+    std::function<void( LIB_PART* )> loader;
+
+    loader.swap( m_bodyLoader );
+
+    try
+    {
+        loader( this );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        wxLogError( _( "Cannot load the graphic items of symbol '%s':\n%s" ),
+                    GetChars( GetName() ), GetChars( ioe.What() ) );
+    }
+}
+
+
 const wxString LIB_PART::GetLibraryName()
 {
     if( m_library )
@@ -316,6 +335,8 @@ void LIB_PART::SetName( const wxString& aName )
 void LIB_PART::Draw( EDA_DRAW_PANEL* aPanel, wxDC* aDc, const wxPoint& aOffset,
             int aMulti, int aConvert, const PART_DRAW_OPTIONS& aOpts )
 {
+    LoadBody();
+
     BASE_SCREEN*   screen = aPanel ? aPanel->GetScreen() : NULL;
 
     GRSetDrawMode( aDc, aOpts.draw_mode );
@@ -457,6 +478,8 @@ void LIB_PART::Draw( EDA_DRAW_PANEL* aPanel, wxDC* aDc, const wxPoint& aOffset,
 void LIB_PART::Plot( PLOTTER* aPlotter, int aUnit, int aConvert,
                           const wxPoint& aOffset, const TRANSFORM& aTransform )
 {
+    LoadBody();
+
     wxASSERT( aPlotter != NULL );
 
     aPlotter->SetColor( GetLayerColor( LAYER_DEVICE ) );
@@ -535,6 +558,8 @@ void LIB_PART::PlotLibFields( PLOTTER* aPlotter, int aUnit, int aConvert,
 
 void LIB_PART::RemoveDrawItem( LIB_ITEM* aItem, EDA_DRAW_PANEL* aPanel, wxDC* aDc )
 {
+    LoadBody();
+
     wxASSERT( aItem != NULL );
 
     // none of the MANDATORY_FIELDS may be removed in RAM, but they may be
@@ -573,6 +598,8 @@ void LIB_PART::RemoveDrawItem( LIB_ITEM* aItem, EDA_DRAW_PANEL* aPanel, wxDC* aD
 
 void LIB_PART::AddDrawItem( LIB_ITEM* aItem )
 {
+    LoadBody();
+
     wxASSERT( aItem != NULL );
 
     drawings.push_back( aItem );
@@ -582,6 +609,8 @@ void LIB_PART::AddDrawItem( LIB_ITEM* aItem )
 
 LIB_ITEM* LIB_PART::GetNextDrawItem( LIB_ITEM* aItem, KICAD_T aType )
 {
+    LoadBody();
+
     /* Return the next draw object pointer.
      * If item is NULL return the first item of type in the list.
      */
@@ -619,6 +648,8 @@ LIB_ITEM* LIB_PART::GetNextDrawItem( LIB_ITEM* aItem, KICAD_T aType )
 
 void LIB_PART::GetPins( LIB_PINS& aList, int aUnit, int aConvert )
 {
+    LoadBody();
+
     /* Notes:
      * when aUnit == 0: no unit filtering
      * when aConvert == 0: no convert (shape selection) filtering
@@ -725,6 +756,8 @@ bool LIB_PART::PinsConflictWith( LIB_PART& aOtherPart, bool aTestNums, bool aTes
 
 bool LIB_PART::Save( OUTPUTFORMATTER& aFormatter )
 {
+    LoadBody();
+
     LIB_FIELD&  value = GetValueField();
 
     // First line: it s a comment (component name for readers)
@@ -1166,6 +1199,8 @@ bool LIB_PART::LoadFootprints( LINE_READER& aLineReader, wxString& aErrorMsg )
 
 const EDA_RECT LIB_PART::GetUnitBoundingBox( int aUnit, int aConvert ) const
 {
+    LoadBody();
+
     EDA_RECT bBox;
     bool initialized = false;
 
@@ -1198,6 +1233,8 @@ const EDA_RECT LIB_PART::GetUnitBoundingBox( int aUnit, int aConvert ) const
 
 const EDA_RECT LIB_PART::GetBodyBoundingBox( int aUnit, int aConvert ) const
 {
+    LoadBody();
+
     EDA_RECT bBox;
     bool initialized = false;
 
@@ -1391,6 +1428,8 @@ bool LIB_PART::LoadDateAndTime( char* aLine )
 
 void LIB_PART::SetOffset( const wxPoint& aOffset )
 {
+    LoadBody();
+
     for( LIB_ITEM& item : drawings )
     {
         item.SetOffset( aOffset );
@@ -1400,12 +1439,16 @@ void LIB_PART::SetOffset( const wxPoint& aOffset )
 
 void LIB_PART::RemoveDuplicateDrawItems()
 {
+    LoadBody();
+
     drawings.unique();
 }
 
 
 bool LIB_PART::HasConversion() const
 {
+    LoadBody();
+
     for( unsigned ii = 0; ii < drawings.size(); ii++  )
     {
         const LIB_ITEM& item = drawings[ii];
@@ -1419,6 +1462,8 @@ bool LIB_PART::HasConversion() const
 
 void LIB_PART::ClearStatus()
 {
+    LoadBody();
+
     for( LIB_ITEM& item : drawings )
     {
         item.m_Flags = 0;
@@ -1428,6 +1473,8 @@ void LIB_PART::ClearStatus()
 
 int LIB_PART::SelectItems( EDA_RECT& aRect, int aUnit, int aConvert, bool aEditPinByPin )
 {
+    LoadBody();
+
     int itemCount = 0;
 
     for( LIB_ITEM& item : drawings )
@@ -1459,6 +1506,8 @@ int LIB_PART::SelectItems( EDA_RECT& aRect, int aUnit, int aConvert, bool aEditP
 
 void LIB_PART::MoveSelectedItems( const wxPoint& aOffset )
 {
+    LoadBody();
+
     for( LIB_ITEM& item : drawings )
     {
         if( !item.IsSelected() )
@@ -1474,6 +1523,8 @@ void LIB_PART::MoveSelectedItems( const wxPoint& aOffset )
 
 void LIB_PART::ClearSelectedItems()
 {
+    LoadBody();
+
     for( LIB_ITEM& item : drawings )
     {
         item.m_Flags = 0;
@@ -1483,6 +1534,8 @@ void LIB_PART::ClearSelectedItems()
 
 void LIB_PART::DeleteSelectedItems()
 {
+    LoadBody();
+
     LIB_ITEMS::iterator item = drawings.begin();
 
     // We *do not* remove the 2 mandatory fields: reference and value
@@ -1513,6 +1566,8 @@ void LIB_PART::DeleteSelectedItems()
 
 void LIB_PART::CopySelectedItems( const wxPoint& aOffset )
 {
+    LoadBody();
+
     /* *do not* use iterators here, because new items
      * are added to drawings that is a  boost::ptr_vector.
      * When push_back elements in buffer,
@@ -1546,6 +1601,8 @@ void LIB_PART::CopySelectedItems( const wxPoint& aOffset )
 
 void LIB_PART::MirrorSelectedItemsH( const wxPoint& aCenter )
 {
+    LoadBody();
+
     for( LIB_ITEM& item : drawings )
     {
         if( !item.IsSelected() )
@@ -1560,6 +1617,8 @@ void LIB_PART::MirrorSelectedItemsH( const wxPoint& aCenter )
 
 void LIB_PART::MirrorSelectedItemsV( const wxPoint& aCenter )
 {
+    LoadBody();
+
     for( LIB_ITEM& item : drawings )
     {
         if( !item.IsSelected() )
@@ -1574,6 +1633,8 @@ void LIB_PART::MirrorSelectedItemsV( const wxPoint& aCenter )
 
 void LIB_PART::RotateSelectedItems( const wxPoint& aCenter )
 {
+    LoadBody();
+
     for( LIB_ITEM& item : drawings )
     {
         if( !item.IsSelected() )
@@ -1591,6 +1652,8 @@ void LIB_PART::RotateSelectedItems( const wxPoint& aCenter )
 LIB_ITEM* LIB_PART::LocateDrawItem( int aUnit, int aConvert,
                                     KICAD_T aType, const wxPoint& aPoint )
 {
+    LoadBody();
+
     for( LIB_ITEM& item : drawings )
     {
         if( ( aUnit && item.m_Unit && ( aUnit != item.m_Unit) )
@@ -1609,6 +1672,8 @@ LIB_ITEM* LIB_PART::LocateDrawItem( int aUnit, int aConvert,
 LIB_ITEM* LIB_PART::LocateDrawItem( int aUnit, int aConvert, KICAD_T aType,
                                     const wxPoint& aPoint, const TRANSFORM& aTransform )
 {
+    LoadBody();
+
     /* we use LocateDrawItem( int aUnit, int convert, KICAD_T type, const
      * wxPoint& pt ) to search items.
      * because this function uses DefaultTransform as orient/mirror matrix
@@ -1629,6 +1694,8 @@ LIB_ITEM* LIB_PART::LocateDrawItem( int aUnit, int aConvert, KICAD_T aType,
 
 void LIB_PART::SetUnitCount( int aCount )
 {
+    LoadBody();
+
     if( m_unitCount == aCount )
         return;
 
@@ -1676,6 +1743,8 @@ void LIB_PART::SetUnitCount( int aCount )
 
 void LIB_PART::SetConversion( bool aSetConvert )
 {
+    LoadBody();
+
     if( aSetConvert == HasConversion() )
         return;
 
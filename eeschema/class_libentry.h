@@ -36,6 +36,7 @@
 #include <lib_field.h>
 #include <vector>
 #include <memory>
+#include <functional>
 
 class EDA_RECT;
 class LINE_READER;
@@ -237,6 +238,7 @@ class LIB_PART : public EDA_ITEM
     LIBRENTRYOPTIONS    m_options;          ///< Special part features such as POWER or NORMAL.)
     int                 m_unitCount;        ///< Number of units (parts) per package.
     LIB_ITEMS           drawings;           ///< How to draw this part.
+    std::function<void( LIB_PART* )> m_bodyLoader;  ///< Loads the draw items not yet loaded.
     wxArrayString       m_FootprintList;    /**< List of suitable footprint names for the
                                                  part (wild card names accepted). */
     LIB_ALIASES         m_aliases;          ///< List of alias object pointers associated with the
@@ -252,6 +254,8 @@ class LIB_PART : public EDA_ITEM
 private:
     void deleteAllFields();
 
+    void loadBody();
+
     // LIB_PART()  { }     // not legal
 
 public:
@@ -681,7 +685,34 @@ public:
      *
      * @return LIB_ITEMS& - Reference to the draw item object list.
      */
-    LIB_ITEMS& GetDrawItemList() { return drawings; }
+    LIB_ITEMS& GetDrawItemList() { LoadBody(); return drawings; }
+
+    /**
+     * Function SetBodyLoader
+     * defers the loading of the draw items, except the fields, until they are first used.
+     *
+     * Libraries set a loader when the part is indexed, so the parts which are only listed
+     * (by the component chooser for instance) are never fully loaded.
+     * @param aLoader adds the draw items to the part, and can throw an IO_ERROR.
+     */
+    void SetBodyLoader( std::function<void( LIB_PART* )> aLoader ) { m_bodyLoader = aLoader; }
+
+    /**
+     * Function IsBodyLoaded
+     * @return true if the draw items of the part are loaded.
+     */
+    bool IsBodyLoaded() const { return !m_bodyLoader; }
+
+    /**
+     * Function LoadBody
+     * loads the draw items of the part if they are not yet loaded.  All members using the
+     * draw items call it, so it only needs to be called before using #drawings directly.
+     */
+    void LoadBody() const
+    {
+        if( m_bodyLoader )
+            const_cast<LIB_PART*>( this )->loadBody();
+    }
 
     /**
      * Set the units per part count.
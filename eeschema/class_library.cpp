@@ -37,6 +37,7 @@
 #include <eda_doc.h>
 #include <wxstruct.h>
 #include <richio.h>
+#include <profile.h>
 #include <config_params.h>
 #include <wildcards_and_files_ext.h>
 #include <project_rescue.h>
@@ -50,6 +51,9 @@
 #include <wx/tokenzr.h>
 #include <wx/regex.h>
 
+#include <atomic>
+#include <thread>
+
 #define DUPLICATE_NAME_MSG  \
     _(  "Library '%s' has duplicate entry name '%s'.\n" \
         "This may cause some unexpected behavior when loading components into a schematic." )
@@ -579,15 +583,11 @@ void PART_LIBS::LoadAllLibraries( PROJECT* aProject, bool aShowProgress )
         lib_dialog.Show();
     }
 
-    wxString progress_message;
+    // Find the library files first: the search stack is not thread safe.
+    std::vector<wxString> lib_files;
 
     for( unsigned i = 0; i < lib_names.GetCount();  ++i )
     {
-        if( aShowProgress )
-        {
-            lib_dialog.Update( i, _( "Loading " + lib_names[i] ) );
-        }
-
         wxFileName fn = lib_names[i];
         // lib_names[] does not store the file extension. Set it:
         fn.SetExt( SchematicLibraryFileExtension );
@@ -618,20 +618,97 @@ void PART_LIBS::LoadAllLibraries( PROJECT* aProject, bool aShowProgress )
             filename = fn.GetFullPath();
         }
 
-        try
+        // Don't load the library twice: AddLibrary() only keeps the first one of a given name.
+        bool duplicate = false;
+
+        for( const wxString& libFile : lib_files )
         {
-            AddLibrary( filename );
+            if( wxFileName( libFile ).GetName() == wxFileName( filename ).GetName() )
+                duplicate = true;
         }
-        catch( const IO_ERROR& ioe )
+
+        if( !duplicate )
+            lib_files.push_back( filename );
+    }
+
+    // The libraries are independent until they are added to the list, so they are loaded
+    // in worker threads, as FOOTPRINT_LIST_IMPL does for the footprint libraries.
+    // The locale is global: it is switched before the threads are created, and restored
+    // after they are finished, and the main thread is blocked while they work.
+    std::vector<std::unique_ptr<PART_LIB>> loaded( lib_files.size() );
+    std::vector<wxString>                  errors( lib_files.size() );
+    std::atomic<size_t>                    nextLib( 0 );
+    std::atomic<size_t>                    finished( 0 );
+    PROF_COUNTER                           timer;
+
+    {
+        LOCALE_IO toggle;
+
+        std::vector<std::thread> threads;
+        size_t threadCount = std::min<size_t>( lib_files.size(),
+                                               std::max( 1u, std::thread::hardware_concurrency() ) );
+
+        for( size_t ii = 0; ii < threadCount; ++ii )
         {
-            wxString msg;
-            msg.Printf( _( "Part library '%s' failed to load. Error:\n %s" ),
-                        GetChars( filename ), GetChars( ioe.What() ) );
+            threads.push_back( std::thread( [&]()
+            {
+                size_t libIdx;
+
+                while( ( libIdx = nextLib++ ) < lib_files.size() )
+                {
+                    try
+                    {
+                        loaded[libIdx].reset( PART_LIB::LoadLibrary( lib_files[libIdx] ) );
+                    }
+                    catch( const IO_ERROR& ioe )
+                    {
+                        errors[libIdx] = ioe.What();
+                    }
+                    catch( const std::exception& e )
+                    {
+                        errors[libIdx] = FROM_UTF8( e.what() );
+                    }
+
+                    finished++;
+                }
+            } ) );
+        }
+
+        while( aShowProgress && finished < lib_files.size() )
+        {
+            lib_dialog.Update( finished, wxString::Format( _( "Loaded %u of %u libraries" ),
+                                                           (unsigned) finished,
+                                                           (unsigned) lib_files.size() ) );
+            wxMilliSleep( 20 );
+        }
+
+        for( auto& thread : threads )
+            thread.join();
+    }
+
+    wxLogTrace( traceSchLibMem, wxT( "Loaded %u symbol libraries in %.1f ms" ),
+                (unsigned) lib_files.size(), timer.msecs() );
 
-            wxLogError( msg );
+    // Add the libraries in the order of the project, and report all the errors at once.
+    wxString errorMsg;
+
+    for( size_t ii = 0; ii < lib_files.size(); ++ii )
+    {
+        if( loaded[ii] )
+        {
+            push_back( loaded[ii].release() );
+        }
+        else
+        {
+            errorMsg += wxString::Format( _( "Part library '%s' failed to load. Error:\n %s" ),
+                                          GetChars( lib_files[ii] ), GetChars( errors[ii] ) );
+            errorMsg += '\n';
         }
     }
 
+    if( !errorMsg.IsEmpty() )
+        wxLogError( errorMsg );
+
     if( aShowProgress )
     {
         lib_dialog.Destroy();
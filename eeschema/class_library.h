@@ -229,6 +229,9 @@ public:
      * Function LoadAllLibraries
      * loads all of the project's libraries into this container, which should
      * be cleared before calling it.
+     *
+     * The libraries are loaded in parallel, and added in the order of the project.
+     * The load errors are reported together when all libraries are loaded.
      */
     void LoadAllLibraries( PROJECT* aProject, bool aShowProgress=true )
         throw( IO_ERROR, boost::bad_pointer );
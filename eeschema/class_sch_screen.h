@@ -38,6 +38,7 @@
 #include <class_page_info.h>
 #include <kiway_player.h>
 #include <sch_marker.h>
+#include <sch_item_index.h>
 
 #include <../eeschema/general.h>
 
@@ -85,6 +86,44 @@ private:
     int     m_modification_sync;        ///< inequality with PART_LIBS::GetModificationHash()
                                         ///< will trigger ResolveAll().
 
+    /// Spatial index of m_drawList, built on demand by the position queries.
+    mutable SCH_ITEM_INDEX m_index;
+
+    /**
+     * Function useIndex
+     * builds the item index if needed, and tells if the position queries can use it.
+     * <p>
+     * The index stores the geometry of the items when they are inserted.  It cannot be
+     * used while an item is moved, dragged or resized, or during a block operation,
+     * because the items are changed without notifying the screen.  The queries walk
+     * the draw list in this case.
+     * </p>
+     * @return true if the index can be used.
+     */
+    bool useIndex() const;
+
+    /**
+     * Function changeIndexedItems
+     * updates the item index when \a aCommand is stored, see PushCommandToUndoList().
+     */
+    void changeIndexedItems( const PICKED_ITEMS_LIST& aCommand );
+
+    /**
+     * Function getHitCandidates
+     * fills \a aItems with the items which can be hit at \a aPosition within \a aAccuracy,
+     * in draw list order.  The candidates must still be tested by the caller.
+     */
+    void getHitCandidates( const wxPoint& aPosition, int aAccuracy,
+                           std::vector<SCH_ITEM*>& aItems ) const;
+
+    /**
+     * Function getConnectionCandidates
+     * fills \a aItems with the items which can have a connection point at one of
+     * \a aPositions, in draw list order.  The candidates must still be tested by the caller.
+     */
+    void getConnectionCandidates( const std::vector<wxPoint>& aPositions,
+                                  std::vector<SCH_ITEM*>& aItems ) const;
+
     /**
      * Function addConnectedItemsToBlock
      * add items connected at \a aPosition to the block pick list.
@@ -140,6 +179,7 @@ public:
     void Append( SCH_ITEM* aItem )
     {
         m_drawList.Append( aItem );
+        m_index.Insert( aItem );
         --m_modification_sync;
     }
 
@@ -152,9 +192,19 @@ public:
     void Append( DLIST< SCH_ITEM >& aList )
     {
         m_drawList.Append( aList );
+        m_index.Invalidate();
         --m_modification_sync;
     }
 
+    /**
+     * Function InvalidateItemIndex
+     * must be called when items are changed in place without an undo command (e.g. the
+     * references changed by the annotation): the item index is built again when needed.
+     * The items of the undo and redo commands are updated in the index, see
+     * PushCommandToUndoList().
+     */
+    void InvalidateItemIndex()                              { m_index.Invalidate(); }
+
     /**
      * Function GetCurItem
      * returns the currently selected SCH_ITEM, overriding BASE_SCREEN::GetCurItem().
@@ -328,8 +378,24 @@ public:
     bool BreakSegmentsOnJunctions();
 
     /* full undo redo management : */
-    // use BASE_SCREEN::PushCommandToUndoList( PICKED_ITEMS_LIST* aItem )
-    // use BASE_SCREEN::PushCommandToRedoList( PICKED_ITEMS_LIST* aItem )
+
+    /**
+     * Function PushCommandToUndoList
+     * adds a command to the undo list, overriding BASE_SCREEN::PushCommandToUndoList().
+     * <p>
+     * The items of a command are changed in place, before or after the command is stored.
+     * The item index stores the new geometry of the items of the previous command, which
+     * are now edited, and searches the items of \a aItem without using their geometry.
+     * </p>
+     */
+    void PushCommandToUndoList( PICKED_ITEMS_LIST* aItem ) override;
+
+    /**
+     * Function PushCommandToRedoList
+     * adds a command to the redo list, and updates the item index like
+     * PushCommandToUndoList().
+     */
+    void PushCommandToRedoList( PICKED_ITEMS_LIST* aItem ) override;
 
     /**
      * Function ClearUndoORRedoList
@@ -557,6 +623,13 @@ public:
      */
     void SchematicCleanUp();
 
+    /**
+     * Function InvalidateItemIndexes
+     * calls SCH_SCREEN::InvalidateItemIndex() for all the screens, after changing items
+     * of the whole hierarchy without undo commands.
+     */
+    void InvalidateItemIndexes();
+
     /**
      * Function ReplaceDuplicateTimeStamps
      * test all sheet and component objects in the schematic for duplicate time stamps
@@ -162,8 +162,14 @@ CMP_TREE_NODE_UNIT& CMP_TREE_NODE_ALIAS::AddUnit( int aUnit )
 
 void CMP_TREE_NODE_ALIAS::UpdateScore( EDA_COMBINED_MATCHER& aMatcher )
 {
-    if( Score <= 0 )
-        return; // Leaf nodes without scores are out of the game.
+    Score = ScoreTerm( aMatcher, Score );
+}
+
+
+int CMP_TREE_NODE_ALIAS::ScoreTerm( EDA_COMBINED_MATCHER& aMatcher, int aScore ) const
+{
+    if( aScore <= 0 )
+        return aScore; // Leaf nodes without scores are out of the game.
 
     // Keywords and description we only count if the match string is at
     // least two characters long. That avoids spurious, low quality
@@ -173,16 +179,16 @@ void CMP_TREE_NODE_ALIAS::UpdateScore( EDA_COMBINED_MATCHER& aMatcher )
 
     if( aMatcher.GetPattern() == MatchName )
     {
-        Score += 1000;  // exact match. High score :)
+        aScore += 1000;  // exact match. High score :)
     }
     else if( aMatcher.Find( MatchName, matchers_fired, found_pos ) )
     {
         // Substring match. The earlier in the string the better.
-        Score += matchPosScore( found_pos, 20 ) + 20;
+        aScore += matchPosScore( found_pos, 20 ) + 20;
     }
     else if( aMatcher.Find( Parent->MatchName, matchers_fired, found_pos ) )
     {
-        Score += 19;   // parent name matches.         score += 19
+        aScore += 19;   // parent name matches.         score += 19
     }
     else if( aMatcher.Find( SearchText, matchers_fired, found_pos ) )
     {
@@ -194,17 +200,17 @@ void CMP_TREE_NODE_ALIAS::UpdateScore( EDA_COMBINED_MATCHER& aMatcher )
         {
             // For longer terms, we add scores 1..18 for positional match
             // (higher in the front, where the keywords are).
-            Score += matchPosScore( found_pos, 17 ) + 1;
+            aScore += matchPosScore( found_pos, 17 ) + 1;
         }
     }
     else
     {
         // No match. That's it for this item.
-        Score = 0;
+        return 0;
     }
 
     // More matchers = better match
-    Score += 2 * matchers_fired;
+    return aScore + 2 * matchers_fired;
 }
 
 
@@ -203,6 +203,16 @@ public:
      */
     virtual void UpdateScore( EDA_COMBINED_MATCHER& aMatcher ) override;
 
+    /**
+     * Compute the score of this alias for one more search term, without changing
+     * the node. Only reads the node strings, so it can be called from a worker thread.
+     *
+     * @param aMatcher  an EDA_COMBINED_MATCHER initialized with the search term
+     * @param aScore    the score for the previous terms
+     * @return the new score, 0 if the term does not match
+     */
+    int ScoreTerm( EDA_COMBINED_MATCHER& aMatcher, int aScore ) const;
+
 protected:
     /**
      * Add a new unit to the component and return it.
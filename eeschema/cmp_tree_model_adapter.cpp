@@ -22,8 +22,6 @@
 #include <cmp_tree_model_adapter.h>
 
 #include <class_library.h>
-#include <eda_pattern_match.h>
-#include <wx/tokenzr.h>
 
 
 CMP_TREE_MODEL_ADAPTER::WIDTH_CACHE CMP_TREE_MODEL_ADAPTER::m_width_cache;
@@ -160,6 +158,8 @@ void CMP_TREE_MODEL_ADAPTER::AddAliasList(
             std::vector<LIB_ALIAS*> const&  aAliasList,
             PART_LIB*               aOptionalLib )
 {
+    m_search_index.Clear();
+
     auto& lib_node = m_tree.AddLib( aNodeName );
 
     for( auto a: aAliasList )
@@ -174,17 +174,13 @@ void CMP_TREE_MODEL_ADAPTER::AddAliasList(
 
 void CMP_TREE_MODEL_ADAPTER::UpdateSearchString( wxString const& aSearch )
 {
-    m_tree.ResetScore();
-
-    wxStringTokenizer tokenizer( aSearch );
+    if( !m_search_index.IsBuilt() )
+        m_search_index.Build( m_tree );
 
-    while( tokenizer.HasMoreTokens() )
-    {
-        const wxString term = tokenizer.GetNextToken().Lower();
-        EDA_COMBINED_MATCHER matcher( term );
+    std::vector<int> scores;
 
-        m_tree.UpdateScore( matcher );
-    }
+    m_search_index.Score( aSearch, scores );
+    m_search_index.ApplyScores( m_tree, scores );
 
     m_tree.SortNodes();
     Cleared();
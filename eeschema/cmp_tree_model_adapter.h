@@ -23,6 +23,7 @@
 #define _CMP_TREE_MODEL_ADAPTER_H
 
 #include <cmp_tree_model.h>
+#include <cmp_tree_search.h>
 
 #include <wx/hashmap.h>
 #include <wx/dataview.h>
@@ -310,6 +311,7 @@ private:
     int                 m_preselect_unit;
 
     CMP_TREE_NODE_ROOT  m_tree;
+    CMP_TREE_SEARCH_INDEX m_search_index;  ///< built on the first search
 
     wxDataViewColumn*   m_col_part;
     wxDataViewColumn*   m_col_desc;
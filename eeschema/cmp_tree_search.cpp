@@ -0,0 +1,321 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmp_tree_search.h>
+#include <cmp_tree_model.h>
+
+#include <eda_pattern_match.h>
+#include <make_unique.h>
+#include <wx/tokenzr.h>
+#include <algorithm>
+
+
+// The score of the aliases before any search term is applied, see cmp_tree_model.cpp
+static const int kLowestDefaultScore = 1;
+
+// Number of aliases scored between two tests of the cancel flag
+static const int kCancelCheckInterval = 256;
+
+
+static inline uint64_t trigramKey( wchar_t aFirst, wchar_t aSecond, wchar_t aThird )
+{
+    // Unicode code points are 21 bits long
+    return ( (uint64_t) (uint32_t) aFirst << 42 ) | ( (uint64_t) (uint32_t) aSecond << 21 )
+           | (uint64_t) (uint32_t) aThird;
+}
+
+
+CMP_TREE_SEARCH_INDEX::CMP_TREE_SEARCH_INDEX()
+    : m_built( false ),
+      m_lastValid( false )
+{
+}
+
+
+void CMP_TREE_SEARCH_INDEX::Clear()
+{
+    m_aliases.clear();
+    m_libs.clear();
+    m_libAliases.clear();
+    m_trigrams.clear();
+    m_built = false;
+
+    m_lastTerms.clear();
+    m_lastMatches.clear();
+    m_lastValid = false;
+}
+
+
+void CMP_TREE_SEARCH_INDEX::Build( CMP_TREE_NODE_ROOT& aRoot )
+{
+    Clear();
+
+    for( auto& libNode: aRoot.Children )
+    {
+        if( libNode->Type != CMP_TREE_NODE::LIB )
+            continue;
+
+        int libIdx = (int) m_libs.size();
+
+        m_libs.push_back( static_cast<CMP_TREE_NODE_LIB*>( &*libNode ) );
+        m_libAliases.emplace_back();
+
+        for( auto& aliasNode: libNode->Children )
+        {
+            if( aliasNode->Type != CMP_TREE_NODE::ALIAS )
+                continue;
+
+            int aliasIdx = (int) m_aliases.size();
+
+            m_aliases.push_back( static_cast<CMP_TREE_NODE_ALIAS*>( &*aliasNode ) );
+            m_libAliases.back().push_back( aliasIdx );
+
+            addTrigrams( aliasNode->MatchName, aliasIdx );
+            addTrigrams( aliasNode->SearchText, aliasIdx );
+        }
+    }
+
+    m_built = true;
+}
+
+
+void CMP_TREE_SEARCH_INDEX::addTrigrams( const wxString& aText, int aAlias )
+{
+    std::wstring text = aText.ToStdWstring();
+
+    for( size_t ii = 0; ii + 2 < text.size(); ++ii )
+    {
+        std::vector<int>& aliases = m_trigrams[ trigramKey( text[ii], text[ii+1], text[ii+2] ) ];
+
+        // The aliases are indexed in increasing order, so the lists stay sorted
+        if( aliases.empty() || aliases.back() != aAlias )
+            aliases.push_back( aAlias );
+    }
+}
+
+
+bool CMP_TREE_SEARCH_INDEX::isPlainTerm( const wxString& aTerm )
+{
+    // Characters without meaning for the regular expression, wildcard
+    // and relational matchers of EDA_COMBINED_MATCHER
+    static const wxString plainPunct = wxT( "_-/,#%&!@~;:'\"" );
+
+    for( wxString::const_iterator it = aTerm.begin(); it != aTerm.end(); ++it )
+    {
+        if( !wxIsalnum( *it ) && plainPunct.Find( *it ) == wxNOT_FOUND )
+            return false;
+    }
+
+    return true;
+}
+
+
+void CMP_TREE_SEARCH_INDEX::findCandidates( const wxString& aTerm,
+                                            std::vector<int>& aCandidates ) const
+{
+    std::wstring term = aTerm.ToStdWstring();
+    std::vector<const std::vector<int>*> lists;
+
+    wxASSERT( term.size() >= 3 );
+
+    aCandidates.clear();
+
+    for( size_t ii = 0; ii + 2 < term.size(); ++ii )
+    {
+        auto it = m_trigrams.find( trigramKey( term[ii], term[ii+1], term[ii+2] ) );
+
+        if( it == m_trigrams.end() )
+        {
+            lists.clear();
+            break;
+        }
+
+        lists.push_back( &it->second );
+    }
+
+    if( !lists.empty() )
+    {
+        // Intersect the shortest lists first
+        std::sort( lists.begin(), lists.end(),
+                []( const std::vector<int>* a, const std::vector<int>* b )
+                    { return a->size() < b->size(); } );
+
+        aCandidates = *lists[0];
+
+        for( size_t ii = 1; ii < lists.size() && !aCandidates.empty(); ++ii )
+        {
+            std::vector<int> intersection;
+
+            std::set_intersection( aCandidates.begin(), aCandidates.end(),
+                                   lists[ii]->begin(), lists[ii]->end(),
+                                   std::back_inserter( intersection ) );
+            aCandidates.swap( intersection );
+        }
+    }
+
+    // All the aliases of a library match its name
+    bool libMatch = false;
+
+    for( size_t ii = 0; ii < m_libs.size(); ++ii )
+    {
+        if( m_libs[ii]->MatchName.Find( aTerm ) != wxNOT_FOUND )
+        {
+            aCandidates.insert( aCandidates.end(), m_libAliases[ii].begin(),
+                                m_libAliases[ii].end() );
+            libMatch = true;
+        }
+    }
+
+    if( libMatch )
+    {
+        std::sort( aCandidates.begin(), aCandidates.end() );
+        aCandidates.erase( std::unique( aCandidates.begin(), aCandidates.end() ),
+                           aCandidates.end() );
+    }
+}
+
+
+bool CMP_TREE_SEARCH_INDEX::Score( const wxString& aSearch, std::vector<int>& aScores,
+                                   const std::atomic<bool>* aCancel )
+{
+    std::vector<wxString> terms;
+    wxStringTokenizer tokenizer( aSearch );
+
+    while( tokenizer.HasMoreTokens() )
+        terms.push_back( tokenizer.GetNextToken().Lower() );
+
+    bool allPlain = std::all_of( terms.begin(), terms.end(), isPlainTerm );
+
+    // Each term must be matched.  If each previous term is a part of a new term, the new
+    // search can only match aliases matched by the previous one (only for substring matches).
+    bool refine = m_lastValid && allPlain
+                  && std::all_of( m_lastTerms.begin(), m_lastTerms.end(), isPlainTerm );
+
+    for( const wxString& lastTerm : m_lastTerms )
+    {
+        if( !refine )
+            break;
+
+        refine = std::any_of( terms.begin(), terms.end(),
+                [&lastTerm]( const wxString& term ) { return term.Contains( lastTerm ); } );
+    }
+
+    bool             allAliases = !refine;
+    std::vector<int> candidates;
+
+    if( refine )
+        candidates = m_lastMatches;
+
+    for( const wxString& term : terms )
+    {
+        // Shorter terms have no trigram
+        if( !isPlainTerm( term ) || term.length() < 3 )
+            continue;
+
+        std::vector<int> termCandidates;
+        findCandidates( term, termCandidates );
+
+        if( allAliases )
+        {
+            candidates.swap( termCandidates );
+            allAliases = false;
+        }
+        else
+        {
+            std::vector<int> intersection;
+
+            std::set_intersection( candidates.begin(), candidates.end(),
+                                   termCandidates.begin(), termCandidates.end(),
+                                   std::back_inserter( intersection ) );
+            candidates.swap( intersection );
+        }
+    }
+
+    if( allAliases )
+    {
+        candidates.resize( m_aliases.size() );
+
+        for( size_t ii = 0; ii < m_aliases.size(); ++ii )
+            candidates[ii] = ii;
+    }
+
+    std::vector<std::unique_ptr<EDA_COMBINED_MATCHER>> matchers;
+
+    for( const wxString& term : terms )
+        matchers.push_back( std::make_unique<EDA_COMBINED_MATCHER>( term ) );
+
+    // Aliases which are not candidates do not match
+    aScores.assign( m_aliases.size(), terms.empty() ? kLowestDefaultScore : 0 );
+
+    std::vector<int> matches;
+
+    for( size_t ii = 0; ii < candidates.size(); ++ii )
+    {
+        if( aCancel && ( ii % kCancelCheckInterval ) == 0 && aCancel->load() )
+            return false;
+
+        int aliasIdx = candidates[ii];
+        int score = kLowestDefaultScore;
+
+        for( auto& matcher : matchers )
+        {
+            score = m_aliases[aliasIdx]->ScoreTerm( *matcher, score );
+
+            if( score <= 0 )
+                break;
+        }
+
+        aScores[aliasIdx] = score;
+
+        if( score > 0 )
+            matches.push_back( aliasIdx );
+    }
+
+    m_lastTerms = terms;
+    m_lastMatches.swap( matches );
+    m_lastValid = true;
+
+    return true;
+}
+
+
+void CMP_TREE_SEARCH_INDEX::ApplyScores( CMP_TREE_NODE_ROOT& aRoot,
+                                         const std::vector<int>& aScores )
+{
+    wxCHECK_RET( aScores.size() == m_aliases.size(), "Scores not computed by this index" );
+
+    aRoot.ResetScore();
+
+    // Without search term, all the nodes keep the default score
+    if( m_lastTerms.empty() )
+        return;
+
+    for( size_t ii = 0; ii < m_aliases.size(); ++ii )
+        m_aliases[ii]->Score = aScores[ii];
+
+    for( size_t ii = 0; ii < m_libs.size(); ++ii )
+    {
+        int score = 0;
+
+        for( int aliasIdx : m_libAliases[ii] )
+            score = std::max( score, aScores[aliasIdx] );
+
+        m_libs[ii]->Score = score;
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _CMP_TREE_SEARCH_H
+#define _CMP_TREE_SEARCH_H
+
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <wx/string.h>
+
+class CMP_TREE_NODE;
+class CMP_TREE_NODE_ALIAS;
+class CMP_TREE_NODE_LIB;
+class CMP_TREE_NODE_ROOT;
+
+
+/**
+ * Search index of the component selector tree.
+ *
+ * The alias nodes are indexed by the trigrams of their names, keywords and
+ * descriptions.  A search term which can only match as a substring (no regular
+ * expression, wildcard or relational syntax) is only scored against the aliases
+ * having all of its trigrams, or belonging to a library whose name contains it.
+ * Other terms are scored against all the aliases.
+ *
+ * When the new search string only extends the previous one (more characters
+ * or more terms), only the aliases matching the previous search are scored.
+ *
+ * The scores are the ones computed by CMP_TREE_NODE_ALIAS::UpdateScore().
+ *
+ * Usage:
+ * - `Build()` once the tree is populated, and again each time it is modified
+ * - `Score()` to compute the scores of a search string; it only reads the tree,
+ *      so it can run in a worker thread (one search at a time), and can be cancelled
+ * - `ApplyScores()` from the thread owning the tree, to store the scores in it
+ */
+class CMP_TREE_SEARCH_INDEX
+{
+public:
+    CMP_TREE_SEARCH_INDEX();
+
+    /**
+     * Index all the alias nodes of a tree.
+     */
+    void Build( CMP_TREE_NODE_ROOT& aRoot );
+
+    void Clear();
+
+    bool IsBuilt() const { return m_built; }
+
+    /**
+     * Compute the scores of all the aliases for a search string.
+     *
+     * @param aSearch   the search string, terms separated by white spaces
+     * @param aScores   receives the score of each alias, in the Build() order
+     * @param aCancel   if not null, the search stops as soon as it is set
+     * @return false if cancelled, and aScores is unusable
+     */
+    bool Score( const wxString& aSearch, std::vector<int>& aScores,
+                const std::atomic<bool>* aCancel = nullptr );
+
+    /**
+     * Store the scores computed by the last Score() in the tree, as
+     * CMP_TREE_NODE_ROOT::UpdateScore() would do for each term of the search string.
+     */
+    void ApplyScores( CMP_TREE_NODE_ROOT& aRoot, const std::vector<int>& aScores );
+
+private:
+    /**
+     * @return true if \a aTerm can only be matched as a substring, so the
+     * index can be used to find the aliases containing it.
+     */
+    static bool isPlainTerm( const wxString& aTerm );
+
+    /// Add the aliases which can contain the plain term \a aTerm to \a aCandidates.
+    void findCandidates( const wxString& aTerm, std::vector<int>& aCandidates ) const;
+
+    void addTrigrams( const wxString& aText, int aAlias );
+
+    std::vector<CMP_TREE_NODE_ALIAS*>           m_aliases;
+    std::vector<CMP_TREE_NODE_LIB*>             m_libs;
+    std::vector<std::vector<int>>               m_libAliases;   ///< indexes in m_aliases
+    std::unordered_map<uint64_t, std::vector<int>> m_trigrams;  ///< sorted alias indexes
+
+    bool                                        m_built;
+
+    // The previous search, to refine it
+    std::vector<wxString>                       m_lastTerms;
+    std::vector<int>                            m_lastMatches;  ///< sorted alias indexes
+    bool                                        m_lastValid;
+};
+
+
+#endif // _CMP_TREE_SEARCH_H
@@ -48,6 +48,8 @@
 #include <symbol_lib_table.h>
 
 #include <kiway.h>
+#include <kiface_ids.h>
+#include <sch_io_mgr.h>
 #include <sim/sim_plot_frame.h>
 
 // The main sheet of the project
@@ -130,7 +132,14 @@ static struct IFACE : public KIFACE_I
      */
     void* IfaceOrAddress( int aDataId ) override
     {
-        return NULL;
+        switch( aDataId )
+        {
+        case KIFACE_NEW_SCH_LEGACY_PLUGIN:
+            return (void*) SCH_IO_MGR::FindPlugin( SCH_IO_MGR::SCH_LEGACY );
+
+        default:
+            return NULL;
+        }
     }
 
 } kiface( "eeschema", KIWAY::FACE_SCH );
@@ -151,8 +151,12 @@ public:
 
     void SetStart( const wxPoint& aPoint ) { m_ArcStart = aPoint; }
 
+    wxPoint GetStart() const { return m_ArcStart; }
+
     void SetEnd( const wxPoint& aPoint ) { m_ArcEnd = aPoint; }
 
+    wxPoint GetEnd() const { return m_ArcEnd; }
+
     wxString GetSelectMenuText() const override;
 
     BITMAP_DEF GetMenuImage() const override;
@@ -65,6 +65,8 @@ public:
 
     void AddPoint( const wxPoint& aPoint ) { m_BezierPoints.push_back( aPoint ); }
 
+    const std::vector<wxPoint>& GetPoints() const { return m_BezierPoints; }
+
     void SetOffset( const wxPoint& aOffset ) override;
 
     /**
@@ -74,6 +74,8 @@ public:
      */
     unsigned GetCornerCount() const { return m_PolyPoints.size(); }
 
+    const std::vector<wxPoint>& GetPolyPoints() const { return m_PolyPoints; }
+
     bool HitTest( const wxPoint& aPosition ) const override;
 
     bool HitTest( const wxPoint &aPosition, int aThreshold, const TRANSFORM& aTransform ) const override;
@@ -0,0 +1,265 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 1992-2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file sch_item_index.cpp
+ */
+
+#include <fctsys.h>
+#include <sch_item_struct.h>
+#include <sch_component.h>
+#include <sch_sheet.h>
+#include <sch_item_index.h>
+
+#include <algorithm>
+
+
+/* The bounding boxes are inflated by this margin (in mils) when inserted,
+ * because the hit test of some items uses a pen size a bit larger than the one
+ * used by their bounding box.
+ */
+#define SCH_INDEX_MARGIN 50
+
+
+SCH_ITEM_INDEX::SCH_ITEM_INDEX() :
+    m_nextOrder( 0 ),
+    m_valid( false )
+{
+}
+
+
+void SCH_ITEM_INDEX::Build( SCH_ITEM* aFirstItem )
+{
+    Clear();
+
+    m_valid = true;
+
+    for( SCH_ITEM* item = aFirstItem; item; item = item->Next() )
+        Insert( item );
+}
+
+
+void SCH_ITEM_INDEX::Insert( SCH_ITEM* aItem )
+{
+    if( !m_valid )
+        return;
+
+    if( m_entries.count( aItem ) )
+        Remove( aItem );
+
+    ENTRY& entry = m_entries[aItem];
+
+    entry.m_order = m_nextOrder++;
+    entry.m_changing = false;
+
+    insertGeometry( aItem, entry );
+}
+
+
+void SCH_ITEM_INDEX::Remove( SCH_ITEM* aItem )
+{
+    if( !m_valid )
+        return;
+
+    auto found = m_entries.find( aItem );
+
+    if( found == m_entries.end() )
+        return;
+
+    if( found->second.m_changing )
+        m_changing.erase( std::remove( m_changing.begin(), m_changing.end(), aItem ),
+                          m_changing.end() );
+    else
+        removeGeometry( aItem, found->second );
+
+    m_entries.erase( found );
+}
+
+
+void SCH_ITEM_INDEX::Update( SCH_ITEM* aItem )
+{
+    if( !m_valid )
+        return;
+
+    auto found = m_entries.find( aItem );
+
+    if( found == m_entries.end() || found->second.m_changing )
+        return;
+
+    removeGeometry( aItem, found->second );
+    insertGeometry( aItem, found->second );
+}
+
+
+void SCH_ITEM_INDEX::BeginChange( SCH_ITEM* aItem )
+{
+    if( !m_valid )
+        return;
+
+    auto found = m_entries.find( aItem );
+
+    if( found == m_entries.end() || found->second.m_changing )
+        return;
+
+    removeGeometry( aItem, found->second );
+    found->second.m_changing = true;
+    m_changing.push_back( aItem );
+}
+
+
+void SCH_ITEM_INDEX::EndChanges()
+{
+    for( SCH_ITEM* item : m_changing )
+    {
+        ENTRY& entry = m_entries.at( item );
+
+        entry.m_changing = false;
+        insertGeometry( item, entry );
+    }
+
+    m_changing.clear();
+}
+
+
+void SCH_ITEM_INDEX::insertGeometry( SCH_ITEM* aItem, ENTRY& aEntry )
+{
+    aEntry.m_bbox = aItem->GetBoundingBox();
+
+    // Sheet pins can be hit outside of the sheet
+    if( aItem->Type() == SCH_SHEET_T )
+    {
+        for( SCH_SHEET_PIN& pin : ( (SCH_SHEET*) aItem )->GetPins() )
+            aEntry.m_bbox.Merge( pin.GetBoundingBox() );
+    }
+
+    aEntry.m_bbox.Normalize();
+    aEntry.m_bbox.Inflate( SCH_INDEX_MARGIN );
+
+    aEntry.m_connections.clear();
+
+    // A component not found in libraries has no connection point
+    if( aItem->Type() != SCH_COMPONENT_T || ( (SCH_COMPONENT*) aItem )->GetPartRef().lock() )
+        aItem->GetConnectionPoints( aEntry.m_connections );
+
+    const int mmin[2] = { aEntry.m_bbox.GetX(), aEntry.m_bbox.GetY() };
+    const int mmax[2] = { aEntry.m_bbox.GetRight(), aEntry.m_bbox.GetBottom() };
+
+    m_tree.Insert( mmin, mmax, aItem );
+
+    for( const wxPoint& pt : aEntry.m_connections )
+    {
+        std::vector<SCH_ITEM*>& items = m_connections[pt];
+
+        // Some items have several connection points at the same position
+        if( std::find( items.begin(), items.end(), aItem ) == items.end() )
+            items.push_back( aItem );
+    }
+}
+
+
+void SCH_ITEM_INDEX::removeGeometry( SCH_ITEM* aItem, ENTRY& aEntry )
+{
+    const int mmin[2] = { aEntry.m_bbox.GetX(), aEntry.m_bbox.GetY() };
+    const int mmax[2] = { aEntry.m_bbox.GetRight(), aEntry.m_bbox.GetBottom() };
+
+    m_tree.Remove( mmin, mmax, aItem );
+
+    for( const wxPoint& pt : aEntry.m_connections )
+    {
+        auto connection = m_connections.find( pt );
+
+        if( connection == m_connections.end() )
+            continue;
+
+        std::vector<SCH_ITEM*>& items = connection->second;
+        items.erase( std::remove( items.begin(), items.end(), aItem ), items.end() );
+
+        if( items.empty() )
+            m_connections.erase( connection );
+    }
+
+    aEntry.m_connections.clear();
+}
+
+
+void SCH_ITEM_INDEX::Clear()
+{
+    m_tree.RemoveAll();
+    m_entries.clear();
+    m_connections.clear();
+    m_changing.clear();
+    m_nextOrder = 0;
+    m_valid = false;
+}
+
+
+void SCH_ITEM_INDEX::sortByOrder( std::vector<SCH_ITEM*>& aItems ) const
+{
+    std::sort( aItems.begin(), aItems.end(),
+               [this]( SCH_ITEM* aFirst, SCH_ITEM* aSecond ) -> bool
+               {
+                   return m_entries.at( aFirst ).m_order < m_entries.at( aSecond ).m_order;
+               } );
+}
+
+
+void SCH_ITEM_INDEX::QueryPosition( const wxPoint& aPosition, int aAccuracy,
+                                    std::vector<SCH_ITEM*>& aItems ) const
+{
+    aItems.clear();
+
+    const int mmin[2] = { aPosition.x - aAccuracy, aPosition.y - aAccuracy };
+    const int mmax[2] = { aPosition.x + aAccuracy, aPosition.y + aAccuracy };
+
+    auto visitor = [&aItems]( SCH_ITEM* aItem ) -> bool
+    {
+        aItems.push_back( aItem );
+        return true;
+    };
+
+    m_tree.Search( mmin, mmax, visitor );
+
+    aItems.insert( aItems.end(), m_changing.begin(), m_changing.end() );
+    sortByOrder( aItems );
+}
+
+
+void SCH_ITEM_INDEX::QueryConnection( const std::vector<wxPoint>& aPositions,
+                                      std::vector<SCH_ITEM*>& aItems ) const
+{
+    aItems.clear();
+
+    for( const wxPoint& pt : aPositions )
+    {
+        auto found = m_connections.find( pt );
+
+        if( found != m_connections.end() )
+            aItems.insert( aItems.end(), found->second.begin(), found->second.end() );
+    }
+
+    aItems.insert( aItems.end(), m_changing.begin(), m_changing.end() );
+    sortByOrder( aItems );
+
+    if( aPositions.size() > 1 )
+        aItems.erase( std::unique( aItems.begin(), aItems.end() ), aItems.end() );
+}
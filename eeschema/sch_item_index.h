@@ -0,0 +1,160 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 1992-2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file sch_item_index.h
+ * @brief Spatial index of the items of a schematic screen.
+ */
+
+#ifndef SCH_ITEM_INDEX_H
+#define SCH_ITEM_INDEX_H
+
+#include <unordered_map>
+#include <vector>
+
+#include <base_struct.h>
+#include <geometry/rtree.h>
+
+class SCH_ITEM;
+
+
+/// Hash function for wxPoint, used to index the schematic items by position
+struct WXPOINT_HASH
+{
+    std::size_t operator()( const wxPoint& aPoint ) const
+    {
+        return std::hash<unsigned long long>()(
+                ( (unsigned long long) (unsigned int) aPoint.x << 32 ) | (unsigned int) aPoint.y );
+    }
+};
+
+
+/**
+ * Class SCH_ITEM_INDEX
+ * indexes the items of a SCH_SCREEN draw list by bounding box, in a R-tree, and
+ * by connection point, in a hash table.
+ *
+ * The queries return the candidate items in the draw list order, so a search using the
+ * index returns the same item as a search walking the draw list.  The candidates must
+ * still be tested by the caller: the index only guarantees that no matching item is missed.
+ *
+ * The geometry of each item is stored when it is inserted.  An item changed in place is
+ * signaled by BeginChange(), before or after the change: it is then returned by all the
+ * queries until EndChanges() stores its new geometry.
+ */
+class SCH_ITEM_INDEX
+{
+public:
+    SCH_ITEM_INDEX();
+
+    /**
+     * Function Build
+     * clears the index and inserts all items of a draw list.
+     * @param aFirstItem is the first item of the draw list.
+     */
+    void Build( SCH_ITEM* aFirstItem );
+
+    /**
+     * Function Insert
+     * adds \a aItem after the other items in the draw list order.
+     */
+    void Insert( SCH_ITEM* aItem );
+
+    /**
+     * Function Remove
+     * removes \a aItem, using the geometry it had when it was inserted.
+     */
+    void Remove( SCH_ITEM* aItem );
+
+    /**
+     * Function Update
+     * stores the current geometry of \a aItem, changed in place, keeping its rank in the
+     * draw list order.  Items which are not indexed, or are between BeginChange() and
+     * EndChanges(), are ignored.
+     */
+    void Update( SCH_ITEM* aItem );
+
+    /**
+     * Function BeginChange
+     * removes the stored geometry of \a aItem, which is changed in place.  Until
+     * EndChanges() is called, \a aItem is a candidate of all the queries.
+     * Items which are not indexed are ignored.
+     */
+    void BeginChange( SCH_ITEM* aItem );
+
+    /**
+     * Function EndChanges
+     * stores the current geometry of the items given to BeginChange().
+     */
+    void EndChanges();
+
+    /**
+     * Function Clear
+     * removes all items, and invalidates the index.
+     */
+    void Clear();
+
+    void Invalidate()       { Clear(); }
+
+    bool IsValid() const    { return m_valid; }
+
+    /**
+     * Function QueryPosition
+     * collects the items which can be hit at \a aPosition within \a aAccuracy.
+     * @param aItems receives the candidate items, in draw list order.
+     */
+    void QueryPosition( const wxPoint& aPosition, int aAccuracy,
+                        std::vector<SCH_ITEM*>& aItems ) const;
+
+    /**
+     * Function QueryConnection
+     * collects the items which have a connection point at one of \a aPositions.
+     * @param aItems receives the items, in draw list order, each item once.
+     */
+    void QueryConnection( const std::vector<wxPoint>& aPositions,
+                          std::vector<SCH_ITEM*>& aItems ) const;
+
+private:
+    struct ENTRY
+    {
+        EDA_RECT             m_bbox;            ///< the inflated bounding box, when inserted
+        std::vector<wxPoint> m_connections;     ///< the connection points, when inserted
+        int                  m_order;           ///< the rank in the draw list
+        bool                 m_changing;        ///< true between BeginChange() and EndChanges()
+    };
+
+    void insertGeometry( SCH_ITEM* aItem, ENTRY& aEntry );
+    void removeGeometry( SCH_ITEM* aItem, ENTRY& aEntry );
+    void sortByOrder( std::vector<SCH_ITEM*>& aItems ) const;
+
+    typedef RTree<SCH_ITEM*, int, 2, float> SCH_RTREE;
+
+    mutable SCH_RTREE                           m_tree;     // Search() is not const
+    std::unordered_map<SCH_ITEM*, ENTRY>        m_entries;
+    std::unordered_map<wxPoint, std::vector<SCH_ITEM*>, WXPOINT_HASH> m_connections;
+    std::vector<SCH_ITEM*>                      m_changing;     ///< see BeginChange()
+    int                                         m_nextOrder;
+    bool                                        m_valid;
+};
+
+#endif  // SCH_ITEM_INDEX_H
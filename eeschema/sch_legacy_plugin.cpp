@@ -26,11 +26,15 @@
 #include <wx/mstream.h>
 #include <wx/filename.h>
 #include <wx/tokenzr.h>
+#include <wx/ffile.h>
 
+#include <common.h>
+#include <cache_file.h>
 #include <drawtxt.h>
 #include <kiway.h>
 #include <kicad_string.h>
 #include <richio.h>
+#include <profile.h>
 #include <core/typeinfo.h>
 #include <properties.h>
 
@@ -465,6 +469,61 @@ static void parseQuotedString( wxString& aString, FILE_LINE_READER& aReader,
 }
 
 
+/// Identifies the binary symbol library cache files.
+#define SYMBOL_CACHE_MAGIC      "KiCad-Symbol-Cache"
+
+/// Change it each time the binary cache format or the symbol classes are changed.
+#define SYMBOL_CACHE_VERSION    2
+
+/// Environment variable disabling the binary symbol library cache, to compare load times.
+#define SYMBOL_CACHE_DISABLE_ENV    wxT( "KICAD_NO_SYMBOL_CACHE" )
+
+
+/**
+ * Struct SYMBOL_CACHE_KEY
+ * identifies the content of a library file and of its document file.  A binary cache
+ * file can only be used if its key is the same as the key of the library.
+ */
+struct SYMBOL_CACHE_KEY
+{
+    wxString    m_LibPath;
+    wxInt64     m_LibSize;
+    wxInt64     m_LibModTime;       ///< in ms since the epoch
+    wxInt64     m_DocSize;          ///< -1 if there is no document file
+    wxInt64     m_DocModTime;
+    wxUint64    m_Hash;             ///< the hash of the library and document file contents
+
+    bool operator==( const SYMBOL_CACHE_KEY& aOther ) const
+    {
+        return m_LibPath == aOther.m_LibPath && m_LibSize == aOther.m_LibSize
+            && m_LibModTime == aOther.m_LibModTime && m_DocSize == aOther.m_DocSize
+            && m_DocModTime == aOther.m_DocModTime && m_Hash == aOther.m_Hash;
+    }
+};
+
+
+/**
+ * Function hashFile
+ * hashes the content of \a aFileName into \a aHash.
+ * @return false if the file cannot be read.
+ */
+static bool hashFile( const wxString& aFileName, wxUint64& aHash )
+{
+    wxFFile file( aFileName, "rb" );
+
+    if( !file.IsOpened() )
+        return false;
+
+    char   buffer[64 * 1024];
+    size_t count;
+
+    while( ( count = file.Read( buffer, sizeof( buffer ) ) ) > 0 )
+        aHash = HashBytes( buffer, count, aHash );
+
+    return !file.Error();
+}
+
+
 /**
  * Class SCH_LEGACY_PLUGIN_CACHE
  * is a cache assistant for the part library portion of the #SCH_PLUGIN API, and only for the
@@ -483,12 +542,19 @@ class SCH_LEGACY_PLUGIN_CACHE
     int             m_versionMinor;
     int             m_libType;      // Is this cache a component or symbol library.
 
-    LIB_PART*       loadPart( FILE_LINE_READER& aReader );
+    void            loadLibFile( bool aDeferDrawEntries );
+    LIB_PART*       loadPart( FILE_LINE_READER& aReader, bool aDeferDrawEntries = false );
     void            loadHeader( FILE_LINE_READER& aReader );
     void            loadAliases( std::unique_ptr< LIB_PART >& aPart, FILE_LINE_READER& aReader );
     void            loadField( std::unique_ptr< LIB_PART >& aPart, FILE_LINE_READER& aReader );
     void            loadDrawEntries( std::unique_ptr< LIB_PART >& aPart,
                                      FILE_LINE_READER&            aReader );
+    void            loadDrawItems( std::unique_ptr< LIB_PART >& aPart,
+                                   FILE_LINE_READER&            aReader );
+    void            deferDrawEntries( std::unique_ptr< LIB_PART >& aPart,
+                                      FILE_LINE_READER&            aReader );
+    void            loadDeferredDrawEntries( LIB_PART* aPart, long aPosition,
+                                             unsigned aLineNumber );
     void            loadFootprintFilters( std::unique_ptr< LIB_PART >& aPart,
                                           FILE_LINE_READER&            aReader );
     void            loadDocs();
@@ -507,6 +573,18 @@ class SCH_LEGACY_PLUGIN_CACHE
 
     void            saveDocFile();
 
+    // The binary cache of the parsed library, see Load().
+    bool            makeCacheKey( SYMBOL_CACHE_KEY& aKey ) const;
+    wxFileName      getCacheFileName() const;
+    bool            loadBinaryCache( const SYMBOL_CACHE_KEY& aKey );
+    void            saveBinaryCache( const SYMBOL_CACHE_KEY& aKey );
+    void            writePart( CACHE_FILE_WRITER& aWriter, LIB_PART* aPart );
+    LIB_PART*       readPart( CACHE_FILE_READER& aReader,
+                              const std::shared_ptr< std::string >& aData );
+    void            readPartBody( const std::string& aData, size_t aOffset, LIB_PART* aPart );
+    void            writeDrawItem( CACHE_FILE_WRITER& aWriter, LIB_ITEM* aItem );
+    LIB_ITEM*       readDrawItem( CACHE_FILE_READER& aReader, LIB_PART* aPart );
+
     friend SCH_LEGACY_PLUGIN;
 
 public:
@@ -522,6 +600,19 @@ public:
     /// Save the entire library to file m_libFileName;
     void Save( bool aSaveDocFile = true );
 
+    /**
+     * Load the library file.
+     *
+     * The parsed library is kept in a binary cache file, in the user cache directory.
+     * It is used instead of the library file while the library and document files are
+     * the same (path, size, modification time and contents), and rebuilt otherwise.
+     * Set the KICAD_NO_SYMBOL_CACHE environment variable to always parse the library
+     * file; the load times are traced with the KI_SCH_LEGACY_PLUGIN trace mask.
+     *
+     * The graphic items of the parts are only loaded when first used (see
+     * LIB_PART::SetBodyLoader()), from the binary cache data or from the library file.
+     * The library file is fully parsed only to write the binary cache file.
+     */
     void Load();
 
     void AddSymbol( const LIB_PART* aPart );
@@ -2155,11 +2246,38 @@ void SCH_LEGACY_PLUGIN_CACHE::Load()
                  wxString::Format( "Cannot use relative file paths in legacy plugin to "
                                    "open library '%s'.", m_libFileName.GetFullPath() ) );
 
+    PROF_COUNTER     timer;
+    SYMBOL_CACHE_KEY key;
+    bool             useCache = !wxGetEnv( SYMBOL_CACHE_DISABLE_ENV, NULL ) && makeCacheKey( key );
+
+    if( useCache && loadBinaryCache( key ) )
+    {
+        wxLogTrace( traceSchLegacyPlugin, "Loaded symbol library '%s' from cache in %.1f ms",
+                    m_libFileName.GetFullPath(), timer.msecs() );
+        return;
+    }
+
+    // The binary cache needs all the graphic items: do not defer them.
+    loadLibFile( !useCache );
+
+    wxLogTrace( traceSchLegacyPlugin, "Parsed symbol library '%s' in %.1f ms",
+                m_libFileName.GetFullPath(), timer.msecs() );
+
+    if( useCache )
+        saveBinaryCache( key );
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::loadLibFile( bool aDeferDrawEntries )
+{
     wxLogTrace( traceSchLegacyPlugin, "Loading legacy symbol file '%s'",
                 m_libFileName.GetFullPath() );
 
     FILE_LINE_READER reader( m_libFileName.GetFullPath() );
 
+    // The deferred draw items can only be read from the file which was indexed.
+    m_fileModTime = GetLibModificationTime();
+
     if( !reader.ReadLine() )
         THROW_IO_ERROR( _( "unexpected end of file" ) );
 
@@ -2213,7 +2331,7 @@ void SCH_LEGACY_PLUGIN_CACHE::Load()
         if( strCompare( "DEF", line ) )
         {
             // Read one DEF/ENDDEF part entry from library:
-            loadPart( reader );
+            loadPart( reader, aDeferDrawEntries );
 
         }
     }
@@ -2346,7 +2464,7 @@ void SCH_LEGACY_PLUGIN_CACHE::loadHeader( FILE_LINE_READER& aReader )
 }
 
 
-LIB_PART* SCH_LEGACY_PLUGIN_CACHE::loadPart( FILE_LINE_READER& aReader )
+LIB_PART* SCH_LEGACY_PLUGIN_CACHE::loadPart( FILE_LINE_READER& aReader, bool aDeferDrawEntries )
 {
     const char* line = aReader.Line();
 
@@ -2470,7 +2588,12 @@ LIB_PART* SCH_LEGACY_PLUGIN_CACHE::loadPart( FILE_LINE_READER& aReader )
         else if( *line == 'F' )                          // Fields
             loadField( part, aReader );
         else if( strCompare( "DRAW", line, &line ) )     // Drawing objects.
-            loadDrawEntries( part, aReader );
+        {
+            if( aDeferDrawEntries )
+                deferDrawEntries( part, aReader );
+            else
+                loadDrawEntries( part, aReader );
+        }
         else if( strCompare( "$FPLIST", line, &line ) )  // Footprint filter list
             loadFootprintFilters( part, aReader );
         else if( strCompare( "ENDDEF", line, &line ) )   // End of part description
@@ -2694,7 +2817,14 @@ void SCH_LEGACY_PLUGIN_CACHE::loadDrawEntries( std::unique_ptr< LIB_PART >& aPar
 
     wxCHECK_RET( strCompare( "DRAW", line, &line ), "Invalid DRAW section" );
 
-    line = aReader.ReadLine();
+    loadDrawItems( aPart, aReader );
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::loadDrawItems( std::unique_ptr< LIB_PART >& aPart,
+                                             FILE_LINE_READER&            aReader )
+{
+    const char* line = aReader.ReadLine();
 
     while( line )
     {
@@ -2748,6 +2878,63 @@ void SCH_LEGACY_PLUGIN_CACHE::loadDrawEntries( std::unique_ptr< LIB_PART >& aPar
 }
 
 
+void SCH_LEGACY_PLUGIN_CACHE::deferDrawEntries( std::unique_ptr< LIB_PART >& aPart,
+                                                FILE_LINE_READER&            aReader )
+{
+    const char* line = aReader.Line();
+
+    wxCHECK_RET( strCompare( "DRAW", line, &line ), "Invalid DRAW section" );
+
+    // Remember where the draw items are, and skip them.
+    long     position = aReader.Tell();
+    unsigned lineNumber = aReader.LineNumber();
+
+    while( ( line = aReader.ReadLine() ) != NULL )
+    {
+        if( strCompare( "ENDDRAW", line ) )
+        {
+            aPart->SetBodyLoader( [this, position, lineNumber]( LIB_PART* aLibPart )
+                                  {
+                                      loadDeferredDrawEntries( aLibPart, position, lineNumber );
+                                  } );
+            return;
+        }
+    }
+
+    SCH_PARSE_ERROR( _( "file ended prematurely loading component draw element" ), aReader, line );
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::loadDeferredDrawEntries( LIB_PART* aPart, long aPosition,
+                                                       unsigned aLineNumber )
+{
+    // The positions are only valid in the file which was indexed.
+    if( GetLibModificationTime() != m_fileModTime )
+        THROW_IO_ERROR( wxString::Format( _( "library file '%s' was modified after being loaded" ),
+                                          m_libFileName.GetFullPath() ) );
+
+    LOCALE_IO        toggle;     // toggles on, then off, the C locale.
+    FILE_LINE_READER reader( m_libFileName.GetFullPath() );
+
+    reader.Seek( aPosition, aLineNumber );
+
+    // The item loaders need a unique_ptr, but the part is owned by the cache.
+    std::unique_ptr< LIB_PART > part( aPart );
+
+    try
+    {
+        loadDrawItems( part, reader );
+    }
+    catch( ... )
+    {
+        part.release();
+        throw;
+    }
+
+    part.release();
+}
+
+
 FILL_T SCH_LEGACY_PLUGIN_CACHE::parseFillMode( FILE_LINE_READER& aReader, const char* aLine,
                                                const char** aOutput )
 {
@@ -3279,11 +3466,607 @@ void SCH_LEGACY_PLUGIN_CACHE::loadFootprintFilters( std::unique_ptr< LIB_PART >&
 }
 
 
+bool SCH_LEGACY_PLUGIN_CACHE::makeCacheKey( SYMBOL_CACHE_KEY& aKey ) const
+{
+    if( !m_libFileName.FileExists() )
+        return false;
+
+    aKey.m_LibPath    = m_libFileName.GetFullPath();
+    aKey.m_LibSize    = (wxInt64) m_libFileName.GetSize().GetValue();
+    aKey.m_LibModTime = m_libFileName.GetModificationTime().GetValue().GetValue();
+    aKey.m_DocSize    = -1;
+    aKey.m_DocModTime = 0;
+    aKey.m_Hash       = HashBytes( NULL, 0 );
+
+    if( !hashFile( aKey.m_LibPath, aKey.m_Hash ) )
+        return false;
+
+    // Old libraries read the aliases documentation from the document file.
+    wxFileName docFileName = m_libFileName;
+
+    docFileName.SetExt( DOC_EXT );
+
+    if( docFileName.FileExists() )
+    {
+        aKey.m_DocSize    = (wxInt64) docFileName.GetSize().GetValue();
+        aKey.m_DocModTime = docFileName.GetModificationTime().GetValue().GetValue();
+
+        if( !hashFile( docFileName.GetFullPath(), aKey.m_Hash ) )
+            return false;
+    }
+
+    return true;
+}
+
+
+wxFileName SCH_LEGACY_PLUGIN_CACHE::getCacheFileName() const
+{
+    // Libraries with the same name can be found in several folders.
+    UTF8       libPath = m_libFileName.GetFullPath();
+    wxFileName fn;
+
+    fn.AssignDir( GetKicadCachePath() );
+    fn.AppendDir( wxT( "symbols" ) );
+    fn.SetName( m_libFileName.GetName() + wxString::Format( wxT( "-%016llx" ),
+                (unsigned long long) HashBytes( libPath.c_str(), libPath.size() ) ) );
+    fn.SetExt( wxT( "symcache" ) );
+
+    return fn;
+}
+
+
+bool SCH_LEGACY_PLUGIN_CACHE::loadBinaryCache( const SYMBOL_CACHE_KEY& aKey )
+{
+    wxFileName  cacheFileName = getCacheFileName();
+
+    // The whole file is read in one block, and parsed from memory.  It is kept in memory
+    // to load the graphic items of the parts when they are first used.
+    std::shared_ptr< std::string > data = std::make_shared< std::string >();
+
+    if( !ReadCacheFile( cacheFileName.GetFullPath(), *data ) || data->empty() )
+        return false;
+
+    std::vector< std::unique_ptr< LIB_PART > > parts;
+    int versionMajor, versionMinor, libType;
+
+    try
+    {
+        CACHE_FILE_READER reader( *data );
+        SYMBOL_CACHE_KEY  key;
+
+        if( reader.ReadString() != SYMBOL_CACHE_MAGIC
+          || reader.ReadInt() != SYMBOL_CACHE_VERSION )
+            return false;
+
+        key.m_LibPath    = reader.ReadString();
+        key.m_LibSize    = reader.ReadInt64();
+        key.m_LibModTime = reader.ReadInt64();
+        key.m_DocSize    = reader.ReadInt64();
+        key.m_DocModTime = reader.ReadInt64();
+        key.m_Hash       = (wxUint64) reader.ReadInt64();
+
+        if( !( key == aKey ) )
+            return false;
+
+        versionMajor = reader.ReadInt();
+        versionMinor = reader.ReadInt();
+        libType      = reader.ReadInt();
+
+        int partCount = reader.ReadInt();
+
+        if( partCount < 0 )
+            return false;
+
+        parts.reserve( partCount );
+
+        for( int ii = 0; ii < partCount; ++ii )
+            parts.emplace_back( readPart( reader, data ) );
+
+        // The file ends with the magic string: it was completely written.
+        if( reader.ReadString() != SYMBOL_CACHE_MAGIC )
+            return false;
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        wxLogTrace( traceSchLegacyPlugin, "Cannot use symbol cache file '%s': %s",
+                    cacheFileName.GetFullPath(), ioe.What() );
+        return false;
+    }
+
+    m_versionMajor = versionMajor;
+    m_versionMinor = versionMinor;
+    m_libType = libType;
+
+    for( std::unique_ptr< LIB_PART >& part : parts )
+    {
+        LIB_PART* libPart = part.release();
+
+        for( size_t ii = 0; ii < libPart->GetAliasCount(); ++ii )
+            m_aliases[ libPart->GetAlias( ii )->GetName() ] = libPart->GetAlias( ii );
+    }
+
+    ++m_modHash;
+    m_fileModTime = GetLibModificationTime();
+
+    return true;
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::saveBinaryCache( const SYMBOL_CACHE_KEY& aKey )
+{
+    CACHE_FILE_WRITER writer;
+    int               partCount = 0;
+
+    for( LIB_ALIAS_MAP::iterator it = m_aliases.begin();  it != m_aliases.end();  it++ )
+    {
+        if( it->second->IsRoot() )
+            partCount++;
+    }
+
+    try
+    {
+        writer.WriteString( SYMBOL_CACHE_MAGIC );
+        writer.WriteInt( SYMBOL_CACHE_VERSION );
+
+        writer.WriteString( aKey.m_LibPath );
+        writer.WriteInt64( aKey.m_LibSize );
+        writer.WriteInt64( aKey.m_LibModTime );
+        writer.WriteInt64( aKey.m_DocSize );
+        writer.WriteInt64( aKey.m_DocModTime );
+        writer.WriteInt64( (wxInt64) aKey.m_Hash );
+
+        writer.WriteInt( m_versionMajor );
+        writer.WriteInt( m_versionMinor );
+        writer.WriteInt( m_libType );
+
+        writer.WriteInt( partCount );
+
+        for( LIB_ALIAS_MAP::iterator it = m_aliases.begin();  it != m_aliases.end();  it++ )
+        {
+            if( it->second->IsRoot() )
+                writePart( writer, it->second->GetPart() );
+        }
+
+        writer.WriteString( SYMBOL_CACHE_MAGIC );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        wxLogTrace( traceSchLegacyPlugin, "Cannot cache symbol library '%s': %s",
+                    m_libFileName.GetFullPath(), ioe.What() );
+        return;
+    }
+
+    WriteCacheFile( getCacheFileName().GetFullPath(), writer.GetData() );
+}
+
+
+/// Writes the attributes of a LIB_TEXT or a LIB_FIELD, but not the text itself
+static void writeTextAttributes( CACHE_FILE_WRITER& aWriter, const EDA_TEXT& aText )
+{
+    aWriter.WritePoint( aText.GetTextPos() );
+    aWriter.WriteInt( aText.GetTextSize().x );
+    aWriter.WriteInt( aText.GetTextSize().y );
+    aWriter.WriteInt( KiROUND( aText.GetTextAngle() ) );
+    aWriter.WriteInt( aText.IsVisible() );
+    aWriter.WriteInt( aText.IsItalic() );
+    aWriter.WriteInt( aText.IsBold() );
+    aWriter.WriteInt( aText.GetHorizJustify() );
+    aWriter.WriteInt( aText.GetVertJustify() );
+}
+
+
+static void readTextAttributes( CACHE_FILE_READER& aReader, LIB_ITEM* aItem, EDA_TEXT& aText )
+{
+    aItem->SetPosition( aReader.ReadPoint() );
+
+    wxSize size;
+
+    size.x = aReader.ReadInt();
+    size.y = aReader.ReadInt();
+    aText.SetTextSize( size );
+    aText.SetTextAngle( (double) aReader.ReadInt() );
+    aText.SetVisible( aReader.ReadInt() != 0 );
+    aText.SetItalic( aReader.ReadInt() != 0 );
+    aText.SetBold( aReader.ReadInt() != 0 );
+    aText.SetHorizJustify( (EDA_TEXT_HJUSTIFY_T) aReader.ReadInt() );
+    aText.SetVertJustify( (EDA_TEXT_VJUSTIFY_T) aReader.ReadInt() );
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::writePart( CACHE_FILE_WRITER& aWriter, LIB_PART* aPart )
+{
+    aWriter.WriteString( aPart->m_name );
+    aWriter.WriteInt( aPart->GetPinNameOffset() );
+    aWriter.WriteInt( aPart->ShowPinNumbers() );
+    aWriter.WriteInt( aPart->ShowPinNames() );
+    aWriter.WriteInt( aPart->GetUnitCount() );
+    aWriter.WriteInt( aPart->UnitsLocked() );
+    aWriter.WriteInt( aPart->IsPower() );
+
+    // The first alias is the root alias.
+    aWriter.WriteInt( (int) aPart->GetAliasCount() );
+
+    for( size_t ii = 0; ii < aPart->GetAliasCount(); ++ii )
+    {
+        LIB_ALIAS* alias = aPart->GetAlias( ii );
+
+        aWriter.WriteString( alias->GetName() );
+        aWriter.WriteString( alias->GetDescription() );
+        aWriter.WriteString( alias->GetKeyWords() );
+        aWriter.WriteString( alias->GetDocFileName() );
+    }
+
+    wxArrayString& footprints = aPart->GetFootPrints();
+
+    aWriter.WriteInt( (int) footprints.GetCount() );
+
+    for( size_t ii = 0; ii < footprints.GetCount(); ++ii )
+        aWriter.WriteString( footprints[ii] );
+
+    // The fields are always loaded, the other items are in a block loaded when first used.
+    LIB_FIELDS fields;
+
+    aPart->GetFields( fields );
+    aWriter.WriteInt( (int) fields.size() );
+
+    for( LIB_FIELD& field : fields )
+        writeDrawItem( aWriter, &field );
+
+    CACHE_FILE_WRITER body;
+    int                 itemCount = 0;
+
+    for( LIB_ITEM& item : aPart->GetDrawItemList() )
+    {
+        if( item.Type() != LIB_FIELD_T )
+            itemCount++;
+    }
+
+    body.WriteInt( itemCount );
+
+    for( LIB_ITEM& item : aPart->GetDrawItemList() )
+    {
+        if( item.Type() != LIB_FIELD_T )
+            writeDrawItem( body, &item );
+    }
+
+    aWriter.WriteData( body.GetData() );
+}
+
+
+LIB_PART* SCH_LEGACY_PLUGIN_CACHE::readPart( CACHE_FILE_READER& aReader,
+                                             const std::shared_ptr< std::string >& aData )
+{
+    std::unique_ptr< LIB_PART > part( new LIB_PART( wxEmptyString ) );
+
+    part->m_name = aReader.ReadString();
+    part->SetPinNameOffset( aReader.ReadInt() );
+    part->SetShowPinNumbers( aReader.ReadInt() != 0 );
+    part->SetShowPinNames( aReader.ReadInt() != 0 );
+    part->SetUnitCount( aReader.ReadInt() );
+    part->LockUnits( aReader.ReadInt() != 0 );
+
+    if( aReader.ReadInt() )
+        part->SetPower();
+    else
+        part->SetNormal();
+
+    int aliasCount = aReader.ReadInt();
+
+    for( int ii = 0; ii < aliasCount; ++ii )
+    {
+        wxString name = aReader.ReadString();
+
+        if( !part->HasAlias( name ) )
+            part->AddAlias( name );
+
+        LIB_ALIAS* alias = part->GetAlias( name );
+
+        alias->SetDescription( aReader.ReadString() );
+        alias->SetKeyWords( aReader.ReadString() );
+        alias->SetDocFileName( aReader.ReadString() );
+    }
+
+    int footprintCount = aReader.ReadInt();
+
+    for( int ii = 0; ii < footprintCount; ++ii )
+        part->GetFootPrints().Add( aReader.ReadString() );
+
+    int fieldCount = aReader.ReadInt();
+
+    // The items are sorted once after loading, and not in AddDrawItem() after each item.
+    for( int ii = 0; ii < fieldCount; ++ii )
+    {
+        std::unique_ptr< LIB_ITEM > item( readDrawItem( aReader, part.get() ) );
+
+        if( item->Type() != LIB_FIELD_T )
+            THROW_IO_ERROR( _( "symbol cache file is corrupted" ) );
+
+        LIB_FIELD* field = (LIB_FIELD*) item.get();
+
+        if( field->GetId() < MANDATORY_FIELDS )
+            *part->GetField( field->GetId() ) = *field;
+        else
+            part->drawings.push_back( item.release() );
+    }
+
+    part->drawings.sort();
+
+    // The other items are read from the cache data when first used.  The data is released
+    // when all the parts are loaded.
+    size_t bodyOffset = aReader.SkipData();
+
+    part->SetBodyLoader( [this, aData, bodyOffset]( LIB_PART* aLibPart )
+                         {
+                             readPartBody( *aData, bodyOffset, aLibPart );
+                         } );
+
+    return part.release();
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::readPartBody( const std::string& aData, size_t aOffset,
+                                            LIB_PART* aPart )
+{
+    CACHE_FILE_READER reader( aData, aOffset );
+
+    int itemCount = reader.ReadInt();
+
+    for( int ii = 0; ii < itemCount; ++ii )
+        aPart->drawings.push_back( readDrawItem( reader, aPart ) );
+
+    aPart->drawings.sort();
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::writeDrawItem( CACHE_FILE_WRITER& aWriter, LIB_ITEM* aItem )
+{
+    aWriter.WriteInt( aItem->Type() );
+    aWriter.WriteInt( aItem->GetUnit() );
+    aWriter.WriteInt( aItem->GetConvert() );
+
+    switch( aItem->Type() )
+    {
+    case LIB_ARC_T:
+    {
+        LIB_ARC* arc = (LIB_ARC*) aItem;
+
+        aWriter.WritePoint( arc->GetPosition() );
+        aWriter.WriteInt( arc->GetRadius() );
+        aWriter.WriteInt( arc->GetFirstRadiusAngle() );
+        aWriter.WriteInt( arc->GetSecondRadiusAngle() );
+        aWriter.WritePoint( arc->GetStart() );
+        aWriter.WritePoint( arc->GetEnd() );
+        aWriter.WriteInt( arc->GetWidth() );
+        aWriter.WriteInt( arc->GetFillMode() );
+        break;
+    }
+
+    case LIB_CIRCLE_T:
+    {
+        LIB_CIRCLE* circle = (LIB_CIRCLE*) aItem;
+
+        aWriter.WritePoint( circle->GetPosition() );
+        aWriter.WriteInt( circle->GetRadius() );
+        aWriter.WriteInt( circle->GetWidth() );
+        aWriter.WriteInt( circle->GetFillMode() );
+        break;
+    }
+
+    case LIB_RECTANGLE_T:
+    {
+        LIB_RECTANGLE* rectangle = (LIB_RECTANGLE*) aItem;
+
+        aWriter.WritePoint( rectangle->GetPosition() );
+        aWriter.WritePoint( rectangle->GetEnd() );
+        aWriter.WriteInt( rectangle->GetWidth() );
+        aWriter.WriteInt( rectangle->GetFillMode() );
+        break;
+    }
+
+    case LIB_POLYLINE_T:
+    case LIB_BEZIER_T:
+    {
+        const std::vector<wxPoint>& points = ( aItem->Type() == LIB_POLYLINE_T )
+                                             ? ( (LIB_POLYLINE*) aItem )->GetPolyPoints()
+                                             : ( (LIB_BEZIER*) aItem )->GetPoints();
+
+        aWriter.WriteInt( (int) points.size() );
+
+        for( const wxPoint& pt : points )
+            aWriter.WritePoint( pt );
+
+        aWriter.WriteInt( aItem->GetWidth() );
+        aWriter.WriteInt( aItem->GetFillMode() );
+        break;
+    }
+
+    case LIB_TEXT_T:
+    {
+        LIB_TEXT* text = (LIB_TEXT*) aItem;
+
+        aWriter.WriteString( text->GetText() );
+        writeTextAttributes( aWriter, *text );
+        break;
+    }
+
+    case LIB_FIELD_T:
+    {
+        LIB_FIELD* field = (LIB_FIELD*) aItem;
+
+        aWriter.WriteInt( field->GetId() );
+        aWriter.WriteString( field->m_Text );
+        aWriter.WriteString( field->m_name );
+        writeTextAttributes( aWriter, *field );
+        break;
+    }
+
+    case LIB_PIN_T:
+    {
+        LIB_PIN* pin = (LIB_PIN*) aItem;
+
+        aWriter.WriteString( pin->GetName() );
+        aWriter.WriteString( pin->GetNumberString() );
+        aWriter.WritePoint( pin->GetPosition() );
+        aWriter.WriteInt( pin->GetLength() );
+        aWriter.WriteInt( pin->GetOrientation() );
+        aWriter.WriteInt( pin->GetNumberTextSize() );
+        aWriter.WriteInt( pin->GetNameTextSize() );
+        aWriter.WriteInt( pin->GetType() );
+        aWriter.WriteInt( pin->GetShape() );
+        aWriter.WriteInt( pin->IsVisible() );
+        break;
+    }
+
+    default:
+        THROW_IO_ERROR( wxString::Format( _( "cannot cache symbol item type %d" ),
+                                          aItem->Type() ) );
+    }
+}
+
+
+LIB_ITEM* SCH_LEGACY_PLUGIN_CACHE::readDrawItem( CACHE_FILE_READER& aReader, LIB_PART* aPart )
+{
+    std::unique_ptr< LIB_ITEM > item;
+
+    KICAD_T type = (KICAD_T) aReader.ReadInt();
+    int     unit = aReader.ReadInt();
+    int     convert = aReader.ReadInt();
+
+    switch( type )
+    {
+    case LIB_ARC_T:
+    {
+        LIB_ARC* arc = new LIB_ARC( aPart );
+        item.reset( arc );
+
+        arc->SetPosition( aReader.ReadPoint() );
+        arc->SetRadius( aReader.ReadInt() );
+        arc->SetFirstRadiusAngle( aReader.ReadInt() );
+        arc->SetSecondRadiusAngle( aReader.ReadInt() );
+        arc->SetStart( aReader.ReadPoint() );
+        arc->SetEnd( aReader.ReadPoint() );
+        arc->SetWidth( aReader.ReadInt() );
+        arc->SetFillMode( (FILL_T) aReader.ReadInt() );
+        break;
+    }
+
+    case LIB_CIRCLE_T:
+    {
+        LIB_CIRCLE* circle = new LIB_CIRCLE( aPart );
+        item.reset( circle );
+
+        circle->SetPosition( aReader.ReadPoint() );
+        circle->SetRadius( aReader.ReadInt() );
+        circle->SetWidth( aReader.ReadInt() );
+        circle->SetFillMode( (FILL_T) aReader.ReadInt() );
+        break;
+    }
+
+    case LIB_RECTANGLE_T:
+    {
+        LIB_RECTANGLE* rectangle = new LIB_RECTANGLE( aPart );
+        item.reset( rectangle );
+
+        rectangle->SetPosition( aReader.ReadPoint() );
+        rectangle->SetEnd( aReader.ReadPoint() );
+        rectangle->SetWidth( aReader.ReadInt() );
+        rectangle->SetFillMode( (FILL_T) aReader.ReadInt() );
+        break;
+    }
+
+    case LIB_POLYLINE_T:
+    {
+        LIB_POLYLINE* polyLine = new LIB_POLYLINE( aPart );
+        item.reset( polyLine );
+
+        int points = aReader.ReadInt();
+
+        for( int ii = 0; ii < points; ++ii )
+            polyLine->AddPoint( aReader.ReadPoint() );
+
+        polyLine->SetWidth( aReader.ReadInt() );
+        polyLine->SetFillMode( (FILL_T) aReader.ReadInt() );
+        break;
+    }
+
+    case LIB_BEZIER_T:
+    {
+        LIB_BEZIER* bezier = new LIB_BEZIER( aPart );
+        item.reset( bezier );
+
+        int points = aReader.ReadInt();
+
+        for( int ii = 0; ii < points; ++ii )
+            bezier->AddPoint( aReader.ReadPoint() );
+
+        bezier->SetWidth( aReader.ReadInt() );
+        bezier->SetFillMode( (FILL_T) aReader.ReadInt() );
+        break;
+    }
+
+    case LIB_TEXT_T:
+    {
+        LIB_TEXT* text = new LIB_TEXT( aPart );
+        item.reset( text );
+
+        text->SetText( aReader.ReadString() );
+        readTextAttributes( aReader, text, *text );
+        break;
+    }
+
+    case LIB_FIELD_T:
+    {
+        LIB_FIELD* field = new LIB_FIELD( aPart, aReader.ReadInt() );
+        item.reset( field );
+
+        field->m_Text = aReader.ReadString();
+        field->m_name = aReader.ReadString();
+        readTextAttributes( aReader, field, *field );
+        break;
+    }
+
+    case LIB_PIN_T:
+    {
+        LIB_PIN* pin = new LIB_PIN( aPart );
+        item.reset( pin );
+
+        pin->SetName( aReader.ReadString() );
+
+        wxString number = aReader.ReadString();
+
+        pin->SetPinNumFromString( number );
+        pin->SetPosition( aReader.ReadPoint() );
+        pin->SetLength( aReader.ReadInt() );
+        pin->SetOrientation( aReader.ReadInt() );
+        pin->SetNumberTextSize( aReader.ReadInt() );
+        pin->SetNameTextSize( aReader.ReadInt() );
+        pin->SetType( (ELECTRICAL_PINTYPE) aReader.ReadInt() );
+        pin->SetShape( (GRAPHIC_PINSHAPE) aReader.ReadInt() );
+        pin->SetVisible( aReader.ReadInt() != 0 );
+        break;
+    }
+
+    default:
+        THROW_IO_ERROR( wxString::Format( _( "unknown symbol item type %d in cache file" ),
+                                          type ) );
+    }
+
+    item->SetUnit( unit );
+    item->SetConvert( convert );
+
+    return item.release();
+}
+
+
 void SCH_LEGACY_PLUGIN_CACHE::Save( bool aSaveDocFile )
 {
     if( !m_isModified )
         return;
 
+    // The deferred draw items are read from the library file, which is going to be overwritten.
+    for( LIB_ALIAS_MAP::iterator it = m_aliases.begin();  it != m_aliases.end();  it++ )
+        it->second->GetPart()->LoadBody();
+
     std::unique_ptr< FILE_OUTPUTFORMATTER > formatter( new FILE_OUTPUTFORMATTER( m_libFileName.GetFullPath() ) );
     formatter->Print( 0, "%s %d.%d\n", LIBFILE_IDENT, LIB_VERSION_MAJOR, LIB_VERSION_MINOR );
     formatter->Print( 0, "#encoding utf-8\n");
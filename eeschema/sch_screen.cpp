@@ -53,6 +53,10 @@
 #include <sch_component.h>
 #include <sch_text.h>
 #include <lib_pin.h>
+#include <sch_item_index.h>
+
+#include <algorithm>
+#include <unordered_map>
 
 
 #define EESCHEMA_FILE_STAMP   "EESchema"
@@ -151,12 +155,14 @@ void SCH_SCREEN::Clear()
 
 void SCH_SCREEN::FreeDrawList()
 {
+    m_index.Clear();
     m_drawList.DeleteAll();
 }
 
 
 void SCH_SCREEN::Remove( SCH_ITEM* aItem )
 {
+    m_index.Remove( aItem );
     m_drawList.Remove( aItem );
 }
 
@@ -179,6 +185,7 @@ void SCH_SCREEN::DeleteItem( SCH_ITEM* aItem )
     }
     else
     {
+        m_index.Remove( aItem );
         delete m_drawList.Remove( aItem );
     }
 }
@@ -200,9 +207,86 @@ bool SCH_SCREEN::CheckIfOnDrawList( SCH_ITEM* aItem )
 }
 
 
-SCH_ITEM* SCH_SCREEN::GetItem( const wxPoint& aPosition, int aAccuracy, KICAD_T aType ) const
+bool SCH_SCREEN::useIndex() const
+{
+    if( IsBlockActive() )
+        return false;
+
+    SCH_ITEM* curItem = GetCurItem();
+
+    if( curItem && curItem->GetFlags() & ( IS_NEW | IS_MOVED | IS_DRAGGED | IS_RESIZED ) )
+        return false;
+
+    if( !m_index.IsValid() )
+        m_index.Build( m_drawList.begin() );
+
+    return true;
+}
+
+
+void SCH_SCREEN::changeIndexedItems( const PICKED_ITEMS_LIST& aCommand )
+{
+    // The previous command is finished: its items have their new geometry
+    m_index.EndChanges();
+
+    for( unsigned ii = 0; ii < aCommand.GetCount(); ii++ )
+        m_index.BeginChange( (SCH_ITEM*) aCommand.GetPickedItem( ii ) );
+}
+
+
+void SCH_SCREEN::PushCommandToUndoList( PICKED_ITEMS_LIST* aItem )
+{
+    changeIndexedItems( *aItem );
+    BASE_SCREEN::PushCommandToUndoList( aItem );
+}
+
+
+void SCH_SCREEN::PushCommandToRedoList( PICKED_ITEMS_LIST* aItem )
+{
+    changeIndexedItems( *aItem );
+    BASE_SCREEN::PushCommandToRedoList( aItem );
+}
+
+
+void SCH_SCREEN::getHitCandidates( const wxPoint& aPosition, int aAccuracy,
+                                   std::vector<SCH_ITEM*>& aItems ) const
+{
+    if( useIndex() )
+    {
+        m_index.QueryPosition( aPosition, aAccuracy, aItems );
+        return;
+    }
+
+    aItems.clear();
+
+    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+        aItems.push_back( item );
+}
+
+
+void SCH_SCREEN::getConnectionCandidates( const std::vector<wxPoint>& aPositions,
+                                          std::vector<SCH_ITEM*>& aItems ) const
 {
+    if( useIndex() )
+    {
+        m_index.QueryConnection( aPositions, aItems );
+        return;
+    }
+
+    aItems.clear();
+
     for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+        aItems.push_back( item );
+}
+
+
+SCH_ITEM* SCH_SCREEN::GetItem( const wxPoint& aPosition, int aAccuracy, KICAD_T aType ) const
+{
+    std::vector<SCH_ITEM*> candidates;
+
+    getHitCandidates( aPosition, aAccuracy, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         if( item->HitTest( aPosition, aAccuracy ) && (aType == NOT_USED) )
             return item;
@@ -243,6 +327,8 @@ void SCH_SCREEN::ExtractWires( DLIST< SCH_ITEM >& aList, bool aCreateCopy )
     SCH_ITEM* item;
     SCH_ITEM* next_item;
 
+    m_index.Invalidate();
+
     for( item = m_drawList.begin(); item; item = next_item )
     {
         next_item = item->Next();
@@ -271,6 +357,8 @@ void SCH_SCREEN::ReplaceWires( DLIST< SCH_ITEM >& aWireList )
     SCH_ITEM* item;
     SCH_ITEM* next_item;
 
+    m_index.Invalidate();
+
     for( item = m_drawList.begin(); item; item = next_item )
     {
         next_item = item->Next();
@@ -297,7 +385,12 @@ void SCH_SCREEN::MarkConnections( SCH_LINE* aSegment )
     wxCHECK_RET( (aSegment) && (aSegment->Type() == SCH_LINE_T),
                  wxT( "Invalid object pointer." ) );
 
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    // Only the items having a connection point on an end of aSegment can be marked
+    std::vector<SCH_ITEM*> candidates;
+
+    getConnectionCandidates( { aSegment->GetStartPoint(), aSegment->GetEndPoint() }, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         if( item->GetFlags() & CANDIDATE )
             continue;
@@ -423,46 +516,198 @@ bool SCH_SCREEN::IsTerminalPoint( const wxPoint& aPosition, int aLayer )
 }
 
 
+/// Size of the cells used to index the items by area, in schematic units (mils)
+#define SCH_INDEX_CELL_SIZE 1000
+
+
+/// A map of grid cells or positions to the indexes of items
+typedef std::unordered_map< wxPoint, std::vector<size_t>, WXPOINT_HASH > SCH_POINT_INDEX;
+
+
+static inline int indexCellCoord( int aCoord )
+{
+    // Round towards minus infinity, for negative coordinates
+    return aCoord >= 0 ? aCoord / SCH_INDEX_CELL_SIZE
+                       : - ( ( - aCoord - 1 ) / SCH_INDEX_CELL_SIZE ) - 1;
+}
+
+
+/**
+ * Function addToCells
+ * adds aIndex to all cells of aCells covered by aRect
+ */
+static void addToCells( SCH_POINT_INDEX& aCells, EDA_RECT aRect, size_t aIndex )
+{
+    aRect.Normalize();
+
+    for( int x = indexCellCoord( aRect.GetX() ); x <= indexCellCoord( aRect.GetRight() ); ++x )
+    {
+        for( int y = indexCellCoord( aRect.GetY() ); y <= indexCellCoord( aRect.GetBottom() ); ++y )
+            aCells[ wxPoint( x, y ) ].push_back( aIndex );
+    }
+}
+
+
+static void removeFromCells( SCH_POINT_INDEX& aCells, EDA_RECT aRect, size_t aIndex )
+{
+    aRect.Normalize();
+
+    for( int x = indexCellCoord( aRect.GetX() ); x <= indexCellCoord( aRect.GetRight() ); ++x )
+    {
+        for( int y = indexCellCoord( aRect.GetY() ); y <= indexCellCoord( aRect.GetBottom() ); ++y )
+        {
+            std::vector<size_t>& cell = aCells[ wxPoint( x, y ) ];
+            cell.erase( std::remove( cell.begin(), cell.end(), aIndex ), cell.end() );
+        }
+    }
+}
+
+
+static inline const std::vector<size_t>* findCell( const SCH_POINT_INDEX& aCells,
+                                                   const wxPoint& aPosition )
+{
+    auto cell = aCells.find( wxPoint( indexCellCoord( aPosition.x ),
+                                      indexCellCoord( aPosition.y ) ) );
+
+    return cell == aCells.end() ? NULL : &cell->second;
+}
+
+
+static inline EDA_RECT segmentRect( const wxPoint& aStart, const wxPoint& aEnd )
+{
+    return EDA_RECT( aStart, wxSize( aEnd.x - aStart.x, aEnd.y - aStart.y ) );
+}
+
+
 bool SCH_SCREEN::SchematicCleanUp()
 {
     bool      modified = false;
 
-    for( SCH_ITEM* item = m_drawList.begin() ; item; item = item->Next() )
+    // Each wire is compared to the wires which share one of its ends, and each junction to the
+    // junctions covering its position, found from the indexes below.
+    // This is the same as comparing each item to all the items after it, and to all the items
+    // after a merge, in the draw list order: the other comparisons do nothing.
+    std::vector<SCH_ITEM*> items;   // the draw list, the deleted items are set to NULL
+    SCH_POINT_INDEX        lineEnds;
+    SCH_POINT_INDEX        junctionCells;
+
+    auto addLine = [&]( size_t aIndex )
+    {
+        SCH_LINE* line = (SCH_LINE*) items[aIndex];
+
+        lineEnds[ line->GetStartPoint() ].push_back( aIndex );
+
+        if( line->GetEndPoint() != line->GetStartPoint() )
+            lineEnds[ line->GetEndPoint() ].push_back( aIndex );
+    };
+
+    auto removeLine = [&]( size_t aIndex, const wxPoint& aStart, const wxPoint& aEnd )
+    {
+        for( const wxPoint& end : { aStart, aEnd } )
+        {
+            std::vector<size_t>& list = lineEnds[ end ];
+            list.erase( std::remove( list.begin(), list.end(), aIndex ), list.end() );
+        }
+    };
+
+    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    {
+        items.push_back( item );
+
+        if( item->Type() == SCH_LINE_T )
+            addLine( items.size() - 1 );
+        else if( item->Type() == SCH_JUNCTION_T )
+            addToCells( junctionCells, item->GetBoundingBox(), items.size() - 1 );
+    }
+
+    std::vector<size_t> candidates;
+
+    for( size_t ii = 0; ii < items.size(); ++ii )
     {
-        if( ( item->Type() != SCH_LINE_T ) && ( item->Type() != SCH_JUNCTION_T ) )
+        SCH_ITEM* item = items[ii];
+
+        if( !item || ( ( item->Type() != SCH_LINE_T ) && ( item->Type() != SCH_JUNCTION_T ) ) )
             continue;
 
-        bool restart;
+        size_t first = ii + 1;     // the first item to compare, in draw list order
 
-        for( SCH_ITEM* testItem = item->Next(); testItem; testItem = restart ? m_drawList.begin() : testItem->Next() )
+        for( ;; )
         {
-            restart = false;
+            candidates.clear();
+
+            // The ends of item, before a merge
+            wxPoint start = item->GetPosition();
+            wxPoint end = start;
 
-            if( ( item->Type() == SCH_LINE_T ) && ( testItem->Type() == SCH_LINE_T ) )
+            if( item->Type() == SCH_LINE_T )
             {
-                SCH_LINE* line = (SCH_LINE*) item;
+                start = ( (SCH_LINE*) item )->GetStartPoint();
+                end = ( (SCH_LINE*) item )->GetEndPoint();
 
-                if( line->MergeOverlap( (SCH_LINE*) testItem ) )
+                for( const wxPoint& pt : { start, end } )
                 {
-                    // Keep the current flags, because the deleted segment can be flagged.
-                    item->SetFlags( testItem->GetFlags() );
-                    DeleteItem( testItem );
-                    restart = true;
-                    modified = true;
+                    const std::vector<size_t>& list = lineEnds[ pt ];
+                    candidates.insert( candidates.end(), list.begin(), list.end() );
                 }
             }
-            else if ( ( ( item->Type() == SCH_JUNCTION_T )
-                      && ( testItem->Type() == SCH_JUNCTION_T ) ) && ( testItem != item ) )
+            else if( const std::vector<size_t>* cell = findCell( junctionCells,
+                                                                item->GetPosition() ) )
+            {
+                candidates = *cell;
+            }
+
+            std::sort( candidates.begin(), candidates.end() );
+            candidates.erase( std::unique( candidates.begin(), candidates.end() ),
+                              candidates.end() );
+
+            SCH_ITEM* testItem = NULL;
+
+            for( size_t jj : candidates )
             {
-                if ( testItem->HitTest( item->GetPosition() ) )
+                if( jj < first || jj == ii )
+                    continue;
+
+                if( item->Type() == SCH_LINE_T )
+                {
+                    SCH_LINE* testLine = (SCH_LINE*) items[jj];
+
+                    if( ( (SCH_LINE*) item )->MergeOverlap( testLine ) )
+                    {
+                        removeLine( jj, testLine->GetStartPoint(), testLine->GetEndPoint() );
+                        testItem = testLine;
+                    }
+                }
+                else if( items[jj]->HitTest( item->GetPosition() ) )
+                {
+                    removeFromCells( junctionCells, items[jj]->GetBoundingBox(), jj );
+                    testItem = items[jj];
+                }
+
+                if( testItem )
                 {
-                    // Keep the current flags, because the deleted segment can be flagged.
-                    item->SetFlags( testItem->GetFlags() );
-                    DeleteItem( testItem );
-                    restart = true;
-                    modified = true;
+                    items[jj] = NULL;
+                    break;
                 }
             }
+
+            if( !testItem )
+                break;
+
+            // The merged line can have new ends
+            if( item->Type() == SCH_LINE_T )
+            {
+                removeLine( ii, start, end );
+                addLine( ii );
+                m_index.Update( item );
+            }
+
+            // Keep the current flags, because the deleted segment can be flagged.
+            item->SetFlags( testItem->GetFlags() );
+            DeleteItem( testItem );
+            modified = true;
+
+            // Compare again to all items, from the start of the draw list
+            first = 0;
         }
     }
 
@@ -550,6 +795,9 @@ void SCH_SCREEN::CheckComponentsToPartsLinks()
             SCH_COMPONENT::ResolveAll( c, libs );
 
             m_modification_sync = mod_hash;     // note the last mod_hash
+
+            // The pins of the components can be changed
+            m_index.Invalidate();
         }
     }
 }
@@ -608,6 +856,7 @@ void SCH_SCREEN::ClearUndoORRedoList( UNDO_REDO_CONTAINER& aList, int aItemCount
         PICKED_ITEMS_LIST* curr_cmd = aList.m_CommandsList[0];
         aList.m_CommandsList.erase( aList.m_CommandsList.begin() );
 
+        ReleaseCommandData( *curr_cmd );
         curr_cmd->ClearListAndDeleteItems();
         delete curr_cmd;    // Delete command
     }
@@ -624,11 +873,18 @@ void SCH_SCREEN::ClearDrawingState()
 LIB_PIN* SCH_SCREEN::GetPin( const wxPoint& aPosition, SCH_COMPONENT** aComponent,
                              bool aEndPointOnly ) const
 {
-    SCH_ITEM*       item;
     SCH_COMPONENT*  component = NULL;
     LIB_PIN*        pin = NULL;
 
-    for( item = m_drawList.begin(); item; item = item->Next() )
+    // The end point of a pin is a connection point of its component
+    std::vector<SCH_ITEM*> candidates;
+
+    if( aEndPointOnly )
+        getConnectionCandidates( { aPosition }, candidates );
+    else
+        getHitCandidates( aPosition, 0, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         if( item->Type() != SCH_COMPONENT_T )
             continue;
@@ -697,8 +953,11 @@ SCH_SHEET* SCH_SCREEN::GetSheet( const wxString& aName )
 SCH_SHEET_PIN* SCH_SCREEN::GetSheetLabel( const wxPoint& aPosition )
 {
     SCH_SHEET_PIN* sheetPin = NULL;
+    std::vector<SCH_ITEM*> candidates;
 
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    getHitCandidates( aPosition, 0, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         if( item->Type() != SCH_SHEET_T )
             continue;
@@ -716,10 +975,12 @@ SCH_SHEET_PIN* SCH_SCREEN::GetSheetLabel( const wxPoint& aPosition )
 
 int SCH_SCREEN::CountConnectedItems( const wxPoint& aPos, bool aTestJunctions ) const
 {
-    SCH_ITEM* item;
     int       count = 0;
+    std::vector<SCH_ITEM*> candidates;
 
-    for( item = m_drawList.begin(); item; item = item->Next() )
+    getConnectionCandidates( { aPos }, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         if( item->Type() == SCH_JUNCTION_T  && !aTestJunctions )
             continue;
@@ -748,6 +1009,9 @@ void SCH_SCREEN::ClearAnnotation( SCH_SHEET_PATH* aSheetPath )
             component->ClearFlags();
         }
     }
+
+    // The references are changed without undo command
+    m_index.Invalidate();
 }
 
 
@@ -917,9 +1181,78 @@ bool SCH_SCREEN::TestDanglingEnds()
     for( item = m_drawList.begin(); item; item = item->Next() )
         item->GetEndPoints( endPoints );
 
+    // Index the end points by position, and the wires and buses, stored as a start and end
+    // pair, by the cells covered by the segment.
+    // The dangling state of an item only depends on the end points at its connection points
+    // and on the segments going through them, so each item is tested with these end points
+    // only, instead of the full list.
+    SCH_POINT_INDEX pointIndex;
+    SCH_POINT_INDEX segmentCells;
+
+    for( size_t ii = 0; ii < endPoints.size(); ++ii )
+    {
+        DANGLING_END_ITEM& endPoint = endPoints[ii];
+
+        if( ( endPoint.GetType() == WIRE_START_END || endPoint.GetType() == BUS_START_END )
+            && ii + 1 < endPoints.size() )
+        {
+            addToCells( segmentCells,
+                        segmentRect( endPoint.GetPosition(), endPoints[ii + 1].GetPosition() ),
+                        ii );
+            ++ii;   // the segment end is stored with its start
+        }
+        else
+        {
+            pointIndex[ endPoint.GetPosition() ].push_back( ii );
+        }
+    }
+
+    std::vector< wxPoint >           connections;
+    std::vector< size_t >            selection;
+    std::vector< DANGLING_END_ITEM > itemEndPoints;
+
     for( item = m_drawList.begin(); item; item = item->Next() )
     {
-        if( item->IsDanglingStateChanged( endPoints ) )
+        connections.clear();
+        selection.clear();
+        itemEndPoints.clear();
+
+        // A component not found in libraries has no pin to test
+        if( item->Type() != SCH_COMPONENT_T || ( (SCH_COMPONENT*) item )->GetPartRef().lock() )
+            item->GetConnectionPoints( connections );
+
+        for( const wxPoint& pt : connections )
+        {
+            auto found = pointIndex.find( pt );
+
+            if( found != pointIndex.end() )
+                selection.insert( selection.end(), found->second.begin(), found->second.end() );
+
+            if( const std::vector<size_t>* cell = findCell( segmentCells, pt ) )
+            {
+                for( size_t ii : *cell )
+                {
+                    EDA_RECT rect = segmentRect( endPoints[ii].GetPosition(),
+                                                 endPoints[ii + 1].GetPosition() );
+                    rect.Normalize();
+
+                    if( rect.Contains( pt ) )
+                    {
+                        selection.push_back( ii );
+                        selection.push_back( ii + 1 );
+                    }
+                }
+            }
+        }
+
+        // Keep the list order, some items expect a segment start just before its end
+        std::sort( selection.begin(), selection.end() );
+        selection.erase( std::unique( selection.begin(), selection.end() ), selection.end() );
+
+        for( size_t ii : selection )
+            itemEndPoints.push_back( endPoints[ii] );
+
+        if( item->IsDanglingStateChanged( itemEndPoints ) )
         {
             hasStateChanged = true;
         }
@@ -934,8 +1267,12 @@ bool SCH_SCREEN::BreakSegment( const wxPoint& aPoint )
     SCH_LINE* segment;
     SCH_LINE* newSegment;
     bool brokenSegments = false;
+    std::vector<SCH_ITEM*> candidates;
 
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    // The new segments end at aPoint, so they are not broken again
+    getHitCandidates( aPoint, 0, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         if( (item->Type() != SCH_LINE_T) || (item->GetLayer() == LAYER_NOTES) )
             continue;
@@ -950,10 +1287,12 @@ bool SCH_SCREEN::BreakSegment( const wxPoint& aPoint )
         newSegment->SetStartPoint( aPoint );
         segment->SetEndPoint( aPoint );
         m_drawList.Insert( newSegment, segment->Next() );
-        item = newSegment;
         brokenSegments = true;
     }
 
+    if( brokenSegments )
+        m_index.Invalidate();
+
     return brokenSegments;
 }
 
@@ -989,7 +1328,11 @@ bool SCH_SCREEN::BreakSegmentsOnJunctions()
 
 int SCH_SCREEN::GetNode( const wxPoint& aPosition, EDA_ITEMS& aList )
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    std::vector<SCH_ITEM*> candidates;
+
+    getHitCandidates( aPosition, 0, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         if( item->Type() == SCH_LINE_T && item->HitTest( aPosition )
             && (item->GetLayer() == LAYER_BUS || item->GetLayer() == LAYER_WIRE) )
@@ -1008,7 +1351,11 @@ int SCH_SCREEN::GetNode( const wxPoint& aPosition, EDA_ITEMS& aList )
 
 SCH_LINE* SCH_SCREEN::GetWireOrBus( const wxPoint& aPosition )
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    std::vector<SCH_ITEM*> candidates;
+
+    getHitCandidates( aPosition, 0, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         if( (item->Type() == SCH_LINE_T) && item->HitTest( aPosition )
             && (item->GetLayer() == LAYER_BUS || item->GetLayer() == LAYER_WIRE) )
@@ -1024,7 +1371,11 @@ SCH_LINE* SCH_SCREEN::GetWireOrBus( const wxPoint& aPosition )
 SCH_LINE* SCH_SCREEN::GetLine( const wxPoint& aPosition, int aAccuracy, int aLayer,
                                SCH_LINE_TEST_T aSearchType )
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    std::vector<SCH_ITEM*> candidates;
+
+    getHitCandidates( aPosition, aAccuracy, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         if( item->Type() != SCH_LINE_T )
             continue;
@@ -1057,7 +1408,11 @@ SCH_LINE* SCH_SCREEN::GetLine( const wxPoint& aPosition, int aAccuracy, int aLay
 
 SCH_TEXT* SCH_SCREEN::GetLabel( const wxPoint& aPosition, int aAccuracy )
 {
-    for( SCH_ITEM* item = m_drawList.begin(); item; item = item->Next() )
+    std::vector<SCH_ITEM*> candidates;
+
+    getHitCandidates( aPosition, aAccuracy, candidates );
+
+    for( SCH_ITEM* item : candidates )
     {
         switch( item->Type() )
         {
@@ -1128,6 +1483,7 @@ int SCH_SCREEN::GetConnection( const wxPoint& aPosition, PICKED_ITEMS_LIST& aLis
     SCH_ITEM* item;
     EDA_ITEM* tmp;
     EDA_ITEMS list;
+    std::vector<SCH_ITEM*> candidates;
 
     // Clear flags member for all items.
     ClearDrawingState();
@@ -1182,20 +1538,26 @@ int SCH_SCREEN::GetConnection( const wxPoint& aPosition, PICKED_ITEMS_LIST& aLis
 
             /* If the wire start point is connected to a wire that was already found
              * and now is not connected, add the wire to the list. */
-            for( tmp = m_drawList.begin(); tmp; tmp = tmp->Next() )
+            getConnectionCandidates( { segment->GetStartPoint() }, candidates );
+            tmp = NULL;
+
+            for( SCH_ITEM* candidate : candidates )
             {
-                // Ensure tmp is a previously deleted segment:
-                if( ( tmp->GetFlags() & STRUCT_DELETED ) == 0 )
+                // Ensure candidate is a previously deleted segment:
+                if( ( candidate->GetFlags() & STRUCT_DELETED ) == 0 )
                     continue;
 
-                if( tmp->Type() != SCH_LINE_T )
+                if( candidate->Type() != SCH_LINE_T )
                     continue;
 
-                SCH_LINE* testSegment = (SCH_LINE*) tmp;
+                SCH_LINE* testSegment = (SCH_LINE*) candidate;
 
-               // Test for segment connected to the previously deleted segment:
+                // Test for segment connected to the previously deleted segment:
                 if( testSegment->IsEndPoint( segment->GetStartPoint() ) )
+                {
+                    tmp = testSegment;
                     break;
+                }
             }
 
             // when tmp != NULL, segment is a new candidate:
@@ -1206,20 +1568,26 @@ int SCH_SCREEN::GetConnection( const wxPoint& aPosition, PICKED_ITEMS_LIST& aLis
 
             /* If the wire end point is connected to a wire that has already been found
              * and now is not connected, add the wire to the list. */
-            for( tmp = m_drawList.begin(); tmp; tmp = tmp->Next() )
+            getConnectionCandidates( { segment->GetEndPoint() }, candidates );
+            tmp = NULL;
+
+            for( SCH_ITEM* candidate : candidates )
             {
-                // Ensure tmp is a previously deleted segment:
-                if( ( tmp->GetFlags() & STRUCT_DELETED ) == 0 )
+                // Ensure candidate is a previously deleted segment:
+                if( ( candidate->GetFlags() & STRUCT_DELETED ) == 0 )
                     continue;
 
-                if( tmp->Type() != SCH_LINE_T )
+                if( candidate->Type() != SCH_LINE_T )
                     continue;
 
-                SCH_LINE* testSegment = (SCH_LINE*) tmp;
+                SCH_LINE* testSegment = (SCH_LINE*) candidate;
 
                 // Test for segment connected to the previously deleted segment:
                 if( testSegment->IsEndPoint( segment->GetEndPoint() ) )
+                {
+                    tmp = testSegment;
                     break;
+                }
             }
 
             // when tmp != NULL, segment is a new candidate:
@@ -1405,6 +1773,13 @@ void SCH_SCREENS::ClearAnnotation()
 }
 
 
+void SCH_SCREENS::InvalidateItemIndexes()
+{
+    for( size_t i = 0;  i < m_screens.size();  i++ )
+        m_screens[i]->InvalidateItemIndex();
+}
+
+
 void SCH_SCREENS::SchematicCleanUp()
 {
     for( size_t i = 0;  i < m_screens.size();  i++ )
@@ -178,6 +178,10 @@ void SCH_SHEET_PATH::UpdateAllScreenReferences()
 
         t = t->Next();
     }
+
+    // The references and units were changed without undo command
+    if( LastScreen() )
+        LastScreen()->InvalidateItemIndex();
 }
 
 
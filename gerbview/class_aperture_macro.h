@@ -183,6 +183,17 @@ struct APERTURE_MACRO
      */
     double GetLocalParam( const D_CODE* aDcode, unsigned aParamId ) const;
 
+    /**
+     * Function ConvertToPolygon
+     * Build the shape of a flashed item using this aperture macro, as polygons
+     * (fractured if the shape has holes).
+     * @param aParent = the parent GERBER_DRAW_ITEM which is actually drawn
+     * @param aShapePos = the actual shape position
+     * @param aShapeBuffer = receives the shape, in plotter (A,B) coordinates
+     */
+    void ConvertToPolygon( GERBER_DRAW_ITEM* aParent, wxPoint aShapePos,
+                           SHAPE_POLY_SET& aShapeBuffer );
+
    /**
      * Function DrawApertureMacroShape
      * Draw the primitive shape for flashed items.
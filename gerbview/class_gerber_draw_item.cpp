@@ -33,6 +33,8 @@
 #include <class_drawpanel.h>
 #include <msgpanel.h>
 #include <gerbview_frame.h>
+#include <geometry/shape_poly_set.h>
+#include <view/view.h>
 
 #include <class_gerber_draw_item.h>
 #include <class_gerber_file_image.h>
@@ -203,7 +205,7 @@ wxString GERBER_DRAW_ITEM::ShowGBRShape()
 }
 
 
-D_CODE* GERBER_DRAW_ITEM::GetDcodeDescr()
+D_CODE* GERBER_DRAW_ITEM::GetDcodeDescr() const
 {
     if( (m_DCode < FIRST_DCODE) || (m_DCode > LAST_DCODE) )
         return NULL;
@@ -235,6 +237,114 @@ const EDA_RECT GERBER_DRAW_ITEM::GetBoundingBox() const
 }
 
 
+const BOX2I GERBER_DRAW_ITEM::ViewBBox() const
+{
+    EDA_RECT bbox;
+
+    switch( m_Shape )
+    {
+    case GBR_SPOT_MACRO:
+    {
+        D_CODE* d_codeDescr = GetDcodeDescr();
+
+        if( d_codeDescr && d_codeDescr->GetMacro() )
+        {
+            // The macro shape is built in A,B coordinates
+            SHAPE_POLY_SET shape;
+            d_codeDescr->GetMacro()->ConvertToPolygon( const_cast<GERBER_DRAW_ITEM*>( this ),
+                                                       m_Start, shape );
+
+            if( shape.OutlineCount() == 0 )
+                return BOX2I( VECTOR2I( GetABPosition( m_Start ) ), VECTOR2I( 1, 1 ) );
+
+            BOX2I box = shape.BBox();
+            box.Inflate( 1 );
+            return box;
+        }
+
+        bbox = GetBoundingBox();
+        return BOX2I( VECTOR2I( bbox.GetOrigin() ), VECTOR2I( bbox.GetSize() ) );
+    }
+
+    case GBR_POLYGON:
+        if( m_PolyCorners.empty() )
+        {
+            bbox = EDA_RECT( m_Start, wxSize( 1, 1 ) );
+        }
+        else
+        {
+            bbox = EDA_RECT( m_PolyCorners[0], wxSize( 0, 0 ) );
+
+            for( const wxPoint& corner : m_PolyCorners )
+                bbox.Merge( corner );
+        }
+        break;
+
+    case GBR_CIRCLE:
+    {
+        int radius = KiROUND( GetLineLength( m_Start, m_End ) ) + m_Size.x / 2;
+        bbox = EDA_RECT( m_Start, wxSize( 1, 1 ) );
+        bbox.Inflate( radius );
+        break;
+    }
+
+    case GBR_ARC:
+    {
+        int radius = KiROUND( GetLineLength( m_Start, m_ArcCentre ) ) + m_Size.x / 2;
+        bbox = EDA_RECT( m_ArcCentre, wxSize( 1, 1 ) );
+        bbox.Inflate( radius );
+        break;
+    }
+
+    case GBR_SEGMENT:
+        bbox = EDA_RECT( m_Start, wxSize( 1, 1 ) );
+        bbox.Merge( m_End );
+        bbox.Inflate( std::max( m_Size.x, m_Size.y ) / 2 );
+        break;
+
+    default:        // Other flashed shapes are inside a circle of diameter m_Size.x or m_Size.y
+        bbox = EDA_RECT( m_Start, wxSize( 1, 1 ) );
+        bbox.Inflate( std::max( m_Size.x, m_Size.y ) / 2 );
+        break;
+    }
+
+    // The image transform can rotate the shape: use the 4 corners
+    wxPoint corners[4] =
+    {
+        bbox.GetOrigin(), wxPoint( bbox.GetRight(), bbox.GetY() ),
+        bbox.GetEnd(), wxPoint( bbox.GetX(), bbox.GetBottom() )
+    };
+
+    EDA_RECT abBox( GetABPosition( corners[0] ), wxSize( 0, 0 ) );
+
+    for( int ii = 1; ii < 4; ++ii )
+        abBox.Merge( GetABPosition( corners[ii] ) );
+
+    abBox.Inflate( 1 );
+
+    return BOX2I( VECTOR2I( abBox.GetOrigin() ), VECTOR2I( abBox.GetSize() ) );
+}
+
+
+void GERBER_DRAW_ITEM::ViewGetLayers( int aLayers[], int& aCount ) const
+{
+    aCount = 2;
+
+    aLayers[0] = GERBER_DRAW_LAYER( GetLayer() );
+    aLayers[1] = LAYER_DCODES;
+}
+
+
+unsigned int GERBER_DRAW_ITEM::ViewGetLOD( int aLayer, KIGFX::VIEW* aView ) const
+{
+    // The D-code of an item is shown only if the item itself is shown
+    if( aLayer == LAYER_DCODES && !aView->IsLayerVisible( GERBER_DRAW_LAYER( GetLayer() ) ) )
+        return UINT_MAX;
+
+    return 0;
+}
+
+
 void GERBER_DRAW_ITEM::MoveAB( const wxPoint& aMoveVector )
 {
     wxPoint xymove = GetXYPosition( aMoveVector );
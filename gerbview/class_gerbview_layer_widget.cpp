@@ -205,14 +205,14 @@ void GERBER_LAYER_WIDGET::onPopupSelection( wxCommandEvent& event )
         }
 
         myframe->SetVisibleLayers( visibleLayers );
-        myframe->GetCanvas()->Refresh();
+        myframe->RefreshCanvas();
         break;
 
     case ID_SORT_GBR_LAYERS:
         GetImagesList()->SortImagesByZOrder();
         myframe->ReFillLayerWidget();
         myframe->syncLayerBox( true );
-        myframe->GetCanvas()->Refresh();
+        myframe->RefreshCanvas();
         break;
     }
 }
@@ -256,7 +256,7 @@ void GERBER_LAYER_WIDGET::OnLayerColorChange( int aLayer, COLOR4D aColor )
 {
     myframe->SetLayerColor( aLayer, aColor );
     myframe->m_SelLayerBox->ResyncBitmapOnly();
-    myframe->GetCanvas()->Refresh();
+    myframe->RefreshCanvas();
 }
 
 bool GERBER_LAYER_WIDGET::OnLayerSelect( int aLayer )
@@ -270,7 +270,7 @@ bool GERBER_LAYER_WIDGET::OnLayerSelect( int aLayer )
     if( layer != myframe->getActiveLayer( ) )
     {
         if( ! OnLayerSelected() )
-            myframe->GetCanvas()->Refresh();
+            myframe->RefreshCanvas();
     }
 
     return true;
@@ -288,19 +288,19 @@ void GERBER_LAYER_WIDGET::OnLayerVisible( int aLayer, bool isVisible, bool isFin
     myframe->SetVisibleLayers( visibleLayers );
 
     if( isFinal )
-        myframe->GetCanvas()->Refresh();
+        myframe->RefreshCanvas();
 }
 
 void GERBER_LAYER_WIDGET::OnRenderColorChange( int aId, COLOR4D aColor )
 {
     myframe->SetVisibleElementColor( (GERBVIEW_LAYER_ID) aId, aColor );
-    myframe->GetCanvas()->Refresh();
+    myframe->RefreshCanvas();
 }
 
 void GERBER_LAYER_WIDGET::OnRenderEnable( int aId, bool isEnabled )
 {
     myframe->SetElementVisibility( (GERBVIEW_LAYER_ID) aId, isEnabled );
-    myframe->GetCanvas()->Refresh();
+    myframe->RefreshCanvas();
 }
 
 //-----</LAYER_WIDGET callbacks>------------------------------------------
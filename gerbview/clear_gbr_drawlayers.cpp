@@ -74,5 +74,5 @@ void GERBVIEW_FRAME::Erase_Current_DrawLayer( bool query )
 
     ReFillLayerWidget();
     syncLayerBox();
-    m_canvas->Refresh();
+    RefreshCanvas();
 }
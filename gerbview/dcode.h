@@ -157,6 +157,12 @@ public:
 
     APERTURE_MACRO* GetMacro() const { return m_Macro; }
 
+    /**
+     * Function GetPolyCorners
+     * @return the polygon built by ConvertShapeToPolygon(), relative to the shape position
+     */
+    const std::vector<wxPoint>& GetPolyCorners() const { return m_PolyCorners; }
+
     /**
      * Function ShowApertureType
      * returns a character string telling what type of aperture type \a aType is.
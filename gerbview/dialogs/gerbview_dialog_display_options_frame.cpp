@@ -64,7 +64,7 @@ void GERBVIEW_FRAME::InstallGerberOptionsDialog( wxCommandEvent& event )
     int opt = dlg.ShowModal();
 
     if( opt > 0 )
-        m_canvas->Refresh();
+        RefreshCanvas();
 }
 
 
@@ -185,7 +185,7 @@ void DIALOG_DISPLAY_OPTIONS::OnOKBUttonClick( wxCommandEvent& event )
     m_Parent->GetCanvas()->SetEnableZoomNoCenter( m_OptZoomNoCenter->GetValue() );
     m_Parent->GetCanvas()->SetEnableMousewheelPan( m_OptMousewheelPan->GetValue() );
 
-    m_Parent->GetCanvas()->Refresh();
+    m_Parent->RefreshCanvas();
 
     EndModal( 1 );
 }
@@ -80,6 +80,11 @@ BEGIN_EVENT_TABLE( GERBVIEW_FRAME, EDA_DRAW_FRAME )
               GERBVIEW_FRAME::OnSelectOptionToolbar )
     EVT_MENU( wxID_PREFERENCES, GERBVIEW_FRAME::InstallGerberOptionsDialog )
 
+    // Canvas selection
+    EVT_MENU( ID_MENU_CANVAS_LEGACY, GERBVIEW_FRAME::SwitchCanvas )
+    EVT_MENU( ID_MENU_CANVAS_OPENGL, GERBVIEW_FRAME::SwitchCanvas )
+    EVT_MENU( ID_MENU_CANVAS_CAIRO, GERBVIEW_FRAME::SwitchCanvas )
+
     // menu Postprocess
     EVT_MENU( ID_GERBVIEW_SHOW_LIST_DCODES, GERBVIEW_FRAME::Process_Special_Functions )
     EVT_MENU( ID_GERBVIEW_SHOW_SOURCE, GERBVIEW_FRAME::OnShowGerberSourceFile )
@@ -146,6 +151,9 @@ BEGIN_EVENT_TABLE( GERBVIEW_FRAME, EDA_DRAW_FRAME )
                    GERBVIEW_FRAME::OnUpdateShowLayerManager )
 
     EVT_UPDATE_UI( ID_TOOLBARH_GERBER_SELECT_ACTIVE_DCODE, GERBVIEW_FRAME::OnUpdateSelectDCode )
+    EVT_UPDATE_UI( ID_MENU_CANVAS_LEGACY, GERBVIEW_FRAME::OnUpdateSwitchCanvas )
+    EVT_UPDATE_UI( ID_MENU_CANVAS_OPENGL, GERBVIEW_FRAME::OnUpdateSwitchCanvas )
+    EVT_UPDATE_UI( ID_MENU_CANVAS_CAIRO, GERBVIEW_FRAME::OnUpdateSwitchCanvas )
     EVT_UPDATE_UI( ID_TOOLBARH_GERBVIEW_SELECT_ACTIVE_LAYER,
                    GERBVIEW_FRAME::OnUpdateLayerSelectBox )
     EVT_UPDATE_UI_RANGE( ID_TB_OPTIONS_SHOW_GBR_MODE_0, ID_TB_OPTIONS_SHOW_GBR_MODE_2,
@@ -198,7 +206,7 @@ void GERBVIEW_FRAME::Process_Special_Functions( wxCommandEvent& event )
             DIALOG_PAGE_SHOW_PAGE_BORDERS dlg( this );
 
             if( dlg.ShowModal() == wxID_OK )
-                m_canvas->Refresh();
+                RefreshCanvas();
         }
         break;
 
@@ -241,24 +249,24 @@ void GERBVIEW_FRAME::Process_Special_Functions( wxCommandEvent& event )
     case ID_GBR_AUX_TOOLBAR_PCB_CMP_CHOICE:
     case ID_GBR_AUX_TOOLBAR_PCB_NET_CHOICE:
     case ID_GBR_AUX_TOOLBAR_PCB_APERATTRIBUTES_CHOICE:
-            m_canvas->Refresh();
+            RefreshCanvas();
         break;
 
     case ID_HIGHLIGHT_CMP_ITEMS:
         if( m_SelComponentBox->SetStringSelection( currItem->GetNetAttributes().m_Cmpref ) )
-            m_canvas->Refresh();
+            RefreshCanvas();
         break;
 
     case ID_HIGHLIGHT_NET_ITEMS:
         if( m_SelNetnameBox->SetStringSelection( currItem->GetNetAttributes().m_Netname ) )
-            m_canvas->Refresh();
+            RefreshCanvas();
         break;
 
     case ID_HIGHLIGHT_APER_ATTRIBUTE_ITEMS:
         {
         D_CODE* apertDescr = currItem->GetDcodeDescr();
         if( m_SelAperAttributesBox->SetStringSelection( apertDescr->m_AperFunction ) )
-            m_canvas->Refresh();
+            RefreshCanvas();
         }
         break;
 
@@ -270,7 +278,7 @@ void GERBVIEW_FRAME::Process_Special_Functions( wxCommandEvent& event )
         if( GetGbrImage( getActiveLayer() ) )
             GetGbrImage( getActiveLayer() )->m_Selected_Tool = 0;
 
-        m_canvas->Refresh();
+        RefreshCanvas();
         break;
 
     default:
@@ -291,7 +299,7 @@ void GERBVIEW_FRAME::OnSelectActiveDCode( wxCommandEvent& event )
         if( tool != gerber_image->m_Selected_Tool )
         {
             gerber_image->m_Selected_Tool = tool;
-            m_canvas->Refresh();
+            RefreshCanvas();
         }
     }
 }
@@ -306,7 +314,7 @@ void GERBVIEW_FRAME::OnSelectActiveLayer( wxCommandEvent& event )
     if( layer != getActiveLayer() )
     {
         if( m_LayersManager->OnLayerSelected() )
-            m_canvas->Refresh();
+            RefreshCanvas();
     }
 }
 
@@ -369,7 +377,7 @@ void GERBVIEW_FRAME::OnSelectDisplayMode( wxCommandEvent& event )
     }
 
     if( GetDisplayMode() != oldMode )
-        m_canvas->Refresh();
+        RefreshCanvas();
 }
 
 
@@ -419,27 +427,27 @@ void GERBVIEW_FRAME::OnSelectOptionToolbar( wxCommandEvent& event )
 
     case ID_TB_OPTIONS_SHOW_FLASHED_ITEMS_SKETCH:
         m_DisplayOptions.m_DisplayFlashedItemsFill = not state;
-        m_canvas->Refresh( true );
+        RefreshCanvas();
         break;
 
     case ID_TB_OPTIONS_SHOW_LINES_SKETCH:
         m_DisplayOptions.m_DisplayLinesFill = not state;
-        m_canvas->Refresh( true );
+        RefreshCanvas();
         break;
 
     case ID_TB_OPTIONS_SHOW_POLYGONS_SKETCH:
         m_DisplayOptions.m_DisplayPolygonsFill = not state;
-        m_canvas->Refresh( true );
+        RefreshCanvas();
         break;
 
     case ID_TB_OPTIONS_SHOW_DCODES:
         SetElementVisibility( LAYER_DCODES, state );
-        m_canvas->Refresh( true );
+        RefreshCanvas();
         break;
 
     case ID_TB_OPTIONS_SHOW_NEGATIVE_ITEMS:
         SetElementVisibility( LAYER_NEGATIVE_OBJECTS, state );
-        m_canvas->Refresh( true );
+        RefreshCanvas();
         break;
 
     case ID_TB_OPTIONS_SHOW_LAYERS_MANAGER_VERTICAL_TOOLBAR:
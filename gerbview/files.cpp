@@ -102,18 +102,18 @@ void GERBVIEW_FRAME::Files_io( wxCommandEvent& event )
     case ID_GERBVIEW_ERASE_ALL:
         Clear_DrawLayers( false );
         Zoom_Automatique( false );
-        m_canvas->Refresh();
+        RefreshCanvas();
         ClearMsgPanel();
         break;
 
     case ID_GERBVIEW_LOAD_DRILL_FILE:
         LoadExcellonFiles( wxEmptyString );
-        m_canvas->Refresh();
+        RefreshCanvas();
         break;
 
     case ID_GERBVIEW_LOAD_ZIP_ARCHIVE_FILE:
         LoadZipArchiveFile( wxEmptyString );
-        m_canvas->Refresh();
+        RefreshCanvas();
         break;
 
     default:
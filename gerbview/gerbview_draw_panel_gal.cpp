@@ -0,0 +1,173 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <fctsys.h>
+#include <convert_to_biu.h>
+#include <view/view.h>
+#include <view/wx_view_controls.h>
+#include <gal/graphics_abstraction_layer.h>
+#include <class_colors_design_settings.h>
+
+#include <gerbview_frame.h>
+#include <gerbview_draw_panel_gal.h>
+#include <gerbview_painter.h>
+#include <class_gerber_file_image.h>
+#include <class_gerber_file_image_list.h>
+
+
+GERBVIEW_DRAW_PANEL_GAL::GERBVIEW_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWindowId,
+                                                  const wxPoint& aPosition, const wxSize& aSize,
+                                                  KIGFX::GAL_DISPLAY_OPTIONS& aOptions,
+                                                  GAL_TYPE aGalType ) :
+EDA_DRAW_PANEL_GAL( aParentWindow, aWindowId, aPosition, aSize, aOptions, aGalType )
+{
+    // GerbView internal units are 10 nm, not 1 nm as for Pcbnew
+    m_gal->SetWorldUnitLength( 2.54 / ( IU_PER_MM * 1e3 ) );
+
+    setDefaultLayerOrder();
+    setDefaultLayerDeps();
+
+    m_painter = new KIGFX::GERBVIEW_PAINTER( m_gal );
+    m_view->SetPainter( m_painter );
+
+    // The negative items clear the items drawn before them: the items of a layer must be
+    // drawn in the file order, not in the R-tree order
+    m_view->UseDrawPriority( true );
+}
+
+
+GERBVIEW_DRAW_PANEL_GAL::~GERBVIEW_DRAW_PANEL_GAL()
+{
+    delete m_painter;
+}
+
+
+void GERBVIEW_DRAW_PANEL_GAL::DisplayImages( GERBER_FILE_IMAGE_LIST* aImages )
+{
+    m_view->Clear();
+
+    for( unsigned ii = 0; ii < aImages->ImagesMaxCount(); ++ii )
+    {
+        GERBER_FILE_IMAGE* image = aImages->GetGbrImage( ii );
+
+        if( image == NULL )
+            continue;
+
+        for( GERBER_DRAW_ITEM* item = image->GetItemsList(); item; item = item->Next() )
+            m_view->Add( item );
+    }
+}
+
+
+void GERBVIEW_DRAW_PANEL_GAL::UseColorScheme( const COLORS_DESIGN_SETTINGS* aSettings )
+{
+    KIGFX::GERBVIEW_RENDER_SETTINGS* rs;
+    rs = static_cast<KIGFX::GERBVIEW_RENDER_SETTINGS*>( m_view->GetPainter()->GetSettings() );
+    rs->ImportLegacyColors( aSettings );
+}
+
+
+void GERBVIEW_DRAW_PANEL_GAL::SyncWithFrame( GERBVIEW_FRAME* aFrame )
+{
+    KIGFX::GERBVIEW_RENDER_SETTINGS* rs;
+    rs = static_cast<KIGFX::GERBVIEW_RENDER_SETTINGS*>( m_view->GetPainter()->GetSettings() );
+
+    aFrame->m_DisplayOptions.m_NegativeDrawColor = aFrame->GetNegativeItemsColor();
+    aFrame->m_DisplayOptions.m_BgDrawColor = aFrame->GetDrawBgColor();
+
+    UseColorScheme( aFrame->GetColorsSettings() );
+
+    // The colors are applied to the cached items without drawing them again,
+    // but the negative items color and the sketch modes are part of the cached geometry
+    if( rs->LoadDisplayOptions( &aFrame->m_DisplayOptions ) )
+        m_view->RecacheAllItems();
+    else
+        m_view->UpdateAllLayersColor();
+
+    m_gal->SetClearColor( aFrame->GetDrawBgColor() );
+
+    for( int i = 0; i < GERBER_DRAWLAYERS_COUNT; ++i )
+        m_view->SetLayerVisible( GERBER_DRAW_LAYER( i ), aFrame->IsLayerVisible( i ) );
+
+    m_view->SetLayerVisible( LAYER_DCODES, aFrame->m_DisplayOptions.m_DisplayDCodes );
+
+    SetTopLayer( GERBER_DRAW_LAYER( aFrame->getActiveLayer() ) );
+}
+
+
+void GERBVIEW_DRAW_PANEL_GAL::SetTopLayer( int aLayer )
+{
+    m_view->ClearTopLayers();
+    setDefaultLayerOrder();
+    m_view->SetTopLayer( aLayer );
+
+    // The D-codes are always displayed on top
+    m_view->SetTopLayer( LAYER_DCODES );
+
+    m_view->UpdateAllLayersOrder();
+}
+
+
+void GERBVIEW_DRAW_PANEL_GAL::OnShow()
+{
+    GERBVIEW_FRAME* frame = dynamic_cast<GERBVIEW_FRAME*>( GetParent() );
+
+    if( frame )
+        SyncWithFrame( frame );
+
+    m_view->RecacheAllItems();
+}
+
+
+bool GERBVIEW_DRAW_PANEL_GAL::SwitchBackend( GAL_TYPE aGalType )
+{
+    bool rv = EDA_DRAW_PANEL_GAL::SwitchBackend( aGalType );
+
+    // The new GAL uses the default world unit
+    m_gal->SetWorldUnitLength( 2.54 / ( IU_PER_MM * 1e3 ) );
+
+    setDefaultLayerDeps();
+    return rv;
+}
+
+
+void GERBVIEW_DRAW_PANEL_GAL::setDefaultLayerOrder()
+{
+    // The graphic layer 0 is drawn on top of the others, like in the legacy canvas
+    m_view->SetLayerOrder( LAYER_DCODES, 0 );
+
+    for( int i = 0; i < GERBER_DRAWLAYERS_COUNT; ++i )
+        m_view->SetLayerOrder( GERBER_DRAW_LAYER( i ), i + 1 );
+}
+
+
+void GERBVIEW_DRAW_PANEL_GAL::setDefaultLayerDeps()
+{
+    // caching makes no sense for Cairo and other software renderers
+    auto target = m_backend == GAL_TYPE_OPENGL ? KIGFX::TARGET_CACHED : KIGFX::TARGET_NONCACHED;
+
+    for( int i = 0; i < KIGFX::VIEW::VIEW_MAX_LAYERS; i++ )
+        m_view->SetLayerTarget( i, target );
+
+    m_view->SetLayerDisplayOnly( LAYER_DCODES );
+}
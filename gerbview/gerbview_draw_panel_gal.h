@@ -0,0 +1,92 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef GERBVIEW_DRAW_PANEL_GAL_H_
+#define GERBVIEW_DRAW_PANEL_GAL_H_
+
+#include <class_draw_panel_gal.h>
+#include <layers_id_colors_and_visibility.h>
+
+class COLORS_DESIGN_SETTINGS;
+class GERBER_FILE_IMAGE_LIST;
+class GERBVIEW_FRAME;
+
+/**
+ * Class GERBVIEW_DRAW_PANEL_GAL
+ * The GAL canvas of GerbView.
+ *
+ * Each gerber draw layer is a VIEW layer, so the items are stored in a R-tree per layer
+ * and only the visible items are drawn.  With OpenGL, the layers are cached: the items
+ * are tessellated once in GPU groups, and only drawn again when the display options change.
+ * This canvas only displays the images: the pan and zoom are managed by the view controls.
+ */
+class GERBVIEW_DRAW_PANEL_GAL : public EDA_DRAW_PANEL_GAL
+{
+public:
+    GERBVIEW_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWindowId,
+                             const wxPoint& aPosition, const wxSize& aSize,
+                             KIGFX::GAL_DISPLAY_OPTIONS& aOptions,
+                             GAL_TYPE aGalType = GAL_TYPE_OPENGL );
+
+    virtual ~GERBVIEW_DRAW_PANEL_GAL();
+
+    /**
+     * Function DisplayImages
+     * adds all the items of the loaded gerber images to the VIEW, so they can be displayed
+     * by GAL.
+     * @param aImages is the list of the images to be displayed.
+     */
+    void DisplayImages( GERBER_FILE_IMAGE_LIST* aImages );
+
+    /**
+     * Function UseColorScheme
+     * Applies layer color settings.
+     * @param aSettings are the new settings.
+     */
+    void UseColorScheme( const COLORS_DESIGN_SETTINGS* aSettings );
+
+    /**
+     * Function SyncWithFrame
+     * Applies the display options, the colors, the layers visibility and the active layer
+     * of \a aFrame to the view.  The cached items are drawn again only if the display
+     * options changed.
+     */
+    void SyncWithFrame( GERBVIEW_FRAME* aFrame );
+
+    ///> @copydoc EDA_DRAW_PANEL_GAL::SetTopLayer()
+    virtual void SetTopLayer( int aLayer ) override;
+
+    ///> @copydoc EDA_DRAW_PANEL_GAL::OnShow()
+    void OnShow() override;
+
+    bool SwitchBackend( GAL_TYPE aGalType ) override;
+
+protected:
+    ///> Reassigns layer order to the initial settings.
+    void setDefaultLayerOrder();
+
+    ///> Sets rendering targets & dependencies for layers.
+    void setDefaultLayerDeps();
+};
+
+#endif /* GERBVIEW_DRAW_PANEL_GAL_H_ */
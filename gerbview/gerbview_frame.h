@@ -40,6 +40,7 @@
 #include <class_gbr_screen.h>
 #include <class_page_info.h>
 #include <class_gbr_display_options.h>
+#include <class_draw_panel_gal.h>
 
 #define NO_AVAILABLE_LAYERS UNDEFINED_LAYER
 
@@ -237,6 +238,48 @@ public:
     double  BestZoom() override;
     void    UpdateStatusBar() override;
 
+    /**
+     * Function UseGalCanvas
+     * switches between the legacy canvas and the GAL canvas, which displays the
+     * currently loaded images.
+     */
+    void    UseGalCanvas( bool aEnable ) override;
+
+    /**
+     * Function RefreshCanvas
+     * redraws the canvas in use.  The display options, colors and layers visibility
+     * are applied to the GAL canvas first.
+     */
+    void    RefreshCanvas();
+
+    /**
+     * Function SwitchCanvas
+     * switches between the legacy canvas, the OpenGL and the Cairo canvas
+     * (selected by the menu entry).
+     */
+    void    SwitchCanvas( wxCommandEvent& aEvent );
+
+    /**
+     * Function OnUpdateSwitchCanvas
+     * updates the check mark of the canvas type menu entries.
+     */
+    void    OnUpdateSwitchCanvas( wxUpdateUIEvent& aEvent );
+
+    /**
+     * Function LoadCanvasTypeSetting()
+     * Returns the canvas type stored in the application settings.
+     */
+    EDA_DRAW_PANEL_GAL::GAL_TYPE LoadCanvasTypeSetting() const;
+
+    /**
+     * Function SaveCanvasTypeSetting()
+     * Stores the canvas type in the application settings.
+     */
+    bool SaveCanvasTypeSetting( EDA_DRAW_PANEL_GAL::GAL_TYPE aCanvasType );
+
+    ///> Key in KifaceSettings to store the canvas type.
+    static const wxChar CANVAS_TYPE_KEY[];
+
     /**
      * Function GetZoomLevelIndicator
      * returns a human readable value which can be displayed as zoom
@@ -351,6 +394,12 @@ public:
      */
     void    SetLayerColor( int aLayer, COLOR4D aColor );
 
+    /**
+     * Function GetColorsSettings
+     * @return the colors of the draw layers and of the other items.
+     */
+    COLORS_DESIGN_SETTINGS* GetColorsSettings() const { return m_colorsSettings; }
+
     /**
      * Function GetNegativeItemsColor
      * @return the color of negative items.
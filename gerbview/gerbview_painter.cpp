@@ -0,0 +1,473 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <fctsys.h>
+#include <trigo.h>
+#include <class_colors_design_settings.h>
+#include <geometry/shape_poly_set.h>
+
+#include <class_gerber_draw_item.h>
+#include <class_gerber_file_image.h>
+#include <class_gbr_display_options.h>
+#include <gerbview_painter.h>
+#include <gal/graphics_abstraction_layer.h>
+
+using namespace KIGFX;
+
+GERBVIEW_RENDER_SETTINGS::GERBVIEW_RENDER_SETTINGS()
+{
+    m_backgroundColor = COLOR4D( 0.0, 0.0, 0.0, 1.0 );
+    m_negativeColor = m_backgroundColor;
+    m_sketchLines = false;
+    m_sketchFlashes = false;
+    m_sketchPolygons = false;
+    m_showDCodes = true;
+
+    update();
+}
+
+
+void GERBVIEW_RENDER_SETTINGS::ImportLegacyColors( const COLORS_DESIGN_SETTINGS* aSettings )
+{
+    // Init the draw layers colors
+    for( int i = 0; i < GERBER_DRAWLAYERS_COUNT; i++ )
+        m_layerColors[GERBER_DRAW_LAYER( i )] = aSettings->GetLayerColor( i );
+
+    // Init specific graphic layers colors
+    for( int i = LAYER_DCODES; i < GERBVIEW_LAYER_ID_END; i++ )
+        m_layerColors[i] = aSettings->GetItemColor( i );
+
+    update();
+}
+
+
+bool GERBVIEW_RENDER_SETTINGS::LoadDisplayOptions( const GBR_DISPLAY_OPTIONS* aOptions )
+{
+    if( aOptions == NULL )
+        return false;
+
+    bool changed = m_sketchLines != !aOptions->m_DisplayLinesFill
+                   || m_sketchFlashes != !aOptions->m_DisplayFlashedItemsFill
+                   || m_sketchPolygons != !aOptions->m_DisplayPolygonsFill
+                   || m_showDCodes != aOptions->m_DisplayDCodes
+                   || m_negativeColor != aOptions->m_NegativeDrawColor;
+
+    m_sketchLines    = !aOptions->m_DisplayLinesFill;
+    m_sketchFlashes  = !aOptions->m_DisplayFlashedItemsFill;
+    m_sketchPolygons = !aOptions->m_DisplayPolygonsFill;
+    m_showDCodes     = aOptions->m_DisplayDCodes;
+    m_negativeColor  = aOptions->m_NegativeDrawColor;
+    m_backgroundColor = aOptions->m_BgDrawColor;
+
+    return changed;
+}
+
+
+const COLOR4D& GERBVIEW_RENDER_SETTINGS::GetColor( const VIEW_ITEM* aItem, int aLayer ) const
+{
+    return m_layerColors[aLayer];
+}
+
+
+GERBVIEW_PAINTER::GERBVIEW_PAINTER( GAL* aGal ) :
+    PAINTER( aGal )
+{
+}
+
+
+bool GERBVIEW_PAINTER::Draw( const VIEW_ITEM* aItem, int aLayer )
+{
+    const EDA_ITEM* item = static_cast<const EDA_ITEM*>( aItem );
+
+    switch( item->Type() )
+    {
+    case TYPE_GERBER_DRAW_ITEM:
+        // The items cache their shapes converted to polygons, as the legacy drawing does
+        draw( static_cast<GERBER_DRAW_ITEM*>( const_cast<EDA_ITEM*>( item ) ), aLayer );
+        break;
+
+    default:
+        // Painter does not know how to draw the object
+        return false;
+    }
+
+    return true;
+}
+
+
+void GERBVIEW_PAINTER::draw( GERBER_DRAW_ITEM* aItem, int aLayer )
+{
+    if( aLayer == LAYER_DCODES )
+    {
+        if( m_gerbviewSettings.m_showDCodes )
+            drawDCode( aItem );
+
+        return;
+    }
+
+    // used when a D_CODE is not found. default D_CODE to draw a flashed item
+    static D_CODE dummyD_CODE( 0 );
+    D_CODE*       d_codeDescr = aItem->GetDcodeDescr();
+
+    if( d_codeDescr == NULL )
+        d_codeDescr = &dummyD_CODE;
+
+    // Negative items are drawn in the background color (or the negative objects color),
+    // like the legacy canvas does in its default display mode
+    bool    isDark = !aItem->HasNegativeItems();
+    COLOR4D color  = isDark ? m_gerbviewSettings.GetColor( aItem, aLayer )
+                            : m_gerbviewSettings.m_negativeColor;
+
+    m_gal->SetFillColor( color );
+    m_gal->SetStrokeColor( color );
+    m_gal->SetLineWidth( m_gerbviewSettings.m_outlineWidth );
+
+    bool isFilled = !m_gerbviewSettings.m_sketchLines;
+
+    switch( aItem->m_Shape )
+    {
+    case GBR_POLYGON:
+        isFilled = !m_gerbviewSettings.m_sketchPolygons || !isDark;
+        drawPolygon( aItem, aItem->m_PolyCorners, wxPoint( 0, 0 ), isFilled );
+        break;
+
+    case GBR_CIRCLE:
+    {
+        VECTOR2D center( aItem->GetABPosition( aItem->m_Start ) );
+        double   radius = GetLineLength( aItem->m_Start, aItem->m_End );
+        double   halfPenWidth = aItem->m_Size.x / 2.0;
+
+        m_gal->SetIsFill( false );
+        m_gal->SetIsStroke( true );
+
+        if( !isFilled )
+        {
+            // draw the border of the pen's path using two circles
+            m_gal->DrawCircle( center, radius - halfPenWidth );
+            m_gal->DrawCircle( center, radius + halfPenWidth );
+        }
+        else
+        {
+            m_gal->SetLineWidth( aItem->m_Size.x );
+            m_gal->DrawCircle( center, radius );
+        }
+
+        break;
+    }
+
+    case GBR_ARC:
+    {
+        // Currently, arcs plotted with a rectangular aperture are not supported.
+        // a round pen only is expected.
+        VECTOR2D start( aItem->GetABPosition( aItem->m_Start ) );
+        VECTOR2D end( aItem->GetABPosition( aItem->m_End ) );
+        VECTOR2D center( aItem->GetABPosition( aItem->m_ArcCentre ) );
+        double   radius = ( start - center ).EuclideanNorm();
+
+        // Like GRArc1(), the arc goes counterclockwise on screen from the start point
+        // to the end point, so the angles increase from the end point to the start point
+        double startAngle = atan2( end.y - center.y, end.x - center.x );
+        double endAngle   = atan2( start.y - center.y, start.x - center.x );
+
+        if( endAngle <= startAngle )
+            endAngle += 2 * M_PI;
+
+        m_gal->SetIsFill( isFilled );
+        m_gal->SetIsStroke( !isFilled );
+        m_gal->DrawArcSegment( center, radius, startAngle, endAngle, aItem->m_Size.x );
+        break;
+    }
+
+    case GBR_SPOT_CIRCLE:
+    case GBR_SPOT_RECT:
+    case GBR_SPOT_OVAL:
+    case GBR_SPOT_POLY:
+    case GBR_SPOT_MACRO:
+        isFilled = !m_gerbviewSettings.m_sketchFlashes;
+        drawFlashedShape( aItem, d_codeDescr, isFilled );
+        break;
+
+    case GBR_SEGMENT:
+        // Usually, a round pen is used, but some gerber files use a rectangular pen
+        if( d_codeDescr->m_Shape == APT_RECT )
+        {
+            if( aItem->m_PolyCorners.size() == 0 )
+                aItem->ConvertSegmentToPolygon();
+
+            drawPolygon( aItem, aItem->m_PolyCorners, wxPoint( 0, 0 ), isFilled );
+        }
+        else
+        {
+            m_gal->SetIsFill( isFilled );
+            m_gal->SetIsStroke( !isFilled );
+            m_gal->DrawSegment( VECTOR2D( aItem->GetABPosition( aItem->m_Start ) ),
+                                VECTOR2D( aItem->GetABPosition( aItem->m_End ) ),
+                                aItem->m_Size.x );
+        }
+
+        break;
+
+    default:
+        wxASSERT_MSG( false, wxT( "GERBVIEW_PAINTER: unknown shape" ) );
+        break;
+    }
+}
+
+
+void GERBVIEW_PAINTER::drawFlashedShape( GERBER_DRAW_ITEM* aItem, D_CODE* aDCode, bool aFilled )
+{
+    VECTOR2D pos( aItem->GetABPosition( aItem->m_Start ) );
+
+    switch( aDCode->m_Shape )
+    {
+    case APT_MACRO:
+        drawApertureMacro( aItem, aDCode, aFilled );
+        break;
+
+    case APT_CIRCLE:
+    {
+        double radius = aDCode->m_Size.x / 2.0;
+
+        if( !aFilled )
+        {
+            m_gal->SetIsFill( false );
+            m_gal->SetIsStroke( true );
+            m_gal->DrawCircle( pos, radius );
+        }
+        else if( aDCode->m_DrillShape == APT_DEF_NO_HOLE )
+        {
+            m_gal->SetIsFill( true );
+            m_gal->SetIsStroke( false );
+            m_gal->DrawCircle( pos, radius );
+        }
+        else if( aDCode->m_DrillShape == APT_DEF_ROUND_HOLE )
+        {
+            double width = ( aDCode->m_Size.x - aDCode->m_Drill.x ) / 2.0;
+
+            m_gal->SetIsFill( false );
+            m_gal->SetIsStroke( true );
+            m_gal->SetLineWidth( width );
+            m_gal->DrawCircle( pos, radius - width / 2 );
+        }
+        else        // rectangular hole
+        {
+            if( aDCode->GetPolyCorners().size() == 0 )
+                aDCode->ConvertShapeToPolygon();
+
+            drawPolygon( aItem, aDCode->GetPolyCorners(), aItem->m_Start, aFilled );
+        }
+
+        break;
+    }
+
+    case APT_RECT:
+        if( aDCode->m_DrillShape == APT_DEF_NO_HOLE || !aFilled )
+        {
+            // The image transform can rotate the rectangle: draw it as a polygon
+            std::vector<wxPoint> corners( 4 );
+            wxSize halfSize = aDCode->m_Size / 2;
+
+            corners[0] = wxPoint( -halfSize.x, -halfSize.y );
+            corners[1] = wxPoint( halfSize.x, -halfSize.y );
+            corners[2] = wxPoint( halfSize.x, halfSize.y );
+            corners[3] = wxPoint( -halfSize.x, halfSize.y );
+
+            drawPolygon( aItem, corners, aItem->m_Start, aFilled );
+        }
+        else
+        {
+            if( aDCode->GetPolyCorners().size() == 0 )
+                aDCode->ConvertShapeToPolygon();
+
+            drawPolygon( aItem, aDCode->GetPolyCorners(), aItem->m_Start, aFilled );
+        }
+
+        break;
+
+    case APT_OVAL:
+        if( aDCode->m_DrillShape == APT_DEF_NO_HOLE || !aFilled )
+        {
+            wxPoint start = aItem->m_Start;
+            wxPoint end   = aItem->m_Start;
+            int     width;
+
+            if( aDCode->m_Size.x > aDCode->m_Size.y )   // horizontal oval
+            {
+                int delta = ( aDCode->m_Size.x - aDCode->m_Size.y ) / 2;
+                start.x -= delta;
+                end.x   += delta;
+                width    = aDCode->m_Size.y;
+            }
+            else                                        // vertical oval
+            {
+                int delta = ( aDCode->m_Size.y - aDCode->m_Size.x ) / 2;
+                start.y -= delta;
+                end.y   += delta;
+                width    = aDCode->m_Size.x;
+            }
+
+            m_gal->SetIsFill( aFilled );
+            m_gal->SetIsStroke( !aFilled );
+            m_gal->DrawSegment( VECTOR2D( aItem->GetABPosition( start ) ),
+                                VECTOR2D( aItem->GetABPosition( end ) ), width );
+        }
+        else
+        {
+            if( aDCode->GetPolyCorners().size() == 0 )
+                aDCode->ConvertShapeToPolygon();
+
+            drawPolygon( aItem, aDCode->GetPolyCorners(), aItem->m_Start, aFilled );
+        }
+
+        break;
+
+    case APT_POLYGON:
+        if( aDCode->GetPolyCorners().size() == 0 )
+            aDCode->ConvertShapeToPolygon();
+
+        drawPolygon( aItem, aDCode->GetPolyCorners(), aItem->m_Start, aFilled );
+        break;
+    }
+}
+
+
+void GERBVIEW_PAINTER::drawApertureMacro( GERBER_DRAW_ITEM* aItem, D_CODE* aDCode, bool aFilled )
+{
+    APERTURE_MACRO* macro = aDCode->GetMacro();
+
+    if( macro == NULL )
+        return;
+
+    SHAPE_POLY_SET shape;
+    macro->ConvertToPolygon( aItem, aItem->m_Start, shape );
+
+    if( aFilled )
+    {
+        m_gal->SetIsFill( true );
+        m_gal->SetIsStroke( false );
+        m_gal->DrawPolygon( shape );
+        return;
+    }
+
+    m_gal->SetIsFill( false );
+    m_gal->SetIsStroke( true );
+
+    for( int ii = 0; ii < shape.OutlineCount(); ii++ )
+    {
+        const SHAPE_LINE_CHAIN& outline = shape.COutline( ii );
+        std::deque<VECTOR2D> points;
+
+        for( int jj = 0; jj < outline.PointCount(); jj++ )
+            points.push_back( VECTOR2D( outline.CPoint( jj ) ) );
+
+        if( !points.empty() )
+            points.push_back( points.front() );
+
+        m_gal->DrawPolyline( points );
+    }
+}
+
+
+void GERBVIEW_PAINTER::drawPolygon( GERBER_DRAW_ITEM* aItem, const std::vector<wxPoint>& aCorners,
+                                    const wxPoint& aOffset, bool aFilled )
+{
+    if( aCorners.size() < 2 )
+        return;
+
+    std::deque<VECTOR2D> points;
+
+    for( const wxPoint& corner : aCorners )
+        points.push_back( VECTOR2D( aItem->GetABPosition( corner + aOffset ) ) );
+
+    m_gal->SetIsFill( aFilled );
+    m_gal->SetIsStroke( !aFilled );
+
+    if( aFilled )
+    {
+        m_gal->DrawPolygon( points );
+    }
+    else
+    {
+        points.push_back( points.front() );
+        m_gal->DrawPolyline( points );
+    }
+}
+
+
+void GERBVIEW_PAINTER::drawDCode( GERBER_DRAW_ITEM* aItem )
+{
+    if( aItem->m_DCode <= 0 )
+        return;
+
+    wxPoint pos;
+
+    if( aItem->m_Flashed || aItem->m_Shape == GBR_ARC )
+        pos = aItem->m_Start;
+    else
+        pos = ( aItem->m_Start + aItem->m_End ) / 2;
+
+    pos = aItem->GetABPosition( pos );
+
+    int width;
+
+    if( aItem->GetDcodeDescr() )
+        width = aItem->GetDcodeDescr()->GetShapeDim( aItem );
+    else
+        width = std::min( aItem->m_Size.x, aItem->m_Size.y );
+
+    double orient = 0.0;
+
+    if( aItem->m_Flashed )
+    {
+        // A reasonable size for text is width/3 because most of time this text has 3 chars.
+        width /= 3;
+    }
+    else        // this item is a line
+    {
+        wxPoint delta = aItem->m_Start - aItem->m_End;
+
+        if( abs( delta.x ) < abs( delta.y ) )
+            orient = M_PI / 2;
+
+        // A reasonable size for text is width/2 because text needs margin below and above it.
+        width /= 2;
+    }
+
+    if( width <= 0 )
+        return;
+
+    wxString text;
+    text.Printf( wxT( "D%d" ), aItem->m_DCode );
+
+    m_gal->SetIsStroke( true );
+    m_gal->SetIsFill( false );
+    m_gal->SetStrokeColor( m_gerbviewSettings.GetColor( aItem, LAYER_DCODES ) );
+    m_gal->SetLineWidth( width / 8.0 );
+    m_gal->SetFontBold( false );
+    m_gal->SetFontItalic( false );
+    m_gal->SetTextMirrored( false );
+    m_gal->SetGlyphSize( VECTOR2D( width, width ) );
+    m_gal->SetHorizontalJustify( GR_TEXT_HJUSTIFY_CENTER );
+    m_gal->SetVerticalJustify( GR_TEXT_VJUSTIFY_CENTER );
+    m_gal->StrokeText( text, VECTOR2D( pos ), orient );
+}
@@ -0,0 +1,145 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __GERBVIEW_PAINTER_H
+#define __GERBVIEW_PAINTER_H
+
+#include <layers_id_colors_and_visibility.h>
+#include <painter.h>
+
+
+class EDA_ITEM;
+class COLORS_DESIGN_SETTINGS;
+class GBR_DISPLAY_OPTIONS;
+class GERBER_DRAW_ITEM;
+class D_CODE;
+
+namespace KIGFX
+{
+class GAL;
+
+/**
+ * Class GERBVIEW_RENDER_SETTINGS
+ * Stores GerbView specific render settings.
+ */
+class GERBVIEW_RENDER_SETTINGS : public RENDER_SETTINGS
+{
+public:
+    friend class GERBVIEW_PAINTER;
+
+    GERBVIEW_RENDER_SETTINGS();
+
+    /// @copydoc RENDER_SETTINGS::ImportLegacyColors()
+    void ImportLegacyColors( const COLORS_DESIGN_SETTINGS* aSettings ) override;
+
+    /**
+     * Function LoadDisplayOptions
+     * Loads settings related to display options (filled or sketch mode of the lines,
+     * flashed items and polygons, D-codes display).
+     * @param aOptions are settings that you want to use for displaying items.
+     * @return true if the settings changed, and the cached items must be drawn again.
+     */
+    bool LoadDisplayOptions( const GBR_DISPLAY_OPTIONS* aOptions );
+
+    /// @copydoc RENDER_SETTINGS::GetColor()
+    virtual const COLOR4D& GetColor( const VIEW_ITEM* aItem, int aLayer ) const override;
+
+protected:
+    ///> Flag determining if lines should be drawn as outlines
+    bool    m_sketchLines;
+
+    ///> Flag determining if flashed items should be drawn as outlines
+    bool    m_sketchFlashes;
+
+    ///> Flag determining if polygons should be drawn as outlines
+    bool    m_sketchPolygons;
+
+    ///> Flag determining if the D-codes of the items should be visible
+    bool    m_showDCodes;
+
+    ///> Color of the negative items when they are shown, or the background color
+    COLOR4D m_negativeColor;
+};
+
+
+/**
+ * Class GERBVIEW_PAINTER
+ * Contains methods for drawing GerbView-specific items.
+ *
+ * Flashes with holes, regular polygon apertures and aperture macros are converted to
+ * polygons when drawn.  With the cached (OpenGL) layers, this is only done once, when
+ * the item is added to its GPU group.
+ */
+class GERBVIEW_PAINTER : public PAINTER
+{
+public:
+    GERBVIEW_PAINTER( GAL* aGal );
+
+    /// @copydoc PAINTER::ApplySettings()
+    virtual void ApplySettings( const RENDER_SETTINGS* aSettings ) override
+    {
+        m_gerbviewSettings = *static_cast<const GERBVIEW_RENDER_SETTINGS*>( aSettings );
+    }
+
+    /// @copydoc PAINTER::GetSettings()
+    virtual GERBVIEW_RENDER_SETTINGS* GetSettings() override
+    {
+        return &m_gerbviewSettings;
+    }
+
+    /// @copydoc PAINTER::Draw()
+    virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) override;
+
+protected:
+    GERBVIEW_RENDER_SETTINGS m_gerbviewSettings;
+
+    void draw( GERBER_DRAW_ITEM* aItem, int aLayer );
+
+    /**
+     * Function drawFlashedShape
+     * Draws the aperture shape of a flashed item.
+     */
+    void drawFlashedShape( GERBER_DRAW_ITEM* aItem, D_CODE* aDCode, bool aFilled );
+
+    /**
+     * Function drawApertureMacro
+     * Draws the shape of a flashed item using an aperture macro.
+     */
+    void drawApertureMacro( GERBER_DRAW_ITEM* aItem, D_CODE* aDCode, bool aFilled );
+
+    /**
+     * Function drawPolygon
+     * Draws a polygon given in X,Y gerber coordinates, relative to \a aOffset.
+     */
+    void drawPolygon( GERBER_DRAW_ITEM* aItem, const std::vector<wxPoint>& aCorners,
+                      const wxPoint& aOffset, bool aFilled );
+
+    /**
+     * Function drawDCode
+     * Draws the D-code number of an item (LAYER_DCODES).
+     */
+    void drawDCode( GERBER_DRAW_ITEM* aItem );
+};
+} // namespace KIGFX
+
+#endif /* __GERBVIEW_PAINTER_H */
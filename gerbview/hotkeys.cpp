@@ -171,34 +171,34 @@ bool GERBVIEW_FRAME::OnHotKey( wxDC* aDC, int aHotkeyCode, const wxPoint& aPosit
 
     case HK_GBR_LINES_DISPLAY_MODE:
         CHANGE(  m_DisplayOptions.m_DisplayLinesFill );
-        m_canvas->Refresh();
+        RefreshCanvas();
         break;
 
     case HK_GBR_FLASHED_DISPLAY_MODE:
         CHANGE( m_DisplayOptions.m_DisplayFlashedItemsFill );
-        m_canvas->Refresh( true );
+        RefreshCanvas();
         break;
 
     case HK_GBR_POLYGON_DISPLAY_MODE:
         CHANGE( m_DisplayOptions.m_DisplayPolygonsFill );
-        m_canvas->Refresh();
+        RefreshCanvas();
         break;
 
     case HK_GBR_NEGATIVE_DISPLAY_ONOFF:
         SetElementVisibility( LAYER_NEGATIVE_OBJECTS, not IsElementVisible( LAYER_NEGATIVE_OBJECTS ) );
-        m_canvas->Refresh();
+        RefreshCanvas();
         break;
 
     case HK_GBR_DCODE_DISPLAY_ONOFF:
         SetElementVisibility( LAYER_DCODES, not IsElementVisible( LAYER_DCODES ) );
-        m_canvas->Refresh();
+        RefreshCanvas();
         break;
 
     case HK_SWITCH_LAYER_TO_PREVIOUS:
         if( getActiveLayer() > 0 )
         {
             setActiveLayer( getActiveLayer() - 1 );
-            m_canvas->Refresh();
+            RefreshCanvas();
         }
         break;
 
@@ -206,7 +206,7 @@ bool GERBVIEW_FRAME::OnHotKey( wxDC* aDC, int aHotkeyCode, const wxPoint& aPosit
         if( getActiveLayer() < 31 )
         {
             setActiveLayer( getActiveLayer() + 1 );
-            m_canvas->Refresh();
+            RefreshCanvas();
         }
         break;
     }
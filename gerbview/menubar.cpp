@@ -200,6 +200,24 @@ void GERBVIEW_FRAME::ReCreateMenuBar()
     // Hotkey submenu
     AddHotkeyConfigMenu( configMenu );
 
+    // Canvas selection
+    configMenu->AppendSeparator();
+
+    configMenu->Append(
+        new wxMenuItem( configMenu, ID_MENU_CANVAS_LEGACY,
+                        _( "Legacy Canva&s" ), _( "Switch canvas implementation to Legacy" ),
+                        wxITEM_RADIO ) );
+
+    configMenu->Append(
+        new wxMenuItem( configMenu, ID_MENU_CANVAS_OPENGL,
+                        _( "Open&GL Canvas" ), _( "Switch canvas implementation to OpenGL" ),
+                        wxITEM_RADIO ) );
+
+    configMenu->Append(
+        new wxMenuItem( configMenu, ID_MENU_CANVAS_CAIRO,
+                        _( "&Cairo Canvas" ), _( "Switch canvas implementation to Cairo" ),
+                        wxITEM_RADIO ) );
+
     // Menu miscellaneous
     wxMenu* miscellaneousMenu = new wxMenu;
 
@@ -25,6 +25,8 @@
 #ifndef BASIC_GAL_H
 #define BASIC_GAL_H
 
+#include <mutex>
+
 #include <class_eda_rect.h>
 
 #include <gal/stroke_font.h>
@@ -74,6 +76,7 @@ public:
         m_Color = RED;
         m_plotter = NULL;
         m_callback = NULL;
+        m_callbackData = NULL;
         m_isClipped = false;
     }
 
@@ -82,9 +85,11 @@ public:
         m_plotter = aPlotter;
     }
 
-    void SetCallback( void (* aCallback)( int x0, int y0, int xf, int yf ) )
+    void SetCallback( void (* aCallback)( int x0, int y0, int xf, int yf, void* aData ),
+                      void* aData = NULL )
     {
         m_callback = aCallback;
+        m_callbackData = aData;
     }
 
     /// Set a clip box for drawings
@@ -154,7 +159,8 @@ private:
     // When calling the draw functions outside a wxDC, to get the basic drawings
     // lines / polylines ..., a callback function (used in DRC) to store
     // coordinates of each segment:
-    void (* m_callback)( int x0, int y0, int xf, int yf );
+    void (* m_callback)( int x0, int y0, int xf, int yf, void* aData );
+    void* m_callbackData;       // the last parameter of m_callback
 
     // When calling the draw functions for plot, the plotter acts as a wxDC
     // to plot basic items
@@ -164,4 +170,7 @@ private:
 
 extern BASIC_GAL basic_gal;
 
+/// Lock it to use basic_gal, which is shared by the threads plotting a board
+extern std::recursive_mutex basic_gal_mutex;
+
 #endif      // define BASIC_GAL_H
@@ -0,0 +1,155 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file cache_file.h
+ * @brief Helpers for the binary cache files stored in the user cache directory
+ *        (see GetKicadCachePath()): the footprint list, the symbol libraries and
+ *        the local copies of the GitHub libraries.
+ */
+
+#ifndef CACHE_FILE_H_
+#define CACHE_FILE_H_
+
+#include <string>
+#include <wx/gdicmn.h>
+#include <wx/string.h>
+
+
+/**
+ * Function HashBytes
+ * computes the FNV-1a hash of \a aData, used to identify the content of the cached files
+ * and to build unique cache file names.
+ * @param aHash = the hash of the previous data, to hash several blocks as a single one
+ */
+wxUint64 HashBytes( const char* aData, size_t aSize,
+                    wxUint64 aHash = 14695981039346656037ULL );
+
+
+/**
+ * Function ReadCacheFile
+ * reads the whole file \a aFileName in \a aData.
+ * A missing or unreadable file is not reported: the cache files are optional.
+ * @return false if the file cannot be read.
+ */
+bool ReadCacheFile( const wxString& aFileName, std::string& aData );
+
+
+/**
+ * Function WriteCacheFile
+ * writes \a aData in the file \a aFileName, and creates its folder if needed.
+ * A temporary file is written first, and renamed, so an other thread or instance never
+ * reads a partial file.  Errors are not reported: the cache files are optional.
+ * @return true if success
+ */
+bool WriteCacheFile( const wxString& aFileName, const std::string& aData );
+
+
+/**
+ * Class CACHE_FILE_WRITER
+ * serializes values in memory, in the native byte order, to write a cache file.
+ */
+class CACHE_FILE_WRITER
+{
+public:
+    void WriteInt( int aValue )         { write( &aValue, sizeof( aValue ) ); }
+    void WriteInt64( wxInt64 aValue )   { write( &aValue, sizeof( aValue ) ); }
+
+    void WritePoint( const wxPoint& aPoint )
+    {
+        WriteInt( aPoint.x );
+        WriteInt( aPoint.y );
+    }
+
+    void WriteString( const wxString& aText );
+
+    /// Writes a block of data, which can be skipped when reading
+    void WriteData( const std::string& aData );
+
+    const std::string& GetData() const  { return m_data; }
+
+private:
+    void write( const void* aData, size_t aSize )
+    {
+        m_data.append( (const char*) aData, aSize );
+    }
+
+    std::string m_data;
+};
+
+
+/**
+ * Class CACHE_FILE_READER
+ * reads the values written by a CACHE_FILE_WRITER.
+ * Throws an IO_ERROR if the data is truncated or corrupted.
+ */
+class CACHE_FILE_READER
+{
+public:
+    /**
+     * @param aData = the data to read, which must outlive the reader
+     * @param aOffset = the position of the first value to read in aData
+     */
+    CACHE_FILE_READER( const std::string& aData, size_t aOffset = 0 );
+
+    int ReadInt()
+    {
+        int value;
+        read( &value, sizeof( value ) );
+        return value;
+    }
+
+    wxInt64 ReadInt64()
+    {
+        wxInt64 value;
+        read( &value, sizeof( value ) );
+        return value;
+    }
+
+    wxPoint ReadPoint()
+    {
+        wxPoint pt;
+
+        pt.x = ReadInt();
+        pt.y = ReadInt();
+        return pt;
+    }
+
+    wxString ReadString();
+
+    /**
+     * Function SkipData
+     * skips a block written by CACHE_FILE_WRITER::WriteData().
+     * @return the offset of the block content, to read it later.
+     */
+    size_t SkipData();
+
+private:
+    void read( void* aData, size_t aSize );
+
+    const char* m_start;
+    const char* m_pos;
+    const char* m_end;
+};
+
+#endif  // CACHE_FILE_H_
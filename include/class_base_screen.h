@@ -31,6 +31,8 @@
 #ifndef  CLASS_BASE_SCREEN_H_
 #define  CLASS_BASE_SCREEN_H_
 
+#include <map>
+
 #include <draw_frame.h>
 #include <base_struct.h>
 #include <class_undoredo_container.h>
@@ -84,6 +86,27 @@ private:
     wxPoint     m_scrollCenter;     ///< Current scroll center point in logical units.
     wxPoint     m_MousePosition;    ///< Mouse cursor coordinate in logical units.
     int         m_UndoRedoCountMax; ///< undo/Redo command Max depth
+    size_t      m_UndoRedoMemoryMax;///< undo/Redo memory budget in bytes, 0 for no limit
+    size_t      m_UndoRedoMemoryUsage;  ///< approximate size of the undo and redo lists
+
+    /**
+     * Struct SHARED_DATA_USAGE
+     * is the accounting of a data shared by the commands of the undo and redo lists
+     * (see UNDO_SHARED_DATA).  It is counted in m_UndoRedoMemoryUsage only when the
+     * commands are its only owners: m_UseCount == m_Holders.
+     */
+    struct SHARED_DATA_USAGE
+    {
+        std::weak_ptr<const void> m_Data;
+        size_t  m_Size;
+        long    m_Holders;      ///< count of references held by the commands
+        long    m_UseCount;     ///< use count of m_Data when it was last accounted
+    };
+
+    ///> The data shared by the commands of the undo and redo lists.  The weak pointers
+    ///> are ordered by owner, so the entries of expired data can still be found.
+    std::map<std::weak_ptr<const void>, SHARED_DATA_USAGE,
+             std::owner_less<std::weak_ptr<const void> > > m_UndoRedoSharedData;
 
     /**
      * The cross hair position in logical (drawing) units.  The cross hair is not the cursor
@@ -94,6 +117,35 @@ private:
 
     double      m_Zoom;             ///< Current zoom coefficient.
 
+    /**
+     * Function trimUndoORRedoList
+     * deletes the oldest commands of aList (using ClearUndoORRedoList) when it holds more
+     * than the max count of commands, or when the undo and redo lists exceed their memory
+     * budget.  The last command of aList is always kept.
+     */
+    void trimUndoORRedoList( UNDO_REDO_CONTAINER& aList );
+
+    /**
+     * Function addCommandData
+     * computes the size of aCommand once, when it is stored in the undo or redo list,
+     * and adds it to the memory usage.
+     */
+    void addCommandData( PICKED_ITEMS_LIST& aCommand );
+
+    /**
+     * Function accountSharedData
+     * updates the count of holders of aData and its use count, and adds it to (or
+     * removes it from) the memory usage accordingly.
+     */
+    void accountSharedData( SHARED_DATA_USAGE& aData, long aHoldersDelta );
+
+    /**
+     * Function refreshSharedData
+     * re-accounts the shared data whose use count changed since they were last
+     * accounted, e.g. a zone fill no longer shared with the board after a refill.
+     */
+    void refreshSharedData();
+
     //----< Old public API now is private, and migratory>------------------------
     // called only from EDA_DRAW_FRAME
     friend class EDA_DRAW_FRAME;
@@ -260,6 +312,29 @@ public:
      */
     virtual void ClearUndoORRedoList( UNDO_REDO_CONTAINER& aList, int aItemCount = -1 ) = 0;
 
+    /**
+     * Function GetCommandDataSize (virtual).
+     * @return the approximate size in bytes of the item copies held by aCommand,
+     * to keep the undo and redo lists within their memory budget.  The default
+     * implementation returns 0, i.e. only the max count of commands is used.
+     * It is called once, when the command is stored in the undo or redo list.
+     * @param aSharedData = the list to append the data shared by the items of aCommand
+     *  with other items (e.g. zone fills) to.  Their size is not included in the returned
+     *  size: it is counted only while the commands are their only owners.
+     */
+    virtual size_t GetCommandDataSize( const PICKED_ITEMS_LIST& aCommand,
+                                       std::vector<UNDO_SHARED_DATA>& aSharedData ) const
+    {
+        return 0;
+    }
+
+    /**
+     * Function ReleaseCommandData
+     * removes aCommand from the memory usage of the undo and redo lists.  It must be
+     * called by ClearUndoORRedoList() for each command it deletes.
+     */
+    void ReleaseCommandData( PICKED_ITEMS_LIST& aCommand );
+
     /**
      * Function ClearUndoRedoList
      * clear undo and redo list, using ClearUndoORRedoList()
@@ -272,7 +347,7 @@ public:
      * Function PushCommandToUndoList
      * add a command to undo in undo list
      * delete the very old commands when the max count of undo commands is
-     * reached
+     * reached, or when the undo and redo lists exceed their memory budget
      * ( using ClearUndoORRedoList)
      */
     virtual void PushCommandToUndoList( PICKED_ITEMS_LIST* aItem );
@@ -281,7 +356,7 @@ public:
      * Function PushCommandToRedoList
      * add a command to redo in redo list
      * delete the very old commands when the max count of redo commands is
-     * reached
+     * reached, or when the undo and redo lists exceed their memory budget
      * ( using ClearUndoORRedoList)
      */
     virtual void PushCommandToRedoList( PICKED_ITEMS_LIST* aItem );
@@ -321,6 +396,26 @@ public:
         }
     }
 
+    size_t GetMaxUndoMemory() const { return m_UndoRedoMemoryMax; }
+
+    /**
+     * Function SetMaxUndoMemory
+     * sets the memory budget of the undo and redo lists.
+     * @param aMaxMB = the budget in megabytes, 0 for no limit
+     */
+    void SetMaxUndoMemory( long aMaxMB )
+    {
+        m_UndoRedoMemoryMax = aMaxMB > 0 ? size_t( aMaxMB ) * 1024 * 1024 : 0;
+    }
+
+    /**
+     * Function GetUndoRedoMemoryUsage
+     * @return the approximate size in bytes of the item copies held by the undo and
+     * redo lists.  The sizes of the commands are cached: only the shared data whose use
+     * count changed are accounted again.
+     */
+    size_t GetUndoRedoMemoryUsage();
+
     void SetModify()        { m_FlagModified = true; }
     void ClrModify()        { m_FlagModified = false; }
     void SetSave()          { m_FlagSave = true; }
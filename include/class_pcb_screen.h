@@ -100,6 +100,15 @@ public:
      * So this function can be called to remove old commands
      */
     void ClearUndoORRedoList( UNDO_REDO_CONTAINER& aList, int aItemCount = -1 ) override;
+
+    /**
+     * Function GetCommandDataSize
+     * @return the approximate size in bytes of the copies of the changed items, and of
+     * the deleted items, held by aCommand.  The filled polygons of the zones, which can be
+     * shared by several copies of a zone, are added to aSharedData instead.
+     */
+    size_t GetCommandDataSize( const PICKED_ITEMS_LIST& aCommand,
+                               std::vector<UNDO_SHARED_DATA>& aSharedData ) const override;
 };
 
 #endif  // CLASS_PCB_SCREEN_H_
@@ -26,6 +26,7 @@
 #ifndef _CLASS_UNDOREDO_CONTAINER_H
 #define _CLASS_UNDOREDO_CONTAINER_H
 #include <vector>
+#include <memory>
 
 #include <base_struct.h>
 
@@ -121,6 +122,19 @@ public:
 };
 
 
+/**
+ * Struct UNDO_SHARED_DATA
+ * describes data held by an item of an undo or redo command, and shared with other
+ * items (e.g. the filled areas of a zone, shared by the copies of the zone).  The command
+ * does not own it: its memory is freed only once no other owner is left.
+ */
+struct UNDO_SHARED_DATA
+{
+    std::weak_ptr<const void> m_Data;       ///< the shared data, not kept alive by the command
+    size_t                    m_Size;       ///< approximate size of the data in bytes
+};
+
+
 /**
  * Class PICKED_ITEMS_LIST
  * is a holder to handle information on schematic or board items.
@@ -133,6 +147,10 @@ public:
                                    * UR_UNSPECIFIED */
     wxPoint m_TransformPoint;     /* used to undo redo command by the same command: usually
                                    * need to know the rotate point or the move vector */
+    size_t  m_DataSize;           /* approximate size in bytes of the data held by the command,
+                                   * without m_SharedData.  Computed by the screen when the
+                                   * command is stored, see BASE_SCREEN::GetCommandDataSize() */
+    std::vector<UNDO_SHARED_DATA> m_SharedData;   /* the shared data held by the command */
 
 private:
     std::vector <ITEM_PICKER> m_ItemsList;
@@ -312,6 +312,13 @@ wxConfigBase* GetNewConfig( const wxString& aProgName );
  */
 wxString GetKicadConfigPath();
 
+/**
+ * Function GetKicadCachePath
+ * @return A wxString containing the path of the user cache directory for Kicad.
+ * The files stored there can be deleted at any time.
+ */
+wxString GetKicadCachePath();
+
 /**
  * Function ExpandEnvVarSubstitutions
  * replaces any environment variable references with their values
@@ -45,6 +45,9 @@ namespace KIGFX
 #define DEFAULT_MAX_UNDO_ITEMS 0
 #define ABS_MAX_UNDO_ITEMS (INT_MAX / 2)
 
+// Default memory budget of the undo/redo lists, in megabytes (0 = no limit)
+#define DEFAULT_MAX_UNDO_MEMORY_MB 512
+
 /**
  * Class EDA_DRAW_FRAME
  * is the base class for create windows for drawing purpose.  The Eeschema, Pcbnew and
@@ -87,6 +90,8 @@ protected:
                                             // is at scale = 1
     int         m_UndoRedoCountMax;         ///< default Undo/Redo command Max depth, to be handed
                                             // to screens
+    long        m_UndoRedoMemoryMaxMB;      ///< default Undo/Redo memory budget in megabytes,
+                                            // to be handed to screens
 
     /// The area to draw on.
     EDA_DRAW_PANEL* m_canvas;
@@ -101,6 +101,9 @@ int GraphicTextWidth( const wxString& aText, const wxSize& aSize, bool italic, b
  *                  used to draw 3D texts or for plotting, NULL for normal drawings
  *  @param aPlotter = a pointer to a PLOTTER instance, when this function is used to plot
  *                  the text. NULL to draw this text.
+ *  @param aCallbackData = the last parameter of aCallback(), the caller data it needs.
+ *                  Do not use static variables instead: texts are converted from
+ *                  several threads when plotting.
  */
 void DrawGraphicText( EDA_RECT* aClipBox,
                       wxDC * aDC,
@@ -114,8 +117,9 @@ void DrawGraphicText( EDA_RECT* aClipBox,
                       int aWidth,
                       bool aItalic,
                       bool aBold,
-                      void (*aCallback)( int x0, int y0, int xf, int yf ) = NULL,
-                      PLOTTER * aPlotter = NULL );
+                      void (*aCallback)( int x0, int y0, int xf, int yf, void* aData ) = NULL,
+                      PLOTTER * aPlotter = NULL,
+                      void* aCallbackData = NULL );
 
 
 /**
@@ -138,7 +142,8 @@ void DrawGraphicHaloText( EDA_RECT* aClipBox,
                           int aWidth,
                           bool aItalic,
                           bool aBold,
-                          void (*aCallback)( int x0, int y0, int xf, int yf ) = NULL,
-                          PLOTTER * aPlotter = NULL );
+                          void (*aCallback)( int x0, int y0, int xf, int yf, void* aData ) = NULL,
+                          PLOTTER * aPlotter = NULL,
+                          void* aCallbackData = NULL );
 
 #endif /* __INCLUDE__DRAWTXT_H__ */
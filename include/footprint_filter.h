@@ -46,7 +46,7 @@ public:
     FOOTPRINT_FILTER();
 
     /**
-     * Set the list to filter.
+     * Set the list to filter.  It must be set again each time the list is reloaded.
      */
     void SetList( FOOTPRINT_LIST& aList );
 
@@ -95,18 +95,8 @@ public:
         bool equal( ITERATOR const& aOther ) const;
         FOOTPRINT_INFO& dereference() const;
 
-        size_t            m_pos;
+        size_t            m_pos;        ///< position in m_filter->m_matches
         FOOTPRINT_FILTER* m_filter;
-
-        /**
-         * Check if the stored component matches an item by footprint filter.
-         */
-        bool FootprintFilterMatch( FOOTPRINT_INFO& aItem );
-
-        /**
-         * Check if the stored component matches an item by pin count.
-         */
-        bool PinCountMatch( FOOTPRINT_INFO& aItem );
     };
 
     /**
@@ -134,6 +124,22 @@ private:
         FILTERING_BY_NAME               = 0x0008
     };
 
+    /**
+     * Find the items matching the filter criteria, using the search index of the list
+     * to test only the candidate items.
+     */
+    void updateMatches();
+
+    /**
+     * Check if an item matches the filter criteria.
+     */
+    bool itemMatches( FOOTPRINT_INFO& aItem ) const;
+
+    /**
+     * Check if the stored component matches an item by footprint filter.
+     */
+    bool footprintFilterMatch( FOOTPRINT_INFO& aItem ) const;
+
     FOOTPRINT_LIST* m_list;
 
     wxString                   m_lib_name;
@@ -143,6 +149,9 @@ private:
     EDA_PATTERN_MATCH_WILDCARD m_filter;
 
     std::vector<std::unique_ptr<EDA_PATTERN_MATCH>> m_footprint_filters;
+
+    std::vector<int>           m_matches;           ///< indexes of the matching items
+    bool                       m_matches_valid;     ///< false when a criterion has changed
 };
 
 #endif // FOOTPRINT_FILTER_H
@@ -32,6 +32,7 @@
 
 #include <boost/ptr_container/ptr_vector.hpp>
 
+#include <footprint_search_index.h>
 #include <import_export.h>
 #include <ki_exception.h>
 #include <ki_mutex.h>
@@ -181,6 +182,7 @@ protected:
 
     MUTEX m_list_lock;
 
+    FOOTPRINT_SEARCH_INDEX m_search_index;  ///< cleared each time m_list is modified
 
 public:
     FOOTPRINT_LIST() : m_lib_table( 0 )
@@ -255,6 +257,14 @@ public:
 
     void DisplayErrors( wxTopLevelWindow* aCaller = NULL );
 
+    /**
+     * Get the search index of the list, to filter it without testing all the items.
+     *
+     * The index is built when the footprints are loaded, or on the first call after
+     * the list is modified.  It must not be used while the list is loading.
+     */
+    const FOOTPRINT_SEARCH_INDEX& GetSearchIndex();
+
     FP_LIB_TABLE* GetTable() const
     {
         return m_lib_table;
@@ -0,0 +1,118 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FOOTPRINT_SEARCH_INDEX_H
+#define FOOTPRINT_SEARCH_INDEX_H
+
+#include <import_export.h>
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <wx/string.h>
+
+class FOOTPRINT_LIST;
+
+
+/**
+ * Search index of the items of a FOOTPRINT_LIST.
+ *
+ * The library nicknames, footprint names, keywords and descriptions are split in
+ * tokens (runs of letters and digits, in lower case), and each distinct token has
+ * the sorted list of the items using it.  The tokens are indexed by their bigrams and
+ * trigrams, to find the tokens containing a run of characters without testing all of
+ * them.  The items are also indexed by library and by unique pad count.
+ *
+ * The index only returns candidates for the wildcard patterns: all the items
+ * matching a pattern are candidates, but the candidates must still be tested
+ * with the pattern itself.  The free text search returns exact results.
+ *
+ * The items are referred to by their index in the list, so the index must be built
+ * again each time the list is modified (see FOOTPRINT_LIST::GetSearchIndex()).
+ */
+class APIEXPORT FOOTPRINT_SEARCH_INDEX
+{
+public:
+    FOOTPRINT_SEARCH_INDEX();
+
+    /**
+     * Index all the items of \a aList.  The items which are not loaded yet are loaded.
+     */
+    void Build( FOOTPRINT_LIST& aList );
+
+    void Clear();
+
+    bool IsBuilt() const { return m_list != nullptr; }
+
+    /**
+     * @return the sorted indexes of the items of the library \a aNickname.
+     */
+    const std::vector<int>& GetLibraryItems( const wxString& aNickname ) const;
+
+    /**
+     * @return the sorted indexes of the items having \a aPadCount unique pads.
+     */
+    const std::vector<int>& GetPadCountItems( unsigned aPadCount ) const;
+
+    /**
+     * Find the items which can match a wildcard pattern (see EDA_PATTERN_MATCH_WILDCARD),
+     * tested against the lower case "nickname:footprint" or footprint name.
+     *
+     * @param aPattern      the lower case pattern
+     * @param aCandidates   receives the sorted indexes of the candidate items
+     * @return false if the index gives no hint, and all the items are candidates
+     */
+    bool FindPatternCandidates( const wxString& aPattern, std::vector<int>& aCandidates ) const;
+
+    /**
+     * Free text search: find the items for which each term of \a aText (separated by
+     * white spaces) is found, case insensitive, in the library nickname, footprint name,
+     * keywords or description.
+     *
+     * @param aItems receives the sorted indexes of the matching items
+     */
+    void Search( const wxString& aText, std::vector<int>& aItems ) const;
+
+private:
+    /// Split the lower case \a aText in runs of letters and digits
+    static void tokenize( const wxString& aText, std::vector<wxString>& aTokens );
+
+    /// Add the token \a aId to the lists of the n-grams of \a aToken
+    void indexNgrams( const std::wstring& aToken, int aId );
+
+    /// Find the items having a token containing \a aRun, or false if \a aRun is too short
+    bool findRun( const wxString& aRun, std::vector<int>& aItems ) const;
+
+    /// Find the items having a token containing each run of \a aText
+    bool findRuns( const wxString& aText, std::vector<int>& aItems ) const;
+
+    FOOTPRINT_LIST*                     m_list;         ///< the indexed list, nullptr if not built
+
+    std::vector<wxString>               m_tokens;       ///< distinct tokens, in lower case
+    std::vector<std::vector<int>>       m_tokenItems;   ///< sorted item indexes for each token
+
+    /// sorted token ids for each bigram and trigram of the tokens, see ngramKey()
+    std::unordered_map<uint64_t, std::vector<int>> m_ngramTokens;
+
+    std::map<wxString, std::vector<int>> m_libraries;   ///< sorted item indexes by nickname
+    std::map<unsigned, std::vector<int>> m_padCounts;   ///< sorted item indexes by pad count
+};
+
+#endif // FOOTPRINT_SEARCH_INDEX_H
@@ -28,6 +28,8 @@
 
 #include <vector>
 #include <cstdio>
+#include <memory>
+#include <functional>
 #include <geometry/shape.h>
 #include <geometry/shape_line_chain.h>
 
@@ -508,6 +510,7 @@ class SHAPE_POLY_SET : public SHAPE
         ///> Returns the reference to aIndex-th outline in the set
         SHAPE_LINE_CHAIN& Outline( int aIndex )
         {
+            invalidateIndex();
             return m_polys[aIndex][0];
         }
 
@@ -530,12 +533,14 @@ class SHAPE_POLY_SET : public SHAPE
         ///> Returns the reference to aHole-th hole in the aIndex-th outline
         SHAPE_LINE_CHAIN& Hole( int aOutline, int aHole )
         {
+            invalidateIndex();
             return m_polys[aOutline][aHole + 1];
         }
 
         ///> Returns the aIndex-th subpolygon in the set
         POLYGON& Polygon( int aIndex )
         {
+            invalidateIndex();
             return m_polys[aIndex];
         }
 
@@ -568,6 +573,8 @@ class SHAPE_POLY_SET : public SHAPE
         {
             ITERATOR iter;
 
+            invalidateIndex();
+
             iter.m_poly = this;
             iter.m_currentPolygon = aFirst;
             iter.m_lastPolygon = aLast < 0 ? OutlineCount() - 1 : aLast;
@@ -757,6 +764,19 @@ class SHAPE_POLY_SET : public SHAPE
         ///> Performs outline inflation/deflation, using round corners.
         void Inflate( int aFactor, int aCircleSegmentsCount );
 
+        /**
+         * Function SetTiledOperations
+         * enables or disables the tiled computation of the boolean operations, Simplify()
+         * and Inflate().  When it is enabled (it is disabled by default) and KiCad is built
+         * with OpenMP, the polygon sets having many vertices are split in vertical strips,
+         * computed in parallel, and the strips are merged.  The result covers the same area
+         * as the result of a single Clipper call, but its vertices can be ordered differently.
+         * Operations called from an OpenMP parallel region are never tiled.
+         * Pcbnew enables it while filling the copper zones, when the "tiled zone fill"
+         * option is set.
+         */
+        static void SetTiledOperations( bool aEnable );
+
         ///> Converts a set of polygons with holes to a singe outline with "slits"/"fractures" connecting the outer ring
         ///> to the inner holes
         ///> For aFastMode meaning, see function booleanOp
@@ -795,6 +815,25 @@ class SHAPE_POLY_SET : public SHAPE
 
         const BOX2I BBox( int aClearance = 0 ) const override;
 
+        /**
+         * Function BuildIndex
+         * builds a spatial index of the edges of the polygons.  Contains(), PointOnEdge(),
+         * Collide() and the distance functions then only test the edges near the query point,
+         * instead of all the vertices of the set.  It is worth it for sets which are queried
+         * many times, like the filled areas of zones.
+         *
+         * The index is dropped by the functions modifying the polygons, including the non-const
+         * accessors and iterators: BuildIndex() must be called again once the set is modified.
+         * Move() and copies keep it.
+         */
+        void BuildIndex();
+
+        ///> Returns true if the set has an edge index, see BuildIndex()
+        bool IsIndexed() const
+        {
+            return m_edgeIndex != nullptr;
+        }
+
         /**
          * Function PointOnEdge()
          *
@@ -806,9 +845,8 @@ class SHAPE_POLY_SET : public SHAPE
 
         /**
          * Function Collide
-         * Checks whether the point aP collides with the inside of the polygon set; if the point
-         * lies on an edge or on a corner of any of the polygons, there is no collision: the edges
-         * does not belong to the polygon itself.
+         * Checks whether the point aP is inside the polygon set, or closer to one of its edges
+         * than aClearance.
          * @param  aP         is the VECTOR2I point whose collision with respect to the poly set
          *                    will be tested.
          * @param  aClearance is the security distance; if the point lies closer to the polygon
@@ -893,6 +931,9 @@ class SHAPE_POLY_SET : public SHAPE
         ///> Returns total number of vertices stored in the set.
         int TotalVertices() const;
 
+        ///> Returns the area of the polygons of the set, minus the area of their holes.
+        double Area() const;
+
         ///> Deletes aIdx-th polygon from the set
         void DeletePolygon( int aIdx );
 
@@ -984,6 +1025,7 @@ class SHAPE_POLY_SET : public SHAPE
         bool IsVertexInHole( int aGlobalIdx );
 
     private:
+        class EDGE_INDEX;
 
         SHAPE_LINE_CHAIN& getContourForCorner( int aCornerId, int& aIndexWithinContour );
         VECTOR2I& vertex( int aCornerId );
@@ -1011,6 +1053,25 @@ class SHAPE_POLY_SET : public SHAPE
                         const SHAPE_POLY_SET& aShape,
                         const SHAPE_POLY_SET& aOtherShape, POLYGON_MODE aFastMode );
 
+        ///> The Clipper operation computed in each strip by tiledOp(), from the contours
+        ///> of the subject and clip sets which can change the result in the strip.
+        typedef std::function<void( const ClipperLib::Paths& aSubject,
+                                    const ClipperLib::Paths& aClip,
+                                    ClipperLib::Paths& aResult )> TILE_OP;
+
+        /**
+         * Function tiledOp
+         * computes aOp in vertical strips, in parallel, and stores the merged result in this
+         * set.  The contours of aShape are the subject of aOp, the contours of aOtherShape its
+         * clip.  The result of aOp in a strip is clipped to the strip, which only gives the
+         * same result as aOp on the whole sets if aOp is local, like the boolean operations,
+         * or if it does not move the edges further than aMargin, like Inflate().
+         * @return bool - false if the sets are too small to be split, or tiled operations are
+         *         disabled; this set is not modified then.
+         */
+        bool tiledOp( const SHAPE_POLY_SET& aShape, const SHAPE_POLY_SET& aOtherShape,
+                      int aMargin, POLYGON_MODE aFastMode, const TILE_OP& aOp );
+
         bool pointInPolygon( const VECTOR2I& aP, const SHAPE_LINE_CHAIN& aPath ) const;
 
         const ClipperLib::Path convertToClipper( const SHAPE_LINE_CHAIN& aPath, bool aRequiredOrientation );
@@ -1029,6 +1090,25 @@ class SHAPE_POLY_SET : public SHAPE
          */
         bool containsSingle( const VECTOR2I& aP, int aSubpolyIndex ) const;
 
+        ///> containsSingle(), using the edge index; all the polygons if aSubpolyIndex < 0
+        bool containsIndexed( const VECTOR2I& aP, int aSubpolyIndex ) const;
+
+        /**
+         * Function nearestEdgeDistance
+         * finds the nearest edges of the aSubpolyIndex-th polygon (all polygons if < 0) with
+         * the edge index, by searching in growing boxes around aBox.
+         * @param aDistance returns the distance from an edge to the query object.
+         * @return the minimal distance, or -1 if the polygon has no edges.
+         */
+        template <class DISTANCE>
+        int nearestEdgeDistance( const BOX2I& aBox, int aSubpolyIndex, DISTANCE aDistance ) const;
+
+        ///> Drops the edge index, when the polygons are modified
+        void invalidateIndex()
+        {
+            m_edgeIndex.reset();
+        }
+
         /**
          * Operations ChamferPolygon and FilletPolygon are computed under the private chamferFillet
          * method; this enum is defined to make the necessary distinction when calling this method
@@ -1060,6 +1140,12 @@ class SHAPE_POLY_SET : public SHAPE
         typedef std::vector<POLYGON> Polyset;
 
         Polyset m_polys;
+
+        ///> The edge index, shared by the copies of the set (see BuildIndex())
+        std::shared_ptr<const EDGE_INDEX> m_edgeIndex;
+
+        ///> The translation of the polygons since the index was built
+        VECTOR2I m_edgeIndexOffset;
 };
 
 #endif
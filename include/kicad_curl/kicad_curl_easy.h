@@ -42,6 +42,7 @@
 #endif
 
 
+#include <map>
 #include <string>
 #include <curl/curl.h>
 #include <kicad_curl/kicad_curl.h>
@@ -175,10 +176,27 @@ public:
         return m_buffer;
     }
 
+    /**
+     * Function GetResponseCode
+     * returns the status code of the last response, e.g. 200 or 304 for HTTP(s) requests,
+     * or 0 if no response was received.
+     */
+    long GetResponseCode();
+
+    /**
+     * Function GetResponseHeader
+     * returns the value of a header of the last response, after the redirects.
+     *
+     * @param aName is the header name, case insensitive, i.e. ETag without the colon
+     * @return const std::string - the header value, or an empty string if it is missing
+     */
+    const std::string GetResponseHeader( const std::string& aName ) const;
+
 private:
     CURL*           m_CURL;
     curl_slist*     m_headers;
     std::string     m_buffer;
+    std::map<std::string, std::string> m_response_headers;  ///< lower case names
 };
 
 #endif // KICAD_CURL_EASY_H_
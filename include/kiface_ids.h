@@ -44,6 +44,13 @@ enum KIFACE_ADDR_ID : int
      * Caller takes ownership
      */
     KIFACE_G_FOOTPRINT_TABLE, ///<
+
+    /**
+     * Return a new instance of the legacy symbol library plugin from eeschema.
+     * Type is SCH_PLUGIN*
+     * Caller takes ownership
+     */
+    KIFACE_NEW_SCH_LEGACY_PLUGIN,
 };
 
 #endif // KIFACE_IDS
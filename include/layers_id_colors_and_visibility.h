@@ -284,6 +284,9 @@ enum GERBVIEW_LAYER_ID: int
     GERBVIEW_LAYER_ID_END
 };
 
+#define GERBER_DRAW_LAYER( x ) ( GERBVIEW_LAYER_ID_START + x )
+#define GERBER_DRAW_LAYER_INDEX( x ) ( x - GERBVIEW_LAYER_ID_START )
+
 /// Must update this if you add any enums after GerbView!
 #define LAYER_ID_COUNT GERBVIEW_LAYER_ID_END
 
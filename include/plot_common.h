@@ -33,6 +33,7 @@
 #define PLOT_COMMON_H_
 
 #include <vector>
+#include <unordered_map>
 #include <math/box2.h>
 #include <drawtxt.h>
 #include <class_page_info.h>
@@ -982,6 +983,36 @@ public:
 };
 
 
+/**
+ * Hash and equality functors to find an APERTURE from its size, type and attribute.
+ * The D code is not part of the key.
+ */
+struct APERTURE_HASH
+{
+    std::size_t operator()( const APERTURE& aAperture ) const
+    {
+        std::size_t hash = 2166136261u;
+
+        hash = ( hash ^ (unsigned) aAperture.m_Size.x ) * 16777619;
+        hash = ( hash ^ (unsigned) aAperture.m_Size.y ) * 16777619;
+        hash = ( hash ^ (unsigned) aAperture.m_Type ) * 16777619;
+        hash = ( hash ^ (unsigned) aAperture.m_ApertureAttribute ) * 16777619;
+
+        return hash;
+    }
+};
+
+
+struct APERTURE_EQUAL
+{
+    bool operator()( const APERTURE& aFirst, const APERTURE& aSecond ) const
+    {
+        return aFirst.m_Type == aSecond.m_Type && aFirst.m_Size == aSecond.m_Size
+               && aFirst.m_ApertureAttribute == aSecond.m_ApertureAttribute;
+    }
+};
+
+
 class GERBER_PLOTTER : public PLOTTER
 {
 public:
@@ -1142,6 +1173,15 @@ protected:
      */
     void emitDcode( const DPOINT& pt, int dcode );
 
+    /**
+     * Emit the contour of a region (inside a G36/G37 block).
+     * Corners which have the same device coordinates as the previous corner,
+     * or which are on the straight line joining their neighbours, are merged:
+     * zone fills have a lot of them once converted to the gerber resolution.
+     * @param aCornerList = the contour corners, in IU
+     */
+    void emitRegionContour( const std::vector<wxPoint>& aCornerList );
+
     /**
      * print a Gerber net attribute object record.
      * In a gerber file, a net attribute is owned by a graphic object
@@ -1192,6 +1232,9 @@ protected:
     std::vector<APERTURE>           apertures;
     std::vector<APERTURE>::iterator currentAperture;
 
+    /// index in apertures of each aperture, to avoid a linear search in getAperture()
+    std::unordered_map<APERTURE, int, APERTURE_HASH, APERTURE_EQUAL> m_apertureIndex;
+
     bool     m_gerberUnitInch;  // true if the gerber units are inches, false for mm
     int      m_gerberUnitFmt;   // number of digits in mantissa.
                                 // usually 6 in Inches and 5 or 6  in mm
@@ -244,6 +244,28 @@ public:
         rewind( fp );
         lineNum = 0;
     }
+
+    /**
+     * Function Tell
+     * @return the position in the file of the next line to read, to give to Seek().
+     */
+    long Tell() const
+    {
+        return ftell( fp );
+    }
+
+    /**
+     * Function Seek
+     * moves to a position returned by Tell().
+     * @param aPosition is the position of the next line to read.
+     * @param aLineNumber is the line number of the line before \a aPosition, as returned
+     *  by LineNumber() when Tell() was called.
+     */
+    void Seek( long aPosition, unsigned aLineNumber )
+    {
+        fseek( fp, aPosition, SEEK_SET );
+        lineNum = aLineNumber;
+    }
 };
 
 
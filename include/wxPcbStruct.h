@@ -54,6 +54,7 @@ class DIMENSION;
 class EDGE_MODULE;
 class DRC;
 class ZONE_CONTAINER;
+class ZONE_CONNECTION_POINTS;
 class DRAWSEGMENT;
 class GENERAL_COLLECTOR;
 class GENERAL_COLLECTORS_GUIDE;
@@ -1418,9 +1419,12 @@ public:
      *  The filling starts from starting points like pads, tracks.
      * If exists the old filling is removed
      * @param aZone = zone to fill
+     * @param aConnectionPoints = the pads, tracks and vias of the board, when shared
+     *                            by several zones filled together (can be NULL)
      * @return error level (0 = no error)
      */
-    int Fill_Zone( ZONE_CONTAINER* aZone );
+    int Fill_Zone( ZONE_CONTAINER* aZone,
+                   const ZONE_CONNECTION_POINTS* aConnectionPoints = NULL );
 
     /**
      * Function Fill_All_Zones
@@ -134,6 +134,7 @@ void PL_EDITOR_SCREEN::ClearUndoORRedoList( UNDO_REDO_CONTAINER& aList,
         PICKED_ITEMS_LIST* curr_cmd = aList.m_CommandsList[0];
         aList.m_CommandsList.erase( aList.m_CommandsList.begin() );
 
+        ReleaseCommandData( *curr_cmd );
         curr_cmd->ClearListAndDeleteItems();
         delete curr_cmd;    // Delete command
     }
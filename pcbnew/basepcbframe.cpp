@@ -577,6 +577,14 @@ void PCB_BASE_FRAME::UpdateMsgPanel()
             GetGalCanvas()->GetMsgPanelInfo( items );
         else
             m_Pcb->GetMsgPanelInfo( items );
+
+        if( GetScreen()->GetUndoCommandCount() || GetScreen()->GetRedoCommandCount() )
+        {
+            wxString msg;
+            msg.Printf( wxT( "%.1f MB" ),
+                        GetScreen()->GetUndoRedoMemoryUsage() / ( 1024.0 * 1024.0 ) );
+            items.push_back( MSG_PANEL_ITEM( _( "Undo Memory" ), msg, DARKGRAY ) );
+        }
     }
 
     SetMsgPanel( items );
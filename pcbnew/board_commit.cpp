@@ -32,12 +32,29 @@
 #include <tools/pcb_tool.h>
 
 #include <functional>
+#include <algorithm>
 using namespace std::placeholders;
 
+// The listeners of the commits pushed to any board
+static std::vector<BOARD_COMMIT_LISTENER*> commitListeners;
+
+// Count of commits being pushed: the frame is modified by the commit, the listeners
+// are already notified of each change
+static int pushDepth = 0;
+
+
+static void notifyListeners( BOARD* aBoard, BOARD_ITEM* aItem, CHANGE_TYPE aChangeType )
+{
+    for( BOARD_COMMIT_LISTENER* listener : commitListeners )
+        listener->OnItemChanged( aBoard, aItem, aChangeType );
+}
+
+
 BOARD_COMMIT::BOARD_COMMIT( PCB_TOOL* aTool )
 {
     m_toolMgr = aTool->GetManager();
     m_editModules = aTool->EditingModules();
+    m_updateRatsnest = true;
 }
 
 
@@ -45,6 +62,7 @@ BOARD_COMMIT::BOARD_COMMIT( PCB_BASE_FRAME* aFrame )
 {
     m_toolMgr = aFrame->GetToolManager();
     m_editModules = aFrame->IsType( FRAME_PCB_MODULE_EDITOR );
+    m_updateRatsnest = true;
 }
 
 
@@ -136,6 +154,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry )
                 }
 
                 view->Add( boardItem );
+                notifyListeners( board, boardItem, CHT_ADD );
                 break;
             }
 
@@ -188,6 +207,9 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry )
                     {
                         view->Remove( boardItem );
 
+                        // The listeners are notified while the item still exists
+                        notifyListeners( board, boardItem, CHT_REMOVE );
+
                         if( !( changeFlags & CHT_DONE ) )
                         {
                             MODULE* module = static_cast<MODULE*>( boardItem->GetParent() );
@@ -217,6 +239,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry )
                         board->Remove( boardItem );
 
                     //ratsnest->Remove( boardItem );    // currently done by BOARD::Remove()
+                    notifyListeners( board, boardItem, CHT_REMOVE );
                     break;
 
                 case PCB_MODULE_T:
@@ -235,6 +258,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry )
 
                     // Clear flags to indicate, that the ratsnest, list of nets & pads are not valid anymore
                     board->m_Status_Pcb = 0;
+                    notifyListeners( board, module, CHT_REMOVE );
                 }
                 break;
 
@@ -262,7 +286,11 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry )
                 }
 
                 view->Update ( boardItem );
-                ratsnest->Update( boardItem );
+
+                if( m_updateRatsnest )
+                    ratsnest->Update( boardItem );
+
+                notifyListeners( board, boardItem, CHT_MODIFY );
                 break;
             }
 
@@ -278,14 +306,47 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry )
     if( TOOL_MANAGER* toolMgr = frame->GetToolManager() )
         toolMgr->PostEvent( { TC_MESSAGE, TA_MODEL_CHANGE, AS_GLOBAL } );
 
-    ratsnest->Recalculate();
+    if( m_updateRatsnest )
+        ratsnest->Recalculate();
+
+    pushDepth++;
     frame->OnModify();
+    pushDepth--;
+
     frame->UpdateMsgPanel();
 
     clear();
 }
 
 
+void BOARD_COMMIT::AddListener( BOARD_COMMIT_LISTENER* aListener )
+{
+    commitListeners.push_back( aListener );
+}
+
+
+void BOARD_COMMIT::RemoveListener( BOARD_COMMIT_LISTENER* aListener )
+{
+    auto it = std::find( commitListeners.begin(), commitListeners.end(), aListener );
+
+    if( it != commitListeners.end() )
+        commitListeners.erase( it );
+}
+
+
+bool BOARD_COMMIT::IsPushing()
+{
+    return pushDepth > 0;
+}
+
+
+void BOARD_COMMIT::NotifyBoardChanged( BOARD* aBoard )
+{
+    for( BOARD_COMMIT_LISTENER* listener : commitListeners )
+        listener->OnBoardChanged( aBoard );
+}
+
+
 EDA_ITEM* BOARD_COMMIT::parentObject( EDA_ITEM* aItem ) const
 {
     switch( aItem->Type() )
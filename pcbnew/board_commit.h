@@ -27,12 +27,41 @@
 
 #include <commit.h>
 
+class BOARD;
 class BOARD_ITEM;
 class PICKED_ITEMS_LIST;
 class PCB_TOOL;
 class PCB_BASE_FRAME;
 class TOOL_MANAGER;
 
+/**
+ * Class BOARD_COMMIT_LISTENER
+ * is notified of the items changed by the commits pushed to a board, so it can keep its own
+ * copy of the board data up to date without reading the whole board again.
+ */
+class BOARD_COMMIT_LISTENER
+{
+public:
+    virtual ~BOARD_COMMIT_LISTENER() {}
+
+    /**
+     * Function OnItemChanged()
+     * is called for each item added, removed or modified by a commit, once the change
+     * is applied to the board.  A removed item is notified before it can be deleted.
+     * @param aChangeType is CHT_ADD, CHT_REMOVE or CHT_MODIFY.
+     */
+    virtual void OnItemChanged( BOARD* aBoard, BOARD_ITEM* aItem, CHANGE_TYPE aChangeType ) = 0;
+
+    /**
+     * Function OnBoardChanged()
+     * is called when the board was changed without a commit (e.g. undo or redo, the
+     * legacy tools, the importers or the scripts), so all its items have to be read again.
+     * Items referenced by the listener may have been deleted.
+     */
+    virtual void OnBoardChanged( BOARD* aBoard ) = 0;
+};
+
+
 class BOARD_COMMIT : public COMMIT
 {
 public:
@@ -43,9 +72,30 @@ public:
     virtual void Push( const wxString& aMessage = wxT( "A commit" ), bool aCreateUndoEntry = true ) override;
     virtual void Revert() override;
 
+    ///> Registers a listener notified of the changes of all the boards.
+    static void AddListener( BOARD_COMMIT_LISTENER* aListener );
+
+    ///> Unregisters a listener added with AddListener().
+    static void RemoveListener( BOARD_COMMIT_LISTENER* aListener );
+
+    ///> Notifies the listeners that aBoard was changed without a commit.
+    static void NotifyBoardChanged( BOARD* aBoard );
+
+    ///> Returns true while a commit is being pushed.
+    static bool IsPushing();
+
+    /**
+     * Function SetUpdateRatsnest()
+     * enables or disables the ratsnest update of the modified items in Push() (enabled by
+     * default).  It is disabled by the callers which rebuild the whole ratsnest after the
+     * commit, e.g. when the pad nets were changed before the commit.
+     */
+    void SetUpdateRatsnest( bool aUpdate ) { m_updateRatsnest = aUpdate; }
+
 private:
     TOOL_MANAGER* m_toolMgr;
     bool m_editModules;
+    bool m_updateRatsnest;
     virtual EDA_ITEM* parentObject( EDA_ITEM* aItem ) const override;
 };
 
@@ -32,6 +32,8 @@
  */
 
 
+#include <unordered_set>
+
 #include <common.h>                         // for PAGE_INFO
 
 #include <class_board.h>
@@ -72,6 +74,62 @@ BOARD_NETLIST_UPDATER::~BOARD_NETLIST_UPDATER()
 }
 
 
+void BOARD_NETLIST_UPDATER::buildLookupTables()
+{
+    m_modulesByReference.clear();
+    m_modulesByPath.clear();
+
+    // emplace() keeps the first footprint of a reference, as BOARD::FindModule()
+    for( MODULE* module = m_board->m_Modules; module; module = module->Next() )
+    {
+        m_modulesByReference.emplace( module->GetReference(), module );
+        m_modulesByPath.emplace( module->GetPath().Lower(), module );
+    }
+}
+
+
+MODULE* BOARD_NETLIST_UPDATER::findModule( const wxString& aKey, bool aByTimeStamp ) const
+{
+    const MODULES_BY_NAME& modules = aByTimeStamp ? m_modulesByPath : m_modulesByReference;
+    auto it = modules.find( aByTimeStamp ? aKey.Lower() : aKey );
+
+    return it != modules.end() ? it->second : NULL;
+}
+
+
+void BOARD_NETLIST_UPDATER::updateModuleLookup( MODULE* aModule, const wxString& aOldReference,
+                                                const wxString& aOldPath, MODULE* aOldModule )
+{
+    MODULE* oldModule = aOldModule ? aOldModule : aModule;
+
+    auto update = [&]( MODULES_BY_NAME& aTable, const wxString& aOldKey,
+                       const wxString& aNewKey )
+    {
+        auto it = aTable.find( aOldKey );
+
+        if( it != aTable.end() && it->second == oldModule )
+            aTable.erase( it );
+
+        // The first footprint of a key is kept, as in buildLookupTables()
+        aTable.emplace( aNewKey, aModule );
+    };
+
+    update( m_modulesByReference, aOldReference, aModule->GetReference() );
+    update( m_modulesByPath, aOldPath.Lower(), aModule->GetPath().Lower() );
+}
+
+
+NETINFO_ITEM* BOARD_NETLIST_UPDATER::findNet( const wxString& aNetName ) const
+{
+    if( NETINFO_ITEM* net = m_board->FindNet( aNetName ) )
+        return net;
+
+    auto it = m_addedNets.find( aNetName );
+
+    return it != m_addedNets.end() ? it->second : NULL;
+}
+
+
 wxPoint BOARD_NETLIST_UPDATER::estimateComponentInsertionPosition()
 {
     wxPoint bestPosition;
@@ -128,6 +186,7 @@ MODULE* BOARD_NETLIST_UPDATER::addNewComponent( COMPONENT* aComponent )
 
             m_addedComponents.push_back( footprint );
             m_commit.Add( footprint );
+            updateModuleLookup( footprint, wxEmptyString, wxEmptyString );
 
             return footprint;
         }
@@ -198,6 +257,8 @@ MODULE* BOARD_NETLIST_UPDATER::replaceComponent( NETLIST& aNetlist, MODULE* aPcb
             aPcbComponent->CopyNetlistSettings( newFootprint, false );
             m_commit.Remove( aPcbComponent );
             m_commit.Add( newFootprint );
+            updateModuleLookup( newFootprint, aPcbComponent->GetReference(),
+                                aPcbComponent->GetPath(), aPcbComponent );
 
             return newFootprint;
         }
@@ -234,7 +295,6 @@ bool BOARD_NETLIST_UPDATER::updateComponentParameters( MODULE* aPcbComponent, CO
         return false;
 
     bool changed = false;
-    MODULE* copy = (MODULE*) aPcbComponent->Clone();
 
     // Test for reference designator field change.
     if( aPcbComponent->GetReference() != aNewComponent->GetReference() )
@@ -255,7 +315,9 @@ bool BOARD_NETLIST_UPDATER::updateComponentParameters( MODULE* aPcbComponent, CO
         if ( !m_isDryRun )
         {
             changed = true;
+            wxString oldReference = aPcbComponent->GetReference();
             aPcbComponent->SetReference( aNewComponent->GetReference() );
+            updateModuleLookup( aPcbComponent, oldReference, aPcbComponent->GetPath() );
         }
     }
 
@@ -297,16 +359,13 @@ bool BOARD_NETLIST_UPDATER::updateComponentParameters( MODULE* aPcbComponent, CO
         if( !m_isDryRun )
         {
             changed = true;
+            wxString oldPath = aPcbComponent->GetPath();
             aPcbComponent->SetPath( aNewComponent->GetTimeStamp() );
+            updateModuleLookup( aPcbComponent, aPcbComponent->GetReference(), oldPath );
         }
     }
 
-    if( changed )
-        m_commit.Modified( aPcbComponent, copy );
-    else
-        delete copy;
-
-    return true;
+    return changed;
 }
 
 
@@ -315,12 +374,24 @@ bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( MODULE* aPcbComponent
     wxString msg;
 
     bool changed = false;
-    MODULE* copy = (MODULE*) aPcbComponent->Clone();
+    NETINFO_ITEM* unconnected = m_board->FindNet( NETINFO_LIST::UNCONNECTED );
+
+    // The component nets by pin name, the first one of a pin as COMPONENT::GetNet()
+    std::unordered_map<wxString, const COMPONENT_NET*, WXSTRING_HASH> pinNets;
+
+    for( unsigned ii = 0; ii < aNewComponent->GetNetCount(); ii++ )
+    {
+        const COMPONENT_NET& pinNet = aNewComponent->GetNet( ii );
+        pinNets.emplace( pinNet.GetPinName(), &pinNet );
+    }
 
     // At this point, the component footprint is updated.  Now update the nets.
+    // The pads nets are only set here: the ratsnest is rebuilt once for the whole board
+    // at the end of the update
     for( D_PAD* pad = aPcbComponent->Pads(); pad; pad = pad->Next() )
     {
-        COMPONENT_NET net = aNewComponent->GetNet( pad->GetPadName() );
+        auto pinNet = pinNets.find( pad->GetPadName() );
+        COMPONENT_NET net = pinNet != pinNets.end() ? *pinNet->second : COMPONENT_NET();
 
         if( !net.IsValid() )                // New footprint pad has no net.
         {
@@ -338,10 +409,10 @@ bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( MODULE* aPcbComponent
                 m_reporter->Report( msg, REPORTER::RPT_INFO );
             }
 
-            if( !m_isDryRun )
+            if( !m_isDryRun && pad->GetNet() != unconnected )
             {
                 changed = true;
-                pad->SetNetCode( NETINFO_LIST::UNCONNECTED );
+                pad->SetNet( unconnected );
             }
         }
         else                                 // New footprint pad has a net.
@@ -349,16 +420,9 @@ bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( MODULE* aPcbComponent
             if( net.GetNetName() != pad->GetNetname() )
             {
                 const wxString& netName = net.GetNetName();
-                NETINFO_ITEM* netinfo = m_board->FindNet( netName );
 
-                if( netinfo == nullptr )
-                {
-                    // It might be a new net that has not been added to the board yet
-                    auto netIt = m_addedNets.find( netName );
-
-                    if( netIt != m_addedNets.end() )
-                        netinfo = netIt->second;
-                }
+                // It might be a new net that has not been added to the board yet
+                NETINFO_ITEM* netinfo = findNet( netName );
 
                 if( netinfo == nullptr )
                 {
@@ -410,12 +474,7 @@ bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( MODULE* aPcbComponent
         }
     }
 
-    if( changed )
-        m_commit.Modified( aPcbComponent, copy );
-    else
-        delete copy;
-
-    return true;
+    return changed;
 }
 
 
@@ -423,18 +482,27 @@ bool BOARD_NETLIST_UPDATER::deleteUnusedComponents( NETLIST& aNetlist )
 {
     wxString msg;
     MODULE* nextModule;
-    const COMPONENT* component;
 
-    for( MODULE* module = m_board->m_Modules; module != NULL; module = nextModule )
+    // The time stamps or references of the netlist components
+    std::unordered_set<wxString, WXSTRING_HASH> components;
+
+    for( unsigned ii = 0; ii < aNetlist.GetCount(); ii++ )
     {
-        nextModule = module->Next();
+        const COMPONENT* component = aNetlist.GetComponent( ii );
 
         if( m_lookupByTimestamp )
-            component = aNetlist.GetComponentByTimeStamp( module->GetPath() );
+            components.insert( component->GetTimeStamp() );
         else
-            component = aNetlist.GetComponentByReference( module->GetReference() );
+            components.insert( component->GetReference() );
+    }
+
+    for( MODULE* module = m_board->m_Modules; module != NULL; module = nextModule )
+    {
+        nextModule = module->Next();
 
-        if( component == NULL )
+        const wxString& key = m_lookupByTimestamp ? module->GetPath() : module->GetReference();
+
+        if( components.count( key ) == 0 )
         {
             if( module->IsLocked() )
             {
@@ -561,21 +629,33 @@ bool BOARD_NETLIST_UPDATER::testConnectivity( NETLIST& aNetlist )
     wxString msg;
     wxString padname;
 
+    // The tables still hold the footprints deleted by the update
+    buildLookupTables();
+
     for( int i = 0; i < (int) aNetlist.GetCount(); i++ )
     {
         const COMPONENT* component = aNetlist.GetComponent( i );
-        MODULE* footprint = m_board->FindModuleByReference( component->GetReference() );
+        MODULE* footprint = findModule( component->GetReference(), false );
 
         if( footprint == NULL )    // It can be missing in partial designs
             continue;
 
+        // The footprint pad names, searched without case as MODULE::FindPadByName()
+        std::unordered_set<wxString, WXSTRING_HASH> padNames;
+
+        for( D_PAD* pad = footprint->Pads(); pad; pad = pad->Next() )
+        {
+            pad->StringPadName( padname );
+            padNames.insert( padname.Lower() );
+        }
+
         // Explore all pins/pads in component
         for( unsigned jj = 0; jj < component->GetNetCount(); jj++ )
         {
             COMPONENT_NET net = component->GetNet( jj );
             padname = net.GetPinName();
 
-            if( footprint->FindPadByName( padname ) )
+            if( padNames.count( padname.Lower() ) )
                 continue;   // OK, pad found
 
             // not found: bad footprint, report error
@@ -622,6 +702,8 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
         m_board->SetStatus( 0 );
     }
 
+    buildLookupTables();
+
     for( int i = 0; i < (int) aNetlist.GetCount();  i++ )
     {
         COMPONENT* component = aNetlist.GetComponent( i );
@@ -634,9 +716,9 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
         m_reporter->Report( msg, REPORTER::RPT_INFO );
 
         if( aNetlist.IsFindByTimeStamp() )
-            footprint = m_board->FindModule( component->GetTimeStamp(), true );
+            footprint = findModule( component->GetTimeStamp(), true );
         else
-            footprint = m_board->FindModule( component->GetReference() );
+            footprint = findModule( component->GetReference(), false );
 
         if( footprint )        // An existing footprint.
         {
@@ -652,8 +734,15 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
         if( footprint )
         {
-            updateComponentParameters( footprint, component );
-            updateComponentPadConnections( footprint, component );
+            // A single copy and commit entry for the fields and the pad nets
+            MODULE* copy = (MODULE*) footprint->Clone();
+            bool changed = updateComponentParameters( footprint, component );
+            changed |= updateComponentPadConnections( footprint, component );
+
+            if( changed )
+                m_commit.Modified( footprint, copy );
+            else
+                delete copy;
         }
     }
 
@@ -667,7 +756,10 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
     if( !m_isDryRun )
     {
+        // The pad nets were changed before the commit: the ratsnest is rebuilt once below
+        m_commit.SetUpdateRatsnest( false );
         m_commit.Push( _( "Update netlist" ) );
+        m_addedNets.clear();
         m_frame->Compile_Ratsnest( NULL, false );
         m_board->GetRatsnest()->ProcessBoard();
         testConnectivity( aNetlist );
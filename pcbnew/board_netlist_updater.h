@@ -41,7 +41,10 @@ class COMPONENT;
 class MODULE;
 class PCB_EDIT_FRAME;
 
+#include <unordered_map>
+
 #include <board_commit.h>
+#include <hashtables.h>
 
 /**
  * Class BOARD_NETLIST_UPDATER
@@ -67,6 +70,8 @@ class PCB_EDIT_FRAME;
  * - After all of the footprints have been added, updated, and net names properly set,
  *   any extra unlock footprints are removed from the #BOARD.
  *
+ * The footprints and nets of the #BOARD are looked up in hash tables built once at the
+ * beginning of the update, and the ratsnest is rebuilt once at the end.
  */
 class BOARD_NETLIST_UPDATER
 {
@@ -132,8 +137,30 @@ private:
     wxPoint estimateComponentInsertionPosition();
     MODULE* addNewComponent( COMPONENT* aComponent );
     MODULE* replaceComponent( NETLIST& aNetlist, MODULE* aPcbComponent, COMPONENT* aNewComponent );
+
+    /**
+     * Functions updateComponentParameters and updateComponentPadConnections
+     * update the fields and the pad nets of aPcbComponent from aNewComponent.
+     * @return true if aPcbComponent was changed.  The caller stores it in the commit once
+     * for both updates.
+     */
     bool updateComponentParameters( MODULE* aPcbComponent, COMPONENT* aNewComponent );
     bool updateComponentPadConnections( MODULE* aPcbComponent, COMPONENT* aNewComponent );
+
+    ///> Fills the footprint tables from the board
+    void buildLookupTables();
+
+    ///> Returns the board footprint having aKey as reference or as path, or NULL
+    MODULE* findModule( const wxString& aKey, bool aByTimeStamp ) const;
+
+    ///> Updates the footprint tables for aModule, which had aOldReference and aOldPath,
+    ///> or replaces aOldModule by aModule if it is not NULL
+    void updateModuleLookup( MODULE* aModule, const wxString& aOldReference,
+                             const wxString& aOldPath, MODULE* aOldModule = NULL );
+
+    ///> Returns the board net, or the net added by the update, named aNetName, or NULL
+    NETINFO_ITEM* findNet( const wxString& aNetName ) const;
+
     bool deleteUnusedComponents( NETLIST& aNetlist );
     bool deleteSinglePadNets();
     bool testConnectivity( NETLIST& aNetlist );
@@ -144,7 +171,15 @@ private:
     REPORTER* m_reporter;
 
     std::vector<MODULE*> m_addedComponents;
-    std::map<wxString, NETINFO_ITEM*> m_addedNets;
+
+    typedef std::unordered_map<wxString, MODULE*, WXSTRING_HASH> MODULES_BY_NAME;
+
+    ///> Board footprints by reference, and by lower case path (searched without case)
+    MODULES_BY_NAME m_modulesByReference;
+    MODULES_BY_NAME m_modulesByPath;
+
+    ///> Nets added by the update, not yet on the board, by name
+    std::unordered_map<wxString, NETINFO_ITEM*, WXSTRING_HASH> m_addedNets;
 
     bool m_deleteSinglePadNets;
     bool m_deleteUnusedComponents;
@@ -49,6 +49,8 @@
 #include <math_for_graphics.h>
 #include <polygon_test_point_inside.h>
 
+#include <mutex>
+
 
 ZONE_CONTAINER::ZONE_CONTAINER( BOARD* aBoard ) :
     BOARD_CONNECTED_ITEM( aBoard, PCB_ZONE_AREA_T )
@@ -66,6 +68,7 @@ ZONE_CONTAINER::ZONE_CONTAINER( BOARD* aBoard ) :
     m_cornerRadius = 0;
     SetLocalFlags( 0 );                         // flags tempoarry used in zone calculations
     m_Poly = new SHAPE_POLY_SET();              // Outlines
+    m_FilledPolysList = std::make_shared<FILLED_POLYS>( m_FilledPolysTransform );
     aBoard->GetZoneSettings().ExportSetting( *this );
 }
 
@@ -90,7 +93,8 @@ ZONE_CONTAINER::ZONE_CONTAINER( const ZONE_CONTAINER& aZone ) :
     m_PadConnection = aZone.m_PadConnection;
     m_ThermalReliefGap = aZone.m_ThermalReliefGap;
     m_ThermalReliefCopperBridge = aZone.m_ThermalReliefCopperBridge;
-    m_FilledPolysList.Append( aZone.m_FilledPolysList );
+    m_FilledPolysList = aZone.m_FilledPolysList;   // shared until modified
+    m_FilledPolysTransform = aZone.m_FilledPolysTransform;
     m_FillSegmList = aZone.m_FillSegmList;      // vector <> copy
 
     m_isKeepout = aZone.m_isKeepout;
@@ -128,8 +132,8 @@ ZONE_CONTAINER& ZONE_CONTAINER::operator=( const ZONE_CONTAINER& aOther )
     SetHatchStyle( aOther.GetHatchStyle() );
     SetHatchPitch( aOther.GetHatchPitch() );
     m_HatchLines = aOther.m_HatchLines;     // copy vector <SEG>
-    m_FilledPolysList.RemoveAllContours();
-    m_FilledPolysList.Append( aOther.m_FilledPolysList );
+    m_FilledPolysList = aOther.m_FilledPolysList;
+    m_FilledPolysTransform = aOther.m_FilledPolysTransform;
     m_FillSegmList.clear();
     m_FillSegmList = aOther.m_FillSegmList;
 
@@ -153,10 +157,10 @@ EDA_ITEM* ZONE_CONTAINER::Clone() const
 
 bool ZONE_CONTAINER::UnFill()
 {
-    bool change = ( !m_FilledPolysList.IsEmpty() ) ||
+    bool change = ( !m_FilledPolysList->m_Polys.IsEmpty() ) ||
                   ( m_FillSegmList.size() > 0 );
 
-    m_FilledPolysList.RemoveAllContours();
+    ClearFilledPolysList();
     m_FillSegmList.clear();
     m_IsFilled = false;
 
@@ -253,7 +257,7 @@ void ZONE_CONTAINER::DrawFilledArea( EDA_DRAW_PANEL* panel,
     if( displ_opts->m_DisplayZonesMode == 1 )     // Do not show filled areas
         return;
 
-    if( m_FilledPolysList.IsEmpty() )  // Nothing to draw
+    if( GetFilledPolysList().IsEmpty() )  // Nothing to draw
         return;
 
     BOARD*      brd = GetBoard();
@@ -277,9 +281,9 @@ void ZONE_CONTAINER::DrawFilledArea( EDA_DRAW_PANEL* panel,
     color.a = 0.588;
 
 
-    for ( int ic = 0; ic < m_FilledPolysList.OutlineCount(); ic++ )
+    for ( int ic = 0; ic < GetFilledPolysList().OutlineCount(); ic++ )
     {
-        const SHAPE_LINE_CHAIN& path = m_FilledPolysList.COutline( ic );
+        const SHAPE_LINE_CHAIN& path = GetFilledPolysList().COutline( ic );
 
         CornersBuffer.clear();
 
@@ -635,7 +639,7 @@ int ZONE_CONTAINER::GetClearance( BOARD_CONNECTED_ITEM* aItem ) const
 
 bool ZONE_CONTAINER::HitTestFilledArea( const wxPoint& aRefPos ) const
 {
-    return m_FilledPolysList.Contains( VECTOR2I( aRefPos.x, aRefPos.y ) );
+    return GetFilledPolysList().Contains( VECTOR2I( aRefPos.x, aRefPos.y ) );
 }
 
 
@@ -713,9 +717,9 @@ void ZONE_CONTAINER::GetMsgPanelInfo( std::vector< MSG_PANEL_ITEM >& aList )
     msg.Printf( wxT( "%d" ), (int) m_HatchLines.size() );
     aList.push_back( MSG_PANEL_ITEM( _( "Hatch Lines" ), msg, BLUE ) );
 
-    if( !m_FilledPolysList.IsEmpty() )
+    if( !GetFilledPolysList().IsEmpty() )
     {
-        msg.Printf( wxT( "%d" ), m_FilledPolysList.TotalVertices() );
+        msg.Printf( wxT( "%d" ), GetFilledPolysList().TotalVertices() );
         aList.push_back( MSG_PANEL_ITEM( _( "Corner Count" ), msg, BLUE ) );
     }
 }
@@ -730,7 +734,7 @@ void ZONE_CONTAINER::Move( const wxPoint& offset )
 
     Hatch();
 
-    m_FilledPolysList.Move( VECTOR2I( offset.x, offset.y ) );
+    transformFilledPolys( ZONE_FILL_TRANSFORM::Translation( VECTOR2I( offset ) ) );
 
     for( unsigned ic = 0; ic < m_FillSegmList.size(); ic++ )
     {
@@ -768,8 +772,15 @@ void ZONE_CONTAINER::Rotate( const wxPoint& centre, double angle )
     Hatch();
 
     /* rotate filled areas: */
-    for( auto ic = m_FilledPolysList.Iterate(); ic; ++ic )
-        RotatePoint( &ic->x, &ic->y, centre.x, centre.y, angle );
+    if( ZONE_FILL_TRANSFORM::IsExactRotation( angle ) )
+    {
+        transformFilledPolys( ZONE_FILL_TRANSFORM::Rotation( centre, angle ) );
+    }
+    else
+    {
+        for( auto ic = filledPolys().Iterate(); ic; ++ic )
+            RotatePoint( &ic->x, &ic->y, centre.x, centre.y, angle );
+    }
 
     for( unsigned ic = 0; ic < m_FillSegmList.size(); ic++ )
     {
@@ -797,11 +808,7 @@ void ZONE_CONTAINER::Mirror( const wxPoint& mirror_ref )
 
     Hatch();
 
-    for( auto ic = m_FilledPolysList.Iterate(); ic; ++ic )
-    {
-        int py = mirror_ref.y - ic->y;
-        ic->y = py + mirror_ref.y;
-    }
+    transformFilledPolys( ZONE_FILL_TRANSFORM::MirrorY( mirror_ref.y ) );
 
     for( unsigned ic = 0; ic < m_FillSegmList.size(); ic++ )
     {
@@ -811,6 +818,165 @@ void ZONE_CONTAINER::Mirror( const wxPoint& mirror_ref )
 }
 
 
+const SHAPE_POLY_SET& ZONE_CONTAINER::GetFilledPolysList() const
+{
+    if( m_FilledPolysList->m_Transform != m_FilledPolysTransform )
+    {
+        // The polygons were transformed in place by another copy of the zone, which can
+        // still use them: this zone gets its own polygons.  This is a const accessor, which
+        // can be called from several threads.
+        static std::mutex mutex;
+        std::lock_guard<std::mutex> lock( mutex );
+
+        if( m_FilledPolysList->m_Transform != m_FilledPolysTransform )
+        {
+            auto polys = std::make_shared<FILLED_POLYS>( *m_FilledPolysList );
+            polys->SetTransform( m_FilledPolysTransform );
+            m_FilledPolysList = polys;
+        }
+    }
+
+    return m_FilledPolysList->m_Polys;
+}
+
+
+void ZONE_CONTAINER::SyncFilledPolys()
+{
+    m_FilledPolysList->SetTransform( m_FilledPolysTransform );
+}
+
+
+SHAPE_POLY_SET& ZONE_CONTAINER::filledPolys()
+{
+    if( m_FilledPolysList.use_count() > 1 )
+        m_FilledPolysList = std::make_shared<FILLED_POLYS>( *m_FilledPolysList );
+
+    m_FilledPolysList->SetTransform( m_FilledPolysTransform );
+
+    return m_FilledPolysList->m_Polys;
+}
+
+
+void ZONE_CONTAINER::transformFilledPolys( const ZONE_FILL_TRANSFORM& aTransform )
+{
+    // The other copies sharing the polygons keep their own transform: they apply the
+    // difference when they are used again
+    m_FilledPolysTransform = aTransform * m_FilledPolysTransform;
+    m_FilledPolysList->SetTransform( m_FilledPolysTransform );
+}
+
+
+void ZONE_CONTAINER::FILLED_POLYS::SetTransform( const ZONE_FILL_TRANSFORM& aTransform )
+{
+    if( m_Transform == aTransform )
+        return;
+
+    ( aTransform * m_Transform.Inverse() ).Apply( m_Polys );
+    m_Transform = aTransform;
+}
+
+
+ZONE_FILL_TRANSFORM ZONE_FILL_TRANSFORM::Translation( const VECTOR2I& aOffset )
+{
+    ZONE_FILL_TRANSFORM transform;
+
+    transform.m_offset = aOffset;
+
+    return transform;
+}
+
+
+ZONE_FILL_TRANSFORM ZONE_FILL_TRANSFORM::Rotation( const wxPoint& aCentre, double aAngle )
+{
+    wxASSERT( IsExactRotation( aAngle ) );
+
+    // The columns of the matrix are the rotated unit vectors
+    wxPoint ex( 1, 0 );
+    wxPoint ey( 0, 1 );
+    RotatePoint( &ex, aAngle );
+    RotatePoint( &ey, aAngle );
+
+    ZONE_FILL_TRANSFORM transform;
+
+    transform.m_xx = ex.x;
+    transform.m_yx = ex.y;
+    transform.m_xy = ey.x;
+    transform.m_yy = ey.y;
+
+    // Rotate around aCentre
+    VECTOR2I centre( aCentre );
+    transform.m_offset = centre - transform.Apply( centre );
+
+    return transform;
+}
+
+
+ZONE_FILL_TRANSFORM ZONE_FILL_TRANSFORM::MirrorY( int aMirrorY )
+{
+    ZONE_FILL_TRANSFORM transform;
+
+    transform.m_yy = -1;
+    transform.m_offset = VECTOR2I( 0, 2 * aMirrorY );
+
+    return transform;
+}
+
+
+bool ZONE_FILL_TRANSFORM::IsExactRotation( double aAngle )
+{
+    NORMALIZE_ANGLE_POS( aAngle );
+
+    return aAngle == 0 || aAngle == 900 || aAngle == 1800 || aAngle == 2700;
+}
+
+
+ZONE_FILL_TRANSFORM ZONE_FILL_TRANSFORM::operator*( const ZONE_FILL_TRANSFORM& aOther ) const
+{
+    ZONE_FILL_TRANSFORM transform;
+
+    transform.m_xx = m_xx * aOther.m_xx + m_xy * aOther.m_yx;
+    transform.m_xy = m_xx * aOther.m_xy + m_xy * aOther.m_yy;
+    transform.m_yx = m_yx * aOther.m_xx + m_yy * aOther.m_yx;
+    transform.m_yy = m_yx * aOther.m_xy + m_yy * aOther.m_yy;
+    transform.m_offset = Apply( aOther.m_offset );
+
+    return transform;
+}
+
+
+ZONE_FILL_TRANSFORM ZONE_FILL_TRANSFORM::Inverse() const
+{
+    // The matrix only swaps and negates the axes: its inverse is its transpose
+    ZONE_FILL_TRANSFORM transform;
+
+    transform.m_xx = m_xx;
+    transform.m_xy = m_yx;
+    transform.m_yx = m_xy;
+    transform.m_yy = m_yy;
+    transform.m_offset = -transform.Apply( m_offset );
+
+    return transform;
+}
+
+
+void ZONE_FILL_TRANSFORM::Apply( SHAPE_POLY_SET& aPolys ) const
+{
+    if( m_xx == 1 && m_xy == 0 && m_yx == 0 && m_yy == 1 )
+    {
+        aPolys.Move( m_offset );
+        return;
+    }
+
+    bool indexed = aPolys.IsIndexed();
+
+    for( auto iterator = aPolys.IterateWithHoles(); iterator; iterator++ )
+        *iterator = Apply( *iterator );
+
+    if( indexed )
+        aPolys.BuildIndex();
+}
+
+
 ZoneConnection ZONE_CONTAINER::GetPadConnection( D_PAD* aPad ) const
 {
     if( aPad == NULL || aPad->GetZoneConnection() == PAD_ZONE_CONN_INHERITED )
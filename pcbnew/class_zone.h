@@ -31,6 +31,7 @@
 #define CLASS_ZONE_H_
 
 
+#include <memory>
 #include <vector>
 #include <gr_basic.h>
 #include <class_board_item.h>
@@ -48,6 +49,7 @@ class PCB_EDIT_FRAME;
 class BOARD;
 class ZONE_CONTAINER;
 class MSG_PANEL_ITEM;
+class ZONE_CONNECTION_POINTS;
 
 
 /**
@@ -69,6 +71,72 @@ struct SEGMENT
 };
 
 
+/**
+ * Class ZONE_FILL_TRANSFORM
+ * is a transform of the filled areas of a zone which can be undone exactly: a rotation
+ * by a multiple of 90 degrees and a mirroring, followed by a translation.
+ * The copies of a zone (e.g. the copies stored in the undo list) share their filled
+ * areas: a copy moved, rotated or mirrored by such a transform applies it to the shared
+ * areas in place, and the other copies apply the difference when they are used again.
+ */
+class ZONE_FILL_TRANSFORM
+{
+public:
+    ZONE_FILL_TRANSFORM() :
+        m_xx( 1 ), m_xy( 0 ), m_yx( 0 ), m_yy( 1 )
+    {
+    }
+
+    static ZONE_FILL_TRANSFORM Translation( const VECTOR2I& aOffset );
+
+    /**
+     * Function Rotation
+     * @return the rotation by aAngle (in 0.1 degrees) around aCentre.
+     * aAngle must be a multiple of 90 degrees, see IsExactRotation().
+     */
+    static ZONE_FILL_TRANSFORM Rotation( const wxPoint& aCentre, double aAngle );
+
+    ///> Returns the mirroring of the Y coordinates about aMirrorY
+    static ZONE_FILL_TRANSFORM MirrorY( int aMirrorY );
+
+    ///> Returns true if a rotation by aAngle (in 0.1 degrees) keeps integer coordinates
+    static bool IsExactRotation( double aAngle );
+
+    ///> Returns the transform applying aOther first, then this one
+    ZONE_FILL_TRANSFORM operator*( const ZONE_FILL_TRANSFORM& aOther ) const;
+
+    ZONE_FILL_TRANSFORM Inverse() const;
+
+    bool operator==( const ZONE_FILL_TRANSFORM& aOther ) const
+    {
+        return m_xx == aOther.m_xx && m_xy == aOther.m_xy && m_yx == aOther.m_yx
+               && m_yy == aOther.m_yy && m_offset == aOther.m_offset;
+    }
+
+    bool operator!=( const ZONE_FILL_TRANSFORM& aOther ) const
+    {
+        return !( *this == aOther );
+    }
+
+    VECTOR2I Apply( const VECTOR2I& aPoint ) const
+    {
+        return VECTOR2I( m_xx * aPoint.x + m_xy * aPoint.y + m_offset.x,
+                         m_yx * aPoint.x + m_yy * aPoint.y + m_offset.y );
+    }
+
+    /**
+     * Function Apply
+     * transforms all the vertices of aPolys.  A translation keeps the edge index of aPolys,
+     * the other transforms build it again if aPolys had one.
+     */
+    void Apply( SHAPE_POLY_SET& aPolys ) const;
+
+private:
+    int      m_xx, m_xy, m_yx, m_yy;    ///< the rotation and mirroring matrix
+    VECTOR2I m_offset;                  ///< the translation, applied after the matrix
+};
+
+
 /**
  * Class ZONE_CONTAINER
  * handles a list of polygons defining a copper zone.
@@ -169,8 +237,11 @@ public:
      * Function TestForCopperIslandAndRemoveInsulatedIslands
      * Remove insulated copper islands found in m_FilledPolysList.
      * @param aPcb = the board to analyze
+     * @param aConnectionPoints = the pads, tracks and vias of aPcb, when shared by
+     *  several zones.  If NULL, the ones of the zone net are read from aPcb.
      */
-    void TestForCopperIslandAndRemoveInsulatedIslands( BOARD* aPcb );
+    void TestForCopperIslandAndRemoveInsulatedIslands( BOARD* aPcb,
+            const ZONE_CONNECTION_POINTS* aConnectionPoints = NULL );
 
     /**
      * Function IsOnCopperLayer
@@ -311,8 +382,11 @@ public:
      * When aOutlineBuffer is not null, his function calls
      * AddClearanceAreasPolygonsToPolysList() to add holes for pads and tracks
      * and other items not in net.
+     * @param aConnectionPoints: the connection points shared by the zones filled
+     * together, used to remove the insulated islands (can be NULL)
      */
-    bool BuildFilledSolidAreasPolygons( BOARD* aPcb, SHAPE_POLY_SET* aOutlineBuffer = NULL );
+    bool BuildFilledSolidAreasPolygons( BOARD* aPcb, SHAPE_POLY_SET* aOutlineBuffer = NULL,
+            const ZONE_CONNECTION_POINTS* aConnectionPoints = NULL );
 
     /**
      * Function AddClearanceAreasPolygonsToPolysList
@@ -324,10 +398,12 @@ public:
      * BuildFilledSolidAreasPolygons() call this function just after creating the
      *  filled copper area polygon (without clearance areas
      * @param aPcb: the current board
+     * @param aConnectionPoints: see BuildFilledSolidAreasPolygons()
      * _NG version uses SHAPE_POLY_SET instead of Boost.Polygon
      */
     void AddClearanceAreasPolygonsToPolysList( BOARD* aPcb );
-    void AddClearanceAreasPolygonsToPolysList_NG( BOARD* aPcb );
+    void AddClearanceAreasPolygonsToPolysList_NG( BOARD* aPcb,
+            const ZONE_CONNECTION_POINTS* aConnectionPoints = NULL );
 
 
      /**
@@ -576,18 +652,17 @@ public:
      */
     void ClearFilledPolysList()
     {
-        m_FilledPolysList.RemoveAllContours();
+        m_FilledPolysList = std::make_shared<FILLED_POLYS>( m_FilledPolysTransform );
     }
 
    /**
      * Function GetFilledPolysList
      * returns a reference to the list of filled polygons.
+     * If the polygons shared with another copy of the zone were transformed by this other
+     * copy, this zone gets its own polygons first.
      * @return Reference to the list of filled polygons.
      */
-    const SHAPE_POLY_SET& GetFilledPolysList() const
-    {
-        return m_FilledPolysList;
-    }
+    const SHAPE_POLY_SET& GetFilledPolysList() const;
 
    /**
      * Function AddFilledPolysList
@@ -595,7 +670,31 @@ public:
      */
     void AddFilledPolysList( SHAPE_POLY_SET& aPolysList )
     {
-        m_FilledPolysList = aPolysList;
+        m_FilledPolysList = std::make_shared<FILLED_POLYS>( m_FilledPolysTransform );
+        m_FilledPolysList->m_Polys = aPolysList;
+        m_FilledPolysList->m_Polys.BuildIndex();
+    }
+
+    /**
+     * Function SyncFilledPolys
+     * applies the transforms of this zone to the filled polygons it shares with other
+     * copies of the zone, in place, so the zone can use them without a copy.
+     * To be called on the zone restored from a copy (e.g. by an undo command): the other
+     * copies apply the difference when they are used again.
+     */
+    void SyncFilledPolys();
+
+    /**
+     * Function GetSharedFilledPolys
+     * @return the filled polygons, which can be shared by several copies of the zone.
+     * Used to account for the memory held by the copies: unlike GetFilledPolysList(),
+     * it never copies the polygons.
+     * @param aSize = the approximate size of the polygons in bytes
+     */
+    std::weak_ptr<const void> GetSharedFilledPolys( size_t& aSize ) const
+    {
+        aSize = m_FilledPolysList->m_Polys.TotalVertices() * sizeof( VECTOR2I );
+        return m_FilledPolysList;
     }
 
     /**
@@ -634,7 +733,7 @@ public:
      */
     void AddFilledPolygon( SHAPE_POLY_SET& aPolygon )
     {
-        m_FilledPolysList.Append( aPolygon );
+        filledPolys().Append( aPolygon );
     }
 
     void AddFillSegments( std::vector< SEGMENT >& aSegments )
@@ -722,6 +821,43 @@ public:
 private:
     void buildFeatureHoleList( BOARD* aPcb, SHAPE_POLY_SET& aFeatures );
 
+    /**
+     * Struct FILLED_POLYS
+     * holds the filled polygons shared by the copies of a zone, and the transform of the
+     * copies they are valid for.
+     */
+    struct FILLED_POLYS
+    {
+        FILLED_POLYS( const ZONE_FILL_TRANSFORM& aTransform ) :
+            m_Transform( aTransform )
+        {
+        }
+
+        /**
+         * Function SetTransform
+         * transforms m_Polys to make them valid for the copies of the zone transformed
+         * by aTransform.
+         */
+        void SetTransform( const ZONE_FILL_TRANSFORM& aTransform );
+
+        SHAPE_POLY_SET      m_Polys;
+        ZONE_FILL_TRANSFORM m_Transform;
+    };
+
+    /**
+     * Function filledPolys
+     * @return the filled polygons, to be modified: they are copied first if they are
+     * shared with another copy of the zone.
+     */
+    SHAPE_POLY_SET& filledPolys();
+
+    /**
+     * Function transformFilledPolys
+     * applies aTransform to the filled polygons, without copying them if they are shared
+     * with another copy of the zone.
+     */
+    void transformFilledPolys( const ZONE_FILL_TRANSFORM& aTransform );
+
     SHAPE_POLY_SET*       m_Poly;                ///< Outline of the zone.
     SHAPE_POLY_SET*       m_smoothedPoly;        // Corner-smoothed version of m_Poly
     int                   m_cornerSmoothingType;
@@ -783,9 +919,15 @@ private:
      * as m_Poly.  In less simple cases (when m_Poly has holes) m_FilledPolysList is
      * a polygon equivalent to m_Poly, without holes but with extra outline segment
      * connecting "holes" with external main outline.  In complex cases an outline
-     * described by m_Poly can have many filled areas
+     * described by m_Poly can have many filled areas.
+     * They are shared by the copies of the zone (e.g. the copies stored in the undo
+     * list) until one of them is modified: see filledPolys().  They are not copied when
+     * a copy is moved, rotated or mirrored: see transformFilledPolys().
      */
-    SHAPE_POLY_SET        m_FilledPolysList;
+    mutable std::shared_ptr<FILLED_POLYS> m_FilledPolysList;
+
+    ///> The transforms applied to this copy of the zone, see ZONE_FILL_TRANSFORM
+    ZONE_FILL_TRANSFORM   m_FilledPolysTransform;
 
     HATCH_STYLE           m_hatchStyle;     // hatch style, see enum above
     int                   m_hatchPitch;     // for DIAGONAL_EDGE, distance between 2 hatch lines
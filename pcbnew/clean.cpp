@@ -39,7 +39,194 @@
 #include <dialog_cleaning_options.h>
 #include <board_commit.h>
 
-#include <tuple>
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+
+
+/**
+ * Class TRACK_ORDER_COUNTER
+ * counts the tracks still on the board between two positions of the initial track list
+ * (a Fenwick tree), to know their distance in the list without walking it.
+ */
+class TRACK_ORDER_COUNTER
+{
+public:
+    void Init( int aCount )
+    {
+        // all the tracks are on the board
+        m_tree.assign( aCount, 0 );
+
+        for( int ii = 0; ii < aCount; ii++ )
+        {
+            m_tree[ii] += 1;
+            int parent = ii | ( ii + 1 );
+
+            if( parent < aCount )
+                m_tree[parent] += m_tree[ii];
+        }
+    }
+
+    void Remove( int aPos )
+    {
+        for( int ii = aPos; ii < (int) m_tree.size(); ii |= ii + 1 )
+            m_tree[ii]--;
+    }
+
+    ///> Count of tracks at positions 0 to aPos - 1
+    int CountBefore( int aPos ) const
+    {
+        int count = 0;
+
+        for( int ii = aPos - 1; ii >= 0; ii = ( ii & ( ii + 1 ) ) - 1 )
+            count += m_tree[ii];
+
+        return count;
+    }
+
+    ///> Count of tracks strictly between aPosA and aPosB
+    int CountBetween( int aPosA, int aPosB ) const
+    {
+        if( aPosA > aPosB )
+            std::swap( aPosA, aPosB );
+
+        return CountBefore( aPosB ) - CountBefore( aPosA + 1 );
+    }
+
+private:
+    std::vector<int> m_tree;
+};
+
+
+/**
+ * Class TRACK_ENDPOINT_INDEX
+ * holds the tracks and vias of the board by endpoint position, and their order in the
+ * board track list, both in the whole list and in the list of the tracks of their net.
+ * It is built once by the cleaner, and updated when tracks are removed or merged.
+ */
+class TRACK_ENDPOINT_INDEX
+{
+public:
+    void Build( TRACK* aFirst )
+    {
+        std::unordered_map<int, int> netCounts;
+
+        for( TRACK* track = aFirst; track; track = track->Next() )
+        {
+            ENTRY& entry = m_entries[track];
+
+            entry.m_pos = m_tracks.size();
+            entry.m_netPos = netCounts[track->GetNetCode()]++;
+            m_tracks.push_back( track );
+            AddEndpoints( track );
+        }
+
+        m_order.Init( m_tracks.size() );
+
+        for( const auto& net : netCounts )
+            m_netOrder[net.first].Init( net.second );
+    }
+
+    void Remove( TRACK* aTrack )
+    {
+        const ENTRY& entry = m_entries.at( aTrack );
+
+        RemoveEndpoints( aTrack );
+        m_order.Remove( entry.m_pos );
+        m_netOrder[aTrack->GetNetCode()].Remove( entry.m_netPos );
+        m_tracks[entry.m_pos] = NULL;
+    }
+
+    void AddEndpoints( TRACK* aTrack )
+    {
+        m_endpoints[key( aTrack->GetStart() )].push_back( aTrack );
+
+        if( aTrack->GetEnd() != aTrack->GetStart() )
+            m_endpoints[key( aTrack->GetEnd() )].push_back( aTrack );
+    }
+
+    void RemoveEndpoints( TRACK* aTrack )
+    {
+        removeEndpoint( aTrack, aTrack->GetStart() );
+
+        if( aTrack->GetEnd() != aTrack->GetStart() )
+            removeEndpoint( aTrack, aTrack->GetEnd() );
+    }
+
+    ///> Returns the tracks having an endpoint at aPosition
+    const std::vector<TRACK*>& TracksAt( const wxPoint& aPosition ) const
+    {
+        static const std::vector<TRACK*> empty;
+        auto it = m_endpoints.find( key( aPosition ) );
+
+        return it == m_endpoints.end() ? empty : it->second;
+    }
+
+    ///> Returns the position of aTrack in the initial track list
+    int Position( const TRACK* aTrack ) const
+    {
+        return m_entries.at( const_cast<TRACK*>( aTrack ) ).m_pos;
+    }
+
+    ///> Returns the track at aPosition in the initial track list, or NULL if removed
+    TRACK* Track( int aPosition ) const
+    {
+        return m_tracks[aPosition];
+    }
+
+    int TrackCount() const
+    {
+        return m_tracks.size();
+    }
+
+    ///> Returns the count of tracks between aTrackA and aTrackB in the board list
+    int CountBetween( const TRACK* aTrackA, const TRACK* aTrackB ) const
+    {
+        return m_order.CountBetween( Position( aTrackA ), Position( aTrackB ) );
+    }
+
+    /**
+     * Function SameNetBetween
+     * @return true if all the tracks between aTrackA and aTrackB in the board list are
+     * on their net (aTrackA and aTrackB must be on the same net)
+     */
+    bool SameNetBetween( const TRACK* aTrackA, const TRACK* aTrackB ) const
+    {
+        const ENTRY& entryA = m_entries.at( const_cast<TRACK*>( aTrackA ) );
+        const ENTRY& entryB = m_entries.at( const_cast<TRACK*>( aTrackB ) );
+        const TRACK_ORDER_COUNTER& netOrder = m_netOrder.at( aTrackA->GetNetCode() );
+
+        return m_order.CountBetween( entryA.m_pos, entryB.m_pos )
+               == netOrder.CountBetween( entryA.m_netPos, entryB.m_netPos );
+    }
+
+private:
+    struct ENTRY
+    {
+        int m_pos;          ///< position in the initial track list
+        int m_netPos;       ///< position in the initial list of the tracks of its net
+    };
+
+    static uint64_t key( const wxPoint& aPosition )
+    {
+        return ( uint64_t( uint32_t( aPosition.x ) ) << 32 ) | uint32_t( aPosition.y );
+    }
+
+    void removeEndpoint( TRACK* aTrack, const wxPoint& aPosition )
+    {
+        std::vector<TRACK*>& tracks = m_endpoints[key( aPosition )];
+
+        tracks.erase( std::remove( tracks.begin(), tracks.end(), aTrack ), tracks.end() );
+    }
+
+    std::unordered_map<TRACK*, ENTRY> m_entries;
+    std::vector<TRACK*> m_tracks;
+    std::unordered_map<uint64_t, std::vector<TRACK*> > m_endpoints;
+    TRACK_ORDER_COUNTER m_order;
+    std::unordered_map<int, TRACK_ORDER_COUNTER> m_netOrder;
+};
+
 
 // Helper class used to clean tracks and vias
 class TRACKS_CLEANER: CONNECTIONS
@@ -117,10 +304,34 @@ private:
     const ZONE_CONTAINER* zoneForTrackEndpoint( const TRACK* aTrack,
             ENDPOINT_T aEndPoint );
 
-    bool testTrackEndpointDangling( TRACK* aTrack, ENDPOINT_T aEndPoint );
+    /**
+     * Function testTrackEndpointDangling
+     * @param aAmbiguous = set to true if the result depends on the order of the tracks
+     * in the board list, i.e. can change when tracks far from aTrack are removed
+     */
+    bool testTrackEndpointDangling( TRACK* aTrack, ENDPOINT_T aEndPoint, bool* aAmbiguous );
+
+    /**
+     * Function getConnectedTrack
+     * finds the same track or via as
+     * aTrack->GetTrack( m_brd->m_Track, NULL, aEndPoint, true, false ), using m_index:
+     * among the tracks of the same net connected to aEndPoint and not flagged BUSY, the
+     * one the nearest to aTrack in the board list, searching forward first, and not
+     * beyond a track of another net.
+     * @param aAmbiguous = if not NULL, set to true if another connected track is found,
+     * and one of them is a via, or if a connected track is hidden by a track of another
+     * net: the result can then change when other tracks are removed.
+     */
+    TRACK* getConnectedTrack( TRACK* aTrack, ENDPOINT_T aEndPoint, bool* aAmbiguous = NULL );
+
+    /// Remove aTrack from the board and from m_index
+    void removeTrack( TRACK* aTrack );
 
     BOARD* m_brd;
     BOARD_COMMIT& m_commit;
+
+    /// The tracks by endpoint and their order in the board list, built by CleanupBoard()
+    TRACK_ENDPOINT_INDEX m_index;
 };
 
 
@@ -167,6 +378,7 @@ bool TRACKS_CLEANER::CleanupBoard( bool aRemoveMisConnected,
                                    bool aDeleteUnconnected )
 {
     buildTrackConnectionInfo();
+    m_index.Build( m_brd->m_Track );
 
     bool modified = false;
 
@@ -222,6 +434,65 @@ TRACKS_CLEANER::TRACKS_CLEANER( BOARD* aPcb, BOARD_COMMIT& aCommit )
 }
 
 
+void TRACKS_CLEANER::removeTrack( TRACK* aTrack )
+{
+    m_index.Remove( aTrack );
+    m_brd->Remove( aTrack );
+    m_commit.Removed( aTrack );
+}
+
+
+TRACK* TRACKS_CLEANER::getConnectedTrack( TRACK* aTrack, ENDPOINT_T aEndPoint,
+                                          bool* aAmbiguous )
+{
+    const wxPoint& position = aTrack->GetEndPoint( aEndPoint );
+    LSET    refLayers = aTrack->GetLayerSet();
+    int     refPos = m_index.Position( aTrack );
+    TRACK*  found = NULL;
+    int     foundDistance = 0;
+    bool    foundBackward = false;
+    int     count = 0;
+    bool    hidden = false;
+    bool    via = false;
+
+    for( TRACK* candidate : m_index.TracksAt( position ) )
+    {
+        if( candidate == aTrack || candidate->GetNetCode() != aTrack->GetNetCode()
+                || candidate->GetState( BUSY | IS_DELETED )
+                || !( refLayers & candidate->GetLayerSet() ).any() )
+            continue;
+
+        count++;
+        via |= candidate->Type() == PCB_VIA_T;
+
+        // TRACK::GetTrack() stops at the first track of another net, in both directions
+        if( !m_index.SameNetBetween( aTrack, candidate ) )
+        {
+            hidden = true;
+            continue;
+        }
+
+        // and looks alternately forward and backward: the nearest track is found first,
+        // and the forward one of two tracks at the same distance
+        int distance = m_index.CountBetween( aTrack, candidate );
+        bool backward = m_index.Position( candidate ) < refPos;
+
+        if( !found || distance < foundDistance
+                || ( distance == foundDistance && foundBackward && !backward ) )
+        {
+            found = candidate;
+            foundDistance = distance;
+            foundBackward = backward;
+        }
+    }
+
+    if( aAmbiguous )
+        *aAmbiguous = hidden || ( count > 1 && via );
+
+    return found;
+}
+
+
 void TRACKS_CLEANER::buildTrackConnectionInfo()
 {
     BuildTracksCandidatesList( m_brd->m_Track, NULL );
@@ -313,8 +584,7 @@ bool TRACKS_CLEANER::removeBadTrackSegments()
         if( segment->GetState( FLAG0 ) )    // Segment is flagged to be removed
         {
             isModified = true;
-            m_brd->Remove( segment );
-            m_commit.Removed( segment );
+            removeTrack( segment );
         }
     }
 
@@ -333,47 +603,52 @@ bool TRACKS_CLEANER::removeBadTrackSegments()
 
 bool TRACKS_CLEANER::remove_duplicates_of_via( const VIA *aVia )
 {
-    bool modified = false;
+    // Search and delete the following vias at same location
+    std::vector<TRACK*> duplicates;
 
-    // Search and delete others vias at same location
-    VIA* next_via;
-
-    for( VIA* alt_via = GetFirstVia( aVia->Next() ); alt_via != NULL; alt_via = next_via )
+    for( TRACK* alt_via : m_index.TracksAt( aVia->GetStart() ) )
     {
-        next_via = GetFirstVia( alt_via->Next() );
-
-        if( ( alt_via->GetViaType() == VIA_THROUGH ) &&
-                ( alt_via->GetStart() == aVia->GetStart() ) )
-        {
-            m_brd->Remove( alt_via );
-            m_commit.Removed( alt_via );
-            modified = true;
-        }
+        if( alt_via->Type() == PCB_VIA_T
+                && m_index.Position( alt_via ) > m_index.Position( aVia )
+                && static_cast<VIA*>( alt_via )->GetViaType() == VIA_THROUGH
+                && alt_via->GetStart() == aVia->GetStart() )
+            duplicates.push_back( alt_via );
     }
-    return modified;
+
+    for( TRACK* alt_via : duplicates )
+        removeTrack( alt_via );
+
+    return !duplicates.empty();
 }
 
 
 bool TRACKS_CLEANER::clean_vias()
 {
     bool modified = false;
+    VIA* next_via;
 
-    for( VIA* via = GetFirstVia( m_brd->m_Track ); via != NULL;
-            via = GetFirstVia( via->Next() ) )
+    for( VIA* via = GetFirstVia( m_brd->m_Track ); via != NULL; via = next_via )
     {
         // Correct via m_End defects (if any), should never happen
         if( via->GetStart() != via->GetEnd() )
         {
             wxFAIL_MSG( "Malformed via with mismatching ends" );
+            m_index.RemoveEndpoints( via );
             via->SetEnd( via->GetStart() );
+            m_index.AddEndpoints( via );
         }
 
         /* Important: these cleanups only do thru hole vias, they don't
          * (yet) handle high density interconnects */
         if( via->GetViaType() == VIA_THROUGH )
-        {
             modified |= remove_duplicates_of_via( via );
 
+        // The via can be removed below: get the next one now (a removed item has no Next())
+        next_via = GetFirstVia( via->Next() );
+
+        if( via->GetViaType() == VIA_THROUGH )
+        {
+
             /* To delete through Via on THT pads at same location
              * Examine the list of connected pads:
              * if one through pad is found, the via can be removed */
@@ -385,8 +660,7 @@ bool TRACKS_CLEANER::clean_vias()
                 if( ( pad->GetLayerSet() & all_cu ) == all_cu )
                 {
                     // redundant: delete the via
-                    m_brd->Remove( via );
-                    m_commit.Removed( via );
+                    removeTrack( via );
                     modified = true;
                     break;
                 }
@@ -421,11 +695,12 @@ const ZONE_CONTAINER* TRACKS_CLEANER::zoneForTrackEndpoint( const TRACK* aTrack,
 
 /** Utility: does the endpoint unconnected processed for one endpoint of one track
  * Returns true if the track must be deleted, false if not necessarily */
-bool TRACKS_CLEANER::testTrackEndpointDangling( TRACK* aTrack, ENDPOINT_T aEndPoint )
+bool TRACKS_CLEANER::testTrackEndpointDangling( TRACK* aTrack, ENDPOINT_T aEndPoint,
+                                                bool* aAmbiguous )
 {
     bool flag_erase = false;
 
-    TRACK* other = aTrack->GetTrack( m_brd->m_Track, NULL, aEndPoint, true, false );
+    TRACK* other = getConnectedTrack( aTrack, aEndPoint, aAmbiguous );
 
     if( !other && !zoneForTrackEndpoint( aTrack, aEndPoint ) )
         flag_erase = true; // Start endpoint is neither on pad, zone or other track
@@ -447,7 +722,9 @@ bool TRACKS_CLEANER::testTrackEndpointDangling( TRACK* aTrack, ENDPOINT_T aEndPo
             // search for another segment following the via
             aTrack->SetState( BUSY, true );
 
-            other = via->GetTrack( m_brd->m_Track, NULL, aEndPoint, true, false );
+            bool ambiguous = false;
+            other = getConnectedTrack( via, aEndPoint, &ambiguous );
+            *aAmbiguous |= ambiguous;
 
             // There is a via on the start but it goes nowhere
             if( !other && !zoneForTrackEndpoint( via, aEndPoint ) )
@@ -473,16 +750,32 @@ bool TRACKS_CLEANER::deleteDanglingTracks()
     bool modified = false;
     bool item_erased;
 
+    /* The tracks are tested in the board list order, and the list is tested again
+     * as long as a track is deleted.  Only the tracks which can have a different result
+     * are tested again: the tracks having an endpoint where a track was deleted, and the
+     * ones whose result depends on the tracks order.  They are listed by position in the
+     * board list: a track after the deleted one is tested in the same pass */
+    std::set<int> pass, next_pass;
+
+    for( TRACK* track = m_brd->m_Track; track != NULL; track = track->Next() )
+        pass.insert( m_index.Position( track ) );
+
     do // Iterate when at least one track is deleted
     {
         item_erased = false;
-        TRACK* next_track;
 
-        for( TRACK *track = m_brd->m_Track; track != NULL; track = next_track )
+        while( !pass.empty() )
         {
-            next_track = track->Next();
+            int position = *pass.begin();
+            pass.erase( pass.begin() );
+
+            TRACK* track = m_index.Track( position );
+
+            if( !track )    // already deleted
+                continue;
 
             bool flag_erase = false; // Start without a good reason to erase it
+            bool ambiguous = false;
 
             /* if a track endpoint is not connected to a pad, test if
              * the endpoint is connected to another track or to a zone.
@@ -493,29 +786,49 @@ bool TRACKS_CLEANER::deleteDanglingTracks()
 
             // Check if there is nothing attached on the start
             if( !( track->GetState( START_ON_PAD ) ) )
-                flag_erase |= testTrackEndpointDangling( track, ENDPOINT_START );
+                flag_erase |= testTrackEndpointDangling( track, ENDPOINT_START, &ambiguous );
 
             // If not sure about removal, then check if there is nothing attached on the end
             if( !flag_erase && !track->GetState( END_ON_PAD ) )
-                flag_erase |= testTrackEndpointDangling( track, ENDPOINT_END );
+                flag_erase |= testTrackEndpointDangling( track, ENDPOINT_END, &ambiguous );
 
             if( flag_erase )
             {
-                m_brd->Remove( track );
-                m_commit.Removed( track );
+                removeTrack( track );
 
                 /* keep iterating, because a track connected to the deleted track
                  * now perhaps is not connected and should be deleted */
+                for( ENDPOINT_T endpoint = ENDPOINT_START; endpoint <= ENDPOINT_END;
+                        endpoint = ENDPOINT_T( endpoint + 1 ) )
+                {
+                    for( TRACK* other : m_index.TracksAt( track->GetEndPoint( endpoint ) ) )
+                    {
+                        int other_position = m_index.Position( other );
+
+                        if( other_position > position )
+                            pass.insert( other_position );
+                        else
+                            next_pass.insert( other_position );
+                    }
+                }
+
                 item_erased = true;
                 modified = true;
             }
+            else if( ambiguous )
+            {
+                next_pass.insert( position );
+            }
         }
+
+        std::swap( pass, next_pass );
     } while( item_erased );
 
     return modified;
 }
 
 
+
 // Delete null length track segments
 bool TRACKS_CLEANER::delete_null_segments()
 {
@@ -529,8 +842,7 @@ bool TRACKS_CLEANER::delete_null_segments()
 
         if( segment->IsNull() )     // Length segment = 0; delete it
         {
-            m_brd->Remove( segment );
-            m_commit.Removed( segment );
+            removeTrack( segment );
             modified = true;
         }
     }
@@ -541,16 +853,15 @@ bool TRACKS_CLEANER::delete_null_segments()
 
 bool TRACKS_CLEANER::remove_duplicates_of_track( const TRACK *aTrack )
 {
-    bool modified = false;
-    TRACK* nextsegment;
+    std::vector<TRACK*> duplicates;
 
-    for( TRACK* other = aTrack->Next(); other; other = nextsegment )
+    for( TRACK* other : m_index.TracksAt( aTrack->GetStart() ) )
     {
-        nextsegment = other->Next();
-
-        // New netcode, break out (can't be there any other)
-        if( aTrack->GetNetCode() != other->GetNetCode() )
-            break;
+        // Only the following tracks of the same net, up to the first one of another net
+        if( other->GetNetCode() != aTrack->GetNetCode()
+                || m_index.Position( other ) <= m_index.Position( aTrack )
+                || !m_index.SameNetBetween( aTrack, other ) )
+            continue;
 
         // Must be of the same type, on the same layer and the endpoints
         // must be the same (maybe swapped)
@@ -562,14 +873,15 @@ bool TRACKS_CLEANER::remove_duplicates_of_track( const TRACK *aTrack )
                 ( ( aTrack->GetStart() == other->GetEnd() ) &&
                  ( aTrack->GetEnd() == other->GetStart() ) ) )
             {
-                m_brd->Remove( other );
-                m_commit.Removed( other );
-                modified = true;
+                duplicates.push_back( other );
             }
         }
     }
 
-    return modified;
+    for( TRACK* other : duplicates )
+        removeTrack( other );
+
+    return !duplicates.empty();
 }
 
 
@@ -585,7 +897,7 @@ bool TRACKS_CLEANER::merge_collinear_of_track( TRACK* aSegment )
 
         if( other )
         {
-            other = aSegment->GetTrack( other, NULL, endpoint, true, false );
+            other = getConnectedTrack( aSegment, endpoint );
 
             if( other )
             {
@@ -596,21 +908,21 @@ bool TRACKS_CLEANER::merge_collinear_of_track( TRACK* aSegment )
                 {
                     // There can be only one segment connected
                     other->SetState( BUSY, true );
-                    TRACK* yet_another = aSegment->GetTrack( m_brd->m_Track, NULL,
-                            endpoint, true, false );
+                    TRACK* yet_another = getConnectedTrack( aSegment, endpoint );
                     other->SetState( BUSY, false );
 
                     if( !yet_another )
                     {
-                        // Try to merge them
+                        // Try to merge them, aSegment endpoints can change
+                        m_index.RemoveEndpoints( aSegment );
                         TRACK* segDelete = mergeCollinearSegmentIfPossible( aSegment,
                                 other, endpoint );
+                        m_index.AddEndpoints( aSegment );
 
                         // Merge succesful, the other one has to go away
                         if( segDelete )
                         {
-                            m_brd->Remove( segDelete );
-                            m_commit.Removed( segDelete );
+                            removeTrack( segDelete );
                             merged_this = true;
                         }
                     }
@@ -40,6 +40,7 @@
 #include <class_module.h>
 
 #include <dialog_gendrill.h>
+#include <plot_job_scheduler.h>
 #include <wildcards_and_files_ext.h>
 #include <reporter.h>
 
@@ -413,6 +414,9 @@ void DIALOG_GENDRILL::GenDrillAndMapFiles( bool aGenDrill, bool aGenMap )
         return;
     }
 
+    wxBusyCursor       dummy;
+    PLOT_JOB_SCHEDULER scheduler( m_parent->GetBoard() );
+
     if( m_drillFileType == 0 )
     {
         EXCELLON_WRITER excellonWriter( m_parent->GetBoard() );
@@ -421,8 +425,7 @@ void DIALOG_GENDRILL::GenDrillAndMapFiles( bool aGenDrill, bool aGenMap )
         excellonWriter.SetOptions( m_Mirror, m_MinimalHeader, m_FileDrillOffset, m_Merge_PTH_NPTH );
         excellonWriter.SetMapFileFormat( filefmt[choice] );
 
-        excellonWriter.CreateDrillandMapFilesSet( outputDir.GetFullPath(),
-                                                  aGenDrill, aGenMap, &reporter );
+        scheduler.AddDrillJobs( excellonWriter, outputDir.GetFullPath(), aGenDrill, aGenMap );
     }
     else
     {
@@ -434,9 +437,11 @@ void DIALOG_GENDRILL::GenDrillAndMapFiles( bool aGenDrill, bool aGenMap )
         gerberWriter.SetOptions( m_FileDrillOffset );
         gerberWriter.SetMapFileFormat( filefmt[choice] );
 
-        gerberWriter.CreateDrillandMapFilesSet( outputDir.GetFullPath(),
-                                                aGenDrill, aGenMap, &reporter );
+        scheduler.AddDrillJobs( gerberWriter, outputDir.GetFullPath(), aGenDrill, aGenMap );
     }
+
+    // Write the drill files and the map files in parallel
+    scheduler.Run( &reporter );
 }
 
 
@@ -83,6 +83,7 @@ void DIALOG_GENERALOPTIONS::init()
     m_MousewheelPANOpt->SetValue( GetParent()->GetCanvas()->GetEnableMousewheelPan() );
     m_AutoPANOpt->SetValue( GetParent()->GetCanvas()->GetEnableAutoPan() );
     m_Track_DoubleSegm_Ctrl->SetValue( g_TwoSegmentTrackBuild );
+    m_TiledZoneFillCtrl->SetValue( g_TiledZoneFill );
     m_MagneticPadOptCtrl->SetSelection( g_MagneticPadOption );
     m_MagneticTrackOptCtrl->SetSelection( g_MagneticTrackOption );
 }
@@ -129,6 +130,7 @@ void DIALOG_GENERALOPTIONS::OnOkClick( wxCommandEvent& event )
     GetParent()->GetCanvas()->SetEnableAutoPan( m_AutoPANOpt->GetValue() );
 
     g_TwoSegmentTrackBuild = m_Track_DoubleSegm_Ctrl->GetValue();
+    g_TiledZoneFill = m_TiledZoneFillCtrl->GetValue();
     g_MagneticPadOption   = m_MagneticPadOptCtrl->GetSelection();
     g_MagneticTrackOption = m_MagneticTrackOptCtrl->GetSelection();
 
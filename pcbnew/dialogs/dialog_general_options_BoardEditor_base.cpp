@@ -114,6 +114,11 @@ DIALOG_GENERALOPTIONS_BOARDEDITOR_BASE::DIALOG_GENERALOPTIONS_BOARDEDITOR_BASE(
 	
 	bMiddleRightBoxSizer->Add( m_Track_DoubleSegm_Ctrl, 0, wxALL, 5 );
 	
+	m_TiledZoneFillCtrl = new wxCheckBox( bMiddleRightBoxSizer->GetStaticBox(), wxID_ANY, _("Fill large zones in parallel strips"), wxDefaultPosition, wxDefaultSize, 0 );
+	m_TiledZoneFillCtrl->SetToolTip( _("Split the copper zones having many holes in vertical strips filled in parallel, to fill them faster on multi-core computers.") );
+	
+	bMiddleRightBoxSizer->Add( m_TiledZoneFillCtrl, 0, wxALL, 5 );
+	
 	
 	bMiddleLeftSizer->Add( bMiddleRightBoxSizer, 4, wxALL|wxEXPAND, 5 );
 	
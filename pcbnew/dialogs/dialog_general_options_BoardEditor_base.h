@@ -67,6 +67,7 @@ class DIALOG_GENERALOPTIONS_BOARDEDITOR_BASE : public DIALOG_SHIM
 		wxCheckBox* m_Track_45_Only_Ctrl;
 		wxCheckBox* m_Segments_45_Only_Ctrl;
 		wxCheckBox* m_Track_DoubleSegm_Ctrl;
+		wxCheckBox* m_TiledZoneFillCtrl;
 		wxRadioBox* m_MagneticPadOptCtrl;
 		wxRadioBox* m_MagneticTrackOptCtrl;
 		wxCheckBox* m_ZoomCenterOpt;
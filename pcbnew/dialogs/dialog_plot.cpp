@@ -31,6 +31,7 @@
 #include <confirm.h>
 #include <wxPcbStruct.h>
 #include <pcbplot.h>
+#include <plot_job_scheduler.h>
 #include <base_units.h>
 #include <macros.h>
 #include <reporter.h>
@@ -800,6 +801,9 @@ void DIALOG_PLOT::Plot( wxCommandEvent& event )
 
     wxBusyCursor dummy;
 
+    BOARD*             board = m_parent->GetBoard();
+    PLOT_JOB_SCHEDULER scheduler( board );
+
     for( LSEQ seq = m_plotOpts.GetLayerSelection().UIOrder();  seq;  ++seq )
     {
         PCB_LAYER_ID layer = *seq;
@@ -825,30 +829,12 @@ void DIALOG_PLOT::Plot( wxCommandEvent& event )
                            m_board->GetLayerName( layer ),
                            file_ext );
 
-        LOCALE_IO toggle;
-
-        BOARD*      board = m_parent->GetBoard();
-        PLOTTER*    plotter = StartPlotBoard( board, &m_plotOpts, layer, fn.GetFullPath(), wxEmptyString );
-
-        // Print diags in messages box:
-        wxString msg;
-
-        if( plotter )
-        {
-            PlotOneBoardLayer( board, plotter, layer, m_plotOpts );
-            plotter->EndPlot();
-            delete plotter;
-
-            msg.Printf( _( "Plot file '%s' created." ), GetChars( fn.GetFullPath() ) );
-            reporter.Report( msg, REPORTER::RPT_ACTION );
-        }
-        else
-        {
-            msg.Printf( _( "Unable to create file '%s'." ), GetChars( fn.GetFullPath() ) );
-            reporter.Report( msg, REPORTER::RPT_ERROR );
-        }
+        scheduler.AddLayerJob( layer, fn.GetFullPath(), m_plotOpts );
     }
 
+    // Plot all layers in parallel, and print diags in messages box
+    scheduler.Run( &reporter );
+
     // If no layer selected, we have nothing plotted.
     // Prompt user if it happens because he could think there is a bug in Pcbnew.
     if( !m_plotOpts.GetLayerSelection().any() )
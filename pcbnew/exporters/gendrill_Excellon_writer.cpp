@@ -68,12 +68,12 @@ EXCELLON_WRITER::EXCELLON_WRITER( BOARD* aPcb )
 }
 
 
-void EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
+bool EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
                                                  bool aGenDrill, bool aGenMap,
                                                  REPORTER * aReporter )
 {
     wxFileName  fn;
-    wxString    msg;
+    bool        success = true;
 
     std::vector<DRILL_LAYER_PAIR> hole_sets = getUniqueLayerPairs();
 
@@ -103,31 +103,23 @@ void EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
 
                 FILE* file = wxFopen( fullFilename, wxT( "w" ) );
 
+                reportFileCreation( aReporter, fullFilename, file != NULL );
+
                 if( file == NULL )
                 {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "** Unable to create %s **\n" ), GetChars( fullFilename ) );
-                        aReporter->Report( msg );
-                    }
+                    success = false;
                     break;
                 }
-                else
-                {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "Create file %s\n" ), GetChars( fullFilename ) );
-                        aReporter->Report( msg );
-                    }
-                }
 
                 createDrillFile( file );
             }
         }
     }
 
-    if( aGenMap )
-        CreateMapFilesSet( aPlotDirectory, aReporter );
+    if( aGenMap && !CreateMapFilesSet( aPlotDirectory, aReporter ) )
+        success = false;
+
+    return success;
 }
 
 
@@ -287,11 +287,10 @@ const wxString GENDRILL_WRITER_BASE::getDrillFileName( DRILL_LAYER_PAIR aPair, b
     return ret;
 }
 
-void GENDRILL_WRITER_BASE::CreateMapFilesSet( const wxString& aPlotDirectory,
+bool GENDRILL_WRITER_BASE::CreateMapFilesSet( const wxString& aPlotDirectory,
                                               REPORTER * aReporter )
 {
     wxFileName  fn;
-    wxString    msg;
 
     std::vector<DRILL_LAYER_PAIR> hole_sets = getUniqueLayerPairs();
 
@@ -321,24 +320,25 @@ void GENDRILL_WRITER_BASE::CreateMapFilesSet( const wxString& aPlotDirectory,
 
             bool success = genDrillMapFile( fullfilename, m_mapFileFmt );
 
-            if( ! success )
-            {
-                if( aReporter )
-                {
-                    msg.Printf( _( "** Unable to create %s **\n" ), GetChars( fullfilename ) );
-                    aReporter->Report( msg );
-                }
+            reportFileCreation( aReporter, fullfilename, success );
 
-                return;
-            }
-            else
-            {
-                if( aReporter )
-                {
-                    msg.Printf( _( "Create file %s\n" ), GetChars( fullfilename ) );
-                    aReporter->Report( msg );
-                }
-            }
+            if( ! success )
+                return false;
         }
     }
+
+    return true;
+}
+
+
+void GENDRILL_WRITER_BASE::reportFileCreation( REPORTER* aReporter,
+                                               const wxString& aFullFilename,
+                                               bool aSuccess ) const
+{
+    if( !aReporter )
+        return;
+
+    wxString msg;
+    msg.Printf( aSuccess ? m_createFileMsg : m_cannotCreateFileMsg, GetChars( aFullFilename ) );
+    aReporter->Report( msg );
 }
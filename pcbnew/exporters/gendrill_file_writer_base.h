@@ -32,6 +32,7 @@
 #include <vector>
 
 class BOARD_ITEM;
+class REPORTER;
 
 
 // the DRILL_TOOL class  handles tools used in the excellon drill file:
@@ -150,6 +151,9 @@ protected:
                                                         // if this map is needed
     const PAGE_INFO*         m_pageInfo;                // the page info used to plot drill maps
                                                         // If NULL, use a A4 page format
+    wxString                 m_createFileMsg;           // messages translated when the writer
+    wxString                 m_cannotCreateFileMsg;     // is created: the files can be written
+                                                        // by a worker thread (see PLOT_JOB_SCHEDULER)
     // This Ctor is protected.
     // Use derived classes to build a fully initialized GENDRILL_WRITER_BASE class.
     GENDRILL_WRITER_BASE( BOARD* aPcb )
@@ -161,6 +165,8 @@ protected:
         m_pageInfo = NULL;
         m_merge_PTH_NPTH = false;
         m_zeroFormat = DECIMAL_FORMAT;
+        m_createFileMsg = _( "Create file %s\n" );
+        m_cannotCreateFileMsg = _( "** Unable to create %s **\n" );
     }
 
 public:
@@ -205,8 +211,9 @@ public:
      * filenames are computed from the board name, and layers id
      * @param aPlotDirectory = the output folder
      * @param aReporter = a REPORTER to return activity or any message (can be NULL)
+     * @return true if all the map files are created
      */
-    void CreateMapFilesSet( const wxString& aPlotDirectory,
+    bool CreateMapFilesSet( const wxString& aPlotDirectory,
                             REPORTER* aReporter = NULL );
 
     /**
@@ -294,6 +301,16 @@ protected:
 
     int  getHolesCount() const { return m_holeListBuffer.size(); }
 
+    /**
+     * Function reportFileCreation
+     * reports the creation of a file, or the failure to create it
+     * @param aReporter = the REPORTER to use (can be NULL)
+     * @param aFullFilename = the file
+     * @param aSuccess = true if the file is created
+     */
+    void reportFileCreation( REPORTER* aReporter, const wxString& aFullFilename,
+                             bool aSuccess ) const;
+
     /** Helper function.
      * Writes the drill marks in HPGL, POSTSCRIPT or other supported formats
      * Each hole size has a symbol (circle, cross X, cross + ...) up to
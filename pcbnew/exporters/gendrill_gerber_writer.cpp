@@ -59,7 +59,7 @@ GERBER_WRITER::GERBER_WRITER( BOARD* aPcb )
 }
 
 
-void GERBER_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
+bool GERBER_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
                                                  bool aGenDrill, bool aGenMap,
                                                  REPORTER * aReporter )
 {
@@ -67,7 +67,7 @@ void GERBER_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
     m_merge_PTH_NPTH = false;
 
     wxFileName  fn;
-    wxString    msg;
+    bool        success = true;
 
     std::vector<DRILL_LAYER_PAIR> hole_sets = getUniqueLayerPairs();
 
@@ -97,30 +97,21 @@ void GERBER_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
 
                 int result = createDrillFile( fullFilename, doing_npth, pair.first, pair.second );
 
+                reportFileCreation( aReporter, fullFilename, result >= 0 );
+
                 if( result < 0 )
                 {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "** Unable to create %s **\n" ), GetChars( fullFilename ) );
-                        aReporter->Report( msg );
-                    }
+                    success = false;
                     break;
                 }
-                else
-                {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "Create file %s\n" ), GetChars( fullFilename ) );
-                        aReporter->Report( msg );
-                    }
-                }
-
             }
         }
     }
 
-    if( aGenMap )
-        CreateMapFilesSet( aPlotDirectory, aReporter );
+    if( aGenMap && !CreateMapFilesSet( aPlotDirectory, aReporter ) )
+        success = false;
+
+    return success;
 }
 
 // A helper class to transform an oblong hole to a segment
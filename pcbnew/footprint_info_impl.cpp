@@ -23,6 +23,7 @@
 #include <footprint_info_impl.h>
 
 #include <class_module.h>
+#include <cache_file.h>
 #include <common.h>
 #include <fctsys.h>
 #include <footprint_info.h>
@@ -37,9 +38,109 @@
 #include <pgm_base.h>
 #include <wildcards_and_files_ext.h>
 
+#include <wx/dir.h>
+#include <algorithm>
 #include <thread>
 
 
+/// Identifies the footprint list cache files.
+#define FP_CACHE_MAGIC          "KiCad-Footprint-List-Cache"
+
+/// Change it each time the cache format or the FOOTPRINT_INFO values are changed.
+#define FP_CACHE_VERSION        1
+
+/// Environment variable disabling the footprint list cache, to compare load times.
+#define FP_CACHE_DISABLE_ENV    wxT( "KICAD_NO_FOOTPRINT_CACHE" )
+
+
+static const wxString traceFootprintCache( wxT( "KicadFootprintCache" ) );
+
+
+static wxUint64 hashValue( wxInt64 aValue, wxUint64 aHash )
+{
+    return HashBytes( (const char*) &aValue, sizeof( aValue ), aHash );
+}
+
+
+/**
+ * Function makeCacheKey
+ * identifies the current content of the library \a aNickname, from the names, sizes and
+ * modification times of its files.  The files themselves are not read.
+ * @return false if the library is not a local file or folder, and cannot be cached.
+ */
+static bool makeCacheKey( FP_LIB_TABLE* aTable, const wxString& aNickname, FP_CACHE_KEY& aKey )
+{
+    const FP_LIB_TABLE_ROW* row = aTable->FindRow( aNickname );
+    wxStructStat            st;
+
+    aKey.m_Type = row->GetType();
+    aKey.m_URI  = row->GetFullURI( true );
+    aKey.m_Hash = HashBytes( NULL, 0 );
+
+    // e.g. a GitHub library
+    if( wxStat( aKey.m_URI, &st ) != 0 )
+    {
+        aKey.m_URI.Clear();
+        return false;
+    }
+
+    aKey.m_ModTime = st.st_mtime;
+    aKey.m_Hash    = hashValue( st.st_size, aKey.m_Hash );
+
+    if( !wxDirExists( aKey.m_URI ) )
+        return true;
+
+    // The folder time only changes when files are added, removed or replaced,
+    // not when a file is modified in place.
+    wxDir                 dir( aKey.m_URI );
+    wxString              name;
+    std::vector<wxString> names;
+
+    if( !dir.IsOpened() )
+    {
+        aKey.m_URI.Clear();
+        return false;
+    }
+
+    for( bool cont = dir.GetFirst( &name, wxEmptyString, wxDIR_FILES ); cont;
+         cont = dir.GetNext( &name ) )
+        names.push_back( name );
+
+    std::sort( names.begin(), names.end() );
+
+    for( const wxString& fileName : names )
+    {
+        UTF8 utf8 = fileName;
+
+        aKey.m_Hash = HashBytes( utf8.c_str(), utf8.size() + 1, aKey.m_Hash );
+
+        if( wxStat( dir.GetNameWithSep() + fileName, &st ) == 0 )
+        {
+            aKey.m_Hash = hashValue( st.st_size, aKey.m_Hash );
+            aKey.m_Hash = hashValue( st.st_mtime, aKey.m_Hash );
+        }
+    }
+
+    return true;
+}
+
+
+static wxString cacheFileName( const wxString& aCachePath, const FP_CACHE_KEY& aKey )
+{
+    // Libraries with the same name can be found in several folders.
+    UTF8       id = aKey.m_Type + wxT( "|" ) + aKey.m_URI;
+    wxFileName fn;
+
+    fn.AssignDir( aCachePath );
+    fn.SetName( wxFileName( aKey.m_URI ).GetName()
+                + wxString::Format( wxT( "-%016llx" ),
+                                    (unsigned long long) HashBytes( id.c_str(), id.size() ) ) );
+    fn.SetExt( wxT( "fpinfo" ) );
+
+    return fn.GetFullPath();
+}
+
+
 void FOOTPRINT_INFO_IMPL::load()
 {
     FP_LIB_TABLE* fptable = m_owner->GetTable();
@@ -103,8 +204,16 @@ void FOOTPRINT_LIST_IMPL::loader_job()
     while( m_queue_in.pop( nickname ) )
     {
         CatchErrors( [this, &nickname]() {
+            FP_CACHE_KEY key;
+
+            // The key is made before the library is read: if it is modified while it is
+            // read, the cache file is saved with the old key, and is never used.
+            if( !m_cache_path.IsEmpty() && makeCacheKey( m_lib_table, nickname, key )
+                    && loadCache( nickname, key ) )
+                return;
+
             m_lib_table->PrefetchLib( nickname );
-            m_queue_out.push( nickname );
+            m_queue_out.push( std::make_pair( nickname, key ) );
         } );
 
         m_count_finished.fetch_add( 1 );
@@ -142,9 +251,24 @@ void FOOTPRINT_LIST_IMPL::StartWorkers( FP_LIB_TABLE* aTable, wxString const* aN
     m_count_finished.store( 0 );
     m_errors.clear();
     m_list.clear();
+    m_search_index.Clear();
     m_threads.clear();
     m_queue_in.clear();
     m_queue_out.clear();
+    m_queue_cached.clear();
+
+    if( wxGetEnv( FP_CACHE_DISABLE_ENV, NULL ) )
+    {
+        m_cache_path.Clear();
+    }
+    else
+    {
+        wxFileName cacheDir;
+
+        cacheDir.AssignDir( GetKicadCachePath() );
+        cacheDir.AppendDir( wxT( "footprints" ) );
+        m_cache_path = cacheDir.GetPath();
+    }
 
     if( aNickname )
         m_queue_in.push( *aNickname );
@@ -185,18 +309,27 @@ bool FOOTPRINT_LIST_IMPL::JoinWorkers()
     for( size_t i = 0; i < std::thread::hardware_concurrency() + 1; ++i )
     {
         threads.push_back( std::thread( [this, &queue_parsed]() {
-            wxString nickname;
+            std::pair<wxString, FP_CACHE_KEY> lib;
 
-            while( this->m_queue_out.pop( nickname ) )
+            while( this->m_queue_out.pop( lib ) )
             {
-                CatchErrors( [this, &queue_parsed, &nickname]() {
+                CatchErrors( [this, &queue_parsed, &lib]() {
+                    const wxString& nickname = lib.first;
                     wxArrayString fpnames = this->m_lib_table->FootprintEnumerate( nickname );
+                    std::vector<FOOTPRINT_INFO*> items;
 
                     for( auto const& fpname : fpnames )
                     {
                         FOOTPRINT_INFO* fpinfo = new FOOTPRINT_INFO_IMPL( this, nickname, fpname );
                         queue_parsed.move_push( std::unique_ptr<FOOTPRINT_INFO>( fpinfo ) );
+
+                        // Still owned by queue_parsed, which is not read before the end
+                        items.push_back( fpinfo );
                     }
+
+                    // Only the libraries read without error are cached
+                    if( !lib.second.m_URI.IsEmpty() )
+                        saveCache( lib.second, items );
                 } );
             }
         } ) );
@@ -207,17 +340,120 @@ bool FOOTPRINT_LIST_IMPL::JoinWorkers()
 
     std::unique_ptr<FOOTPRINT_INFO> fpi;
 
+    wxLogTrace( traceFootprintCache, "%u footprints parsed, %u read from cache",
+                (unsigned) queue_parsed.size(), (unsigned) m_queue_cached.size() );
+
     while( queue_parsed.pop( fpi ) )
         m_list.push_back( std::move( fpi ) );
 
+    while( m_queue_cached.pop( fpi ) )
+        m_list.push_back( std::move( fpi ) );
+
     std::sort( m_list.begin(), m_list.end(),
             []( std::unique_ptr<FOOTPRINT_INFO> const&     lhs,
                     std::unique_ptr<FOOTPRINT_INFO> const& rhs ) -> bool { return *lhs < *rhs; } );
 
+    // Index the list while the caller waits anyway, not when it is first filtered
+    m_search_index.Build( *this );
+
     return m_errors.empty();
 }
 
 
+bool FOOTPRINT_LIST_IMPL::loadCache( const wxString& aNickname, const FP_CACHE_KEY& aKey )
+{
+    wxString    fileName = cacheFileName( m_cache_path, aKey );
+    std::string data;
+
+    if( !ReadCacheFile( fileName, data ) || data.empty() )
+        return false;
+
+    std::vector<std::unique_ptr<FOOTPRINT_INFO>> items;
+
+    try
+    {
+        CACHE_FILE_READER reader( data );
+        FP_CACHE_KEY      key;
+
+        if( reader.ReadString() != FP_CACHE_MAGIC || reader.ReadInt() != FP_CACHE_VERSION )
+            return false;
+
+        key.m_Type    = reader.ReadString();
+        key.m_URI     = reader.ReadString();
+        key.m_ModTime = reader.ReadInt64();
+        key.m_Hash    = (wxUint64) reader.ReadInt64();
+
+        if( !( key == aKey ) )
+            return false;
+
+        int count = reader.ReadInt();
+
+        if( count < 0 )
+            return false;
+
+        items.reserve( count );
+
+        for( int ii = 0; ii < count; ++ii )
+        {
+            wxString fpname   = reader.ReadString();
+            wxString doc      = reader.ReadString();
+            wxString keywords = reader.ReadString();
+            int      padCount = reader.ReadInt();
+            int      uniqueCount = reader.ReadInt();
+
+            items.push_back( std::make_unique<FOOTPRINT_INFO_IMPL>( this, aNickname, fpname,
+                                                                    doc, keywords, padCount,
+                                                                    uniqueCount ) );
+        }
+
+        // The file ends with the magic string: it was completely written.
+        if( reader.ReadString() != FP_CACHE_MAGIC )
+            return false;
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        wxLogTrace( traceFootprintCache, "Cannot use footprint cache file '%s': %s",
+                    fileName, ioe.What() );
+        return false;
+    }
+
+    for( auto& item : items )
+        m_queue_cached.move_push( std::move( item ) );
+
+    return true;
+}
+
+
+void FOOTPRINT_LIST_IMPL::saveCache( const FP_CACHE_KEY& aKey,
+                                     const std::vector<FOOTPRINT_INFO*>& aItems )
+{
+    CACHE_FILE_WRITER writer;
+
+    writer.WriteString( FP_CACHE_MAGIC );
+    writer.WriteInt( FP_CACHE_VERSION );
+
+    writer.WriteString( aKey.m_Type );
+    writer.WriteString( aKey.m_URI );
+    writer.WriteInt64( aKey.m_ModTime );
+    writer.WriteInt64( (wxInt64) aKey.m_Hash );
+
+    writer.WriteInt( (int) aItems.size() );
+
+    for( FOOTPRINT_INFO* item : aItems )
+    {
+        writer.WriteString( item->GetFootprintName() );
+        writer.WriteString( item->GetDoc() );
+        writer.WriteString( item->GetKeywords() );
+        writer.WriteInt( item->GetPadCount() );
+        writer.WriteInt( item->GetUniquePadCount() );
+    }
+
+    writer.WriteString( FP_CACHE_MAGIC );
+
+    WriteCacheFile( cacheFileName( m_cache_path, aKey ), writer.GetData() );
+}
+
+
 size_t FOOTPRINT_LIST_IMPL::CountFinished()
 {
     return m_count_finished.load();
@@ -32,6 +32,26 @@
 
 class LOCALE_IO;
 
+
+/**
+ * Identifies the content of a footprint library for the footprint list cache.  The items
+ * of a library are read from its cache file only if the file has the same key.
+ */
+struct FP_CACHE_KEY
+{
+    wxString    m_Type;         ///< the plugin type
+    wxString    m_URI;          ///< the full URI, empty if the library cannot be cached
+    wxInt64     m_ModTime;      ///< modification time of the library file or folder
+    wxUint64    m_Hash;         ///< hash of the names, sizes and times of the library files
+
+    bool operator==( const FP_CACHE_KEY& aOther ) const
+    {
+        return m_Type == aOther.m_Type && m_URI == aOther.m_URI
+            && m_ModTime == aOther.m_ModTime && m_Hash == aOther.m_Hash;
+    }
+};
+
+
 class FOOTPRINT_INFO_IMPL : public FOOTPRINT_INFO
 {
 public:
@@ -50,6 +70,24 @@ public:
 #endif
     }
 
+    /**
+     * Construct a loaded item from the values read in the footprint list cache.
+     */
+    FOOTPRINT_INFO_IMPL( FOOTPRINT_LIST* aOwner, const wxString& aNickname,
+            const wxString& aFootprintName, const wxString& aDoc, const wxString& aKeywords,
+            int aPadCount, int aUniquePadCount )
+    {
+        m_owner = aOwner;
+        m_loaded = true;
+        m_nickname = aNickname;
+        m_fpname = aFootprintName;
+        m_num = 0;
+        m_pad_count = aPadCount;
+        m_unique_pad_count = aUniquePadCount;
+        m_doc = aDoc;
+        m_keywords = aKeywords;
+    }
+
 protected:
     virtual void load() override;
 };
@@ -60,10 +98,13 @@ class FOOTPRINT_LIST_IMPL : public FOOTPRINT_LIST
     FOOTPRINT_ASYNC_LOADER*  m_loader;
     std::vector<std::thread> m_threads;
     SYNC_QUEUE<wxString>     m_queue_in;
-    SYNC_QUEUE<wxString>     m_queue_out;
+    SYNC_QUEUE<std::pair<wxString, FP_CACHE_KEY>> m_queue_out;  ///< libraries to parse
     std::atomic_size_t       m_count_finished;
     std::atomic_bool         m_first_to_finish;
 
+    wxString                 m_cache_path;  ///< cache folder, empty if the cache is disabled
+    SYNC_QUEUE<std::unique_ptr<FOOTPRINT_INFO>> m_queue_cached;   ///< items read from cache
+
     /**
      * Call aFunc, pushing any IO_ERRORs and std::exceptions it throws onto m_errors.
      *
@@ -83,6 +124,19 @@ protected:
      */
     void loader_job();
 
+    /**
+     * Read the items of the library \a aNickname from its cache file into m_queue_cached.
+     *
+     * @return false if the cache file is missing or does not match \a aKey.
+     */
+    bool loadCache( const wxString& aNickname, const FP_CACHE_KEY& aKey );
+
+    /**
+     * Write the items of the library \a aNickname to its cache file.
+     */
+    void saveCache( const FP_CACHE_KEY& aKey,
+                    const std::vector<FOOTPRINT_INFO*>& aItems );
+
 public:
     FOOTPRINT_LIST_IMPL();
     virtual ~FOOTPRINT_LIST_IMPL();
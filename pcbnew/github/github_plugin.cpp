@@ -73,6 +73,8 @@ Vary: Accept-Encoding
 #include <wx/uri.h>
 
 #include <fctsys.h>
+#include <common.h>
+#include <cache_file.h>
 
 #include <io_mgr.h>
 #include <richio.h>
@@ -90,6 +92,11 @@ using namespace std;
 
 static const char* PRETTY_DIR = "allow_pretty_writing_to_this_dir";
 
+/// Environment variable disabling the local copy of the zip files, to always download them.
+#define GH_ZIP_CACHE_DISABLE_ENV    wxT( "KICAD_NO_GITHUB_CACHE" )
+
+static const wxString traceGithubPlugin( wxT( "KicadGithubPlugin" ) );
+
 
 typedef boost::ptr_map<string, wxZipEntry>  MODULE_MAP;
 typedef MODULE_MAP::iterator                MODULE_ITER;
@@ -529,6 +536,42 @@ bool GITHUB_PLUGIN::repoURL_zipURL( const wxString& aRepoURL, std::string* aZipU
 }
 
 
+/**
+ * Function zipCacheFileName
+ * returns the file name of the local copy of the zip file at \a aZipURL, or an empty
+ * string if the local copies are disabled.  The response headers needed to revalidate
+ * the copy are stored in the same file name, with an added ".headers" extension.
+ */
+static wxString zipCacheFileName( const std::string& aZipURL )
+{
+    if( wxGetEnv( GH_ZIP_CACHE_DISABLE_ENV, NULL ) )
+        return wxEmptyString;
+
+    // Several repos can have the same name
+    unsigned long long hash = HashBytes( aZipURL.data(), aZipURL.size() );
+
+    wxURI       uri( FROM_UTF8( aZipURL.c_str() ) );
+    wxFileName  fn;
+    wxString    repoName;
+
+    // e.g. "/KiCad/Resistors_SMD.pretty/zip/master" for a github.com repo
+    wxArrayString parts = wxSplit( uri.GetPath(), '/' );
+
+    for( const wxString& part : parts )
+    {
+        if( part.EndsWith( ".pretty" ) )
+            repoName = part.BeforeLast( '.' );
+    }
+
+    fn.AssignDir( GetKicadCachePath() );
+    fn.AppendDir( wxT( "github" ) );
+    fn.SetName( repoName + wxString::Format( wxT( "-%016llx" ), hash ) );
+    fn.SetExt( wxT( "zip" ) );
+
+    return fn.GetFullPath();
+}
+
+
 void GITHUB_PLUGIN::remoteGetZip( const wxString& aRepoURL ) throw( IO_ERROR )
 {
     std::string  zip_url;
@@ -542,6 +585,30 @@ void GITHUB_PLUGIN::remoteGetZip( const wxString& aRepoURL ) throw( IO_ERROR )
         THROW_IO_ERROR( msg );
     }
 
+    // The local copy of the zip file, and the validators sent back to the server
+    // to download the zip file only if it has changed since.
+    wxString    cache_file = zipCacheFileName( zip_url );
+    std::string cached_zip;
+    std::string etag;
+    std::string last_modified;
+
+    if( !cache_file.IsEmpty() && ReadCacheFile( cache_file, cached_zip ) && !cached_zip.empty() )
+    {
+        std::string        headers;
+        std::istringstream lines;
+
+        if( ReadCacheFile( cache_file + wxT( ".headers" ), headers ) )
+        {
+            lines.str( headers );
+            std::getline( lines, etag );
+            std::getline( lines, last_modified );
+        }
+    }
+    else
+    {
+        cached_zip.clear();
+    }
+
     wxLogDebug( wxT( "Attempting to download: " ) + zip_url );
 
     KICAD_CURL_EASY kcurl;      // this can THROW_IO_ERROR
@@ -551,13 +618,30 @@ void GITHUB_PLUGIN::remoteGetZip( const wxString& aRepoURL ) throw( IO_ERROR )
     kcurl.SetHeader( "Accept", "application/zip" );
     kcurl.SetFollowRedirects( true );
 
+    if( !cached_zip.empty() )
+    {
+        if( !etag.empty() )
+            kcurl.SetHeader( "If-None-Match", etag );
+
+        if( !last_modified.empty() )
+            kcurl.SetHeader( "If-Modified-Since", last_modified );
+    }
+
     try
     {
         kcurl.Perform();
-        m_zip_image = kcurl.GetBuffer();
     }
     catch( const IO_ERROR& ioe )
     {
+        // Without network, the local copy is better than nothing
+        if( !cached_zip.empty() )
+        {
+            wxLogTrace( traceGithubPlugin, "Cannot download '%s' (%s), using '%s'",
+                        zip_url, ioe.What(), cache_file );
+            m_zip_image.swap( cached_zip );
+            return;
+        }
+
         // https "GET" has failed, report this to API caller.
         // Note: kcurl.Perform() does not return an error if the file to download is not found
         static const char errorcmd[] = "http GET command failed";  // Do not translate this message
@@ -574,16 +658,56 @@ void GITHUB_PLUGIN::remoteGetZip( const wxString& aRepoURL ) throw( IO_ERROR )
         THROW_IO_ERROR( msg );
     }
 
-    // If the zip archive is not existing, the received data is "Not Found" or "404: Not Found",
-    // and no error is returned by kcurl.Perform().
-    if( ( m_zip_image.compare( 0, 9, "Not Found", 9 ) == 0 ) ||
-        ( m_zip_image.compare( 0, 14, "404: Not Found", 14 ) == 0 ) )
+    long code = kcurl.GetResponseCode();
+
+    // 304: Not Modified, the local copy is up to date
+    if( !cached_zip.empty() && code == 304 )
     {
-        UTF8 fmt( _( "Cannot download library '%s'.\nThe library does not exist on the server" ) );
-        std::string msg = StrPrintf( fmt.c_str(), TO_UTF8( aRepoURL ) );
+        wxLogTrace( traceGithubPlugin, "'%s' not modified, using '%s'", zip_url, cache_file );
+        m_zip_image.swap( cached_zip );
+        return;
+    }
+
+    if( code != 200 )
+    {
+        // Any other answer than the zip file (a server error, a rate limit, a removed
+        // repo...): the local copy is better than nothing
+        if( !cached_zip.empty() )
+        {
+            wxLogTrace( traceGithubPlugin, "Cannot download '%s' (HTTP code %ld), using '%s'",
+                        zip_url, code, cache_file );
+            m_zip_image.swap( cached_zip );
+            return;
+        }
+
+        // kcurl.Perform() does not return an error if the file to download is not found
+        if( code == 404 )
+        {
+            UTF8 fmt( _( "Cannot download library '%s'.\nThe library does not exist on the server" ) );
+            std::string msg = StrPrintf( fmt.c_str(), TO_UTF8( aRepoURL ) );
+
+            THROW_IO_ERROR( msg );
+        }
+
+        UTF8 fmt( _( "Cannot download library '%s'.\nThe server returned the HTTP code %ld" ) );
+        std::string msg = StrPrintf( fmt.c_str(), TO_UTF8( aRepoURL ), code );
 
         THROW_IO_ERROR( msg );
     }
+
+    m_zip_image = kcurl.GetBuffer();
+
+    if( !cache_file.IsEmpty() && !m_zip_image.empty() )
+    {
+        wxLogTrace( traceGithubPlugin, "Downloaded '%s' (%u bytes) to '%s'",
+                    zip_url, (unsigned) m_zip_image.size(), cache_file );
+
+        // The zip file first: with the old headers, it is only downloaded again.
+        WriteCacheFile( cache_file, m_zip_image );
+        WriteCacheFile( cache_file + wxT( ".headers" ),
+                        kcurl.GetResponseHeader( "ETag" ) + '\n'
+                        + kcurl.GetResponseHeader( "Last-Modified" ) + '\n' );
+    }
 }
 
 #if 0 && defined(STANDALONE)
@@ -220,6 +220,12 @@ protected:
      * fetches a zip file image from a github repo synchronously.  The byte image
      * is received into the m_input_stream. If the image has already been stored,
      * do nothing.
+     *
+     * A copy of the zip file is kept in the user cache folder, with its ETag and
+     * Last-Modified response headers.  The server is then asked for the zip file
+     * only if it was modified since, and the local copy is used if the server
+     * cannot be reached.  Set the KICAD_NO_GITHUB_CACHE environment variable to
+     * always download the zip file.
      */
     void remoteGetZip( const wxString& aRepoURL ) throw( IO_ERROR );
 
@@ -66,6 +66,7 @@
 #include <worksheet_viewitem.h>
 #include <ratsnest_data.h>
 #include <ratsnest_viewitem.h>
+#include <board_commit.h>
 
 #include <tool/tool_manager.h>
 #include <tool/tool_dispatcher.h>
@@ -381,6 +382,7 @@ PCB_EDIT_FRAME::PCB_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
 
     SetScreen( new PCB_SCREEN( GetPageSettings().GetSizeIU() ) );
     GetScreen()->SetMaxUndoItems( m_UndoRedoCountMax );
+    GetScreen()->SetMaxUndoMemory( m_UndoRedoMemoryMaxMB );
 
     // PCB drawings start in the upper left corner.
     GetScreen()->m_Center = false;
@@ -1007,6 +1009,11 @@ void PCB_EDIT_FRAME::OnModify( )
 {
     PCB_BASE_FRAME::OnModify();
 
+    // The board was changed outside of a commit: the copies of the board items kept
+    // by the tools (e.g. the router world) are out of date
+    if( !BOARD_COMMIT::IsPushing() )
+        BOARD_COMMIT::NotifyBoardChanged( GetBoard() );
+
     EDA_3D_VIEWER* draw3DFrame = Get3DViewerFrame();
 
     if( draw3DFrame )
@@ -1069,6 +1076,9 @@ void PCB_EDIT_FRAME::ScriptingConsoleEnableDisable( wxCommandEvent& aEvent )
     else
         pythonPanelShown = ! pythonPanelFrame->IsShown();
 
+    // The scripts run in the console may have changed the board
+    BOARD_COMMIT::NotifyBoardChanged( GetBoard() );
+
     if( pythonPanelFrame )
         pythonPanelFrame->Show( pythonPanelShown );
     else
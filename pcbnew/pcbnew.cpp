@@ -74,6 +74,7 @@ bool         g_Alternate_Track_Posture = false;
 bool         g_Track_45_Only_Allowed = true;  // True to allow horiz, vert. and 45deg only tracks
 bool         g_Segments_45_Only;              // True to allow horiz, vert. and 45deg only graphic segments
 bool         g_TwoSegmentTrackBuild = true;
+bool         g_TiledZoneFill = false;
 
 PCB_LAYER_ID g_Route_Layer_TOP;
 PCB_LAYER_ID g_Route_Layer_BOTTOM;
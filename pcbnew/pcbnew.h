@@ -88,6 +88,7 @@ extern PCB_LAYER_ID g_Route_Layer_TOP;
 extern PCB_LAYER_ID g_Route_Layer_BOTTOM;
 
 extern bool     g_TwoSegmentTrackBuild;
+extern bool     g_TiledZoneFill;        ///< split the large zone fills in strips filled in parallel
 
 extern int      g_MagneticPadOption;
 extern int      g_MagneticTrackOption;
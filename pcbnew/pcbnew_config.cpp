@@ -422,6 +422,8 @@ PARAM_CFG_ARRAY& PCB_EDIT_FRAME::GetConfigurationSettings()
                                                         &g_TwoSegmentTrackBuild, true ) );
         m_configSettings.push_back( new PARAM_CFG_BOOL( true, wxT( "SegmPcb45Only" )
                                                         , &g_Segments_45_Only, true ) );
+        m_configSettings.push_back( new PARAM_CFG_BOOL( true, wxT( "TiledZoneFill" ),
+                                                        &g_TiledZoneFill, false ) );
     }
 
     return m_configSettings;
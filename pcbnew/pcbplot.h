@@ -164,6 +164,13 @@ private:
 
 };
 
+/**
+ * Function FootprintHasBadTextLayer
+ * @return true if a text of aModule has a bad layer number, so the footprint texts
+ * cannot be plotted (see BRDITEMS_PLOTTER::PlotAllTextsModule())
+ */
+bool FootprintHasBadTextLayer( MODULE* aModule );
+
 PLOTTER* StartPlotBoard( BOARD* aBoard,
                          PCB_PLOT_PARAMS* aPlotOpts,
                          int aLayer,
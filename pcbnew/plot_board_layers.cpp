@@ -61,6 +61,19 @@ static void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter,
                                  LSET aLayerMask, const PCB_PLOT_PARAMS& aPlotOpt,
                                  int aMinThickness );
 
+/* Report a footprint whose texts cannot be plotted.
+ * Layers can be plotted from worker threads (see PLOT_JOB_SCHEDULER), which must not
+ * use the wx log: the scheduler reports these footprints itself before starting them.
+ */
+static void reportBadTextLayer( MODULE* aModule )
+{
+    if( !wxThread::IsMain() )
+        return;
+
+    wxLogMessage( _( "Your BOARD has a bad layer number for footprint %s" ),
+                  GetChars( aModule->GetReference() ) );
+}
+
 /* Creates the plot for silkscreen layers
  * Silkscreen layers have specific requirement for pads (not filled) and texts
  * (with option to remove them from some copper areas (pads...)
@@ -117,10 +130,7 @@ void PlotSilkScreen( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     for( MODULE* module = aBoard->m_Modules;  module;  module = module->Next() )
     {
         if( ! itemplotter.PlotAllTextsModule( module ) )
-        {
-             wxLogMessage( _( "Your BOARD has a bad layer number for footprint %s" ),
-                           GetChars( module->GetReference() ) );
-        }
+            reportBadTextLayer( module );
     }
 
     // Plot filled areas
@@ -306,10 +316,7 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
     for( MODULE* module = aBoard->m_Modules;  module;  module = module->Next() )
     {
         if( ! itemplotter.PlotAllTextsModule( module ) )
-        {
-            wxLogMessage( _( "Your BOARD has a bad layer number for footprint %s" ),
-                           GetChars( module->GetReference() ) );
-        }
+            reportBadTextLayer( module );
     }
 
     for( MODULE* module = aBoard->m_Modules;  module;  module = module->Next() )
@@ -366,7 +373,7 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             wxSize extraSize = margin * 2;
             extraSize.x += width_adj;
             extraSize.y += width_adj;
-            wxSize deltaSize = pad->GetDelta(); // has meaning only for trapezoidal pads
+            wxSize padPlotsDelta = pad->GetDelta(); // has meaning only for trapezoidal pads
 
             if( pad->GetShape() == PAD_SHAPE_TRAPEZOID )
             {   // The easy way is to use BuildPadPolygon to calculate
@@ -392,14 +399,12 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
 
                 // calculate the delta ( difference of lenght between 2 opposite edges )
                 // The delta.x is the delta along the X axis, therefore the delta of Y lenghts
-                wxSize delta;
+                padPlotsDelta = wxSize( 0, 0 );
 
                 if( coord[0].y != coord[3].y )
-                    delta.x = coord[0].y - coord[3].y;
+                    padPlotsDelta.x = coord[0].y - coord[3].y;
                 else
-                    delta.y = coord[1].x - coord[0].x;
-
-                pad->SetDelta( delta );
+                    padPlotsDelta.y = coord[1].x - coord[0].x;
             }
             else
                 padPlotsSize = pad->GetSize() + extraSize;
@@ -416,17 +421,19 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             if( pad->GetLayerSet()[F_Cu] )
                 color = color.LegacyMix( aBoard->GetVisibleElementColor( LAYER_PAD_FR ) );
 
-            // Temporary set the pad size to the required plot size:
-            wxSize tmppadsize = pad->GetSize();
-            pad->SetSize( padPlotsSize );
+            // Plot a copy of the pad, with the required plot size.
+            // The board is not modified, so several layers can be plotted at the same time
+            D_PAD plotPad( *pad );
+            plotPad.SetSize( padPlotsSize );
+            plotPad.SetDelta( padPlotsDelta );
 
-            switch( pad->GetShape() )
+            switch( plotPad.GetShape() )
             {
             case PAD_SHAPE_CIRCLE:
             case PAD_SHAPE_OVAL:
                 if( aPlotOpt.GetSkipPlotNPTH_Pads() &&
-                    (pad->GetSize() == pad->GetDrillSize()) &&
-                    (pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED) )
+                    (plotPad.GetSize() == plotPad.GetDrillSize()) &&
+                    (plotPad.GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED) )
                     break;
 
                 // Fall through:
@@ -434,12 +441,9 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             case PAD_SHAPE_RECT:
             case PAD_SHAPE_ROUNDRECT:
             default:
-                itemplotter.PlotPad( pad, color, plotMode );
+                itemplotter.PlotPad( &plotPad, color, plotMode );
                 break;
             }
-
-            pad->SetSize( tmppadsize );     // Restore the pad size
-            pad->SetDelta( deltaSize );
         }
 
         aPlotter->EndBlock( NULL );
@@ -191,6 +191,24 @@ void BRDITEMS_PLOTTER::PlotPad( D_PAD* aPad, COLOR4D aColor, EDA_DRAW_MODE_T aPl
 }
 
 
+bool FootprintHasBadTextLayer( MODULE* aModule )
+{
+    if( aModule->Reference().GetLayer() >= PCB_LAYER_ID_COUNT
+            || aModule->Value().GetLayer() > PCB_LAYER_ID_COUNT )
+        return true;
+
+    for( BOARD_ITEM *item = aModule->GraphicalItems().GetFirst(); item; item = item->Next() )
+    {
+        TEXTE_MODULE* textModule = dyn_cast<TEXTE_MODULE*>( item );
+
+        if( textModule && textModule->IsVisible() && textModule->GetLayer() >= PCB_LAYER_ID_COUNT )
+            return true;
+    }
+
+    return false;
+}
+
+
 bool BRDITEMS_PLOTTER::PlotAllTextsModule( MODULE* aModule )
 {
     // see if we want to plot VALUE and REF fields
@@ -638,8 +656,7 @@ void BRDITEMS_PLOTTER::PlotFilledAreas( ZONE_CONTAINER* aZone )
     }
 
     // We need a buffer to store corners coordinates:
-    static std::vector< wxPoint > cornerList;
-    cornerList.clear();
+    std::vector< wxPoint > cornerList;
 
     m_plotter->SetColor( getColor( aZone->GetLayer() ) );
 
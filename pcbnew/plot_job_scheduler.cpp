@@ -0,0 +1,305 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 1992-2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file pcbnew/plot_job_scheduler.cpp
+ */
+
+#include <fctsys.h>
+#include <common.h>
+#include <plot_common.h>
+#include <ki_exception.h>
+#include <profile.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <pcbplot.h>
+#include <plot_job_scheduler.h>
+#include <gendrill_Excellon_writer.h>
+#include <gendrill_gerber_writer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+/**
+ * A REPORTER storing the messages of a job, to report them later from the main thread
+ */
+class JOB_REPORTER : public REPORTER
+{
+public:
+    JOB_REPORTER( std::vector<PLOT_JOB_SCHEDULER::MESSAGE>& aMessages ) :
+        REPORTER(),
+        m_messages( aMessages )
+    {
+    }
+
+    REPORTER& Report( const wxString& aText, SEVERITY aSeverity = RPT_UNDEFINED ) override
+    {
+        m_messages.push_back( PLOT_JOB_SCHEDULER::MESSAGE( aText, aSeverity ) );
+        return *this;
+    }
+
+private:
+    std::vector<PLOT_JOB_SCHEDULER::MESSAGE>& m_messages;
+};
+
+
+PLOT_JOB_SCHEDULER::PLOT_JOB_SCHEDULER( BOARD* aBoard ) :
+    m_board( aBoard ),
+    m_hasLayerJobs( false ),
+    m_duration( 0.0 )
+{
+}
+
+
+void PLOT_JOB_SCHEDULER::AddJob( const wxString& aName, JOB_FUNCTION aFunction )
+{
+    JOB job;
+
+    job.m_Name     = aName;
+    job.m_Function = aFunction;
+    job.m_Success  = false;
+    job.m_Duration = 0.0;
+
+    m_jobs.push_back( job );
+}
+
+
+void PLOT_JOB_SCHEDULER::AddLayerJob( PCB_LAYER_ID aLayer, const wxString& aFullFileName,
+                                      const PCB_PLOT_PARAMS& aPlotOpts,
+                                      const wxString& aSheetDesc )
+{
+    BOARD* board = m_board;
+
+    // Translations use the wx locale, which is not thread-safe:
+    // the messages are translated here, in the calling thread
+    wxString errorMsg;
+    wxString doneMsg;
+
+    errorMsg.Printf( _( "Unable to create file '%s'." ), GetChars( aFullFileName ) );
+    doneMsg.Printf( _( "Plot file '%s' created." ), GetChars( aFullFileName ) );
+
+    m_hasLayerJobs = true;
+
+    // The plot options are captured by value: each job owns its own copy
+    AddJob( board->GetLayerName( aLayer ),
+            [board, aLayer, aFullFileName, aPlotOpts, aSheetDesc, errorMsg, doneMsg]
+            ( REPORTER& aReporter ) -> bool
+    {
+        PCB_PLOT_PARAMS plotOpts = aPlotOpts;
+
+        PLOTTER* plotter = StartPlotBoard( board, &plotOpts, aLayer, aFullFileName, aSheetDesc );
+
+        if( !plotter )
+        {
+            aReporter.Report( errorMsg, REPORTER::RPT_ERROR );
+            return false;
+        }
+
+        PlotOneBoardLayer( board, plotter, aLayer, plotOpts );
+        plotter->EndPlot();
+        delete plotter;
+
+        aReporter.Report( doneMsg, REPORTER::RPT_ACTION );
+
+        return true;
+    } );
+}
+
+
+/**
+ * Add the drill and drill map jobs of a EXCELLON_WRITER or a GERBER_WRITER.
+ * The writers keep the hole list of the file being written, so each job
+ * owns its own copy of the writer.
+ */
+template<class WRITER>
+static void addDrillJobs( PLOT_JOB_SCHEDULER* aScheduler, const WRITER& aWriter,
+                          const wxString& aPlotDirectory, bool aGenDrill, bool aGenMap )
+{
+    if( aGenDrill )
+    {
+        aScheduler->AddJob( _( "Drill files" ),
+                            [aWriter, aPlotDirectory]( REPORTER& aReporter ) -> bool
+        {
+            WRITER writer = aWriter;
+            return writer.CreateDrillandMapFilesSet( aPlotDirectory, true, false, &aReporter );
+        } );
+    }
+
+    if( aGenMap )
+    {
+        aScheduler->AddJob( _( "Drill map files" ),
+                            [aWriter, aPlotDirectory]( REPORTER& aReporter ) -> bool
+        {
+            WRITER writer = aWriter;
+            return writer.CreateDrillandMapFilesSet( aPlotDirectory, false, true, &aReporter );
+        } );
+    }
+}
+
+
+void PLOT_JOB_SCHEDULER::AddDrillJobs( const EXCELLON_WRITER& aWriter,
+                                       const wxString& aPlotDirectory,
+                                       bool aGenDrill, bool aGenMap )
+{
+    addDrillJobs( this, aWriter, aPlotDirectory, aGenDrill, aGenMap );
+}
+
+
+void PLOT_JOB_SCHEDULER::AddDrillJobs( const GERBER_WRITER& aWriter,
+                                       const wxString& aPlotDirectory,
+                                       bool aGenDrill, bool aGenMap )
+{
+    addDrillJobs( this, aWriter, aPlotDirectory, aGenDrill, aGenMap );
+}
+
+
+void PLOT_JOB_SCHEDULER::runJob( JOB& aJob )
+{
+    JOB_REPORTER  reporter( aJob.m_Messages );
+    PROF_COUNTER  timer;
+
+    aJob.m_Messages.clear();
+
+    try
+    {
+        aJob.m_Success = aJob.m_Function( reporter );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        reporter.Report( ioe.What(), REPORTER::RPT_ERROR );
+        aJob.m_Success = false;
+    }
+    catch( const std::exception& e )
+    {
+        reporter.Report( FROM_UTF8( e.what() ), REPORTER::RPT_ERROR );
+        aJob.m_Success = false;
+    }
+
+    aJob.m_Duration = timer.msecs();
+}
+
+
+bool PLOT_JOB_SCHEDULER::Run( REPORTER* aReporter, unsigned aNThreads )
+{
+    PROF_COUNTER timer;
+
+    if( m_jobs.empty() )
+        return true;
+
+    if( aNThreads == 0 )
+        aNThreads = std::max( 1u, std::thread::hardware_concurrency() );
+
+    aNThreads = std::min<size_t>( aNThreads, m_jobs.size() );
+
+    // The layer jobs cannot use the wx log from the worker threads:
+    // the footprints having texts which cannot be plotted are reported here
+    if( m_hasLayerJobs && aReporter )
+    {
+        for( MODULE* module = m_board->m_Modules; module; module = module->Next() )
+        {
+            if( FootprintHasBadTextLayer( module ) )
+            {
+                wxString msg;
+                msg.Printf( _( "Your BOARD has a bad layer number for footprint %s" ),
+                            GetChars( module->GetReference() ) );
+                aReporter->Report( msg, REPORTER::RPT_WARNING );
+            }
+        }
+    }
+
+    // The locale is global: as in FOOTPRINT_LIST_IMPL::JoinWorkers(), switch it
+    // before the threads are created, and restore it after they are finished.
+    // The LOCALE_IO used by the jobs only change the reference count.
+    LOCALE_IO toggle;
+
+    std::atomic<size_t>      nextJob( 0 );
+    std::mutex               finishedLock;
+    std::condition_variable  finishedCond;
+    std::vector<size_t>      finished;
+    std::vector<std::thread> threads;
+
+    for( unsigned ii = 0; ii < aNThreads; ++ii )
+    {
+        threads.push_back( std::thread( [&]()
+        {
+            size_t jobIdx;
+
+            while( ( jobIdx = nextJob++ ) < m_jobs.size() )
+            {
+                runJob( m_jobs[jobIdx] );
+
+                std::lock_guard<std::mutex> lock( finishedLock );
+                finished.push_back( jobIdx );
+                finishedCond.notify_one();
+            }
+        } ) );
+    }
+
+    // Report the jobs as they finish, from this thread only,
+    // because most of reporters use the GUI
+    bool   success = true;
+    size_t reportedCount = 0;
+    std::vector<size_t> toReport;
+
+    while( reportedCount < m_jobs.size() )
+    {
+        {
+            std::unique_lock<std::mutex> lock( finishedLock );
+            finishedCond.wait( lock, [&]() { return !finished.empty(); } );
+            toReport.swap( finished );
+        }
+
+        for( size_t jobIdx : toReport )
+        {
+            const JOB& job = m_jobs[jobIdx];
+
+            success = success && job.m_Success;
+            reportedCount++;
+
+            if( !aReporter )
+                continue;
+
+            for( const MESSAGE& message : job.m_Messages )
+                aReporter->Report( message.first, message.second );
+
+            wxString msg;
+            msg.Printf( _( "%s done in %.0f ms (%u/%u)." ), GetChars( job.m_Name ),
+                        job.m_Duration, (unsigned) reportedCount, (unsigned) m_jobs.size() );
+            aReporter->Report( msg, REPORTER::RPT_INFO );
+        }
+
+        toReport.clear();
+    }
+
+    for( auto& thread : threads )
+        thread.join();
+
+    m_duration = timer.msecs();
+
+    return success;
+}
@@ -0,0 +1,147 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 1992-2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file pcbnew/plot_job_scheduler.h
+ * @brief Run the plot of several layers and the drill files in parallel.
+ */
+
+#ifndef PLOT_JOB_SCHEDULER_H_
+#define PLOT_JOB_SCHEDULER_H_
+
+#include <functional>
+#include <vector>
+#include <wx/string.h>
+#include <reporter.h>
+#include <pcb_plot_params.h>
+#include <layers_id_colors_and_visibility.h>
+
+class BOARD;
+class EXCELLON_WRITER;
+class GERBER_WRITER;
+
+
+/**
+ * Class PLOT_JOB_SCHEDULER
+ * runs a set of fabrication output jobs (one plotted layer, the drill files...)
+ * in worker threads.
+ *
+ * The jobs share the board, so they must only read it. PlotOneBoardLayer()
+ * and the drill file writers do not modify the board.
+ * The board must not be modified by the caller until Run() returns.
+ *
+ * No GUI is used, so it can be used from scripts or command line tools.
+ * The jobs must not use the wx log nor translate messages (_()), which are not
+ * thread-safe.
+ */
+class PLOT_JOB_SCHEDULER
+{
+public:
+    /**
+     * A job creates one or more files.
+     * It is run in a worker thread and must report its messages to aReporter only.
+     * @return true if success
+     */
+    typedef std::function<bool( REPORTER& aReporter )> JOB_FUNCTION;
+
+    typedef std::pair<wxString, REPORTER::SEVERITY> MESSAGE;
+
+    struct JOB
+    {
+        wxString             m_Name;        ///< name used in reports
+        JOB_FUNCTION         m_Function;
+        bool                 m_Success;
+        double               m_Duration;    ///< run time, in ms
+        std::vector<MESSAGE> m_Messages;    ///< messages reported by the job
+    };
+
+    PLOT_JOB_SCHEDULER( BOARD* aBoard );
+
+    /**
+     * Function AddJob
+     * adds a job to run
+     * @param aName = the job name, used in reports
+     * @param aFunction = the job itself
+     */
+    void AddJob( const wxString& aName, JOB_FUNCTION aFunction );
+
+    /**
+     * Function AddLayerJob
+     * adds a job plotting one layer of the board in a file,
+     * using StartPlotBoard() and PlotOneBoardLayer()
+     * @param aLayer = the layer to plot
+     * @param aFullFileName = the file to create
+     * @param aPlotOpts = the plot options, copied in the job
+     * @param aSheetDesc = the sheet description, for the frame reference
+     */
+    void AddLayerJob( PCB_LAYER_ID aLayer, const wxString& aFullFileName,
+                      const PCB_PLOT_PARAMS& aPlotOpts,
+                      const wxString& aSheetDesc = wxEmptyString );
+
+    /**
+     * Function AddDrillJobs
+     * adds a job writing the drill files and a job writing the drill map files
+     * (as selected by aGenDrill and aGenMap) of the board.
+     * Each job uses its own copy of aWriter, which must be set up for the board
+     * given to the constructor.
+     * @param aWriter = the drill file writer, with its format and options
+     * @param aPlotDirectory = the output folder
+     * @param aGenDrill = true to add the drill files job
+     * @param aGenMap = true to add the drill map files job
+     */
+    void AddDrillJobs( const EXCELLON_WRITER& aWriter, const wxString& aPlotDirectory,
+                       bool aGenDrill = true, bool aGenMap = true );
+    void AddDrillJobs( const GERBER_WRITER& aWriter, const wxString& aPlotDirectory,
+                       bool aGenDrill = true, bool aGenMap = true );
+
+    /**
+     * Function Run
+     * runs all the jobs, and waits for their completion.
+     * Must be called from the main thread: the messages of each job and its run time are sent
+     * to aReporter from the calling thread, when the job is finished.
+     * @param aReporter = the reporter to use (can be NULL)
+     * @param aNThreads = the number of worker threads, 0 to use one thread by core
+     * @return true if all jobs are successful
+     */
+    bool Run( REPORTER* aReporter = NULL, unsigned aNThreads = 0 );
+
+    /**
+     * @return the jobs, with the results of the last Run()
+     */
+    const std::vector<JOB>& GetJobs() const { return m_jobs; }
+
+    /**
+     * @return the wall time of the last Run(), in ms
+     */
+    double GetDuration() const { return m_duration; }
+
+private:
+    void runJob( JOB& aJob );
+
+    BOARD*           m_board;
+    bool             m_hasLayerJobs;    ///< true if AddLayerJob() was used
+    std::vector<JOB> m_jobs;
+    double           m_duration;
+};
+
+#endif  // PLOT_JOB_SCHEDULER_H_
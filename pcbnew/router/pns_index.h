@@ -31,6 +31,7 @@
 #include <geometry/shape_index.h>
 
 #include "pns_item.h"
+#include "pns_pool.h"
 
 namespace PNS {
 
@@ -52,6 +53,17 @@ public:
     INDEX();
     ~INDEX();
 
+    ///> Each branch has its own index, which comes from a POOL as the branch itself
+    static void* operator new( size_t aSize )
+    {
+        return POOL<INDEX>::Alloc( aSize );
+    }
+
+    static void operator delete( void* aPtr, size_t aSize )
+    {
+        POOL<INDEX>::Free( aPtr, aSize );
+    }
+
     /**
      * Function Add()
      *
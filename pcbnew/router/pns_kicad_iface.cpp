@@ -416,6 +416,9 @@ public:
 
     void AddLine( const SHAPE_LINE_CHAIN& aLine, int aType, int aWidth ) override
     {
+        if( !m_view )
+            return;
+
         ROUTER_PREVIEW_ITEM* pitem = new ROUTER_PREVIEW_ITEM( NULL, m_view );
 
         pitem->Line( aLine, aWidth, aType );
@@ -440,6 +443,10 @@ private:
 
 PNS::DEBUG_DECORATOR* PNS_KICAD_IFACE::GetDebugDecorator()
 {
+    // Without a view (e.g. when a session is replayed), the debug graphics are dropped
+    if( !m_debugDecorator )
+        m_debugDecorator = new PNS_PCBNEW_DEBUG_DECORATOR();
+
     return m_debugDecorator;
 }
 
@@ -455,11 +462,17 @@ PNS_KICAD_IFACE::PNS_KICAD_IFACE()
     m_router = nullptr;
     m_debugDecorator = nullptr;
     m_dispOptions = nullptr;
+    m_worldNeedsSync = true;
+    m_committing = false;
+
+    BOARD_COMMIT::AddListener( this );
 }
 
 
 PNS_KICAD_IFACE::~PNS_KICAD_IFACE()
 {
+    BOARD_COMMIT::RemoveListener( this );
+
     delete m_ruleResolver;
     delete m_debugDecorator;
 
@@ -792,6 +805,13 @@ void PNS_KICAD_IFACE::SyncWorld( PNS::NODE *aWorld )
         }
     }
 
+    UpdateRules( aWorld );
+    m_worldNeedsSync = false;
+}
+
+
+void PNS_KICAD_IFACE::UpdateRules( PNS::NODE* aWorld )
+{
     int worstClearance = m_board->GetDesignSettings().GetBiggestClearanceValue();
 
     delete m_ruleResolver;
@@ -802,6 +822,151 @@ void PNS_KICAD_IFACE::SyncWorld( PNS::NODE *aWorld )
 }
 
 
+std::unique_ptr<PNS::ITEM> PNS_KICAD_IFACE::syncItem( BOARD_CONNECTED_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_PAD_T:
+        return syncPad( static_cast<D_PAD*>( aItem ) );
+
+    case PCB_TRACE_T:
+        return syncTrack( static_cast<TRACK*>( aItem ) );
+
+    case PCB_VIA_T:
+        return syncVia( static_cast<VIA*>( aItem ) );
+
+    default:
+        return nullptr;
+    }
+}
+
+
+void PNS_KICAD_IFACE::updateWorldItem( PNS::NODE* aWorld, BOARD_CONNECTED_ITEM* aItem,
+                                       CHANGE_TYPE aChangeType )
+{
+    if( aChangeType != CHT_ADD )
+    {
+        PNS::ITEM* old = aWorld->FindItemByParent( aItem );
+
+        // The net of a modified item may have been changed
+        if( !old && aChangeType == CHT_MODIFY )
+            old = aWorld->FindItemByParentInAllNets( aItem );
+
+        if( old )
+            aWorld->Remove( old );
+    }
+
+    if( aChangeType != CHT_REMOVE )
+    {
+        std::unique_ptr<PNS::ITEM> item = syncItem( aItem );
+
+        if( item )
+            aWorld->Add( std::move( item ) );
+    }
+}
+
+
+void PNS_KICAD_IFACE::OnItemChanged( BOARD* aBoard, BOARD_ITEM* aItem, CHANGE_TYPE aChangeType )
+{
+    // The changes committed by the router are already in its world
+    if( aBoard != m_board || m_committing || m_worldNeedsSync )
+        return;
+
+    PNS::NODE* world = m_router ? m_router->GetWorld() : nullptr;
+
+    // The root node cannot be modified while a routing is in progress
+    if( !world || world->HasChildren() )
+    {
+        m_worldNeedsSync = true;
+        return;
+    }
+
+    switch( aItem->Type() )
+    {
+    case PCB_MODULE_T:
+        for( D_PAD* pad = static_cast<MODULE*>( aItem )->Pads(); pad; pad = pad->Next() )
+            updateWorldItem( world, pad, aChangeType );
+
+        break;
+
+    case PCB_PAD_T:
+    case PCB_TRACE_T:
+    case PCB_VIA_T:
+        updateWorldItem( world, static_cast<BOARD_CONNECTED_ITEM*>( aItem ), aChangeType );
+        break;
+
+    default:    // the other items are not seen by the router
+        break;
+    }
+}
+
+
+void PNS_KICAD_IFACE::OnBoardChanged( BOARD* aBoard )
+{
+    if( aBoard == m_board )
+        m_worldNeedsSync = true;
+}
+
+
+#ifdef DEBUG
+static bool sameWorldItems( const PNS::ITEM* aA, const PNS::ITEM* aB )
+{
+    if( aA->Kind() != aB->Kind() || aA->Net() != aB->Net() || aA->IsLocked() != aB->IsLocked() )
+        return false;
+
+    if( aA->Layers().Start() != aB->Layers().Start() || aA->Layers().End() != aB->Layers().End() )
+        return false;
+
+    BOX2I bboxA = aA->Shape()->BBox();
+    BOX2I bboxB = aB->Shape()->BBox();
+
+    return bboxA.GetOrigin() == bboxB.GetOrigin() && bboxA.GetSize() == bboxB.GetSize();
+}
+
+
+bool PNS_KICAD_IFACE::CheckWorld()
+{
+    PNS::NODE* world = m_router->GetWorld();
+    int count = 0;
+    bool valid = true;
+
+    auto checkItem = [&]( BOARD_CONNECTED_ITEM* aItem )
+    {
+        std::unique_ptr<PNS::ITEM> fresh = syncItem( aItem );
+
+        if( !fresh )
+            return;
+
+        PNS::ITEM* live = world->FindItemByParent( aItem );
+        count++;
+
+        if( !live || !sameWorldItems( live, fresh.get() ) )
+        {
+            wxLogTrace( "PNS", "The world item of %p is out of date", aItem );
+            valid = false;
+        }
+    };
+
+    for( MODULE* module = m_board->m_Modules; module; module = module->Next() )
+    {
+        for( D_PAD* pad = module->Pads(); pad; pad = pad->Next() )
+            checkItem( pad );
+    }
+
+    for( TRACK* t = m_board->m_Track; t; t = t->Next() )
+        checkItem( t );
+
+    if( count != world->ItemCount() )
+    {
+        wxLogTrace( "PNS", "The world has %d items, the board %d", world->ItemCount(), count );
+        valid = false;
+    }
+
+    return valid;
+}
+#endif
+
+
 void PNS_KICAD_IFACE::EraseView()
 {
     for( auto item : m_hiddenItems )
@@ -824,6 +989,9 @@ void PNS_KICAD_IFACE::DisplayItem( const PNS::ITEM* aItem, int aColor, int aClea
 {
     wxLogTrace( "PNS", "DisplayItem %p", aItem );
 
+    if( !m_view )
+        return;
+
     ROUTER_PREVIEW_ITEM* pitem = new ROUTER_PREVIEW_ITEM( aItem, m_view );
 
     if( aColor >= 0 )
@@ -852,7 +1020,7 @@ void PNS_KICAD_IFACE::HideItem( PNS::ITEM* aItem )
 {
     BOARD_CONNECTED_ITEM* parent = aItem->Parent();
 
-    if( parent )
+    if( parent && m_view )
     {
         if( m_view->IsVisible( parent ) )
             m_hiddenItems.insert( parent );
@@ -867,7 +1035,7 @@ void PNS_KICAD_IFACE::RemoveItem( PNS::ITEM* aItem )
 {
     BOARD_CONNECTED_ITEM* parent = aItem->Parent();
 
-    if( parent )
+    if( parent && m_commit )
     {
         m_commit->Remove( parent );
     }
@@ -878,6 +1046,10 @@ void PNS_KICAD_IFACE::AddItem( PNS::ITEM* aItem )
 {
     BOARD_CONNECTED_ITEM* newBI = NULL;
 
+    // Without a host frame, only the router world is modified, not the board
+    if( !m_commit )
+        return;
+
     switch( aItem->Kind() )
     {
     case PNS::ITEM::SEGMENT_T:
@@ -926,7 +1098,13 @@ void PNS_KICAD_IFACE::AddItem( PNS::ITEM* aItem )
 void PNS_KICAD_IFACE::Commit()
 {
     EraseView();
+
+    if( !m_commit )
+        return;
+
+    m_committing = true;
     m_commit->Push( wxT( "Added a track" ) );
+    m_committing = false;
     m_commit.reset( new BOARD_COMMIT( m_frame ) );
 }
 
@@ -24,13 +24,14 @@
 
 #include <unordered_set>
 
+#include <board_commit.h>
+
 #include "pns_router.h"
 
 class PNS_PCBNEW_RULE_RESOLVER;
 class PNS_PCBNEW_DEBUG_DECORATOR;
 
 class BOARD;
-class BOARD_COMMIT;
 class DISPLAY_OPTIONS;
 
 namespace KIGFX
@@ -38,7 +39,15 @@ namespace KIGFX
     class VIEW;
 };
 
-class PNS_KICAD_IFACE : public PNS::ROUTER_IFACE {
+/**
+ * Class PNS_KICAD_IFACE
+ * connects the router to the board.
+ *
+ * The router world is kept between the routing sessions: the commits pushed to the board
+ * update its items, and it is only read again from the board after changes that are not
+ * made by a commit (undo, redo, and the edits notified by PCB_EDIT_FRAME::OnModify()).
+ */
+class PNS_KICAD_IFACE : public PNS::ROUTER_IFACE, public BOARD_COMMIT_LISTENER {
 public:
     PNS_KICAD_IFACE();
     ~PNS_KICAD_IFACE();
@@ -49,6 +58,33 @@ public:
     void SetBoard( BOARD* aBoard );
     void SetView( KIGFX::VIEW* aView );
     void SyncWorld( PNS::NODE* aWorld ) override;
+
+    /**
+     * Function UpdateRules()
+     * builds again the clearance rules of a router world, without reading the board items.
+     */
+    void UpdateRules( PNS::NODE* aWorld );
+
+    ///> Returns true if the router world is out of date and has to be read from the board.
+    bool WorldNeedsSync() const
+    {
+        return m_worldNeedsSync;
+    }
+
+#ifdef DEBUG
+    /**
+     * Function CheckWorld()
+     * compares the router world, updated by the commits, with the items of the board.
+     * @return true if the router world matches the board.
+     */
+    bool CheckWorld();
+#endif
+
+    ///> @copydoc BOARD_COMMIT_LISTENER::OnItemChanged()
+    void OnItemChanged( BOARD* aBoard, BOARD_ITEM* aItem, CHANGE_TYPE aChangeType ) override;
+
+    ///> @copydoc BOARD_COMMIT_LISTENER::OnBoardChanged()
+    void OnBoardChanged( BOARD* aBoard ) override;
     void EraseView() override;
     void HideItem( PNS::ITEM* aItem ) override;
     void DisplayItem( const PNS::ITEM* aItem, int aColor = 0, int aClearance = 0 ) override;
@@ -68,6 +104,10 @@ private:
     std::unique_ptr<PNS::SOLID>   syncPad( D_PAD* aPad );
     std::unique_ptr<PNS::SEGMENT> syncTrack( TRACK* aTrack );
     std::unique_ptr<PNS::VIA>     syncVia( VIA* aVia );
+    std::unique_ptr<PNS::ITEM>    syncItem( BOARD_CONNECTED_ITEM* aItem );
+
+    ///> Replaces the router items of a pad, a track or a via with its current state.
+    void updateWorldItem( PNS::NODE* aWorld, BOARD_CONNECTED_ITEM* aItem, CHANGE_TYPE aChangeType );
 
     KIGFX::VIEW* m_view;
     KIGFX::VIEW_GROUP* m_previewItems;
@@ -79,6 +119,12 @@ private:
     PCB_EDIT_FRAME* m_frame;
     std::unique_ptr<BOARD_COMMIT> m_commit;
     DISPLAY_OPTIONS* m_dispOptions;
+
+    ///> The router world does not match the board
+    bool m_worldNeedsSync;
+
+    ///> The changes being committed come from the router, and are already in its world
+    bool m_committing;
 };
 
 #endif
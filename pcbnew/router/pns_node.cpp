@@ -21,6 +21,7 @@
 
 #include <vector>
 #include <cassert>
+#include <atomic>
 
 #include <math/vector2d.h>
 
@@ -47,6 +48,9 @@ namespace PNS {
 static boost::unordered_set<NODE*> allocNodes;
 #endif
 
+// Number of collision queries run on all the nodes, reported by the router benchmarks
+static std::atomic<uint64_t> queryCount( 0 );
+
 NODE::NODE()
 {
     wxLogTrace( "PNS", "NODE::create %p", this );
@@ -261,6 +265,8 @@ struct NODE::DEFAULT_OBSTACLE_VISITOR : public OBSTACLE_VISITOR
 
 int NODE::QueryColliding( const ITEM* aItem, OBSTACLE_VISITOR& aVisitor )
 {
+    queryCount.fetch_add( 1, std::memory_order_relaxed );
+
     aVisitor.SetWorld( this, NULL );
     m_index->Query( aItem, m_maxClearance, aVisitor );
 
@@ -280,6 +286,8 @@ int NODE::QueryColliding( const ITEM* aItem,
 {
     DEFAULT_OBSTACLE_VISITOR visitor( aObstacles, aItem, aKindMask, aDifferentNetsOnly );
 
+    queryCount.fetch_add( 1, std::memory_order_relaxed );
+
 #ifdef DEBUG
     assert( allocNodes.find( this ) != allocNodes.end() );
 #endif
@@ -1338,4 +1346,28 @@ ITEM *NODE::FindItemByParent( const BOARD_CONNECTED_ITEM* aParent )
     return NULL;
 }
 
+
+ITEM* NODE::FindItemByParentInAllNets( const BOARD_CONNECTED_ITEM* aParent )
+{
+    for( INDEX::ITEM_SET::iterator i = m_index->begin(); i != m_index->end(); ++i )
+    {
+        if( (*i)->Parent() == aParent )
+            return *i;
+    }
+
+    return NULL;
+}
+
+
+int NODE::ItemCount() const
+{
+    return m_index->Size();
+}
+
+
+uint64_t NODE::QueryCount()
+{
+    return queryCount.load( std::memory_order_relaxed );
+}
+
 }
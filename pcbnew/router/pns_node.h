@@ -36,6 +36,7 @@
 #include "pns_item.h"
 #include "pns_joint.h"
 #include "pns_itemset.h"
+#include "pns_pool.h"
 
 namespace PNS {
 
@@ -133,6 +134,9 @@ protected:
  * - assembly of lines connecting joints, finding loops and unique paths
  * - lightweight cloning/branching (for recursive optimization and shove
  * springback)
+ *
+ * The collision and joint queries do not modify the nodes, so a branch and its parents
+ * can be searched from several threads, as long as none of them is modified meanwhile.
  **/
 class NODE
 {
@@ -144,6 +148,17 @@ public:
     NODE();
     ~NODE();
 
+    ///> Branches come from a POOL, they are created and destroyed on each mouse move
+    static void* operator new( size_t aSize )
+    {
+        return POOL<NODE>::Alloc( aSize );
+    }
+
+    static void operator delete( void* aPtr, size_t aSize )
+    {
+        POOL<NODE>::Free( aPtr, aSize );
+    }
+
     ///> Returns the expected clearance between items a and b.
     int GetClearance( const ITEM* aA, const ITEM* aB ) const;
 
@@ -407,6 +422,16 @@ public:
 
     ITEM* FindItemByParent( const BOARD_CONNECTED_ITEM* aParent );
 
+    ///> looks for the item of aParent in all the nets. Slower than FindItemByParent(),
+    ///> but it finds the items whose parent has been moved to another net.
+    ITEM* FindItemByParentInAllNets( const BOARD_CONNECTED_ITEM* aParent );
+
+    ///> returns the number of items stored in this branch
+    int ItemCount() const;
+
+    ///> returns the number of collision queries run on all the nodes so far
+    static uint64_t QueryCount();
+
     bool HasChildren() const
     {
         return !m_children.empty();
@@ -0,0 +1,113 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PNS_POOL_H
+#define __PNS_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace PNS {
+
+/**
+ * Class POOL
+ *
+ * Fixed size memory blocks for the objects of type T that the router creates and
+ * destroys on each mouse move (segments, vias, branches).  Freed blocks are kept in a
+ * free list and reused by the next allocation, instead of going through the heap.
+ *
+ * The blocks are allocated by chunks, which are never returned to the system: the pool
+ * keeps the peak number of objects.  Each thread has its own free list, so the threads
+ * running the walkaround and shove attempts do not lock each other.  A block freed by
+ * another thread than the one which allocated it moves to the free list of that thread.
+ *
+ * The classes use it through their operator new and delete.  Objects of derived classes
+ * have a different size, and are allocated on the heap.
+ */
+template <class T>
+class POOL
+{
+public:
+    static void* Alloc( size_t aSize )
+    {
+        if( aSize != sizeof( T ) )
+            return ::operator new( aSize );
+
+        BLOCK*& freeList = freeBlocks();
+
+        if( !freeList )
+            freeList = allocChunk();
+
+        BLOCK* block = freeList;
+        freeList = block->m_next;
+
+        return block;
+    }
+
+    static void Free( void* aPtr, size_t aSize )
+    {
+        if( !aPtr )
+            return;
+
+        if( aSize != sizeof( T ) )
+        {
+            ::operator delete( aPtr );
+            return;
+        }
+
+        BLOCK* block = static_cast<BLOCK*>( aPtr );
+        BLOCK*& freeList = freeBlocks();
+
+        block->m_next = freeList;
+        freeList = block;
+    }
+
+private:
+    union BLOCK
+    {
+        BLOCK* m_next;
+        typename std::aligned_storage<sizeof( T ), alignof( T )>::type m_storage;
+    };
+
+    ///> Number of blocks allocated at once when the free list is empty
+    static const int ChunkSize = 256;
+
+    static BLOCK*& freeBlocks()
+    {
+        static thread_local BLOCK* freeList = nullptr;
+        return freeList;
+    }
+
+    static BLOCK* allocChunk()
+    {
+        BLOCK* chunk = new BLOCK[ChunkSize];
+
+        for( int i = 0; i < ChunkSize - 1; i++ )
+            chunk[i].m_next = &chunk[i + 1];
+
+        chunk[ChunkSize - 1].m_next = nullptr;
+
+        return chunk;
+    }
+};
+
+}
+
+#endif
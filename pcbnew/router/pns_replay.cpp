@@ -0,0 +1,317 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <wx/intl.h>
+#include <wx/tokenzr.h>
+
+#include <profile.h>
+#include <class_board.h>
+
+#include "pns_replay.h"
+#include "pns_kicad_iface.h"
+#include "pns_router.h"
+#include "pns_item.h"
+#include "pns_itemset.h"
+#include "pns_node.h"
+
+namespace PNS {
+
+// The keywords of the events in the replay files, in the order of REPLAY_EVENT::TYPE
+static const char* eventNames[REPLAY_EVENT::TYPE_COUNT] =
+{
+    "mode", "sizes", "start", "move", "fix", "drag", "stop", "layer", "via", "posture"
+};
+
+// The number of arguments following the item of each event type
+static const unsigned eventArgCount[REPLAY_EVENT::TYPE_COUNT] =
+{
+    2, 5, 1, 0, 0, 0, 0, 1, 0, 0
+};
+
+
+void REPLAY_EVENT::SetItem( const ITEM* aItem )
+{
+    m_itemKind = aItem ? aItem->Kind() : 0;
+    m_itemNet = aItem ? aItem->Net() : 0;
+    m_itemLayer = aItem ? aItem->Layers().Start() : 0;
+}
+
+
+REPLAY_RECORDER::REPLAY_RECORDER( const wxString& aFileName ) :
+    m_file( aFileName, "a" )
+{
+}
+
+
+void REPLAY_RECORDER::Record( const REPLAY_EVENT& aEvent )
+{
+    // Each line is: name x y item_kind item_net item_layer [args]
+    wxString line = wxString::Format( "%s %d %d %d %d %d", eventNames[aEvent.m_type],
+                                      aEvent.m_pos.x, aEvent.m_pos.y,
+                                      aEvent.m_itemKind, aEvent.m_itemNet, aEvent.m_itemLayer );
+
+    for( int arg : aEvent.m_args )
+        line << " " << arg;
+
+    line << "\n";
+
+    m_file.Write( line );
+
+    // Keep the session if pcbnew crashes
+    m_file.Flush();
+}
+
+
+REPLAY::REPLAY() :
+    m_failures( 0 )
+{
+}
+
+
+bool REPLAY::Load( const wxString& aFileName )
+{
+    wxFFile file( aFileName, "r" );
+    wxString content;
+
+    if( !file.IsOpened() || !file.ReadAll( &content ) )
+    {
+        m_error.Printf( _( "Cannot read the replay file '%s'" ), aFileName );
+        return false;
+    }
+
+    m_events.clear();
+
+    wxStringTokenizer lines( content, "\n" );
+    int lineNumber = 0;
+
+    while( lines.HasMoreTokens() )
+    {
+        wxString line = lines.GetNextToken().Trim().Trim( false );
+        lineNumber++;
+
+        if( line.IsEmpty() || line[0] == '#' )
+            continue;
+
+        wxStringTokenizer tokens( line, " \t" );
+        wxString name = tokens.GetNextToken();
+
+        int type = 0;
+
+        while( type < REPLAY_EVENT::TYPE_COUNT && name != eventNames[type] )
+            type++;
+
+        std::vector<long> values;
+        bool valid = type < REPLAY_EVENT::TYPE_COUNT;
+
+        while( valid && tokens.HasMoreTokens() )
+        {
+            long value;
+            valid = tokens.GetNextToken().ToLong( &value );
+            values.push_back( value );
+        }
+
+        if( !valid || values.size() != 5 + eventArgCount[type] )
+        {
+            m_error.Printf( _( "Invalid event in '%s', line %d" ), aFileName, lineNumber );
+            return false;
+        }
+
+        REPLAY_EVENT event( (REPLAY_EVENT::TYPE) type, VECTOR2I( values[0], values[1] ) );
+        event.m_itemKind = values[2];
+        event.m_itemNet = values[3];
+        event.m_itemLayer = values[4];
+        event.m_args.assign( values.begin() + 5, values.end() );
+
+        m_events.push_back( event );
+    }
+
+    return true;
+}
+
+
+/**
+ * Function findItem
+ * looks for the item of an event under the event position, like the routing tools do.
+ */
+static ITEM* findItem( ROUTER& aRouter, const REPLAY_EVENT& aEvent )
+{
+    // The dragger ignores the items, and has no placer to query
+    if( !aEvent.m_itemKind || ( aRouter.RoutingInProgress() && !aRouter.Placer() ) )
+        return NULL;
+
+    ITEM_SET candidates = aRouter.QueryHoverItems( aEvent.m_pos );
+
+    for( ITEM* item : candidates.Items() )
+    {
+        if( item->Kind() == aEvent.m_itemKind && item->Net() == aEvent.m_itemNet
+                && item->Layers().Overlaps( aEvent.m_itemLayer ) )
+            return item;
+    }
+
+    return NULL;
+}
+
+
+/**
+ * Function runEvent
+ * makes the router call of an event.
+ * @return false if the router refused to start routing or dragging.
+ */
+static bool runEvent( ROUTER& aRouter, SIZES_SETTINGS& aSizes, const REPLAY_EVENT& aEvent )
+{
+    ITEM* item = findItem( aRouter, aEvent );
+
+    switch( aEvent.m_type )
+    {
+    case REPLAY_EVENT::MODE:
+        aRouter.SetMode( (ROUTER_MODE) aEvent.m_args[0] );
+        aRouter.Settings().SetMode( (PNS_MODE) aEvent.m_args[1] );
+        break;
+
+    case REPLAY_EVENT::SIZES:
+        aSizes.SetTrackWidth( aEvent.m_args[0] );
+        aSizes.SetViaDiameter( aEvent.m_args[1] );
+        aSizes.SetViaDrill( aEvent.m_args[2] );
+        aSizes.SetDiffPairWidth( aEvent.m_args[3] );
+        aSizes.SetDiffPairGap( aEvent.m_args[4] );
+        aRouter.UpdateSizes( aSizes );
+        break;
+
+    case REPLAY_EVENT::START:
+        return aRouter.StartRouting( aEvent.m_pos, item, aEvent.m_args[0] );
+
+    case REPLAY_EVENT::MOVE:
+        aRouter.Move( aEvent.m_pos, item );
+        break;
+
+    case REPLAY_EVENT::FIX:
+        aRouter.FixRoute( aEvent.m_pos, item );
+        break;
+
+    case REPLAY_EVENT::DRAG:
+        return aRouter.StartDragging( aEvent.m_pos, item );
+
+    case REPLAY_EVENT::STOP:
+        aRouter.StopRouting();
+        break;
+
+    case REPLAY_EVENT::LAYER:
+        aRouter.SwitchLayer( aEvent.m_args[0] );
+        break;
+
+    case REPLAY_EVENT::VIA:
+        aRouter.ToggleViaPlacement();
+        break;
+
+    case REPLAY_EVENT::POSTURE:
+        aRouter.FlipPosture();
+        break;
+
+    default:
+        break;
+    }
+
+    return true;
+}
+
+
+void REPLAY::Run( BOARD* aBoard, int aRepeat )
+{
+    for( int pass = 0; pass < aRepeat; pass++ )
+    {
+        // Each pass starts from the board, which is never modified
+        PNS_KICAD_IFACE iface;
+        iface.SetBoard( aBoard );
+
+        ROUTER router;
+        router.SetInterface( &iface );
+        router.SyncWorld();
+
+        SIZES_SETTINGS sizes;
+        sizes.Init( aBoard );
+        router.UpdateSizes( sizes );
+
+        for( const REPLAY_EVENT& event : m_events )
+        {
+            uint64_t queries = NODE::QueryCount();
+            PROF_COUNTER counter;
+
+            if( !runEvent( router, sizes, event ) )
+                m_failures++;
+
+            double latency = counter.msecs();
+
+            m_stats[event.m_type].m_latency.push_back( latency );
+            m_stats[event.m_type].m_queries.push_back( NODE::QueryCount() - queries );
+        }
+
+        if( router.RoutingInProgress() )
+            router.StopRouting();
+    }
+}
+
+
+/**
+ * Function percentile
+ * @return the value below which aPercent percents of the sorted values fall.
+ */
+static double percentile( const std::vector<double>& aSorted, int aPercent )
+{
+    size_t index = ( ( aSorted.size() - 1 ) * aPercent + 50 ) / 100;
+    return aSorted[index];
+}
+
+
+wxString REPLAY::Report() const
+{
+    wxString report;
+
+    report << wxString::Format( "%-8s %8s %10s %10s %10s %10s %12s\n", "event", "count",
+                                "p50 ms", "p90 ms", "p99 ms", "max ms", "queries/ev" );
+
+    for( int type = 0; type < REPLAY_EVENT::TYPE_COUNT; type++ )
+    {
+        const STATS& stats = m_stats[type];
+
+        if( stats.m_latency.empty() )
+            continue;
+
+        std::vector<double> sorted( stats.m_latency );
+        std::sort( sorted.begin(), sorted.end() );
+
+        uint64_t queries = 0;
+
+        for( uint64_t count : stats.m_queries )
+            queries += count;
+
+        report << wxString::Format( "%-8s %8u %10.3f %10.3f %10.3f %10.3f %12.1f\n",
+                                    eventNames[type], (unsigned) sorted.size(),
+                                    percentile( sorted, 50 ), percentile( sorted, 90 ),
+                                    percentile( sorted, 99 ), sorted.back(),
+                                    (double) queries / sorted.size() );
+    }
+
+    report << wxString::Format( "%d events failed\n", m_failures );
+
+    return report;
+}
+
+}
@@ -0,0 +1,157 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PNS_REPLAY_H
+#define __PNS_REPLAY_H
+
+#include <vector>
+#include <cstdint>
+
+#include <wx/string.h>
+#include <wx/ffile.h>
+
+#include <math/vector2d.h>
+
+class BOARD;
+
+/// Environment variable giving the file where the router sessions are recorded.
+#define PNS_RECORD_ENV    wxT( "KICAD_PNS_RECORD" )
+
+namespace PNS {
+
+class ITEM;
+
+/**
+ * Struct REPLAY_EVENT
+ *
+ * One call made by a routing tool to the router.  The items passed to the router are
+ * stored by their kind, net and layer, and looked up again under the event position
+ * when the event is replayed.
+ */
+struct REPLAY_EVENT
+{
+    enum TYPE
+    {
+        MODE = 0,       ///< router mode and routing mode (shove, walkaround...)
+        SIZES,          ///< track width, via diameter and drill, diff pair width and gap
+        START,          ///< StartRouting() on a layer
+        MOVE,           ///< Move()
+        FIX,            ///< FixRoute()
+        DRAG,           ///< StartDragging()
+        STOP,           ///< StopRouting()
+        LAYER,          ///< SwitchLayer()
+        VIA,            ///< ToggleViaPlacement()
+        POSTURE,        ///< FlipPosture()
+        TYPE_COUNT
+    };
+
+    REPLAY_EVENT( TYPE aType = STOP, const VECTOR2I& aPos = VECTOR2I( 0, 0 ) ) :
+        m_type( aType ),
+        m_pos( aPos ),
+        m_itemKind( 0 ),
+        m_itemNet( 0 ),
+        m_itemLayer( 0 )
+    {}
+
+    ///> Stores the reference of the item passed to the router (can be NULL).
+    void SetItem( const ITEM* aItem );
+
+    TYPE             m_type;
+    VECTOR2I         m_pos;
+    std::vector<int> m_args;
+    int              m_itemKind;
+    int              m_itemNet;
+    int              m_itemLayer;
+};
+
+
+/**
+ * Class REPLAY_RECORDER
+ *
+ * Appends the events of the routing sessions to a text file, one event per line, in the
+ * format read by REPLAY::Load().
+ */
+class REPLAY_RECORDER
+{
+public:
+    REPLAY_RECORDER( const wxString& aFileName );
+
+    bool IsOpened() const
+    {
+        return m_file.IsOpened();
+    }
+
+    void Record( const REPLAY_EVENT& aEvent );
+
+private:
+    wxFFile m_file;
+};
+
+
+/**
+ * Class REPLAY
+ *
+ * Replays recorded routing sessions on a board, without any view or frame, and measures
+ * the latency and the number of collision queries of each router event.  The board
+ * itself is not modified: the routed tracks are only committed to the router world.
+ */
+class REPLAY
+{
+public:
+    REPLAY();
+
+    /**
+     * Function Load()
+     * reads the events recorded by REPLAY_RECORDER.
+     * @return false if the file cannot be read, see Error().
+     */
+    bool Load( const wxString& aFileName );
+
+    /**
+     * Function Run()
+     * replays the loaded events on aBoard, aRepeat times, and accumulates the
+     * statistics of each event type.
+     */
+    void Run( BOARD* aBoard, int aRepeat = 1 );
+
+    ///> Returns the latency percentiles and collision query counts of each event type.
+    wxString Report() const;
+
+    const wxString& Error() const
+    {
+        return m_error;
+    }
+
+private:
+    ///> The measures of one event type
+    struct STATS
+    {
+        std::vector<double>   m_latency;    ///< milliseconds
+        std::vector<uint64_t> m_queries;
+    };
+
+    std::vector<REPLAY_EVENT> m_events;
+    STATS m_stats[REPLAY_EVENT::TYPE_COUNT];
+    int m_failures;
+    wxString m_error;
+};
+
+}
+
+#endif
@@ -133,6 +133,9 @@ const ITEM_SET ROUTER::QueryHoverItems( const VECTOR2I& aP )
 
 bool ROUTER::StartDragging( const VECTOR2I& aP, ITEM* aStartItem )
 {
+    recordSettings();
+    record( REPLAY_EVENT::DRAG, aP, aStartItem );
+
     if( !aStartItem || aStartItem->OfKind( ITEM::SOLID_T ) )
         return false;
 
@@ -155,6 +158,9 @@ bool ROUTER::StartDragging( const VECTOR2I& aP, ITEM* aStartItem )
 
 bool ROUTER::StartRouting( const VECTOR2I& aP, ITEM* aStartItem, int aLayer )
 {
+    recordSettings();
+    record( REPLAY_EVENT::START, aP, aStartItem, { aLayer } );
+
     switch( m_mode )
     {
         case PNS_MODE_ROUTE_SINGLE:
@@ -201,6 +207,8 @@ void ROUTER::DisplayItems( const ITEM_SET& aItems )
 
 void ROUTER::Move( const VECTOR2I& aP, ITEM* endItem )
 {
+    record( REPLAY_EVENT::MOVE, aP, endItem );
+
     m_currentEnd = aP;
 
     switch( m_state )
@@ -342,6 +350,8 @@ bool ROUTER::FixRoute( const VECTOR2I& aP, ITEM* aEndItem )
 {
     bool rv = false;
 
+    record( REPLAY_EVENT::FIX, aP, aEndItem );
+
     switch( m_state )
     {
     case ROUTE_TRACK:
@@ -357,13 +367,20 @@ bool ROUTER::FixRoute( const VECTOR2I& aP, ITEM* aEndItem )
     }
 
     if( rv )
-       StopRouting();
+       stopRouting();
 
     return rv;
 }
 
 
 void ROUTER::StopRouting()
+{
+    record( REPLAY_EVENT::STOP );
+    stopRouting();
+}
+
+
+void ROUTER::stopRouting()
 {
     // Update the ratsnest with new changes
 
@@ -393,6 +410,8 @@ void ROUTER::StopRouting()
 
 void ROUTER::FlipPosture()
 {
+    record( REPLAY_EVENT::POSTURE );
+
     if( m_state == ROUTE_TRACK )
     {
         m_placer->FlipPosture();
@@ -402,6 +421,8 @@ void ROUTER::FlipPosture()
 
 void ROUTER::SwitchLayer( int aLayer )
 {
+    record( REPLAY_EVENT::LAYER, m_currentEnd, NULL, { aLayer } );
+
     switch( m_state )
     {
     case ROUTE_TRACK:
@@ -415,6 +436,8 @@ void ROUTER::SwitchLayer( int aLayer )
 
 void ROUTER::ToggleViaPlacement()
 {
+    record( REPLAY_EVENT::VIA );
+
     if( m_state == ROUTE_TRACK )
     {
         bool toggle = !m_placer->IsPlacingVia();
@@ -440,6 +463,41 @@ int ROUTER::GetCurrentLayer() const
 }
 
 
+void ROUTER::RecordSession( const wxString& aFileName )
+{
+    m_recorder.reset( new REPLAY_RECORDER( aFileName ) );
+
+    if( !m_recorder->IsOpened() )
+    {
+        wxLogTrace( "PNS", "Cannot record the router session in %s", aFileName );
+        m_recorder.reset();
+    }
+}
+
+
+void ROUTER::record( REPLAY_EVENT::TYPE aType, const VECTOR2I& aP, const ITEM* aItem,
+                     const std::vector<int>& aArgs )
+{
+    if( !m_recorder )
+        return;
+
+    REPLAY_EVENT event( aType, aP );
+    event.SetItem( aItem );
+    event.m_args = aArgs;
+
+    m_recorder->Record( event );
+}
+
+
+void ROUTER::recordSettings()
+{
+    record( REPLAY_EVENT::MODE, VECTOR2I( 0, 0 ), NULL, { m_mode, m_settings.Mode() } );
+    record( REPLAY_EVENT::SIZES, VECTOR2I( 0, 0 ), NULL,
+            { m_sizes.TrackWidth(), m_sizes.ViaDiameter(), m_sizes.ViaDrill(),
+              m_sizes.DiffPairWidth(), m_sizes.DiffPairGap() } );
+}
+
+
 void ROUTER::DumpLog()
 {
     LOGGER* logger = nullptr;
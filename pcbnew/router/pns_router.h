@@ -35,6 +35,7 @@
 #include "pns_item.h"
 #include "pns_itemset.h"
 #include "pns_node.h"
+#include "pns_replay.h"
 
 namespace KIGFX
 {
@@ -211,7 +212,22 @@ public:
         return m_iface;
     }
 
+    /**
+     * Function RecordSession()
+     * appends the calls made to the router to a file, to replay them with REPLAY.
+     */
+    void RecordSession( const wxString& aFileName );
+
 private:
+    void stopRouting();
+
+    ///> Records a call made to the router, if the session is recorded
+    void record( REPLAY_EVENT::TYPE aType, const VECTOR2I& aP = VECTOR2I( 0, 0 ),
+                 const ITEM* aItem = NULL, const std::vector<int>& aArgs = std::vector<int>() );
+
+    ///> Records the router mode and sizes used by the next routing
+    void recordSettings();
+
     void movePlacing( const VECTOR2I& aP, ITEM* aItem );
     void moveDragging( const VECTOR2I& aP, ITEM* aItem );
 
@@ -241,6 +257,7 @@ private:
     RouterState m_state;
 
     std::unique_ptr< NODE > m_world;
+    std::unique_ptr< REPLAY_RECORDER > m_recorder;
     NODE*                   m_lastNode;
 
     std::unique_ptr< PLACEMENT_ALGO > m_placer;
@@ -30,6 +30,7 @@
 
 #include "pns_item.h"
 #include "pns_line.h"
+#include "pns_pool.h"
 
 namespace PNS {
 
@@ -58,6 +59,17 @@ public:
         m_rank = aParentLine.Rank();
     }
 
+    ///> Segments come from a POOL, they are created and destroyed on each mouse move
+    static void* operator new( size_t aSize )
+    {
+        return POOL<SEGMENT>::Alloc( aSize );
+    }
+
+    static void operator delete( void* aPtr, size_t aSize )
+    {
+        POOL<SEGMENT>::Free( aPtr, aSize );
+    }
+
     static inline bool ClassOf( const ITEM* aItem )
     {
         return aItem && SEGMENT_T == aItem->Kind();
@@ -158,98 +158,137 @@ SHOVE::SHOVE_STATUS SHOVE::walkaroundLoneVia( LINE& aCurrent, LINE& aObstacle,
 }
 
 
-SHOVE::SHOVE_STATUS SHOVE::processHullSet( LINE& aCurrent, LINE& aObstacle,
-                                                   LINE& aShoved, const HULL_SET& aHulls )
+SHOVE::SHOVE_STATUS SHOVE::shoveHullSetAttempt( int aAttempt, const LINE& aCurrent,
+                                                const LINE& aObstacle, const HULL_SET& aHulls,
+                                                SHAPE_LINE_CHAIN& aPath, bool& aWrongDirection )
 {
     const SHAPE_LINE_CHAIN& obs = aObstacle.CLine();
 
-    int attempt;
+    bool invertTraversal = ( aAttempt >= 2 );
+    bool clockwise = aAttempt % 2;
+    int vFirst = -1, vLast = -1;
 
-    for( attempt = 0; attempt < 4; attempt++ )
-    {
-        bool invertTraversal = ( attempt >= 2 );
-        bool clockwise = attempt % 2;
-        int vFirst = -1, vLast = -1;
+    SHAPE_LINE_CHAIN path;
+    LINE l( aObstacle );
 
-        SHAPE_LINE_CHAIN path;
-        LINE l( aObstacle );
+    aWrongDirection = false;
 
-        for( int i = 0; i < (int) aHulls.size(); i++ )
-        {
-            const SHAPE_LINE_CHAIN& hull = aHulls[invertTraversal ? aHulls.size() - 1 - i : i];
+    for( int i = 0; i < (int) aHulls.size(); i++ )
+    {
+        const SHAPE_LINE_CHAIN& hull = aHulls[invertTraversal ? aHulls.size() - 1 - i : i];
 
-            l.Walkaround( hull, path, clockwise );
-            path.Simplify();
-            l.SetShape( path );
-        }
+        l.Walkaround( hull, path, clockwise );
+        path.Simplify();
+        l.SetShape( path );
+    }
 
-        for( int i = 0; i < std::min( path.PointCount(), obs.PointCount() ); i++ )
+    for( int i = 0; i < std::min( path.PointCount(), obs.PointCount() ); i++ )
+    {
+        if( path.CPoint( i ) != obs.CPoint( i ) )
         {
-            if( path.CPoint( i ) != obs.CPoint( i ) )
-            {
-                vFirst = i;
-                break;
-            }
+            vFirst = i;
+            break;
         }
+    }
 
-        int k = obs.PointCount() - 1;
-        for( int i = path.PointCount() - 1; i >= 0 && k >= 0; i--, k-- )
+    int k = obs.PointCount() - 1;
+    for( int i = path.PointCount() - 1; i >= 0 && k >= 0; i--, k-- )
+    {
+        if( path.CPoint( i ) != obs.CPoint( k ) )
         {
-            if( path.CPoint( i ) != obs.CPoint( k ) )
-            {
-                vLast = i;
-                break;
-            }
+            vLast = i;
+            break;
         }
+    }
 
-        if( ( vFirst < 0 || vLast < 0 ) && !path.CompareGeometry( aObstacle.CLine() ) )
-        {
-            wxLogTrace( "PNS", "attempt %d fail vfirst-last", attempt );
-            continue;
-        }
+    if( ( vFirst < 0 || vLast < 0 ) && !path.CompareGeometry( aObstacle.CLine() ) )
+    {
+        wxLogTrace( "PNS", "attempt %d fail vfirst-last", aAttempt );
+        return SH_INCOMPLETE;
+    }
 
-        if( path.CPoint( -1 ) != obs.CPoint( -1 ) || path.CPoint( 0 ) != obs.CPoint( 0 ) )
-        {
-            wxLogTrace( "PNS", "attempt %d fail vend-start\n", attempt );
-            continue;
-        }
+    if( path.CPoint( -1 ) != obs.CPoint( -1 ) || path.CPoint( 0 ) != obs.CPoint( 0 ) )
+    {
+        wxLogTrace( "PNS", "attempt %d fail vend-start\n", aAttempt );
+        return SH_INCOMPLETE;
+    }
 
-        if( !checkBumpDirection( aCurrent, l ) )
-        {
-            wxLogTrace( "PNS", "attempt %d fail direction-check", attempt );
-            aShoved.SetShape( l.CLine() );
+    if( !checkBumpDirection( aCurrent, l ) )
+    {
+        wxLogTrace( "PNS", "attempt %d fail direction-check", aAttempt );
+        aPath = l.CLine();
+        aWrongDirection = true;
+        return SH_INCOMPLETE;
+    }
 
-            continue;
-        }
+    if( path.SelfIntersecting() )
+    {
+        wxLogTrace( "PNS", "attempt %d fail self-intersect", aAttempt );
+        return SH_INCOMPLETE;
+    }
 
-        if( path.SelfIntersecting() )
+    bool colliding = m_currentNode->CheckColliding( &l, &aCurrent, ITEM::ANY_T, m_forceClearance );
+
+    if( ( aCurrent.Marker() & MK_HEAD ) && !colliding )
+    {
+        JOINT* jtStart = m_currentNode->FindJoint( aCurrent.CPoint( 0 ), &aCurrent );
+
+        for( ITEM* item : jtStart->LinkList() )
         {
-            wxLogTrace( "PNS", "attempt %d fail self-intersect", attempt );
-            continue;
+            if( m_currentNode->CheckColliding( item, &l ) )
+                colliding = true;
         }
+    }
 
-        bool colliding = m_currentNode->CheckColliding( &l, &aCurrent, ITEM::ANY_T, m_forceClearance );
+    if( colliding )
+    {
+        wxLogTrace( "PNS", "attempt %d fail coll-check", aAttempt );
+        return SH_INCOMPLETE;
+    }
 
-        if( ( aCurrent.Marker() & MK_HEAD ) && !colliding )
-        {
-            JOINT* jtStart = m_currentNode->FindJoint( aCurrent.CPoint( 0 ), &aCurrent );
+    aPath = l.CLine();
 
-            for( ITEM* item : jtStart->LinkList() )
-            {
-                if( m_currentNode->CheckColliding( item, &l ) )
-                    colliding = true;
-            }
-        }
+    return SH_OK;
+}
 
-        if( colliding )
+
+SHOVE::SHOVE_STATUS SHOVE::processHullSet( LINE& aCurrent, LINE& aObstacle,
+                                                   LINE& aShoved, const HULL_SET& aHulls )
+{
+    const int attemptCount = 4;
+
+    SHOVE_STATUS status[attemptCount];
+    SHAPE_LINE_CHAIN path[attemptCount];
+    bool wrongDirection[attemptCount];
+
+#ifdef USE_OPENMP
+    // The attempts only read the current node, so they are evaluated concurrently.
+    // The result is the same as if they were tried one after another: the first
+    // successful attempt wins.
+    #pragma omp parallel for schedule( static, 1 )
+    for( int attempt = 0; attempt < attemptCount; attempt++ )
+    {
+        status[attempt] = shoveHullSetAttempt( attempt, aCurrent, aObstacle, aHulls,
+                                               path[attempt], wrongDirection[attempt] );
+    }
+#endif
+
+    for( int attempt = 0; attempt < attemptCount; attempt++ )
+    {
+#ifndef USE_OPENMP
+        // Without threads, the next attempts are not computed once one succeeds
+        status[attempt] = shoveHullSetAttempt( attempt, aCurrent, aObstacle, aHulls,
+                                               path[attempt], wrongDirection[attempt] );
+#endif
+
+        if( status[attempt] == SH_OK )
         {
-            wxLogTrace( "PNS", "attempt %d fail coll-check", attempt );
-            continue;
+            aShoved.SetShape( path[attempt] );
+            return SH_OK;
         }
 
-        aShoved.SetShape( l.CLine() );
-
-        return SH_OK;
+        if( wrongDirection[attempt] )
+            aShoved.SetShape( path[attempt] );
     }
 
     return SH_INCOMPLETE;
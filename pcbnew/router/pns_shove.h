@@ -105,6 +105,12 @@ private:
     SHOVE_STATUS processHullSet( LINE& aCurrent, LINE& aObstacle,
                                  LINE& aShoved, const HULL_SET& hulls );
 
+    ///> Walks aObstacle around the hulls, in the direction given by aAttempt (0 to 3).
+    ///> aWrongDirection is set if the path is valid, but bumps aCurrent the wrong way.
+    SHOVE_STATUS shoveHullSetAttempt( int aAttempt, const LINE& aCurrent, const LINE& aObstacle,
+                                      const HULL_SET& aHulls, SHAPE_LINE_CHAIN& aPath,
+                                      bool& aWrongDirection );
+
     bool reduceSpringback( const ITEM_SET& aHeadItems );
     bool pushSpringback( NODE* aNode, const ITEM_SET& aHeadItems,
                                 const COST_ESTIMATOR& aCost, const OPT_BOX2I& aAffectedArea );
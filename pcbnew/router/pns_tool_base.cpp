@@ -98,6 +98,28 @@ TOOL_BASE::~TOOL_BASE()
 
 void TOOL_BASE::Reset( RESET_REASON aReason )
 {
+    // The router world is kept when the tool is started again on the same board,
+    // as it is updated by the commits
+    if( aReason == RUN && m_router && m_board == getModel<BOARD>() && !m_iface->WorldNeedsSync() )
+    {
+        m_frame = getEditFrame<PCB_EDIT_FRAME>();
+        m_ctls = getViewControls();
+        m_iface->SetHostFrame( m_frame );
+
+#ifdef DEBUG
+        if( !m_iface->CheckWorld() )
+        {
+            wxFAIL_MSG( "The router world does not match the board" );
+            m_router->SyncWorld();
+        }
+#endif
+
+        m_iface->UpdateRules( m_router->GetWorld() );
+        m_router->LoadSettings( m_savedSettings );
+        m_router->UpdateSizes( m_savedSizes );
+        return;
+    }
+
     delete m_gridHelper;
     delete m_iface;
     delete m_router;
@@ -118,6 +140,11 @@ void TOOL_BASE::Reset( RESET_REASON aReason )
     m_router->LoadSettings( m_savedSettings );
     m_router->UpdateSizes( m_savedSizes );
 
+    wxString recordFile;
+
+    if( wxGetEnv( PNS_RECORD_ENV, &recordFile ) )
+        m_router->RecordSession( recordFile );
+
     m_gridHelper = new GRID_HELPER( m_frame );
 }
 
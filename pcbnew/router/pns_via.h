@@ -28,6 +28,7 @@
 #include "../class_track.h"
 
 #include "pns_item.h"
+#include "pns_pool.h"
 
 namespace PNS {
 
@@ -79,6 +80,17 @@ public:
         m_viaType = aB.m_viaType;
     }
 
+    ///> Vias come from a POOL, they are created and destroyed on each mouse move
+    static void* operator new( size_t aSize )
+    {
+        return POOL<VIA>::Alloc( aSize );
+    }
+
+    static void operator delete( void* aPtr, size_t aSize )
+    {
+        POOL<VIA>::Free( aPtr, aSize );
+    }
+
     static inline bool ClassOf( const ITEM* aItem )
     {
         return aItem && VIA_T == aItem->Kind();
@@ -31,6 +31,10 @@ using boost::optional;
 
 namespace PNS {
 
+// The walked paths having fewer segments are stepped in a single thread, see Route()
+static const int PARALLEL_STEP_MIN_SEGMENTS = 64;
+
+
 void WALKAROUND::start( const LINE& aInitialPath )
 {
     m_iteration = 0;
@@ -59,6 +63,7 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath,
         aWindingDirection ? m_currentObstacle[0] : m_currentObstacle[1];
 
     bool& prev_recursive = aWindingDirection ? m_recursiveCollision[0] : m_recursiveCollision[1];
+    int& blockage_count = aWindingDirection ? m_recursiveBlockageCount[0] : m_recursiveBlockageCount[1];
 
     if( !current_obs )
         return DONE;
@@ -69,9 +74,9 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath,
 
     if( ( current_obs->m_hull ).PointInside( last ) || ( current_obs->m_hull ).PointOnEdge( last ) )
     {
-        m_recursiveBlockageCount++;
+        blockage_count++;
 
-        if( m_recursiveBlockageCount < 3 )
+        if( blockage_count < 3 )
             aPath.Line().Append( current_obs->m_hull.NearestPoint( last ) );
         else
         {
@@ -86,12 +91,17 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath,
                       path_post[1], !aWindingDirection );
 
 #ifdef DEBUG
-    m_logger.NewGroup( aWindingDirection ? "walk-cw" : "walk-ccw", m_iteration );
-    m_logger.Log( &path_walk[0], 0, "path-walk" );
-    m_logger.Log( &path_pre[0], 1, "path-pre" );
-    m_logger.Log( &path_post[0], 4, "path-post" );
-    m_logger.Log( &current_obs->m_hull, 2, "hull" );
-    m_logger.Log( current_obs->m_item, 3, "item" );
+#ifdef USE_OPENMP
+    #pragma omp critical( walkaroundLogger )
+#endif
+    {
+        m_logger.NewGroup( aWindingDirection ? "walk-cw" : "walk-ccw", m_iteration );
+        m_logger.Log( &path_walk[0], 0, "path-walk" );
+        m_logger.Log( &path_pre[0], 1, "path-pre" );
+        m_logger.Log( &path_post[0], 4, "path-post" );
+        m_logger.Log( &current_obs->m_hull, 2, "hull" );
+        m_logger.Log( current_obs->m_item, 3, "item" );
+    }
 #endif
 
     int len_pre = path_walk[0].Length();
@@ -162,7 +172,7 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::Route( const LINE& aInitialPath,
     start( aInitialPath );
 
     m_currentObstacle[0] = m_currentObstacle[1] = nearestObstacle( aInitialPath );
-    m_recursiveBlockageCount = 0;
+    m_recursiveBlockageCount[0] = m_recursiveBlockageCount[1] = 0;
 
     aWalkPath = aInitialPath;
 
@@ -175,13 +185,26 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::Route( const LINE& aInitialPath,
         m_forceSingleDirection = false;
     }
 
+    LINE* paths[2] = { &path_cw, &path_ccw };
+    WALKAROUND_STATUS* status[2] = { &s_cw, &s_ccw };
+
     while( m_iteration < m_iterationLimit )
     {
-        if( s_cw != STUCK )
-            s_cw = singleStep( path_cw, true );
-
-        if( s_ccw != STUCK )
-            s_ccw = singleStep( path_ccw, false );
+        // The directions are independent, and only read the world.  Both steps are
+        // finished before the results are compared, so the chosen path does not depend
+        // on the thread scheduling.  Starting the threads costs more than a step on a
+        // short path, so only long paths walked in both directions are stepped in parallel.
+#ifdef USE_OPENMP
+        bool parallelStep = s_cw != STUCK && s_ccw != STUCK
+                && path_cw.SegmentCount() + path_ccw.SegmentCount() >= PARALLEL_STEP_MIN_SEGMENTS;
+
+        #pragma omp parallel for num_threads( 2 ) if( parallelStep )
+#endif
+        for( int i = 0; i < 2; i++ )
+        {
+            if( *status[i] != STUCK )
+                *status[i] = singleStep( *paths[i], i == 0 );
+        }
 
         if( ( s_cw == DONE && s_ccw == DONE ) || ( s_cw == STUCK && s_ccw == STUCK ) )
         {
@@ -32,6 +32,13 @@
 
 namespace PNS {
 
+/**
+ * Class WALKAROUND
+ *
+ * Walks a line around the obstacles of a node. Both winding directions are walked
+ * step by step, concurrently when OpenMP is available: they only read the world node,
+ * and each one has its own state.
+ */
 class WALKAROUND : public ALGO_BASE
 {
     static const int DefaultIterationLimit = 50;
@@ -49,7 +56,7 @@ public:
         m_itemMask = ITEM::ANY_T;
 
         // Initialize other members, to avoid uninitialized variables.
-        m_recursiveBlockageCount = 0;
+        m_recursiveBlockageCount[0] = m_recursiveBlockageCount[1] = 0;
         m_recursiveCollision[0] = m_recursiveCollision[1] = false;
         m_iteration = 0;
         m_forceCw = false;
@@ -134,7 +141,7 @@ private:
 
     NODE* m_world;
 
-    int m_recursiveBlockageCount;
+    int m_recursiveBlockageCount[2];
     int m_iteration;
     int m_iterationLimit;
     int m_itemMask;
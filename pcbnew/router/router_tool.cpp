@@ -60,6 +60,7 @@ using namespace std::placeholders;
 #include "router_tool.h"
 #include "pns_segment.h"
 #include "pns_router.h"
+#include "pns_kicad_iface.h"
 
 using namespace KIGFX;
 using boost::optional;
@@ -857,10 +858,16 @@ int ROUTER_TOOL::mainLoop( PNS::ROUTER_MODE aMode )
         {
             m_router->ClearWorld();
         }
-        else if( evt->Action() == TA_UNDO_REDO_POST || evt->Action() == TA_MODEL_CHANGE )
+        else if( evt->Action() == TA_UNDO_REDO_POST )
         {
             m_router->SyncWorld();
         }
+        else if( evt->Action() == TA_MODEL_CHANGE )
+        {
+            // The commits update the world, unless they were pushed while routing
+            if( m_iface->WorldNeedsSync() )
+                m_router->SyncWorld();
+        }
         else if( evt->IsMotion() )
         {
             updateStartItem( *evt );
@@ -971,7 +978,10 @@ int ROUTER_TOOL::InlineDrag( const TOOL_EVENT& aEvent )
     Activate();
 
     m_toolMgr->RunAction( PCB_ACTIONS::selectionClear, true );
-    m_router->SyncWorld();
+
+    if( m_iface->WorldNeedsSync() )
+        m_router->SyncWorld();
+
     m_startItem = m_router->GetWorld()->FindItemByParent( item );
 
     if( m_startItem && m_startItem->IsLocked() )
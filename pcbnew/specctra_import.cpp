@@ -45,6 +45,7 @@
 #include <class_zone.h>
 #include <class_drawsegment.h>
 #include <ratsnest_data.h>
+#include <board_commit.h>
 #include <view/view.h>
 
 #include <specctra.h>
@@ -97,6 +98,9 @@ void PCB_EDIT_FRAME::ImportSpecctraSession( wxCommandEvent& event )
     SPECCTRA_DB     db;
     LOCALE_IO       toggle;
 
+    // The tracks are deleted and created again without a commit, even if the import fails
+    BOARD_COMMIT::NotifyBoardChanged( GetBoard() );
+
     try
     {
         db.LoadSESSION( fullFileName );
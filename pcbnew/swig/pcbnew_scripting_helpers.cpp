@@ -35,10 +35,17 @@
 #include <build_version.h>
 #include <class_board.h>
 #include <class_drawpanel.h>
+#include <board_commit.h>
 #include <kicad_string.h>
 #include <io_mgr.h>
 #include <macros.h>
 #include <stdlib.h>
+#include <3d_canvas/cinfo3d_visu.h>
+#include <3d_rendering/3d_render_raytracing/c3d_render_raytracing.h>
+#include <router/pns_replay.h>
+#include <pcbplot.h>
+#include <plot_job_scheduler.h>
+#include <gendrill_Excellon_writer.h>
 
 static PCB_EDIT_FRAME* PcbEditFrame = NULL;
 
@@ -88,8 +95,154 @@ bool SaveBoard( wxString& aFileName, BOARD* aBoard )
 }
 
 
+bool RenderBoard3D( BOARD* aBoard, wxString& aFileName, int aWidth, int aHeight,
+                    RENDER_3D_VIEW aView )
+{
+    if( !aBoard || aWidth <= 0 || aHeight <= 0 )
+        return false;
+
+    CINFO3D_VISU settings;
+
+    settings.SetBoard( aBoard );
+    settings.RenderEngineSet( RENDER_ENGINE_RAYTRACING );
+    settings.SetFlag( FL_RENDER_RAYTRACING_SHADOWS, true );
+    settings.SetFlag( FL_RENDER_RAYTRACING_REFRACTIONS, true );
+    settings.SetFlag( FL_RENDER_RAYTRACING_REFLECTIONS, true );
+    settings.SetFlag( FL_RENDER_RAYTRACING_POST_PROCESSING, true );
+    settings.SetFlag( FL_RENDER_RAYTRACING_ANTI_ALIASING, true );
+    settings.SetFlag( FL_RENDER_RAYTRACING_PROCEDURAL_TEXTURES, true );
+
+    // The look at position is only known after the board is loaded by the
+    // render, but it does not change the rotation set here
+    CCAMERA& camera = settings.CameraGet();
+
+    camera.Reset();
+
+    switch( aView )
+    {
+    case RENDER_3D_VIEW_TOP:
+        break;
+
+    case RENDER_3D_VIEW_BOTTOM:
+        camera.RotateX( glm::radians( -180.0f ) );
+        break;
+
+    case RENDER_3D_VIEW_FRONT:
+        camera.RotateX( glm::radians( -90.0f ) );
+        break;
+
+    case RENDER_3D_VIEW_BACK:
+        camera.RotateX( glm::radians( -90.0f ) );
+        camera.RotateZ( glm::radians( -180.0f ) );
+        break;
+
+    case RENDER_3D_VIEW_LEFT:
+        camera.RotateZ( glm::radians( -90.0f ) );
+        camera.RotateX( glm::radians( -90.0f ) );
+        break;
+
+    case RENDER_3D_VIEW_RIGHT:
+        camera.RotateZ( glm::radians( 90.0f ) );
+        camera.RotateX( glm::radians( -90.0f ) );
+        break;
+    }
+
+    C3D_RENDER_RAYTRACING render( settings );
+    wxImage image;
+
+    render.RenderToImage( wxSize( aWidth, aHeight ), image );
+
+    // Not registered when the module is loaded from a plain python interpreter
+    if( !wxImage::FindHandler( wxBITMAP_TYPE_PNG ) )
+        wxImage::AddHandler( new wxPNGHandler );
+
+    return image.SaveFile( aFileName, wxBITMAP_TYPE_PNG );
+}
+
+
+wxString ReplayRouterSession( BOARD* aBoard, wxString& aSessionFileName, int aRepeat )
+{
+    if( !aBoard || aRepeat <= 0 )
+        return wxEmptyString;
+
+    PNS::REPLAY replay;
+
+    if( !replay.Load( aSessionFileName ) )
+    {
+        wxLogError( replay.Error() );
+        return wxEmptyString;
+    }
+
+    replay.Run( aBoard, aRepeat );
+
+    return replay.Report();
+}
+
+
+bool PlotFabricationFiles( BOARD* aBoard, wxString& aOutputDir, int aThreadCount )
+{
+    if( !aBoard || aThreadCount < 0 )
+        return false;
+
+    wxString           messages;
+    WX_STRING_REPORTER reporter( &messages );
+    PCB_PLOT_PARAMS    plotOpts = aBoard->GetPlotOptions();
+    wxString           boardFilename = aBoard->GetFileName();
+    wxFileName         outputDir = wxFileName::DirName( aOutputDir );
+
+    if( !EnsureFileDirectoryExists( &outputDir, boardFilename, &reporter ) )
+    {
+        wxLogError( messages );
+        return false;
+    }
+
+    PLOT_JOB_SCHEDULER scheduler( aBoard );
+
+    for( LSEQ seq = plotOpts.GetLayerSelection().UIOrder();  seq;  ++seq )
+    {
+        PCB_LAYER_ID layer = *seq;
+
+        // As in the plot dialog, the disabled copper layers are not plotted
+        if( ( LSET::AllCuMask() & ~aBoard->GetEnabledLayers() )[layer] )
+            continue;
+
+        wxFileName fn( boardFilename );
+        wxString   file_ext = GetDefaultPlotExtension( plotOpts.GetFormat() );
+
+        if( plotOpts.GetFormat() == PLOT_FORMAT_GERBER
+            && plotOpts.GetUseGerberProtelExtensions() )
+            file_ext = GetGerberProtelExtension( layer );
+
+        BuildPlotFileName( &fn, outputDir.GetPath(), aBoard->GetLayerName( layer ), file_ext );
+        scheduler.AddLayerJob( layer, fn.GetFullPath(), plotOpts );
+    }
+
+    wxPoint drillOffset;
+
+    if( plotOpts.GetUseAuxOrigin() )
+        drillOffset = aBoard->GetAuxOrigin();
+
+    EXCELLON_WRITER drillWriter( aBoard );
+    drillWriter.SetFormat( true );
+    drillWriter.SetOptions( false, false, drillOffset, false );
+    drillWriter.SetMapFileFormat( PLOT_FORMAT_PDF );
+    scheduler.AddDrillJobs( drillWriter, outputDir.GetFullPath() );
+
+    if( !scheduler.Run( &reporter, aThreadCount ) )
+    {
+        wxLogError( messages );
+        return false;
+    }
+
+    return true;
+}
+
+
 void Refresh()
 {
+    // The script may have changed the board without a commit
+    BOARD_COMMIT::NotifyBoardChanged( PcbEditFrame->GetBoard() );
+
     // first argument is erase background, second is a wxRect
     PcbEditFrame->GetCanvas()->Refresh( true, NULL );
 }
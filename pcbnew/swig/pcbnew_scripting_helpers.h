@@ -49,6 +49,33 @@ BOARD*  LoadBoard( wxString& aFileName );
 // so no option to choose the file format.
 bool    SaveBoard( wxString& aFileName, BOARD* aBoard );
 
+/// Camera presets for RenderBoard3D(), the same views as the 3D viewer keys
+enum RENDER_3D_VIEW
+{
+    RENDER_3D_VIEW_TOP,         ///< 'z'
+    RENDER_3D_VIEW_BOTTOM,      ///< 'Z'
+    RENDER_3D_VIEW_FRONT,       ///< 'y'
+    RENDER_3D_VIEW_BACK,        ///< 'Y'
+    RENDER_3D_VIEW_LEFT,        ///< 'x'
+    RENDER_3D_VIEW_RIGHT        ///< 'X'
+};
+
+// Raytraces the board on the CPU, without any window or OpenGL context,
+// and saves the image as a .png file. 3D models are not rendered.
+bool    RenderBoard3D( BOARD* aBoard, wxString& aFileName, int aWidth, int aHeight,
+                       RENDER_3D_VIEW aView = RENDER_3D_VIEW_TOP );
+
+// Replays the router sessions recorded with KICAD_PNS_RECORD on the board, without
+// modifying it, and returns the latency and collision query statistics of each event.
+// Returns an empty string if the session file cannot be read.
+wxString ReplayRouterSession( BOARD* aBoard, wxString& aSessionFileName, int aRepeat = 1 );
+
+// Plots the layers selected in the board plot settings, and writes the Excellon drill
+// files and their PDF maps in aOutputDir (relative to the board file), without any dialog.
+// The files are written in parallel by aThreadCount threads (0 = one thread by core).
+// Returns true if all the files are created, the errors are sent to the wx log.
+bool    PlotFabricationFiles( BOARD* aBoard, wxString& aOutputDir, int aThreadCount = 0 );
+
 void    Refresh();
 void    WindowZoom( int xl, int yl, int width, int height );
 
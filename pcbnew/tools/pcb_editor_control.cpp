@@ -45,6 +45,7 @@
 #include <ratsnest_data.h>
 #include <collectors.h>
 #include <zones_functions_for_undo_redo.h>
+#include <zone_connection_points.h>
 #include <board_commit.h>
 #include <confirm.h>
 #include <bitmaps.h>
@@ -669,6 +670,7 @@ int PCB_EDITOR_CONTROL::ZoneFillAll( const TOOL_EVENT& aEvent )
     RN_DATA* ratsnest = board->GetRatsnest();
 
     BOARD_COMMIT commit( this );
+    ZONE_CONNECTION_POINTS connectionPoints( board );
 
     for( int i = 0; i < board->GetAreaCount(); ++i )
     {
@@ -676,7 +678,7 @@ int PCB_EDITOR_CONTROL::ZoneFillAll( const TOOL_EVENT& aEvent )
 
         commit.Modify( zone );
 
-        m_frame->Fill_Zone( zone );
+        m_frame->Fill_Zone( zone, &connectionPoints );
         zone->SetIsFilled( true );
         ratsnest->Update( zone );
         getView()->Update( zone );
@@ -46,6 +46,7 @@ using namespace std::placeholders;
 #include <class_edge_mod.h>
 
 #include <ratsnest_data.h>
+#include <board_commit.h>
 
 #include <tools/selection_tool.h>
 #include <tool/tool_manager.h>
@@ -338,6 +339,7 @@ void PCB_BASE_EDIT_FRAME::RestoreCopyFromUndoList( wxCommandEvent& aEvent )
     GetScreen()->PushCommandToRedoList( List );
 
     OnModify();
+    BOARD_COMMIT::NotifyBoardChanged( GetBoard() );
 
     m_toolManager->ProcessEvent( { TC_MESSAGE, TA_UNDO_REDO_POST, AS_GLOBAL } );
 
@@ -367,6 +369,7 @@ void PCB_BASE_EDIT_FRAME::RestoreCopyFromRedoList( wxCommandEvent& aEvent )
     GetScreen()->PushCommandToUndoList( List );
 
     OnModify();
+    BOARD_COMMIT::NotifyBoardChanged( GetBoard() );
 
     m_toolManager->ProcessEvent( { TC_MESSAGE, TA_UNDO_REDO_POST, AS_GLOBAL } );
 
@@ -600,6 +603,7 @@ void BOARD_ITEM::SwapData( BOARD_ITEM* aImage )
 
     case PCB_ZONE_AREA_T:
         std::swap( *((ZONE_CONTAINER*) this), *((ZONE_CONTAINER*) aImage) );
+        ( (ZONE_CONTAINER*) this )->SyncFilledPolys();
         break;
 
     case PCB_LINE_T:
@@ -641,6 +645,98 @@ void BOARD_ITEM::SwapData( BOARD_ITEM* aImage )
 }
 
 
+/**
+ * Function itemDataSize
+ * @return the approximate memory size of aItem in bytes, with its outlines and sub-items.
+ * @param aSharedData = the list to append the data aItem can share with other items to,
+ * e.g. the zone fills, see PCB_SCREEN::GetCommandDataSize()
+ */
+static size_t itemDataSize( const BOARD_ITEM* aItem, std::vector<UNDO_SHARED_DATA>& aSharedData )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_MODULE_T:
+    {
+        const MODULE* module = static_cast<const MODULE*>( aItem );
+        size_t size = sizeof( MODULE ) + 2 * sizeof( TEXTE_MODULE );
+
+        for( const D_PAD* pad = module->Pads(); pad; pad = pad->Next() )
+            size += sizeof( D_PAD );
+
+        for( const BOARD_ITEM* item = module->GraphicalItems(); item; item = item->Next() )
+            size += item->Type() == PCB_MODULE_TEXT_T ? sizeof( TEXTE_MODULE )
+                                                      : sizeof( EDGE_MODULE );
+
+        return size + module->Models().size() * sizeof( S3D_INFO );
+    }
+
+    case PCB_ZONE_AREA_T:
+    {
+        const ZONE_CONTAINER* zone = static_cast<const ZONE_CONTAINER*>( aItem );
+        size_t size = sizeof( ZONE_CONTAINER )
+                      + zone->GetNumCorners() * sizeof( VECTOR2I )
+                      + zone->GetHatchLines().size() * sizeof( SEG )
+                      + zone->FillSegments().size() * sizeof( SEGMENT );
+
+        // The fill can be shared with the other copies of the zone
+        UNDO_SHARED_DATA fill;
+        fill.m_Data = zone->GetSharedFilledPolys( fill.m_Size );
+        aSharedData.push_back( fill );
+
+        return size;
+    }
+
+    case PCB_TRACE_T:
+        return sizeof( TRACK );
+
+    case PCB_VIA_T:
+        return sizeof( VIA );
+
+    case PCB_LINE_T:
+        return sizeof( DRAWSEGMENT );
+
+    case PCB_TEXT_T:
+        return sizeof( TEXTE_PCB );
+
+    case PCB_DIMENSION_T:
+        return sizeof( DIMENSION );
+
+    default:
+        return sizeof( BOARD_ITEM );
+    }
+}
+
+
+size_t PCB_SCREEN::GetCommandDataSize( const PICKED_ITEMS_LIST& aCommand,
+                                       std::vector<UNDO_SHARED_DATA>& aSharedData ) const
+{
+    size_t size = sizeof( PICKED_ITEMS_LIST ) + aCommand.GetCount() * sizeof( ITEM_PICKER );
+
+    for( unsigned ii = 0; ii < aCommand.GetCount(); ii++ )
+    {
+        // The changed items are held as copies, and the deleted items themselves
+        // are owned by the command
+        switch( aCommand.GetPickedItemStatus( ii ) )
+        {
+        case UR_CHANGED:
+            if( aCommand.GetPickedItemLink( ii ) )
+                size += itemDataSize( (BOARD_ITEM*) aCommand.GetPickedItemLink( ii ),
+                                      aSharedData );
+            break;
+
+        case UR_DELETED:
+            size += itemDataSize( (BOARD_ITEM*) aCommand.GetPickedItem( ii ), aSharedData );
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    return size;
+}
+
+
 void PCB_SCREEN::ClearUndoORRedoList( UNDO_REDO_CONTAINER& aList, int aItemCount )
 {
     if( aItemCount == 0 )
@@ -659,6 +755,7 @@ void PCB_SCREEN::ClearUndoORRedoList( UNDO_REDO_CONTAINER& aList, int aItemCount
         PICKED_ITEMS_LIST* curr_cmd = aList.m_CommandsList[0];
         aList.m_CommandsList.erase( aList.m_CommandsList.begin() );
 
+        ReleaseCommandData( *curr_cmd );
         curr_cmd->ClearListAndDeleteItems();
         delete curr_cmd;    // Delete command
     }
@@ -0,0 +1,78 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <fctsys.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_track.h>
+
+#include <zone_connection_points.h>
+
+
+ZONE_CONNECTION_POINTS::ZONE_CONNECTION_POINTS( BOARD* aBoard, int aNetCode )
+{
+    const LSET copperLayers = LSET::AllCuMask();
+
+    for( MODULE* module = aBoard->m_Modules; module; module = module->Next() )
+    {
+        for( D_PAD* pad = module->Pads(); pad != NULL; pad = pad->Next() )
+        {
+            if( aNetCode >= 0 && pad->GetNetCode() != aNetCode )
+                continue;
+
+            for( LSEQ cu = ( pad->GetLayerSet() & copperLayers ).Seq(); cu; ++cu )
+                add( pad->GetNetCode(), *cu, VECTOR2I( pad->GetPosition() ) );
+        }
+    }
+
+    for( TRACK* track = aBoard->m_Track; track; track = track->Next() )
+    {
+        if( aNetCode >= 0 && track->GetNetCode() != aNetCode )
+            continue;
+
+        if( track->Type() == PCB_VIA_T )
+        {
+            // A via is on all the layers between its end layers, and only its start is used
+            for( LSEQ cu = ( track->GetLayerSet() & copperLayers ).Seq(); cu; ++cu )
+                add( track->GetNetCode(), *cu, VECTOR2I( track->GetStart() ) );
+        }
+        else
+        {
+            add( track->GetNetCode(), track->GetLayer(), VECTOR2I( track->GetStart() ) );
+            add( track->GetNetCode(), track->GetLayer(), VECTOR2I( track->GetEnd() ) );
+        }
+    }
+
+    for( auto& list : m_points )
+    {
+        std::sort( list.second.begin(), list.second.end(),
+                   []( const VECTOR2I& aA, const VECTOR2I& aB ) { return aA.x < aB.x; } );
+    }
+}
+
+
+void ZONE_CONNECTION_POINTS::add( int aNetCode, PCB_LAYER_ID aLayer, const VECTOR2I& aPoint )
+{
+    m_points[KEY( aNetCode, aLayer )].push_back( aPoint );
+}
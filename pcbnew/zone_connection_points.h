@@ -0,0 +1,100 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef ZONE_CONNECTION_POINTS_H
+#define ZONE_CONNECTION_POINTS_H
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <math/box2.h>
+#include <layers_id_colors_and_visibility.h>
+
+class BOARD;
+
+/**
+ * Class ZONE_CONNECTION_POINTS
+ *
+ * The points which connect a filled zone area to its net: the pad positions, the track
+ * ends and the vias of the board, by net and copper layer.  Each list is sorted by x,
+ * so the points inside the bounding box of a filled area are found without looking at
+ * the rest of the board.
+ *
+ * Building it walks the board once: when several zones are filled in a row, one
+ * instance is shared by all of them.  It is a snapshot, which must not be used after
+ * the pads or tracks are modified.
+ */
+class ZONE_CONNECTION_POINTS
+{
+public:
+    /**
+     * Constructor
+     * @param aBoard = the board to read the pads and tracks from
+     * @param aNetCode = the only net to index, or -1 to index all the nets
+     */
+    ZONE_CONNECTION_POINTS( BOARD* aBoard, int aNetCode = -1 );
+
+    /**
+     * Function FindPoint
+     * calls aPredicate( const VECTOR2I& ) for the points of aNetCode on aLayer inside
+     * aBox, until it returns true.
+     * @return true if aPredicate returned true for one of the points.
+     */
+    template <class PREDICATE>
+    bool FindPoint( int aNetCode, PCB_LAYER_ID aLayer, const BOX2I& aBox,
+                    PREDICATE aPredicate ) const
+    {
+        auto list = m_points.find( KEY( aNetCode, aLayer ) );
+
+        if( list == m_points.end() )
+            return false;
+
+        const std::vector<VECTOR2I>& points = list->second;
+
+        auto it = std::lower_bound( points.begin(), points.end(), aBox.GetX(),
+                                    []( const VECTOR2I& aP, int aX ) { return aP.x < aX; } );
+
+        for( ; it != points.end() && it->x <= aBox.GetRight(); ++it )
+        {
+            if( it->y < aBox.GetY() || it->y > aBox.GetBottom() )
+                continue;
+
+            if( aPredicate( *it ) )
+                return true;
+        }
+
+        return false;
+    }
+
+private:
+    typedef std::pair<int, PCB_LAYER_ID> KEY;
+
+    void add( int aNetCode, PCB_LAYER_ID aLayer, const VECTOR2I& aPoint );
+
+    ///> The points of each net and layer, sorted by x
+    std::map<KEY, std::vector<VECTOR2I> > m_points;
+};
+
+#endif /* ZONE_CONNECTION_POINTS_H */
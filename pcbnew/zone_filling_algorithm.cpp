@@ -55,7 +55,8 @@
  * to add holes for pads and tracks and other items not in net.
  */
 
-bool ZONE_CONTAINER::BuildFilledSolidAreasPolygons( BOARD* aPcb, SHAPE_POLY_SET* aOutlineBuffer )
+bool ZONE_CONTAINER::BuildFilledSolidAreasPolygons( BOARD* aPcb, SHAPE_POLY_SET* aOutlineBuffer,
+        const ZONE_CONNECTION_POINTS* aConnectionPoints )
 {
     /* convert outlines + holes to outlines without holes (adding extra segments if necessary)
      * m_Poly data is expected normalized, i.e. NormalizeAreaOutlines was used after building
@@ -105,11 +106,14 @@ bool ZONE_CONTAINER::BuildFilledSolidAreasPolygons( BOARD* aPcb, SHAPE_POLY_SET*
      */
     else
     {
-        m_FilledPolysList.RemoveAllContours();
+        ClearFilledPolysList();
 
         if( IsOnCopperLayer() )
         {
-            AddClearanceAreasPolygonsToPolysList_NG( aPcb );
+            // The holes of the large zones are removed in strips, in parallel
+            SHAPE_POLY_SET::SetTiledOperations( g_TiledZoneFill );
+            AddClearanceAreasPolygonsToPolysList_NG( aPcb, aConnectionPoints );
+            SHAPE_POLY_SET::SetTiledOperations( false );
 
             if( m_FillMode )   // if fill mode uses segments, create them:
             {
@@ -121,15 +125,17 @@ bool ZONE_CONTAINER::BuildFilledSolidAreasPolygons( BOARD* aPcb, SHAPE_POLY_SET*
         {
             m_FillMode = 0;     // Fill by segments is no more used in non copper layers
                                 // force use solid polygons (usefull only for old boards)
-            m_FilledPolysList = *m_smoothedPoly;
+            filledPolys() = *m_smoothedPoly;
 
             // The filled areas are deflated by -m_ZoneMinThickness / 2, because
             // the outlines are drawn with a line thickness = m_ZoneMinThickness to
             // give a good shape with the minimal thickness
-            m_FilledPolysList.Inflate( -m_ZoneMinThickness / 2, 16 );
-            m_FilledPolysList.Fracture( SHAPE_POLY_SET::PM_FAST );
+            filledPolys().Inflate( -m_ZoneMinThickness / 2, 16 );
+            filledPolys().Fracture( SHAPE_POLY_SET::PM_FAST );
         }
 
+        // Speeds up the hit tests and the connectivity tests on the filled areas
+        filledPolys().BuildIndex();
         m_IsFilled = true;
     }
 
@@ -171,9 +177,9 @@ bool ZONE_CONTAINER::FillZoneAreasWithSegments()
     m_FillSegmList.clear();
 
     // Creates the horizontal segments
-    for ( int index = 0; index < m_FilledPolysList.OutlineCount(); index++ )
+    for ( int index = 0; index < GetFilledPolysList().OutlineCount(); index++ )
     {
-        const SHAPE_LINE_CHAIN& outline0 = m_FilledPolysList.COutline( index );
+        const SHAPE_LINE_CHAIN& outline0 = GetFilledPolysList().COutline( index );
         success = fillPolygonWithHorizontalSegments( outline0, m_FillSegmList, grid_size );
 
         if( !success )
@@ -42,6 +42,7 @@
 
 #include <pcbnew.h>
 #include <zones.h>
+#include <zone_connection_points.h>
 
 #include <view/view.h>
 
@@ -89,7 +90,8 @@ void PCB_EDIT_FRAME::Delete_OldZone_Fill( SEGZONE* aZone, time_t aTimestamp )
 }
 
 
-int PCB_EDIT_FRAME::Fill_Zone( ZONE_CONTAINER* aZone )
+int PCB_EDIT_FRAME::Fill_Zone( ZONE_CONTAINER* aZone,
+                               const ZONE_CONNECTION_POINTS* aConnectionPoints )
 {
     aZone->ClearFilledPolysList();
     aZone->UnFill();
@@ -116,7 +118,7 @@ int PCB_EDIT_FRAME::Fill_Zone( ZONE_CONTAINER* aZone )
 
     wxBusyCursor dummy;     // Shows an hourglass cursor (removed by its destructor)
 
-    aZone->BuildFilledSolidAreasPolygons( GetBoard() );
+    aZone->BuildFilledSolidAreasPolygons( GetBoard(), NULL, aConnectionPoints );
     GetGalCanvas()->GetView()->Update( aZone, KIGFX::ALL );
     GetBoard()->GetRatsnest()->Update( aZone );
 
@@ -150,6 +152,9 @@ int PCB_EDIT_FRAME::Fill_All_Zones( wxWindow * aActiveWindow, bool aVerbose )
     // Remove segment zones
     GetBoard()->m_Zone.DeleteAll();
 
+    // The pads and tracks are not modified by the fill: read them once for all the zones
+    ZONE_CONNECTION_POINTS connectionPoints( GetBoard() );
+
     int ii;
 
     for( ii = 0; ii < areaCount; ii++ )
@@ -166,7 +171,7 @@ int PCB_EDIT_FRAME::Fill_All_Zones( wxWindow * aActiveWindow, bool aVerbose )
                 break;  // Aborted by user
         }
 
-        errorLevel = Fill_Zone( zoneContainer );
+        errorLevel = Fill_Zone( zoneContainer, &connectionPoints );
 
         if( errorLevel && !aVerbose )
             break;
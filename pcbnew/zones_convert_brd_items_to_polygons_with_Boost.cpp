@@ -407,7 +407,8 @@ void ZONE_CONTAINER::buildFeatureHoleList( BOARD* aPcb, SHAPE_POLY_SET& aFeature
  *     Remove new insulated copper islands
  */
 
-void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList_NG( BOARD* aPcb )
+void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList_NG( BOARD* aPcb,
+        const ZONE_CONNECTION_POINTS* aConnectionPoints )
 {
     int segsPerCircle;
     double correctionFactor;
@@ -471,11 +472,11 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList_NG( BOARD* aPcb )
     if (g_DumpZonesWhenFilling)
         dumper->Write( &areas_fractured, "areas_fractured" );
 
-    m_FilledPolysList = areas_fractured;
+    filledPolys() = areas_fractured;
 
     // Remove insulated islands:
     if( GetNetCode() > 0 )
-        TestForCopperIslandAndRemoveInsulatedIslands( aPcb );
+        TestForCopperIslandAndRemoveInsulatedIslands( aPcb, aConnectionPoints );
 
     SHAPE_POLY_SET thermalHoles;
 
@@ -504,10 +505,10 @@ void ZONE_CONTAINER::AddClearanceAreasPolygonsToPolysList_NG( BOARD* aPcb )
         if( g_DumpZonesWhenFilling )
             dumper->Write ( &th_fractured, "th_fractured" );
 
-        m_FilledPolysList = th_fractured;
+        filledPolys() = th_fractured;
 
         if( GetNetCode() > 0 )
-            TestForCopperIslandAndRemoveInsulatedIslands( aPcb );
+            TestForCopperIslandAndRemoveInsulatedIslands( aPcb, aConnectionPoints );
     }
 
     if(g_DumpZonesWhenFilling)
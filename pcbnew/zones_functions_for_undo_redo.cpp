@@ -237,6 +237,7 @@ void UpdateCopyOfZonesList( PICKED_ITEMS_LIST& aPickList,
                                   wxT( "UpdateCopyOfZonesList() error: link = NULL" ) );
 
                     *ref = *zcopy;
+                    ref->SyncFilledPolys();
 
                     // the copy was deleted; the link does not exists now.
                     aPickList.SetPickedItemLink( NULL, kk );
@@ -36,67 +36,47 @@
 #include <pcbnew.h>
 #include <zones.h>
 #include <polygon_test_point_inside.h>
+#include <zone_connection_points.h>
 
+#include <memory>
 
-void ZONE_CONTAINER::TestForCopperIslandAndRemoveInsulatedIslands( BOARD* aPcb )
+
+void ZONE_CONTAINER::TestForCopperIslandAndRemoveInsulatedIslands( BOARD* aPcb,
+        const ZONE_CONNECTION_POINTS* aConnectionPoints )
 {
-    if( m_FilledPolysList.IsEmpty() )
+    if( GetFilledPolysList().IsEmpty() )
         return;
 
-    // Build a list of points connected to the net:
-    // list of coordinates of pads and vias on this layer and on this net.
-    std::vector <wxPoint> listPointsCandidates;
+    // Build the list of points connected to the net, if the caller has not done it
+    // for all the zones: pads, track ends and vias on this net.
+    std::unique_ptr<ZONE_CONNECTION_POINTS> localPoints;
 
-    for( MODULE* module = aPcb->m_Modules; module; module = module->Next() )
+    if( !aConnectionPoints )
     {
-        for( D_PAD* pad = module->Pads(); pad != NULL; pad = pad->Next() )
-        {
-            if( !pad->IsOnLayer( GetLayer() ) )
-                continue;
-
-            if( pad->GetNetCode() != GetNetCode() )
-                continue;
-
-            listPointsCandidates.push_back( pad->GetPosition() );
-        }
+        localPoints.reset( new ZONE_CONNECTION_POINTS( aPcb, GetNetCode() ) );
+        aConnectionPoints = localPoints.get();
     }
 
-    for( TRACK* track = aPcb->m_Track; track; track = track->Next() )
-    {
-        if( !track->IsOnLayer( GetLayer() ) )
-            continue;
-
-        if( track->GetNetCode() != GetNetCode() )
-            continue;
+    // Test each area against the points inside its bounding box.  The polygons are
+    // deleted at the end, so the edge index stays valid during the tests.
+    filledPolys().BuildIndex();
 
-        listPointsCandidates.push_back( track->GetStart() );
+    std::vector<int> insulated;
 
-        if( track->Type() != PCB_VIA_T )
-            listPointsCandidates.push_back( track->GetEnd() );
-    }
-
-    // test if a point is inside
-
-    for( int outline = 0; outline < m_FilledPolysList.OutlineCount(); outline++ )
+    for( int outline = 0; outline < GetFilledPolysList().OutlineCount(); outline++ )
     {
-        bool connected = false;
+        const BOX2I bbox = GetFilledPolysList().COutline( outline ).BBox();
 
-        for( unsigned ic = 0; ic < listPointsCandidates.size(); ic++ )
-        {
-            // test if this area is connected to a board item:
-            wxPoint pos = listPointsCandidates[ic];
+        bool connected = aConnectionPoints->FindPoint( GetNetCode(), GetLayer(), bbox,
+                [&]( const VECTOR2I& aPoint )
+                {
+                    return GetFilledPolysList().Contains( aPoint, outline );
+                } );
 
-            if( m_FilledPolysList.Contains( VECTOR2I( pos.x, pos.y ), outline ) )
-            {
-                connected = true;
-                break;
-            }
-        }
-
-        if( !connected )                 // this polygon is connected: analyse next polygon
-        {
-            m_FilledPolysList.DeletePolygon( outline );
-            outline--;
-        }
+        if( !connected )
+            insulated.push_back( outline );
     }
+
+    for( auto it = insulated.rbegin(); it != insulated.rend(); ++it )
+        filledPolys().DeletePolygon( *it );
 }
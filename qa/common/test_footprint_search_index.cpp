@@ -0,0 +1,189 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <eda_pattern_match.h>
+#include <footprint_search_index.h>
+
+#include <qa/data/fixtures_footprint_list.h>
+
+#include <algorithm>
+
+
+/**
+ * A list of generated footprints, and the brute force results the index must give.
+ */
+struct FootprintListFixture
+{
+    TEST_FOOTPRINT_LIST list;
+
+    FootprintListFixture()
+    {
+        list.Generate( 5000 );
+        list.Add( wxT( "Misc" ), wxT( "Fiducial_1mm" ), wxT( "Circular fiducial" ),
+                  wxT( "fiducial marker" ), 1 );
+    }
+
+    /// The items whose name matches the wildcard \a aPattern, as FOOTPRINT_FILTER tests it
+    std::vector<int> patternMatches( const wxString& aPattern )
+    {
+        EDA_PATTERN_MATCH_WILDCARD matcher;
+        std::vector<int>           matches;
+
+        matcher.SetPattern( aPattern.Lower() );
+
+        for( unsigned ii = 0; ii < list.GetCount(); ++ii )
+        {
+            if( matcher.Find( list.GetItem( ii ).GetFootprintName().Lower() )
+                    != EDA_PATTERN_NOT_FOUND )
+                matches.push_back( ii );
+        }
+
+        return matches;
+    }
+
+    /// The items whose fields contain all the words of \a aText
+    std::vector<int> textMatches( const wxString& aText )
+    {
+        wxArrayString    words = wxSplit( aText.Lower(), ' ' );
+        std::vector<int> matches;
+
+        for( unsigned ii = 0; ii < list.GetCount(); ++ii )
+        {
+            FOOTPRINT_INFO& item = list.GetItem( ii );
+            wxString        text = item.GetNickname() + wxT( ":" ) + item.GetFootprintName()
+                                   + wxT( "\n" ) + item.GetKeywords() + wxT( "\n" )
+                                   + item.GetDoc();
+
+            text.MakeLower();
+
+            bool found = std::all_of( words.begin(), words.end(),
+                    [&text]( const wxString& word )
+                    {
+                        return word.IsEmpty() || text.Find( word ) != wxNOT_FOUND;
+                    } );
+
+            if( found )
+                matches.push_back( ii );
+        }
+
+        return matches;
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( FootprintSearchIndex, FootprintListFixture )
+
+/**
+ * Checks that the index is rebuilt after the list is modified.
+ */
+BOOST_AUTO_TEST_CASE( Build )
+{
+    const FOOTPRINT_SEARCH_INDEX& index = list.GetSearchIndex();
+
+    BOOST_CHECK( index.IsBuilt() );
+    BOOST_CHECK_EQUAL( index.GetLibraryItems( wxT( "Misc" ) ).size(), 1u );
+    BOOST_CHECK( index.GetLibraryItems( wxT( "Unknown" ) ).empty() );
+
+    list.Add( wxT( "Misc" ), wxT( "MountingHole_3.2mm" ) );
+
+    BOOST_CHECK( !index.IsBuilt() );
+    BOOST_CHECK_EQUAL( list.GetSearchIndex().GetLibraryItems( wxT( "Misc" ) ).size(), 2u );
+}
+
+/**
+ * Checks that the candidates of a pattern include all the items it matches, for runs
+ * shorter than, as long as, and longer than the indexed n-grams.
+ */
+BOOST_AUTO_TEST_CASE( PatternCandidates )
+{
+    const FOOTPRINT_SEARCH_INDEX& index = list.GetSearchIndex();
+
+    const wxString patterns[] = { wxT( "*06*" ), wxT( "soic-8*" ), wxT( "qfn*5x5mm*" ),
+                                  wxT( "*header_1x4*" ), wxT( "fiducial*" ),
+                                  wxT( "r_*_0402_1?" ) };
+
+    for( const wxString& pattern : patterns )
+    {
+        std::vector<int> candidates;
+        std::vector<int> matches = patternMatches( pattern );
+
+        BOOST_REQUIRE( index.FindPatternCandidates( pattern, candidates ) );
+        BOOST_CHECK( std::is_sorted( candidates.begin(), candidates.end() ) );
+        BOOST_CHECK_MESSAGE( !matches.empty(), "no match for " << pattern );
+        BOOST_CHECK_MESSAGE( std::includes( candidates.begin(), candidates.end(),
+                                            matches.begin(), matches.end() ),
+                             "missing candidates for " << pattern );
+        BOOST_CHECK_LT( candidates.size(), list.GetCount() );
+    }
+}
+
+/**
+ * Checks that a pattern without any run long enough gives no hint, and that a run
+ * absent from all the tokens gives no candidates.
+ */
+BOOST_AUTO_TEST_CASE( PatternWithoutCandidates )
+{
+    list.Add( wxT( "Misc" ), wxT( "Jumper_abab" ) );
+
+    const FOOTPRINT_SEARCH_INDEX& index = list.GetSearchIndex();
+    std::vector<int>              candidates;
+
+    BOOST_CHECK( !index.FindPatternCandidates( wxT( "r_*" ), candidates ) );
+
+    BOOST_CHECK( index.FindPatternCandidates( wxT( "*xyz*" ), candidates ) );
+    BOOST_CHECK( candidates.empty() );
+
+    // All the trigrams of "ababa" are in the token "abab", but not the run itself
+    BOOST_CHECK( index.FindPatternCandidates( wxT( "ababa*" ), candidates ) );
+    BOOST_CHECK( candidates.empty() );
+
+    BOOST_CHECK( index.FindPatternCandidates( wxT( "*abab" ), candidates ) );
+    BOOST_CHECK_EQUAL( candidates.size(), 1u );
+}
+
+/**
+ * Checks that the free text search gives exactly the items containing all the words.
+ */
+BOOST_AUTO_TEST_CASE( Search )
+{
+    const FOOTPRINT_SEARCH_INDEX& index = list.GetSearchIndex();
+
+    const wxString texts[] = { wxT( "soic 3.9x4.9mm" ), wxT( "Quartz" ), wxT( "pin header" ),
+                               wxT( "qfp 7x7" ), wxT( "smd:c_" ), wxT( "fiducial" ),
+                               wxT( "crystal 0402" ), wxT( "x" ) };
+
+    for( const wxString& text : texts )
+    {
+        std::vector<int> items;
+        std::vector<int> matches = textMatches( text );
+
+        BOOST_TEST_MESSAGE( "searching " << text );
+        index.Search( text, items );
+        BOOST_CHECK_EQUAL_COLLECTIONS( items.begin(), items.end(),
+                                       matches.begin(), matches.end() );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
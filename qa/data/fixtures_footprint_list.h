@@ -0,0 +1,145 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __FIXTURES_FOOTPRINT_LIST_H
+#define __FIXTURES_FOOTPRINT_LIST_H
+
+#include <footprint_info.h>
+#include <macros.h>
+#include <make_unique.h>
+
+#include <random>
+
+
+/**
+ * A footprint given by its fields rather than loaded from a library.
+ */
+class TEST_FOOTPRINT_INFO : public FOOTPRINT_INFO
+{
+public:
+    TEST_FOOTPRINT_INFO( const wxString& aNickname, const wxString& aFootprintName,
+                         const wxString& aDoc, const wxString& aKeywords, int aPadCount )
+    {
+        m_owner = nullptr;
+        m_loaded = true;
+        m_nickname = aNickname;
+        m_fpname = aFootprintName;
+        m_num = 0;
+        m_pad_count = aPadCount;
+        m_unique_pad_count = aPadCount;
+        m_doc = aDoc;
+        m_keywords = aKeywords;
+    }
+
+protected:
+    void load() override
+    {
+        m_loaded = true;
+    }
+};
+
+
+/**
+ * A footprint list filled in memory, without library table.
+ */
+class TEST_FOOTPRINT_LIST : public FOOTPRINT_LIST
+{
+public:
+    void Add( const wxString& aNickname, const wxString& aFootprintName,
+              const wxString& aDoc = wxEmptyString, const wxString& aKeywords = wxEmptyString,
+              int aPadCount = 0 )
+    {
+        m_list.push_back( std::make_unique<TEST_FOOTPRINT_INFO>( aNickname, aFootprintName,
+                                                                 aDoc, aKeywords, aPadCount ) );
+        m_search_index.Clear();
+    }
+
+    /**
+     * Fill the list with \a aCount footprints named like the ones of the standard
+     * libraries, always the same for a given \a aSeed.
+     */
+    void Generate( unsigned aCount, unsigned aSeed = 1 )
+    {
+        static const struct
+        {
+            const char* nickname;
+            const char* prefix;
+            const char* doc;
+            const char* keywords;
+        } families[] =
+        {
+            { "Resistor_SMD",   "R_",       "Resistor SMD",         "resistor" },
+            { "Capacitor_SMD",  "C_",       "Capacitor SMD",        "capacitor" },
+            { "Package_SO",     "SOIC-",    "Small outline IC",     "SOIC SO" },
+            { "Package_QFP",    "LQFP-",    "Low profile quad flat package", "QFP" },
+            { "Package_DFN_QFN", "QFN-",    "Quad flat no lead",    "QFN NL" },
+            { "Package_TO_SOT_SMD", "SOT-", "Small outline transistor", "SOT TO" },
+            { "Connector_PinHeader_2.54mm", "PinHeader_1x", "Through hole pin header",
+              "THT pin header" },
+            { "Crystal",        "Crystal_HC49-", "Quartz crystal",  "crystal oscillator" },
+        };
+
+        static const char* sizes[] = { "0402", "0603", "0805", "1206", "3.9x4.9mm",
+                                       "7x7mm", "5x5mm", "2.54mm" };
+
+        std::mt19937                           rng( aSeed );
+        std::uniform_int_distribution<size_t>  family( 0, DIM( families ) - 1 );
+        std::uniform_int_distribution<size_t>  size( 0, DIM( sizes ) - 1 );
+        std::uniform_int_distribution<int>     pads( 2, 100 );
+
+        for( unsigned ii = 0; ii < aCount; ++ii )
+        {
+            const auto& f = families[family( rng )];
+            int         padCount = pads( rng );
+
+            wxString name = wxString::Format( "%s%d_%s_%u", f.prefix, padCount,
+                                              sizes[size( rng )], ii );
+            wxString doc = wxString::Format( "%s, %d pins", f.doc, padCount );
+
+            Add( f.nickname, name, doc, f.keywords, padCount );
+        }
+    }
+
+    bool ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxString* aNickname = NULL ) override
+    {
+        return true;
+    }
+
+protected:
+    void StartWorkers( FP_LIB_TABLE* aTable, wxString const* aNickname,
+                       FOOTPRINT_ASYNC_LOADER* aLoader, unsigned aNThreads ) override
+    {
+    }
+
+    bool JoinWorkers() override
+    {
+        return true;
+    }
+
+    size_t CountFinished() override
+    {
+        return 0;
+    }
+};
+
+#endif // __FIXTURES_FOOTPRINT_LIST_H
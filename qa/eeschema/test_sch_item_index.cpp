@@ -0,0 +1,77 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <class_sch_screen.h>
+#include <sch_line.h>
+
+
+/**
+ * A screen holding two aligned wires sharing an end: (0, 0) - (1000, 0) and
+ * (1000, 0) - (2000, 0).
+ */
+struct AlignedWiresFixture
+{
+    SCH_SCREEN screen;
+
+    AlignedWiresFixture() :
+        screen( nullptr )
+    {
+        SCH_LINE* first = new SCH_LINE( wxPoint( 0, 0 ), LAYER_WIRE );
+        first->SetEndPoint( wxPoint( 1000, 0 ) );
+        screen.Append( first );
+
+        SCH_LINE* second = new SCH_LINE( wxPoint( 1000, 0 ), LAYER_WIRE );
+        second->SetEndPoint( wxPoint( 2000, 0 ) );
+        screen.Append( second );
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( SchItemIndex, AlignedWiresFixture )
+
+/**
+ * Checks that the wire lengthened by SchematicCleanUp() is found by the hit tests on
+ * its new part, through the item index built before the merge.
+ */
+BOOST_AUTO_TEST_CASE( MergedWireHitTest )
+{
+    // Build the item index
+    BOOST_REQUIRE( screen.GetWire( wxPoint( 100, 0 ) ) );
+
+    BOOST_CHECK( screen.SchematicCleanUp() );
+
+    SCH_LINE* merged = (SCH_LINE*) screen.GetDrawItems();
+
+    BOOST_REQUIRE( merged );
+    BOOST_CHECK( !merged->Next() );
+    BOOST_CHECK( merged->GetStartPoint() == wxPoint( 0, 0 ) );
+    BOOST_CHECK( merged->GetEndPoint() == wxPoint( 2000, 0 ) );
+
+    BOOST_CHECK_EQUAL( screen.GetWire( wxPoint( 1800, 0 ) ), merged );
+    BOOST_CHECK_EQUAL( screen.GetWire( wxPoint( 100, 0 ) ), merged );
+    BOOST_CHECK( !screen.GetWire( wxPoint( 2200, 0 ) ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
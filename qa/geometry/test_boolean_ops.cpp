@@ -0,0 +1,167 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif /* USE_OPENMP */
+
+#include <boost/test/unit_test.hpp>
+#include <geometry/shape_poly_set.h>
+#include <geometry/shape_line_chain.h>
+#include <cmath>
+
+/**
+ * Fixture for the boolean operations on large polygon sets: a square zone outline and
+ * thousands of small regular polygons, which overlap each other, as the holes of the
+ * pads and tracks.
+ */
+struct BooleanOpsFixture
+{
+    SHAPE_POLY_SET solidAreas;
+    SHAPE_POLY_SET holes;
+    int            maxThreads;     // the OpenMP thread count, restored after the tests
+
+    static const int width = 10000000;
+
+    BooleanOpsFixture()
+    {
+        solidAreas.NewOutline();
+        solidAreas.Append( 0, 0 );
+        solidAreas.Append( width, 0 );
+        solidAreas.Append( width, width );
+        solidAreas.Append( 0, width );
+
+        // A deterministic pseudo-random sequence, the same on all platforms
+        unsigned int seed = 1;
+
+        auto next = [&seed]( int aMax ) -> int
+        {
+            seed = seed * 1103515245 + 12345;
+            return ( seed >> 8 ) % aMax;
+        };
+
+        for( int i = 0; i < 3000; i++ )
+        {
+            int x = next( width );
+            int y = next( width );
+            int r = 1000 + next( 40000 );
+
+            holes.NewOutline();
+
+            for( int j = 0; j < 12; j++ )
+                holes.Append( x + (int) ( r * cos( 2 * M_PI * j / 12 ) ),
+                              y + (int) ( r * sin( 2 * M_PI * j / 12 ) ) );
+        }
+
+#ifdef USE_OPENMP
+        // Split the operations in strips even on a single core
+        maxThreads = omp_get_max_threads();
+        omp_set_num_threads( 4 );
+#endif
+    }
+
+    ~BooleanOpsFixture()
+    {
+#ifdef USE_OPENMP
+        omp_set_num_threads( maxThreads );
+#endif
+        SHAPE_POLY_SET::SetTiledOperations( false );
+    }
+};
+
+
+/**
+ * Function checkSameArea
+ * checks that aTiled and aSingle cover the same area, using points on a grid.
+ */
+static void checkSameArea( SHAPE_POLY_SET& aTiled, SHAPE_POLY_SET& aSingle, int aWidth )
+{
+    BOOST_CHECK_CLOSE( aTiled.Area(), aSingle.Area(), 1e-6 );
+
+    aTiled.BuildIndex();
+    aSingle.BuildIndex();
+
+    for( int x = 0; x < aWidth; x += aWidth / 97 )
+    {
+        for( int y = 0; y < aWidth; y += aWidth / 89 )
+        {
+            VECTOR2I p( x, y );
+
+            if( aTiled.PointOnEdge( p ) || aSingle.PointOnEdge( p ) )
+                continue;
+
+            BOOST_CHECK_EQUAL( aTiled.Contains( p ), aSingle.Contains( p ) );
+        }
+    }
+}
+
+
+BOOST_FIXTURE_TEST_SUITE( BooleanOps, BooleanOpsFixture )
+
+/**
+ * Checks that the operations split in strips give the same result as a single Clipper call.
+ */
+BOOST_AUTO_TEST_CASE( TiledOperations )
+{
+    SHAPE_POLY_SET simplified[2], subtracted[2], inflated[2];
+
+    for( int tiled = 0; tiled < 2; tiled++ )
+    {
+        SHAPE_POLY_SET::SetTiledOperations( tiled );
+
+        simplified[tiled] = holes;
+        simplified[tiled].Simplify( SHAPE_POLY_SET::PM_FAST );
+
+        subtracted[tiled] = solidAreas;
+        subtracted[tiled].BooleanSubtract( simplified[tiled], SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+
+        inflated[tiled] = holes;
+        inflated[tiled].Inflate( 20000, 16 );
+    }
+
+    checkSameArea( simplified[1], simplified[0], width );
+    checkSameArea( subtracted[1], subtracted[0], width );
+    checkSameArea( inflated[1], inflated[0], width );
+}
+
+
+/**
+ * Checks that Fracture() connects all the holes to the outline.
+ */
+BOOST_AUTO_TEST_CASE( Fracture )
+{
+    SHAPE_POLY_SET fractured = solidAreas;
+
+    fractured.BooleanSubtract( holes, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+
+    double area = fractured.Area();
+
+    BOOST_CHECK( fractured.HasHoles() );
+
+    fractured.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK( !fractured.HasHoles() );
+    BOOST_CHECK_CLOSE( fractured.Area(), area, 1e-6 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
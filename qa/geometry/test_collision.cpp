@@ -147,4 +147,54 @@ BOOST_AUTO_TEST_CASE( CollideVertexWithClearance )
     }
 }
 
+/**
+ * This test checks that the queries give the same results once the polygon set has an edge
+ * index, also after the set is copied and moved, and that modifying the set drops the index.
+ */
+BOOST_AUTO_TEST_CASE( IndexedQueries )
+{
+    SHAPE_POLY_SET indexedPolySet( common.holeyPolySet );
+
+    indexedPolySet.BuildIndex();
+    BOOST_CHECK( indexedPolySet.IsIndexed() );
+
+    for( const VECTOR2I& point : collidingPoints )
+    {
+        BOOST_CHECK( indexedPolySet.Contains( point ) );
+        BOOST_CHECK( indexedPolySet.Contains( point, 0 ) );
+        BOOST_CHECK( indexedPolySet.Collide( point, 0 ) );
+    }
+
+    for( const VECTOR2I& point : nonCollidingPoints )
+    {
+        BOOST_CHECK( !indexedPolySet.Contains( point ) );
+        BOOST_CHECK( !indexedPolySet.Collide( point, 0 ) );
+    }
+
+    BOOST_CHECK( indexedPolySet.PointOnEdge( VECTOR2I( 0,50 ) ) );
+    BOOST_CHECK( indexedPolySet.PointOnEdge( VECTOR2I( 10,11 ) ) );
+    BOOST_CHECK( !indexedPolySet.PointOnEdge( VECTOR2I( 12,12 ) ) );
+
+    BOOST_CHECK( indexedPolySet.Collide( VECTOR2I( -1,10 ), 5 ) );
+    BOOST_CHECK( indexedPolySet.Collide( VECTOR2I( 11,11 ), 5 ) );
+
+    BOOST_CHECK_EQUAL( indexedPolySet.Distance( VECTOR2I( 150,50 ) ),
+                       common.holeyPolySet.Distance( VECTOR2I( 150,50 ) ) );
+    BOOST_CHECK_EQUAL( indexedPolySet.Distance( VECTOR2I( 15,12 ) ),
+                       common.holeyPolySet.Distance( VECTOR2I( 15,12 ) ) );
+
+    // The copies share the index, and the moved sets translate the queries
+    SHAPE_POLY_SET movedPolySet( indexedPolySet );
+    movedPolySet.Move( VECTOR2I( 1000,1000 ) );
+
+    BOOST_CHECK( movedPolySet.IsIndexed() );
+    BOOST_CHECK( movedPolySet.Contains( VECTOR2I( 1010,1090 ) ) );
+    BOOST_CHECK( !movedPolySet.Contains( VECTOR2I( 10,90 ) ) );
+    BOOST_CHECK( !movedPolySet.Contains( VECTOR2I( 1015,1012 ) ) );
+
+    // Modifying the polygons drops the index
+    indexedPolySet.Append( VECTOR2I( 50,150 ) );
+    BOOST_CHECK( !indexedPolySet.IsIndexed() );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,42 @@
+import os
+import shutil
+import tempfile
+import unittest
+import pcbnew
+
+
+class TestPlotFabricationFiles(unittest.TestCase):
+
+    def setUp(self):
+        self.pcb = pcbnew.LoadBoard("data/complex_hierarchy.kicad_pcb")
+        self.output_dirs = []
+
+    def tearDown(self):
+        for output_dir in self.output_dirs:
+            shutil.rmtree(output_dir, ignore_errors=True)
+
+    def plot(self, thread_count):
+        output_dir = tempfile.mkdtemp()
+        self.output_dirs.append(output_dir)
+        self.assertTrue(pcbnew.PlotFabricationFiles(self.pcb, output_dir, thread_count))
+        return sorted(os.listdir(output_dir))
+
+    def test_plot_fabrication_files(self):
+        files = self.plot(0)
+
+        gerbers = [f for f in files if f.endswith(".gbr")]
+        drills = [f for f in files if f.endswith(".drl")]
+        maps = [f for f in files if f.endswith("-drl_map.pdf")]
+
+        # F.Cu and B.Cu at least are selected in the board plot settings
+        self.assertTrue(len(gerbers) >= 2)
+        self.assertTrue(len(drills) >= 1)
+        self.assertEqual(len(maps), len(drills))
+
+    def test_plot_fabrication_files_threads(self):
+        # The parallel jobs write the same files as a single worker thread
+        self.assertEqual(self.plot(1), self.plot(0))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,49 @@
+#!/usr/bin/env python
+
+# Replay the interactive router sessions recorded on a board, without any display,
+# and print the latency percentiles and collision query counts of each router event.
+# The board is not modified.
+
+# 1) Record sessions: run pcbnew with KICAD_PNS_RECORD set to the session file,
+#    and route or drag tracks on the board.
+# $ KICAD_PNS_RECORD=/tmp/session.pns pcbnew board.kicad_pcb
+
+# 2) Build target _pcbnew after enabling scripting in cmake.
+# $ make _pcbnew
+
+# 3) Run from the build/pcbnew directory:
+# $ PYTHONPATH=. <path_to>/pns_replay_benchmark.py board.kicad_pcb /tmp/session.pns [--repeat 10]
+
+
+from __future__ import print_function
+
+import argparse
+import sys
+
+import pcbnew
+
+
+def main():
+    parser = argparse.ArgumentParser( description='Benchmark the router on recorded sessions' )
+    parser.add_argument( 'board', help='the .kicad_pcb file the sessions were recorded on' )
+    parser.add_argument( 'session', help='the file recorded with KICAD_PNS_RECORD' )
+    parser.add_argument( '--repeat', type=int, default=1,
+                         help='number of times the sessions are replayed' )
+    args = parser.parse_args()
+
+    if args.repeat <= 0:
+        parser.error( '--repeat must be positive' )
+
+    board = pcbnew.LoadBoard( args.board )
+    report = pcbnew.ReplayRouterSession( board, args.session, args.repeat )
+
+    if not report:
+        print( 'Failed to replay "%s"' % args.session, file=sys.stderr )
+        return 1
+
+    print( report, end='' )
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit( main() )
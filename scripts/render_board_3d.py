@@ -0,0 +1,54 @@
+#!/usr/bin/env python
+
+# Raytrace a board in 3D and save it as a .png file, without any display or GPU.
+# Several instances can run in parallel, each one uses all the cores by OpenMP.
+
+# 1) Build target _pcbnew after enabling scripting in cmake.
+# $ make _pcbnew
+
+# 2) Run from the build/pcbnew directory:
+# $ PYTHONPATH=. <path_to>/render_board_3d.py board.kicad_pcb board.png [--size 1920x1080] [--view top]
+
+
+from __future__ import print_function
+
+import argparse
+import sys
+
+import pcbnew
+
+
+VIEWS = {
+    'top':    pcbnew.RENDER_3D_VIEW_TOP,
+    'bottom': pcbnew.RENDER_3D_VIEW_BOTTOM,
+    'front':  pcbnew.RENDER_3D_VIEW_FRONT,
+    'back':   pcbnew.RENDER_3D_VIEW_BACK,
+    'left':   pcbnew.RENDER_3D_VIEW_LEFT,
+    'right':  pcbnew.RENDER_3D_VIEW_RIGHT,
+}
+
+
+def main():
+    parser = argparse.ArgumentParser( description='Raytrace a board to a .png file' )
+    parser.add_argument( 'board', help='the .kicad_pcb file' )
+    parser.add_argument( 'output', help='the .png file to create' )
+    parser.add_argument( '--size', default='1920x1080', help='WIDTHxHEIGHT in pixels' )
+    parser.add_argument( '--view', default='top', choices=sorted( VIEWS.keys() ) )
+    args = parser.parse_args()
+
+    try:
+        width, height = [ int( v ) for v in args.size.lower().split( 'x' ) ]
+    except ValueError:
+        parser.error( 'bad --size "%s", expected WIDTHxHEIGHT' % args.size )
+
+    board = pcbnew.LoadBoard( args.board )
+
+    if not pcbnew.RenderBoard3D( board, args.output, width, height, VIEWS[args.view] ):
+        print( 'Failed to render "%s"' % args.board, file=sys.stderr )
+        return 1
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit( main() )
@@ -0,0 +1,175 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/*
+ * Benchmarks the footprint name filtering of cvpcb and of the footprint selector on a
+ * generated list of footprints: the wildcard pattern is tested on each footprint, as
+ * done without search index, then only on the candidates given by FOOTPRINT_SEARCH_INDEX
+ * through FOOTPRINT_FILTER.  The numbers of matches of both are compared.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#include <eda_pattern_match.h>
+#include <footprint_filter.h>
+
+#include <qa/data/fixtures_footprint_list.h>
+
+
+using CLOCK = std::chrono::steady_clock;
+using TIME_PT = std::chrono::time_point<CLOCK>;
+
+
+/**
+ * Name patterns, as typed in the filter fields
+ */
+static const wxString patternList[] =
+{
+    wxT( "soic-8*" ),
+    wxT( "*0603*" ),
+    wxT( "qfn*5x5mm*" ),
+    wxT( "*header_1x4*" ),
+    wxT( "r_*_0402_1?" ),
+    wxT( "*06*" ),
+};
+
+
+static double elapsedMs( TIME_PT aStart )
+{
+    using MS = std::chrono::duration<double, std::milli>;
+
+    return std::chrono::duration_cast<MS>( CLOCK::now() - aStart ).count();
+}
+
+
+/**
+ * Count the footprints matching \a aPattern by testing each one of them.
+ */
+static size_t scanList( FOOTPRINT_LIST& aList, const wxString& aPattern )
+{
+    EDA_PATTERN_MATCH_WILDCARD matcher;
+    size_t                     count = 0;
+
+    matcher.SetPattern( aPattern.Lower() );
+
+    for( unsigned ii = 0; ii < aList.GetCount(); ++ii )
+    {
+        if( matcher.Find( aList.GetItem( ii ).GetFootprintName().Lower() )
+                != EDA_PATTERN_NOT_FOUND )
+            ++count;
+    }
+
+    return count;
+}
+
+
+/**
+ * Count the footprints matching \a aPattern with a filter using the search index.
+ */
+static size_t filterList( FOOTPRINT_LIST& aList, const wxString& aPattern )
+{
+    FOOTPRINT_FILTER filter( aList );
+
+    filter.FilterByPattern( aPattern );
+
+    return std::distance( filter.begin(), filter.end() );
+}
+
+
+enum RET_CODES
+{
+    BAD_ARGS = 1,
+    BAD_RESULTS,
+};
+
+
+int main( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc > 3 )
+    {
+        os << "Usage: " << argv[0] << " [FOOTPRINT_COUNT [REPS]]\n";
+        return BAD_ARGS;
+    }
+
+    unsigned count = argc > 1 ? std::max( 1, atoi( argv[1] ) ) : 100000;
+    int      reps = argc > 2 ? std::max( 1, atoi( argv[2] ) ) : 10;
+
+    TEST_FOOTPRINT_LIST list;
+
+    list.Generate( count );
+
+    os << "Footprint Search Bench Mark Util" << std::endl;
+
+    os << "  Footprints:     " << count << std::endl;
+    os << "  Repetitions:    " << reps << std::endl;
+
+    TIME_PT start = CLOCK::now();
+    list.GetSearchIndex();
+    os << "  Index build:    " << elapsedMs( start ) << " ms" << std::endl;
+    os << std::endl;
+
+    char line[256];
+    int  ret = 0;
+
+    snprintf( line, sizeof( line ), "%-16s %10s %12s %12s", "pattern", "matches",
+              "scan ms", "index ms" );
+    os << line << std::endl;
+
+    for( const wxString& pattern : patternList )
+    {
+        size_t scanCount = 0;
+        size_t filterCount = 0;
+
+        start = CLOCK::now();
+
+        for( int ii = 0; ii < reps; ++ii )
+            scanCount = scanList( list, pattern );
+
+        double scanMs = elapsedMs( start ) / reps;
+
+        start = CLOCK::now();
+
+        for( int ii = 0; ii < reps; ++ii )
+            filterCount = filterList( list, pattern );
+
+        double filterMs = elapsedMs( start ) / reps;
+
+        snprintf( line, sizeof( line ), "%-16s %10u %12.3f %12.3f",
+                  (const char*) pattern.c_str(), (unsigned) filterCount, scanMs, filterMs );
+        os << line << std::endl;
+
+        if( filterCount != scanCount )
+        {
+            os << "  mismatch: " << scanCount << " footprints found by the scan" << std::endl;
+            ret = BAD_RESULTS;
+        }
+    }
+
+    return ret;
+}
@@ -0,0 +1,299 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/*
+ * Benchmarks the SHAPE_POLY_SET operations used to fill the zones, on the polygons dumped
+ * by pcbnew when g_DumpZonesWhenFilling is set in zones_convert_brd_items_to_polygons_with_Boost.cpp.
+ * Each operation is run with a single Clipper call, then split in parallel strips (see
+ * SHAPE_POLY_SET::SetTiledOperations()), and the areas of both results are compared.
+ */
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif /* USE_OPENMP */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <geometry/shape_poly_set.h>
+
+
+using CLOCK = std::chrono::steady_clock;
+using TIME_PT = std::chrono::time_point<CLOCK>;
+
+
+/**
+ * The polygons of a zone fill: the zone outline and the holes of the pads, tracks
+ * and other items, with their clearance.
+ */
+struct ZONE_DATA
+{
+    SHAPE_POLY_SET solidAreas;
+    SHAPE_POLY_SET featureHoles;
+};
+
+
+struct BENCH_REPORT
+{
+    std::chrono::milliseconds clipperDurMs;
+    std::chrono::milliseconds tiledDurMs;
+
+    ///> Largest relative difference between the areas of the results
+    double areaDiff;
+};
+
+
+using BENCH_FUNC = std::function<void( const ZONE_DATA&, SHAPE_POLY_SET& )>;
+
+
+struct BENCHMARK
+{
+    BENCH_FUNC func;
+    std::string name;
+};
+
+
+/**
+ * List of available benchmarks, following the zone filling steps
+ */
+static std::vector<BENCHMARK> benchmarkList =
+{
+    {
+        []( const ZONE_DATA& aZone, SHAPE_POLY_SET& aResult )
+        {
+            aResult = aZone.featureHoles;
+            aResult.Simplify( SHAPE_POLY_SET::PM_FAST );
+        },
+        "simplify holes"
+    },
+    {
+        []( const ZONE_DATA& aZone, SHAPE_POLY_SET& aResult )
+        {
+            // the clearance of the holes grown by 0.1 mm
+            aResult = aZone.featureHoles;
+            aResult.Inflate( 100000, 16 );
+        },
+        "inflate holes"
+    },
+    {
+        []( const ZONE_DATA& aZone, SHAPE_POLY_SET& aResult )
+        {
+            SHAPE_POLY_SET holes = aZone.featureHoles;
+            holes.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+            aResult = aZone.solidAreas;
+            aResult.BooleanSubtract( holes, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+        },
+        "subtract holes"
+    },
+    {
+        []( const ZONE_DATA& aZone, SHAPE_POLY_SET& aResult )
+        {
+            SHAPE_POLY_SET holes = aZone.featureHoles;
+            holes.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+            aResult = aZone.solidAreas;
+            aResult.BooleanSubtract( holes, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+            aResult.Fracture( SHAPE_POLY_SET::PM_FAST );
+        },
+        "subtract and fracture"
+    },
+};
+
+
+/**
+ * Reads the "solid-areas" and "feature-holes" shapes of each "clipper-zone" group
+ * in a zone dump.
+ */
+static bool loadZones( const std::string& aFilename, std::vector<ZONE_DATA>& aZones )
+{
+    std::ifstream file( aFilename );
+
+    if( !file )
+        return false;
+
+    std::stringstream stream;
+    stream << file.rdbuf();
+
+    std::string token;
+    ZONE_DATA zone;
+    bool inZone = false;
+
+    while( stream >> token )
+    {
+        if( token == "group" )
+        {
+            stream >> token;
+            inZone = ( token == "clipper-zone" );
+            zone = ZONE_DATA();
+        }
+        else if( token == "shape" )
+        {
+            int type;
+            std::string name;
+            SHAPE_POLY_SET polySet;
+
+            stream >> type >> name;
+
+            if( !polySet.Parse( stream ) )
+                return false;
+
+            if( inZone && name == "solid-areas" )
+                zone.solidAreas = polySet;
+            else if( inZone && name == "feature-holes" )
+                zone.featureHoles = polySet;
+        }
+        else if( token == "endgroup" )
+        {
+            if( inZone && !zone.solidAreas.IsEmpty() )
+                aZones.push_back( zone );
+
+            inZone = false;
+        }
+    }
+
+    return true;
+}
+
+
+static std::chrono::milliseconds runBenchmark( const BENCHMARK& aBenchmark, int aReps,
+        const std::vector<ZONE_DATA>& aZones, std::vector<SHAPE_POLY_SET>& aResults )
+{
+    aResults.resize( aZones.size() );
+
+    TIME_PT start = CLOCK::now();
+
+    for( int i = 0; i < aReps; ++i )
+    {
+        for( unsigned int z = 0; z < aZones.size(); z++ )
+            aBenchmark.func( aZones[z], aResults[z] );
+    }
+
+    TIME_PT end = CLOCK::now();
+
+    using std::chrono::milliseconds;
+    using std::chrono::duration_cast;
+
+    return duration_cast<milliseconds>( end - start );
+}
+
+
+BENCH_REPORT executeBenchMark( const BENCHMARK& aBenchmark, int aReps,
+        const std::vector<ZONE_DATA>& aZones )
+{
+    BENCH_REPORT report = {};
+    std::vector<SHAPE_POLY_SET> clipperResults, tiledResults;
+
+    SHAPE_POLY_SET::SetTiledOperations( false );
+    report.clipperDurMs = runBenchmark( aBenchmark, aReps, aZones, clipperResults );
+
+    SHAPE_POLY_SET::SetTiledOperations( true );
+    report.tiledDurMs = runBenchmark( aBenchmark, aReps, aZones, tiledResults );
+
+    for( unsigned int z = 0; z < aZones.size(); z++ )
+    {
+        double clipperArea = clipperResults[z].Area();
+        double tiledArea = tiledResults[z].Area();
+
+        if( clipperArea != 0.0 )
+            report.areaDiff = std::max( report.areaDiff,
+                                        std::fabs( tiledArea - clipperArea ) / clipperArea );
+    }
+
+    return report;
+}
+
+
+enum RET_CODES
+{
+    BAD_ARGS = 1,
+    BAD_FILE,
+};
+
+
+int main( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 3 )
+    {
+        os << "Usage: " << argv[0] << " <ZONE_DUMP_FILE> <REPS>\n";
+        return BAD_ARGS;
+    }
+
+    std::vector<ZONE_DATA> zones;
+
+    if( !loadZones( argv[1], zones ) )
+    {
+        os << "Cannot read the zone dump " << argv[1] << std::endl;
+        return BAD_FILE;
+    }
+
+    int reps = std::max( 1, atoi( argv[2] ) );
+    int holeVertices = 0;
+
+    for( const ZONE_DATA& zone : zones )
+        holeVertices += zone.featureHoles.TotalVertices();
+
+#ifdef USE_OPENMP
+    int threads = omp_get_max_threads();
+#else
+    int threads = 1;
+#endif
+
+    os << "Polygon Bench Mark Util" << std::endl;
+
+    os << "  Zone dump:      " << argv[1] << std::endl;
+    os << "  Zones:          " << zones.size() << " (" << holeVertices << " hole vertices)"
+       << std::endl;
+    os << "  Repetitions:    " << reps << std::endl;
+    os << "  Threads:        " << threads << std::endl;
+    os << std::endl;
+
+    char line[256];
+
+    snprintf( line, sizeof( line ), "%-24s %12s %12s %12s", "operation", "clipper ms",
+              "tiled ms", "area diff" );
+    os << line << std::endl;
+
+    for( auto& bmark : benchmarkList )
+    {
+        BENCH_REPORT report = executeBenchMark( bmark, reps, zones );
+
+        snprintf( line, sizeof( line ), "%-24s %12d %12d %12.2e", bmark.name.c_str(),
+                  (int) report.clipperDurMs.count(), (int) report.tiledDurMs.count(),
+                  report.areaDiff );
+        os << line << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Times the loading of a legacy symbol library by eeschema, when it is parsed
+ * (cold load) and when it is read from its binary cache file (warm load).
+ *
+ * The SCH_PLUGIN is built inside the eeschema KIFACE, so the KIFACE is loaded
+ * at run time, the same way the KIWAY does.
+ */
+
+#include <wx/wx.h>
+#include <wx/dynlib.h>
+#include <wx/filename.h>
+
+#include <kiway.h>
+#include <kiface_ids.h>
+#include <sch_io_mgr.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+
+using CLOCK = std::chrono::steady_clock;
+using TIME_PT = std::chrono::time_point<CLOCK>;
+
+
+/// Environment variable disabling the symbol library cache, see sch_legacy_plugin.cpp
+#define SYMBOL_CACHE_DISABLE_ENV    wxT( "KICAD_NO_SYMBOL_CACHE" )
+
+
+struct BENCH_REPORT
+{
+    /// Symbol count of the last load, to check all the loads read the same library
+    unsigned symbolCount;
+
+    std::chrono::milliseconds benchDurMs;
+};
+
+
+/**
+ * Load the library \a aLibPath \a aReps times, each time with a new plugin
+ * so nothing is kept in memory between two loads.
+ */
+static BENCH_REPORT executeBenchMark( KIFACE* aKiface, const wxString& aLibPath, int aReps )
+{
+    BENCH_REPORT report = {};
+
+    TIME_PT start = CLOCK::now();
+
+    for( int i = 0; i < aReps; ++i )
+    {
+        std::unique_ptr<SCH_PLUGIN> plugin( static_cast<SCH_PLUGIN*>(
+                aKiface->IfaceOrAddress( KIFACE_NEW_SCH_LEGACY_PLUGIN ) ) );
+        wxArrayString aliasNames;
+
+        plugin->EnumerateSymbolLib( aliasNames, aLibPath );
+        report.symbolCount = aliasNames.GetCount();
+    }
+
+    TIME_PT end = CLOCK::now();
+
+    using std::chrono::milliseconds;
+    using std::chrono::duration_cast;
+
+    report.benchDurMs = duration_cast<milliseconds>( end - start );
+
+    return report;
+}
+
+
+/**
+ * Load the eeschema KIFACE from \a aKifacePath.
+ * @return the KIFACE or NULL on error, the library is never unloaded.
+ */
+static KIFACE* loadKiface( const wxString& aKifacePath )
+{
+    wxDynamicLibrary dso;
+
+    if( !dso.Load( aKifacePath, wxDL_VERBATIM | wxDL_NOW | wxDL_GLOBAL ) )
+        return NULL;
+
+    void* addr = dso.GetSymbol( wxT( KIFACE_INSTANCE_NAME_AND_VERSION ) );
+
+    if( !addr )
+        return NULL;
+
+    KIFACE_GETTER_FUNC* getter = (KIFACE_GETTER_FUNC*) addr;
+    int kifaceVersion;
+
+    // Loading the libraries does not use the PGM_BASE: the KIFACE is not started.
+    KIFACE* kiface = getter( &kifaceVersion, KIFACE_VERSION, NULL );
+
+    (void) dso.Detach();
+
+    return kiface;
+}
+
+
+enum RET_CODES
+{
+    BAD_ARGS = 1,
+    BAD_KIFACE,
+    LOAD_ERROR,
+};
+
+
+int main( int argc, char* argv[] )
+{
+    wxInitializer initializer( argc, argv );
+    auto& os = std::cout;
+
+    if( argc < 4 )
+    {
+        os << "Usage: " << argv[0] << " <KIFACE> <LIBRARY> <REPS>\n\n";
+        os << "  KIFACE:  the eeschema KIFACE, e.g. eeschema/_eeschema.kiface\n";
+        os << "  LIBRARY: a legacy symbol library (.lib)\n";
+        return BAD_ARGS;
+    }
+
+    KIFACE* kiface = loadKiface( argv[1] );
+
+    if( !kiface )
+    {
+        os << "Cannot load the KIFACE " << argv[1] << std::endl;
+        return BAD_KIFACE;
+    }
+
+    wxFileName libFile( argv[2] );
+    libFile.MakeAbsolute();
+
+    long reps = 0;
+    wxString( argv[3] ).ToLong( &reps );
+    reps = std::max( 1L, reps );
+
+    os << "Symbol Library Bench Mark Util" << std::endl;
+
+    os << "  Library:        " << libFile.GetFullName() << std::endl;
+    os << "  Repetitions:    " << (int) reps << std::endl;
+    os << std::endl;
+
+    try
+    {
+        // Cold loads: the library is parsed, and the cache file is neither read nor written
+        wxSetEnv( SYMBOL_CACHE_DISABLE_ENV, wxT( "1" ) );
+        BENCH_REPORT cold = executeBenchMark( kiface, libFile.GetFullPath(), reps );
+
+        // Warm loads: a first load writes the cache file if it is missing or out of date
+        wxUnsetEnv( SYMBOL_CACHE_DISABLE_ENV );
+        executeBenchMark( kiface, libFile.GetFullPath(), 1 );
+        BENCH_REPORT warm = executeBenchMark( kiface, libFile.GetFullPath(), reps );
+
+        os << wxString::Format( "%-30s %u symbols in %u ms",
+                "cold (parsed)", cold.symbolCount, (int) cold.benchDurMs.count() )
+            << std::endl;
+        os << wxString::Format( "%-30s %u symbols in %u ms",
+                "warm (binary cache)", warm.symbolCount, (int) warm.benchDurMs.count() )
+            << std::endl;
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        os << "Error loading the library: " << ioe.What() << std::endl;
+        return LOAD_ERROR;
+    }
+
+    return 0;
+}